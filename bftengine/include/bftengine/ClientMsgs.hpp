@@ -17,6 +17,15 @@
 #define REQUEST_MSG_TYPE (700)
 #define BATCH_REQUEST_MSG_TYPE (750)
 #define REPLY_MSG_TYPE (800)
+// A reply whose body is the SHA-256 digest of the common reply data, followed by the replica specific information.
+// Sent instead of a full REPLY_MSG_TYPE by the replicas that are not the designated replier of a request that asked for
+// digest-only replies.
+#define REPLY_DIGEST_MSG_TYPE (801)
+#define REPLY_DIGEST_LENGTH (32)
+// A reply, with an OVERLOADED result, sent instead of handling a request when the replica is overloaded. Its body is
+// the time, in milliseconds, after which the client may retry (uint32_t), followed by the signature of the replica over
+// ClientBusyReplySignedData as the replica specific information.
+#define REPLY_BUSY_MSG_TYPE (802)
 
 namespace bftEngine {
 
@@ -63,6 +72,15 @@ struct ClientReplyMsgHeader {
   uint32_t replicaSpecificInfoLength = 0;
 };
 
+// The data signed by the replica in a REPLY_BUSY_MSG_TYPE reply
+struct ClientBusyReplySignedData {
+  uint16_t msgType;  // always == REPLY_BUSY_MSG_TYPE
+  uint16_t replicaId;
+  uint16_t clientId;
+  uint64_t reqSeqNum;
+  uint32_t retryAfterMilli;
+};
+
 #pragma pack(pop)
 
 }  // namespace bftEngine
@@ -0,0 +1,180 @@
+// Concord
+//
+// Copyright (c) 2022 VMware, Inc. All Rights Reserved.
+//
+// This product is licensed to you under the Apache 2.0 license (the "License"). You may not use this product except in
+// compliance with the Apache 2.0 License.
+//
+// This product may include a number of subcomponents with separate copyright notices and license terms. Your use of
+// these subcomponents is subject to the terms and conditions of the subcomponent's license, as noted in the LICENSE
+// file.
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "assertUtils.hpp"
+#include "sha_hash.hpp"
+
+// Merkle-batched client request signatures.
+//
+// A client that sends a batch of requests can sign a single merkle root over the digests of the requests, instead of
+// signing each one of them. The signature field of every request in the batch then holds:
+//
+// | root signature | BatchSignatureHeader | inclusion path (pathLength() * 32 bytes) |
+//
+// The root signature is the client's signature of batchDigest(leafCount, root). Replicas tell the two formats apart by
+// the length of the signature field, which is longer than the client's signature length only for batched signatures.
+// As the whole signature field is carried along with the request, this format goes through pre-execution unchanged.
+//
+// Non-primary replicas use the same format for the result hashes of a batch of pre-processed requests, see
+// preprocessor::PreProcessReplyMsg::signBatch().
+namespace bftEngine::batch_signature {
+
+using Hash = concord::util::SHA2_256::Digest;
+
+#pragma pack(push, 1)
+struct BatchSignatureHeader {
+  uint32_t leafIndex;
+  uint32_t leafCount;
+};
+#pragma pack(pop)
+
+// Domain separation between leaves, inner nodes and the signed digest.
+enum HashPrefix : uint8_t { LEAF = 0x0, NODE = 0x1, BATCH = 0x2 };
+
+inline Hash leafHash(const char* request, size_t length) {
+  concord::util::SHA2_256 hasher;
+  const auto prefix = HashPrefix::LEAF;
+  hasher.init();
+  hasher.update(&prefix, sizeof(prefix));
+  hasher.update(request, length);
+  return hasher.finish();
+}
+
+inline Hash nodeHash(const Hash& left, const Hash& right) {
+  concord::util::SHA2_256 hasher;
+  const auto prefix = HashPrefix::NODE;
+  hasher.init();
+  hasher.update(&prefix, sizeof(prefix));
+  hasher.update(left.data(), left.size());
+  hasher.update(right.data(), right.size());
+  return hasher.finish();
+}
+
+// The data the client signs. The leaf count is included so that a path can't be reinterpreted for a different tree.
+inline Hash batchDigest(uint32_t leafCount, const Hash& root) {
+  concord::util::SHA2_256 hasher;
+  const auto prefix = HashPrefix::BATCH;
+  hasher.init();
+  hasher.update(&prefix, sizeof(prefix));
+  hasher.update(&leafCount, sizeof(leafCount));
+  hasher.update(root.data(), root.size());
+  return hasher.finish();
+}
+
+// The number of hashes in the inclusion path of a leaf. The last node of a level with an odd number of nodes has no
+// sibling and is promoted to the next level as is.
+inline size_t pathLength(uint32_t index, uint32_t count) {
+  size_t length = 0;
+  while (count > 1) {
+    if (index % 2 == 1 || index + 1 < count) ++length;
+    index /= 2;
+    count = (count + 1) / 2;
+  }
+  return length;
+}
+
+class MerkleTree {
+ public:
+  explicit MerkleTree(std::vector<Hash> leaves) {
+    ConcordAssert(!leaves.empty());
+    levels_.push_back(std::move(leaves));
+    while (levels_.back().size() > 1) {
+      const auto& level = levels_.back();
+      std::vector<Hash> next;
+      next.reserve((level.size() + 1) / 2);
+      for (size_t i = 0; i < level.size(); i += 2) {
+        next.push_back(i + 1 < level.size() ? nodeHash(level[i], level[i + 1]) : level[i]);
+      }
+      levels_.push_back(std::move(next));
+    }
+  }
+
+  const Hash& root() const { return levels_.back().front(); }
+  uint32_t size() const { return static_cast<uint32_t>(levels_.front().size()); }
+
+  // Sibling hashes from the leaf up to the root.
+  std::vector<Hash> path(uint32_t index) const {
+    ConcordAssertLT(index, size());
+    std::vector<Hash> path;
+    for (size_t l = 0; l + 1 < levels_.size(); ++l, index /= 2) {
+      const auto sibling = index ^ 1u;
+      if (sibling < levels_[l].size()) path.push_back(levels_[l][sibling]);
+    }
+    return path;
+  }
+
+ private:
+  std::vector<std::vector<Hash>> levels_;
+};
+
+// Serialize the signature field of the request at `index`.
+inline std::string serialize(const std::string& rootSignature, uint32_t index, const MerkleTree& tree) {
+  const auto path = tree.path(index);
+  const auto header = BatchSignatureHeader{index, tree.size()};
+  std::string sig;
+  sig.reserve(rootSignature.size() + sizeof(header) + path.size() * sizeof(Hash));
+  sig.append(rootSignature);
+  sig.append(reinterpret_cast<const char*>(&header), sizeof(header));
+  for (const auto& h : path) sig.append(reinterpret_cast<const char*>(h.data()), h.size());
+  return sig;
+}
+
+// A batched signature field, as parsed by `parse`. Pointers refer to the parsed buffer.
+struct ParsedBatchSignature {
+  const char* rootSignature;
+  size_t rootSignatureLength;
+  BatchSignatureHeader header;
+  const char* path;
+  size_t pathLength;
+};
+
+// Parse a batched signature field of a client whose signature length is `clientSigLength`. Returns std::nullopt if the
+// field is malformed.
+inline std::optional<ParsedBatchSignature> parse(const char* sig, size_t sigLength, size_t clientSigLength) {
+  if (sig == nullptr || clientSigLength == 0 || sigLength < clientSigLength + sizeof(BatchSignatureHeader)) {
+    return std::nullopt;
+  }
+  BatchSignatureHeader header;
+  std::memcpy(&header, sig + clientSigLength, sizeof(header));
+  if (header.leafCount == 0 || header.leafIndex >= header.leafCount) return std::nullopt;
+  const auto pathLen = pathLength(header.leafIndex, header.leafCount);
+  if (sigLength != clientSigLength + sizeof(header) + pathLen * sizeof(Hash)) return std::nullopt;
+  return ParsedBatchSignature{sig, clientSigLength, header, sig + clientSigLength + sizeof(header), pathLen};
+}
+
+// Compute the signed digest of a batch from a request and its parsed batched signature.
+inline Hash batchDigestFromPath(const char* request, size_t length, const ParsedBatchSignature& sig) {
+  auto node = leafHash(request, length);
+  auto index = sig.header.leafIndex;
+  auto count = sig.header.leafCount;
+  const char* sibling = sig.path;
+  while (count > 1) {
+    if (index % 2 == 1 || index + 1 < count) {
+      Hash h;
+      std::memcpy(h.data(), sibling, h.size());
+      sibling += h.size();
+      node = (index % 2 == 1) ? nodeHash(h, node) : nodeHash(node, h);
+    }
+    index /= 2;
+    count = (count + 1) / 2;
+  }
+  return batchDigest(sig.header.leafCount, node);
+}
+
+}  // namespace bftEngine::batch_signature
@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <memory>
 #include "threshsign/ThresholdSignaturesTypes.h"
 #include "threshsign/IThresholdSigner.h"
@@ -51,6 +52,13 @@ class CryptoManager : public IKeyExchanger, public IMultiSigKeyGenerator {
   std::shared_ptr<IThresholdVerifier> thresholdVerifierForOptimisticCommit(const SeqNum sn) const {
     return get(sn)->thresholdVerifierForOptimisticCommit_;
   }
+  // The key seq nums of pre-execution results are set by the primary and may come from other replicas' messages
+  std::shared_ptr<IThresholdSigner> thresholdSignerForPreExecution(const SeqNum sn) const {
+    return get(std::max<SeqNum>(sn, 1))->thresholdSigner_;
+  }
+  std::shared_ptr<IThresholdVerifier> thresholdVerifierForPreExecution(const SeqNum sn) const {
+    return get(std::max<SeqNum>(sn, 1))->thresholdVerifierForPreExecution_;
+  }
   // IMultiSigKeyGenerator methods
   std::pair<std::string, std::string> generateMultisigKeyPair() override {
     LOG_INFO(logger(), "Generating new multisig key pair");
@@ -101,6 +109,9 @@ class CryptoManager : public IKeyExchanger, public IMultiSigKeyGenerator {
     // verifier of a threshold signature (for threshold N out of N)
     std::shared_ptr<IThresholdVerifier> thresholdVerifierForOptimisticCommit_;
 
+    // verifier of a threshold signature on pre-execution results (for threshold fVal+1 out of N)
+    std::shared_ptr<IThresholdVerifier> thresholdVerifierForPreExecution_;
+
     void init() {
       std::uint16_t f{ReplicaConfig::instance().getfVal()};
       std::uint16_t c{ReplicaConfig::instance().getcVal()};
@@ -109,6 +120,7 @@ class CryptoManager : public IKeyExchanger, public IMultiSigKeyGenerator {
       thresholdVerifierForSlowPathCommit_.reset(cryptosys_->createThresholdVerifier(f * 2 + c + 1));
       thresholdVerifierForCommit_.reset(cryptosys_->createThresholdVerifier(f * 3 + c + 1));
       thresholdVerifierForOptimisticCommit_.reset(cryptosys_->createThresholdVerifier(numSigners));
+      thresholdVerifierForPreExecution_.reset(cryptosys_->createThresholdVerifier(f + 1));
     }
   };
 
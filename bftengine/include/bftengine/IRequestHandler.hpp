@@ -20,6 +20,7 @@
 #include <string>
 #include <functional>
 #include <deque>
+#include <vector>
 #include "OpenTracing.hpp"
 #include "TimeService.hpp"
 #include "ISystemResourceEntity.hpp"
@@ -54,6 +55,12 @@ class IRequestsHandler {
     uint64_t blockId = 0;
   };
 
+  // The keys that a request reads and writes
+  struct KeySets {
+    std::vector<std::string> readKeys;
+    std::vector<std::string> writeKeys;
+  };
+
   static std::shared_ptr<IRequestsHandler> createRequestsHandler(
       std::shared_ptr<IRequestsHandler> userReqHandler,
       const std::shared_ptr<concord::cron::CronTableRegistry> &,
@@ -72,6 +79,14 @@ class IRequestsHandler {
 
   virtual void onFinishExecutingReadWriteRequests() {}
 
+  // Returns the keys that a request is going to read and write, if the handler can tell them before pre-executing it,
+  // e.g. from the request itself or from previous executions of similar requests. When
+  // preExecConflictAwareSchedulingEnabled, the requests that conflict by these keys are pre-executed one after the
+  // other. Missing keys only let conflicting requests be pre-executed concurrently, as without them.
+  virtual std::optional<KeySets> preExecutionKeySets(uint16_t clientId, const char *request, uint32_t requestSize) {
+    return std::nullopt;
+  }
+
   std::vector<std::shared_ptr<concord::reconfiguration::IReconfigurationHandler>> getReconfigurationHandler() const {
     return reconfig_handler_;
   }
@@ -48,6 +48,7 @@ enum MsgFlag : uint64_t {
   KEY_EXCHANGE_FLAG = 0x8,  // TODO [TK] use reconfig_flag
   TICK_FLAG = 0x10,
   RECONFIG_FLAG = 0x20,
+  DIGEST_REPLIES_FLAG = 0x40,
   PUBLISH_ON_CHAIN_OBJECT_FLAG = 0x80,
   CLIENTS_PUB_KEYS_FLAG = 0x100,
   DB_CHECKPOINT_FLAG = 0x200
@@ -33,7 +33,7 @@ namespace bftEngine {
   CONFIG_PARAM_RO(param, type, default_val, description);   \
   void set##param(const type& val) { param = val; } /* NOLINT(bugprone-macro-parentheses) */
 
-enum BatchingPolicy { BATCH_SELF_ADJUSTED, BATCH_BY_REQ_SIZE, BATCH_BY_REQ_NUM, BATCH_ADAPTIVE };
+enum BatchingPolicy { BATCH_SELF_ADJUSTED, BATCH_BY_REQ_SIZE, BATCH_BY_REQ_NUM, BATCH_ADAPTIVE, BATCH_LATENCY_TARGET };
 
 class ReplicaConfig : public concord::serialize::SerializableFactory<ReplicaConfig> {
  public:
@@ -102,11 +102,22 @@ class ReplicaConfig : public concord::serialize::SerializableFactory<ReplicaConf
                "Number of threads to be used by the PreProcessor to execute "
                "client requests. If equals to 0, a default of "
                "min(thread::hardware_concurrency(), numOfClients) is used ");
+  CONFIG_PARAM(preExecConflictAwareSchedulingEnabled,
+               bool,
+               false,
+               "if the PreProcessor pre-executes the requests that conflict one after the other, by the keys that the "
+               "requests handler reports they read and write, so that fewer of them are aborted at execution");
 
   CONFIG_PARAM(batchingPolicy, uint32_t, BATCH_SELF_ADJUSTED, "BFT consensus batching policy for requests");
   CONFIG_PARAM(batchFlushPeriod, uint32_t, 1000, "BFT consensus batching flush period");
   CONFIG_PARAM(maxNumOfRequestsInBatch, uint32_t, 100, "Maximum number of requests in BFT consensus batch");
   CONFIG_PARAM(maxBatchSizeInBytes, uint32_t, 33554432, "Maximum size of all requests in BFT consensus batch");
+  CONFIG_PARAM(prePrepareDigestsOnlyEnabled,
+               bool,
+               false,
+               "if the primary references the client requests of a PrePrepare instead of sending them, for the other "
+               "replicas to rebuild it from the requests they got from the clients. Clients should send their write "
+               "requests to all the replicas");
   CONFIG_PARAM(maxInitialBatchSize,
                uint32_t,
                350,
@@ -120,6 +131,62 @@ class ReplicaConfig : public concord::serialize::SerializableFactory<ReplicaConf
   CONFIG_PARAM(adaptiveBatchingMidIncCond, std::string, "0.9", "The mid increase condition");
   CONFIG_PARAM(adaptiveBatchingMinIncCond, std::string, "0.75", "The min increase condition");
   CONFIG_PARAM(adaptiveBatchingDecCond, std::string, "0.5", "The decrease condition");
+  CONFIG_PARAM(batchingLatencyTargetMs,
+               uint32_t,
+               100,
+               "Target p99 PrePrepare-to-commit latency of the BATCH_LATENCY_TARGET batching policy, in milliseconds");
+  CONFIG_PARAM(admissionControlEnabled,
+               bool,
+               false,
+               "Whether the primary turns away new client requests, with a signed busy reply, when overloaded");
+  CONFIG_PARAM(admissionControlMaxPendingRequests,
+               uint32_t,
+               5000,
+               "Requests pending in the clients manager at which admission control considers the replica fully loaded");
+  CONFIG_PARAM(admissionControlMaxPreProcessorRequests,
+               uint32_t,
+               1000,
+               "Requests in the pre-processor at which admission control considers the replica fully loaded");
+  CONFIG_PARAM(admissionControlMaxRetryAfterMs,
+               uint32_t,
+               1000,
+               "Longest time, in milliseconds, after which an overloaded replica asks clients to retry");
+  CONFIG_PARAM(concurrencyControllerEnabled,
+               bool,
+               false,
+               "Whether the pre-processor and request thread pools are resized at runtime by queue wait and CPU use");
+  CONFIG_PARAM(concurrencyControllerPeriodMs,
+               uint32_t,
+               1000,
+               "How often the concurrency controller resizes the thread pools, in milliseconds");
+  CONFIG_PARAM(concurrencyControllerTargetQueueWaitMicros,
+               uint32_t,
+               5000,
+               "Time, in microseconds, that jobs may wait in a thread pool's queue before the pool grows");
+  CONFIG_PARAM(concurrencyControllerMaxCpuUtilizationPercent,
+               uint32_t,
+               90,
+               "CPU utilization of the replica process above which the thread pools shrink");
+  CONFIG_PARAM(preExecMinConcurrencyLevel,
+               uint16_t,
+               1,
+               "Fewest threads the PreProcessor runs with when the concurrency controller is enabled");
+  CONFIG_PARAM(preExecMaxConcurrencyLevel,
+               uint16_t,
+               0,
+               "Most threads the PreProcessor runs with when the concurrency controller is enabled. "
+               "If equals to 0, its startup number of threads is used, so the controller only shrinks its pool under "
+               "load and grows it back to its startup size");
+  CONFIG_PARAM(threadbagMinConcurrencyLevel,
+               uint32_t,
+               1u,
+               "Fewest threads each request thread pool runs with when the concurrency controller is enabled");
+  CONFIG_PARAM(threadbagMaxConcurrencyLevel,
+               uint32_t,
+               0u,
+               "Most threads each request thread pool runs with when the concurrency controller is enabled. "
+               "If equals to 0, threadbagConcurrencyLevel1 and threadbagConcurrencyLevel2 are used, so the controller "
+               "only shrinks the pools under load and grows them back to their startup sizes");
 
   // Crypto system
   // RSA public keys of all replicas. map from replica identifier to a public key
@@ -197,6 +264,17 @@ class ReplicaConfig : public concord::serialize::SerializableFactory<ReplicaConf
                "wake up the ticks generator every ticksGeneratorPollPeriod seconds and fire pending ticks");
 
   CONFIG_PARAM(preExecutionResultAuthEnabled, bool, false, "if PreExecution result authentication is enabled");
+  CONFIG_PARAM(preExecutionResultThresholdAuthEnabled,
+               bool,
+               false,
+               "if PreExecution results are authenticated by one threshold signature, combined by the primary from the "
+               "replicas' signature shares, instead of by fVal + 1 signatures; requires preExecutionResultAuthEnabled");
+  CONFIG_PARAM(preExecutionBatchResultSigningEnabled,
+               bool,
+               false,
+               "if a non-primary replica signs one merkle root over the result hashes of a batch of pre-processed "
+               "requests, instead of each result hash; requires batchedPreProcessEnabled, and is ignored when "
+               "preExecutionResultThresholdAuthEnabled");
 
   CONFIG_PARAM(prePrepareFinalizeAsyncEnabled, bool, true, "Enabling asynchronous preprepare finishing");
 
@@ -255,6 +333,11 @@ class ReplicaConfig : public concord::serialize::SerializableFactory<ReplicaConf
 
   CONFIG_PARAM(enableMultiplexChannel, bool, false, "whether multiplex communication channel is enabled")
 
+  CONFIG_PARAM(enableReplicaMacAuthenticators,
+               bool,
+               false,
+               "whether messages between replicas carry MAC authenticators of pairwise session keys");
+
   CONFIG_PARAM(useUnifiedCertificates, bool, false, "A flag to use unified Certificates");
 
   CONFIG_PARAM(adaptivePruningIntervalDuration,
@@ -594,12 +677,31 @@ inline std::ostream& operator<<(std::ostream& os, const ReplicaConfig& rc) {
   os << KVLOG(rc.dbCheckpointMonitorIntervalSeconds.count(),
               rc.dbCheckpointDiskSpaceThreshold,
               rc.enableMultiplexChannel,
+              rc.enableReplicaMacAuthenticators,
               rc.enableEventGroups,
               rc.operatorEnabled_,
               rc.enablePreProcessorMemoryPool,
               rc.diagnosticsServerPort,
               rc.useUnifiedCertificates,
-              rc.kvBlockchainVersion);
+              rc.kvBlockchainVersion,
+              rc.batchingLatencyTargetMs,
+              rc.admissionControlEnabled,
+              rc.admissionControlMaxPendingRequests,
+              rc.admissionControlMaxPreProcessorRequests,
+              rc.admissionControlMaxRetryAfterMs);
+  os << ",";
+  os << KVLOG(rc.concurrencyControllerEnabled,
+              rc.concurrencyControllerPeriodMs,
+              rc.concurrencyControllerTargetQueueWaitMicros,
+              rc.concurrencyControllerMaxCpuUtilizationPercent,
+              rc.preExecMinConcurrencyLevel,
+              rc.preExecMaxConcurrencyLevel,
+              rc.threadbagMinConcurrencyLevel,
+              rc.threadbagMaxConcurrencyLevel,
+              rc.preExecutionResultThresholdAuthEnabled,
+              rc.preExecutionBatchResultSigningEnabled,
+              rc.preExecConflictAwareSchedulingEnabled,
+              rc.prePrepareDigestsOnlyEnabled);
   os << ", ";
   for (auto& [param, value] : rc.config_params_) os << param << ": " << value << "\n";
   return os;
@@ -49,6 +49,7 @@ enum ClientMsgFlag : uint8_t {
   EMPTY_CLIENT_REQ = 0x10,
   RECONFIG_FLAG_REQ = 0x20,
   RECONFIG_READ_ONLY_REQ = 0x21,  // Same as READ_ONLY_REQ | RECONFIG_FLAG_REQ
+  DIGEST_REPLIES_REQ = 0x40,
 };
 
 // Call back for request - at this point we know for sure that a client is handling the request, so we can assure that
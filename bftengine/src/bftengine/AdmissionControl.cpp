@@ -0,0 +1,79 @@
+// Concord
+//
+// Copyright (c) 2022 VMware, Inc. All Rights Reserved.
+//
+// This product is licensed to you under the Apache 2.0 license (the "License"). You may not use this product except in
+// compliance with the Apache 2.0 License.
+//
+// This product may include a number of subcomponents with separate copyright notices and license terms.
+// Your use of these subcomponents is subject to the terms and conditions of the sub-component's license,
+// as noted in the LICENSE file.
+
+#include "AdmissionControl.hpp"
+#include "Logger.hpp"
+#include "kvstream.h"
+
+#include <algorithm>
+
+namespace bftEngine::impl {
+
+using namespace std::chrono;
+
+namespace {
+// A limit of 0 leaves its part of the load out
+double ratio(int64_t value, uint64_t limit) {
+  return limit > 0 ? static_cast<double>(std::max<int64_t>(value, 0)) / static_cast<double>(limit) : 0;
+}
+}  // namespace
+
+AdmissionControl::AdmissionControl(const Limits& limits,
+                                   std::function<uint64_t()> requestsInQueue,
+                                   std::function<uint64_t()> pendingRequests,
+                                   concordMetrics::Component& metrics)
+    : limits_{limits.maxRequestsInQueue,
+              limits.maxPendingRequests,
+              limits.maxPreProcessorRequests,
+              std::max(limits.maxRetryAfter, MIN_RETRY_AFTER)},
+      requestsInQueue_(std::move(requestsInQueue)),
+      pendingRequests_(std::move(pendingRequests)),
+      metric_load_percent_{metrics.RegisterAtomicGauge("admissionControlLoadPercent", 0)},
+      metric_rejected_{metrics.RegisterAtomicCounter("admissionControlRejectedRequests")},
+      metric_busy_replies_dropped_{metrics.RegisterAtomicCounter("admissionControlDroppedBusyReplies")} {}
+
+double AdmissionControl::load() const {
+  return std::max({ratio(static_cast<int64_t>(requestsInQueue_()), limits_.maxRequestsInQueue),
+                   ratio(static_cast<int64_t>(pendingRequests_()), limits_.maxPendingRequests),
+                   ratio(preProcessorRequests_, limits_.maxPreProcessorRequests)});
+}
+
+std::optional<milliseconds> AdmissionControl::admit() {
+  const auto currentLoad = load();
+  metric_load_percent_.Get().Set(static_cast<uint64_t>(currentLoad * 100));
+
+  if (!overloaded_ && currentLoad >= HIGH_WATERMARK) {
+    overloaded_ = true;
+    LOG_INFO(GL, "Overloaded, turning away new client requests" << KVLOG(currentLoad));
+  } else if (overloaded_ && currentLoad < LOW_WATERMARK) {
+    overloaded_ = false;
+    LOG_INFO(GL, "No longer overloaded, admitting new client requests" << KVLOG(currentLoad));
+  }
+  if (!overloaded_) return std::nullopt;
+
+  metric_rejected_++;
+  const auto excess = std::clamp((currentLoad - LOW_WATERMARK) / (1 - LOW_WATERMARK), 0.0, 1.0);
+  return MIN_RETRY_AFTER + duration_cast<milliseconds>((limits_.maxRetryAfter - MIN_RETRY_AFTER) * excess);
+}
+
+bool AdmissionControl::shouldSendBusyReply(uint16_t clientId, milliseconds retryAfter) {
+  const auto now = steady_clock::now();
+  std::lock_guard<std::mutex> lock(busyRepliesLock_);
+  auto& nextBusyReply = nextBusyReply_[clientId];
+  if (now < nextBusyReply) {
+    metric_busy_replies_dropped_++;
+    return false;
+  }
+  nextBusyReply = now + retryAfter;
+  return true;
+}
+
+}  // namespace bftEngine::impl
@@ -0,0 +1,79 @@
+// Concord
+//
+// Copyright (c) 2022 VMware, Inc. All Rights Reserved.
+//
+// This product is licensed to you under the Apache 2.0 license (the "License"). You may not use this product except in
+// compliance with the Apache 2.0 License.
+//
+// This product may include a number of subcomponents with separate copyright notices and license terms.
+// Your use of these subcomponents is subject to the terms and conditions of the sub-component's license,
+// as noted in the LICENSE file.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+#include "Metrics.hpp"
+
+namespace bftEngine::impl {
+
+// Admission control of the new client requests of the primary. The load of the replica is the fullest of its requests
+// queue, the requests pending in the clients manager and the requests in the pre-processor, each relative to its limit.
+// Once the load reaches HIGH_WATERMARK the replica is overloaded, and new requests are turned away with a time after
+// which the client may retry, until the load drops under LOW_WATERMARK. The retry time grows from MIN_RETRY_AFTER to
+// the configured maximum with the load above LOW_WATERMARK, so clients back off harder the more overloaded it is.
+class AdmissionControl {
+ public:
+  static constexpr double HIGH_WATERMARK = 0.9;
+  static constexpr double LOW_WATERMARK = 0.7;
+  static constexpr std::chrono::milliseconds MIN_RETRY_AFTER{20};
+
+  struct Limits {
+    uint64_t maxRequestsInQueue;
+    uint64_t maxPendingRequests;
+    uint64_t maxPreProcessorRequests;
+    std::chrono::milliseconds maxRetryAfter;
+  };
+
+  AdmissionControl(const Limits& limits,
+                   std::function<uint64_t()> requestsInQueue,
+                   std::function<uint64_t()> pendingRequests,
+                   concordMetrics::Component& metrics);
+
+  // Returns std::nullopt if a new request is admitted, or else the time after which its client may retry
+  std::optional<std::chrono::milliseconds> admit();
+
+  // Whether to send a busy reply to a request of clientId that admit() turned away with retryAfter. A client is sent
+  // at most one busy reply per retry time: it holds back its retransmissions until then anyway, and signing a reply to
+  // every request of a flooding client would only add to the load.
+  bool shouldSendBusyReply(uint16_t clientId, std::chrono::milliseconds retryAfter);
+
+  // The pre-processor started, or stopped, handling a client request
+  void onPreProcessorRequestStarted() { preProcessorRequests_++; }
+  void onPreProcessorRequestReleased() { preProcessorRequests_--; }
+
+  double load() const;
+  bool overloaded() const { return overloaded_; }
+
+ private:
+  const Limits limits_;
+  const std::function<uint64_t()> requestsInQueue_;
+  const std::function<uint64_t()> pendingRequests_;
+  std::atomic_int64_t preProcessorRequests_{0};
+  std::atomic_bool overloaded_{false};
+  // The time until which no other busy reply is sent to a client
+  std::mutex busyRepliesLock_;
+  std::unordered_map<uint16_t, std::chrono::steady_clock::time_point> nextBusyReply_;
+
+  concordMetrics::AtomicGaugeHandle metric_load_percent_;
+  concordMetrics::AtomicCounterHandle metric_rejected_;
+  concordMetrics::AtomicCounterHandle metric_busy_replies_dropped_;
+};
+
+}  // namespace bftEngine::impl
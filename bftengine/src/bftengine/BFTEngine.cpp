@@ -22,6 +22,7 @@
 #include "PreProcessor.hpp"
 #include "MsgReceiver.hpp"
 #include "RequestHandler.h"
+#include "SigManager.hpp"
 #include "ReservedPagesClient.hpp"
 #include "bftengine/EpochManager.hpp"
 #include "bcstatetransfer/AsyncStateTransferCRE.hpp"
@@ -218,9 +219,28 @@ IReplica::IReplicaPtr IReplica::createNewReplica(const ReplicaConfig &replicaCon
       std::make_unique<IncomingMsgsStorageImp>(msgHandlersPtr, timersResolution, replicaConfig.replicaId);
   auto &timers = incomingMsgsStorageImpPtr->timers();
   shared_ptr<IncomingMsgsStorage> incomingMsgsStoragePtr{std::move(incomingMsgsStorageImpPtr)};
-  shared_ptr<bft::communication::IReceiver> msgReceiverPtr(new MsgReceiver(incomingMsgsStoragePtr));
+  shared_ptr<MsgReceiver> msgReceiverPtr(new MsgReceiver(incomingMsgsStoragePtr));
   shared_ptr<MsgsCommunicator> msgsCommunicatorPtr(
       new MsgsCommunicator(communication, incomingMsgsStoragePtr, msgReceiverPtr));
+  if (replicaConfig.enableReplicaMacAuthenticators) {
+    // The handshakes are signed with the RSA keys of the replicas, SigManager is initialized by the replica
+    auto macAuthenticator = std::make_shared<ReplicaMacAuthenticator>(
+        replicaConfig.replicaId,
+        replicaConfig.numReplicas,
+        [](const char *data, size_t dataLength) {
+          auto *sigManager = SigManager::instance();
+          std::string sig(sigManager->getMySigLength(), '\0');
+          sigManager->sign(data, dataLength, sig.data(), sig.size());
+          return sig;
+        },
+        [](ReplicaId signer, const char *data, size_t dataLength, const char *sig, size_t sigLength) {
+          auto *sigManager = SigManager::instance();
+          return sigLength == sigManager->getSigLength(signer) &&
+                 sigManager->verifySig(signer, data, dataLength, sig, sigLength);
+        });
+    msgReceiverPtr->setMacAuthenticator(macAuthenticator);
+    msgsCommunicatorPtr->setMacAuthenticator(macAuthenticator);
+  }
   if (isNewStorage) {
     auto replicaImp = std::make_unique<ReplicaImp>(replicaConfig,
                                                    requestsHandler,
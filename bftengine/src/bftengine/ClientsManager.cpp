@@ -27,33 +27,45 @@ namespace bftEngine::impl {
 
 /*************************** Class ClientsManager::RequestsInfo ***************************/
 
+void ClientsManager::RequestsInfo::onSizeChanged() {
+  const size_t size = requestsMap_.size();
+  const size_t oldSize = size_.exchange(size);
+  if (size > oldSize) {
+    *numOfPendingRequests += size - oldSize;
+  } else {
+    *numOfPendingRequests -= oldSize - size;
+  }
+}
+
 void ClientsManager::RequestsInfo::emplaceSafe(NodeIdType clientId, ReqId reqSeqNum, const std::string& cid) {
+  const lock_guard<mutex> lock(requestsMapMutex_);
   if (requestsMap_.find(reqSeqNum) != requestsMap_.end()) {
     LOG_WARN(CL_MNGR, "The request already exists - skip adding" << KVLOG(clientId, reqSeqNum));
     return;
   }
-  const lock_guard<mutex> lock(requestsMapMutex_);
   requestsMap_.emplace(reqSeqNum, RequestInfo{getMonotonicTime(), cid});
+  onSizeChanged();
   LOG_DEBUG(CL_MNGR, "Added request" << KVLOG(clientId, reqSeqNum, requestsMap_.size()));
 }
 
-bool ClientsManager::RequestsInfo::findSafe(ReqId reqSeqNum) {
+bool ClientsManager::RequestsInfo::findSafe(ReqId reqSeqNum) const {
+  if (size_ == 0) return false;
   const lock_guard<mutex> lock(requestsMapMutex_);
   return (requestsMap_.find(reqSeqNum) != requestsMap_.end());
 }
 
 bool ClientsManager::RequestsInfo::removeRequestsOutOfBatchBoundsSafe(NodeIdType clientId, ReqId reqSequenceNum) {
-  ReqId maxReqId{0};
-  if (requestsMap_.find(reqSequenceNum) != requestsMap_.end()) return false;
-
+  if (size_ < maxNumOfRequestsInBatch) return false;
   const lock_guard<mutex> lock(requestsMapMutex_);
-  for (const auto& reqInfo : requestsMap_)
-    if (reqInfo.first > maxReqId) maxReqId = reqInfo.first;
+  if (requestsMap_.find(reqSequenceNum) != requestsMap_.end()) return false;
+  // The map is sorted by sequence number
+  const ReqId maxReqId = requestsMap_.empty() ? 0 : requestsMap_.crbegin()->first;
 
   if (requestsMap_.size() == maxNumOfRequestsInBatch && maxReqId > reqSequenceNum) {
     // If we don't have room for the sequence number, and we see that the highest sequence number is greater
     // than the given one, it means that the highest sequence number is out of the boundaries and can be safely removed
     requestsMap_.erase(maxReqId);
+    onSizeChanged();
     return true;
   }
   return false;
@@ -68,33 +80,37 @@ void ClientsManager::RequestsInfo::removeOldPendingReqsSafe(NodeIdType clientId,
     } else
       it++;
   }
+  onSizeChanged();
 }
 
 void ClientsManager::RequestsInfo::removePendingForExecutionRequestSafe(NodeIdType clientId, ReqId reqSeqNum) {
+  if (size_ == 0) return;
   const lock_guard<mutex> lock(requestsMapMutex_);
   const auto& reqIt = requestsMap_.find(reqSeqNum);
   if (reqIt != requestsMap_.end()) {
     requestsMap_.erase(reqIt);
+    onSizeChanged();
     LOG_DEBUG(CL_MNGR, "Removed request" << KVLOG(clientId, reqSeqNum, requestsMap_.size()));
   }
 }
 
 void ClientsManager::RequestsInfo::clearSafe() {
+  if (size_ == 0) return;
   const lock_guard<mutex> lock(requestsMapMutex_);
   requestsMap_.clear();
+  onSizeChanged();
 }
 
-bool ClientsManager::RequestsInfo::find(ReqId reqSeqNum) const {
-  return (requestsMap_.find(reqSeqNum) != requestsMap_.end());
-}
-
-bool ClientsManager::RequestsInfo::isPending(ReqId reqSeqNum) const {
+bool ClientsManager::RequestsInfo::isPendingSafe(ReqId reqSeqNum) const {
+  if (size_ == 0) return false;
+  const lock_guard<mutex> lock(requestsMapMutex_);
   const auto& reqIt = requestsMap_.find(reqSeqNum);
   if (reqIt != requestsMap_.end() && !reqIt->second.committed) return true;
   return false;
 }
 
-void ClientsManager::RequestsInfo::markRequestAsCommitted(NodeIdType clientId, ReqId reqSeqNum) {
+void ClientsManager::RequestsInfo::markRequestAsCommittedSafe(NodeIdType clientId, ReqId reqSeqNum) {
+  const lock_guard<mutex> lock(requestsMapMutex_);
   const auto& reqIt = requestsMap_.find(reqSeqNum);
   if (reqIt != requestsMap_.end()) {
     reqIt->second.committed = true;
@@ -104,8 +120,10 @@ void ClientsManager::RequestsInfo::markRequestAsCommitted(NodeIdType clientId, R
   LOG_DEBUG(CL_MNGR, "Request not found" << KVLOG(clientId, reqSeqNum));
 }
 
-void ClientsManager::RequestsInfo::infoOfEarliestPendingRequest(Time& earliestTime,
-                                                                RequestInfo& earliestPendingReqInfo) const {
+void ClientsManager::RequestsInfo::infoOfEarliestPendingRequestSafe(Time& earliestTime,
+                                                                    RequestInfo& earliestPendingReqInfo) const {
+  if (size_ == 0) return;
+  const lock_guard<mutex> lock(requestsMapMutex_);
   for (const auto& req : requestsMap_) {
     // Don't take into account already committed requests
     if ((req.second.time != MinTime) && (earliestTime > req.second.time) && (!req.second.committed)) {
@@ -115,9 +133,11 @@ void ClientsManager::RequestsInfo::infoOfEarliestPendingRequest(Time& earliestTi
   }
 }
 
-void ClientsManager::RequestsInfo::logAllPendingRequestsExceedingThreshold(const int64_t threshold,
-                                                                           const Time& currTime,
-                                                                           int& numExceeding) const {
+void ClientsManager::RequestsInfo::logAllPendingRequestsExceedingThresholdSafe(const int64_t threshold,
+                                                                               const Time& currTime,
+                                                                               int& numExceeding) const {
+  if (size_ == 0) return;
+  const lock_guard<mutex> lock(requestsMapMutex_);
   for (const auto& req : requestsMap_) {
     // Don't take into account already committed requests
     if ((req.second.time != MinTime) && (!req.second.committed)) {
@@ -135,6 +155,7 @@ void ClientsManager::RequestsInfo::logAllPendingRequestsExceedingThreshold(const
 void ClientsManager::RepliesInfo::deleteOldestReplyIfNeededSafe(NodeIdType clientId, uint16_t maxNumOfReqsPerClient) {
   Time earliestTime = MaxTime;
   ReqId earliestReplyId = 0;
+  const lock_guard<mutex> lock(repliesMapMutex_);
   if (repliesMap_.size() < maxNumOfReqsPerClient) return;
   if (repliesMap_.size() > maxNumOfReqsPerClient)
     LOG_FATAL(CL_MNGR,
@@ -146,7 +167,6 @@ void ClientsManager::RepliesInfo::deleteOldestReplyIfNeededSafe(NodeIdType clien
       earliestTime = reply.second;
     }
   }
-  const lock_guard<mutex> lock(repliesMapMutex_);
   if (earliestReplyId) {
     repliesMap_.erase(earliestReplyId);
   } else if (!repliesMap_.empty()) {
@@ -163,18 +183,18 @@ void ClientsManager::RepliesInfo::deleteOldestReplyIfNeededSafe(NodeIdType clien
 
 bool ClientsManager::RepliesInfo::insertOrAssignSafe(ReqId reqSeqNum, Time time) {
   const lock_guard<mutex> lock(repliesMapMutex_);
-  return repliesMap_.insert_or_assign(reqSeqNum, time).second;
+  const bool inserted = repliesMap_.insert_or_assign(reqSeqNum, time).second;
+  // Only after the reply is in the map, for findSafe() not to miss it
+  if (reqSeqNum > maxReqSeqNum_) maxReqSeqNum_ = reqSeqNum;
+  return inserted;
 }
 
-bool ClientsManager::RepliesInfo::findSafe(ReqId reqSeqNum) {
+bool ClientsManager::RepliesInfo::findSafe(ReqId reqSeqNum) const {
+  if (reqSeqNum > maxReqSeqNum_) return false;
   const lock_guard<mutex> lock(repliesMapMutex_);
   return (repliesMap_.find(reqSeqNum) != repliesMap_.end());
 }
 
-bool ClientsManager::RepliesInfo::find(ReqId reqSeqNum) const {
-  return (repliesMap_.find(reqSeqNum) != repliesMap_.end());
-}
-
 /*************************** Class ClientsManager ***************************/
 
 // Initialize:
@@ -210,27 +230,24 @@ ClientsManager::ClientsManager(const std::set<NodeIdType>& proxyClients,
       metric_reply_inconsistency_detected_{metrics_.RegisterCounter("totalReplyInconsistenciesDetected")},
       metric_removed_due_to_out_of_boundaries_{metrics_.RegisterCounter("totalRemovedDueToOutOfBoundaries")} {
   reservedPagesPerClient_ = reservedPagesPerClient(sizeOfReservedPage(), maxReplySize_);
+  std::set<NodeIdType> clientIds;
   for (NodeIdType i = 0; i < ReplicaConfig::instance().numReplicas + ReplicaConfig::instance().numRoReplicas; i++) {
-    clientIds_.insert(i);
+    clientIds.insert(i);
   }
-  clientIds_.insert(proxyClients_.begin(), proxyClients_.end());
-  clientIds_.insert(externalClients_.begin(), externalClients_.end());
-  clientIds_.insert(clientServices_.begin(), clientServices_.end());
-  clientIds_.insert(internalClients_.begin(), internalClients_.end());
-  ConcordAssert(clientIds_.size() >= 1);
-  uint32_t rpage = 0;
-  for (const auto cid : clientIds_) {
-    clientIdsToReservedPages_.emplace(cid, rpage);
-    rpage++;
-  }
-  // For the benefit of code accessing clientsInfo_, pre-fill clientsInfo_ with a blank entry for each client to reduce
-  // ambiguity between invalid client IDs and valid client IDs for which nothing stored in clientsInfo_ has been loaded
-  // so far.
-  for (const auto& client_id : clientIds_) {
-    clientsInfo_.emplace(client_id, ClientInfo());
-    clientsInfo_[client_id].requestsInfo = make_shared<RequestsInfo>();
-    clientsInfo_[client_id].repliesInfo = make_shared<RepliesInfo>();
+  clientIds.insert(proxyClients_.begin(), proxyClients_.end());
+  clientIds.insert(externalClients_.begin(), externalClients_.end());
+  clientIds.insert(clientServices_.begin(), clientServices_.end());
+  clientIds.insert(internalClients_.begin(), internalClients_.end());
+  ConcordAssert(clientIds.size() >= 1);
+  // The reserved pages of the clients are in the order of their ids
+  clientIds_.assign(clientIds.cbegin(), clientIds.cend());
+  clientIndices_.assign(static_cast<size_t>(clientIds_.back()) + 1, kNoClient);
+  for (uint32_t i = 0; i < clientIds_.size(); i++) {
+    clientIndices_[clientIds_[i]] = i;
   }
+  // A blank entry for each client, until what the reserved pages hold for it is loaded
+  clients_ = std::vector<ClientInfo>(clientIds_.size());
+  for (auto& client : clients_) client.requestsInfo.numOfPendingRequests = &numOfPendingRequests_;
 
   LOG_INFO(
       CL_MNGR,
@@ -257,8 +274,8 @@ uint32_t ClientsManager::reservedPagesPerClient(const uint32_t& sizeOfReservedPa
 void ClientsManager::loadInfoFromReservedPages() {
   for (auto const& clientId : clientIds_) {
     if (internalClients_.find(clientId) != internalClients_.end()) continue;
+    auto& info = clientInfo(clientId);
     if (loadReservedPage(getKeyPageId(clientId), sizeOfReservedPage(), scratchPage_.data())) {
-      auto& info = clientsInfo_[clientId];
       std::istringstream iss(scratchPage_);
       concord::serialize::Serializable::deserialize(iss, info.pubKey);
       ConcordAssertGT(info.pubKey.first.length(), 0);
@@ -272,26 +289,25 @@ void ClientsManager::loadInfoFromReservedPages() {
     ConcordAssert(replyHeader->replyLength >= 0);
     ConcordAssert(replyHeader->replyLength + sizeof(ClientReplyMsgHeader) <= maxReplySize_);
 
-    clientsInfo_[clientId].repliesInfo->deleteOldestReplyIfNeededSafe(clientId, maxNumOfReqsPerClient_);
-    const auto& res = clientsInfo_[clientId].repliesInfo->insertOrAssignSafe(replyHeader->reqSeqNum, MinTime);
+    info.repliesInfo.deleteOldestReplyIfNeededSafe(clientId, maxNumOfReqsPerClient_);
+    const auto& res = info.repliesInfo.insertOrAssignSafe(replyHeader->reqSeqNum, MinTime);
     LOG_INFO(CL_MNGR, "Added/updated reply message" << KVLOG(clientId, replyHeader->reqSeqNum, res));
-    clientsInfo_[clientId].requestsInfo->removeOldPendingReqsSafe(clientId, replyHeader->reqSeqNum);
+    info.requestsInfo.removeOldPendingReqsSafe(clientId, replyHeader->reqSeqNum);
   }
 }
 
 bool ClientsManager::hasReply(NodeIdType clientId, ReqId reqSeqNum) {
-  try {
-    const bool found = clientsInfo_.at(clientId).repliesInfo->findSafe(reqSeqNum);
-    if (found) LOG_DEBUG(CL_MNGR, "Reply found for" << KVLOG(clientId, reqSeqNum));
-    return found;
-  } catch (const std::out_of_range& e) {
+  if (!isValidClient(clientId)) {
     LOG_DEBUG(CL_MNGR, "No info found for client" << KVLOG(clientId, reqSeqNum));
     return false;
   }
+  const bool found = clientInfo(clientId).repliesInfo.findSafe(reqSeqNum);
+  if (found) LOG_DEBUG(CL_MNGR, "Reply found for" << KVLOG(clientId, reqSeqNum));
+  return found;
 }
 
 void ClientsManager::deleteOldestReply(NodeIdType clientId) {
-  clientsInfo_[clientId].repliesInfo->deleteOldestReplyIfNeededSafe(clientId, maxNumOfReqsPerClient_);
+  clientInfo(clientId).repliesInfo.deleteOldestReplyIfNeededSafe(clientId, maxNumOfReqsPerClient_);
 }
 
 // Reference the ClientInfo of the corresponding client:
@@ -307,8 +323,9 @@ std::unique_ptr<ClientReplyMsg> ClientsManager::allocateNewReplyMsgAndWriteToSto
                                                                                      uint32_t replyLength,
                                                                                      uint32_t rsiLength,
                                                                                      uint32_t executionResult) {
-  clientsInfo_[clientId].repliesInfo->deleteOldestReplyIfNeededSafe(clientId, maxNumOfReqsPerClient_);
-  clientsInfo_[clientId].repliesInfo->insertOrAssignSafe(requestSeqNum, getMonotonicTime());
+  auto& repliesInfo = clientInfo(clientId).repliesInfo;
+  repliesInfo.deleteOldestReplyIfNeededSafe(clientId, maxNumOfReqsPerClient_);
+  repliesInfo.insertOrAssignSafe(requestSeqNum, getMonotonicTime());
   LOG_DEBUG(CL_MNGR, KVLOG(clientId, requestSeqNum));
   auto r = std::make_unique<ClientReplyMsg>(myId_, requestSeqNum, reply, replyLength - rsiLength, executionResult);
 
@@ -421,7 +438,7 @@ void ClientsManager::setClientPublicKey(NodeIdType clientId,
                                         const std::string& key,
                                         concord::util::crypto::KeyFormat fmt) {
   LOG_INFO(CL_MNGR, "key: " << key << " fmt: " << (uint16_t)fmt << " client: " << clientId);
-  ClientInfo& info = clientsInfo_[clientId];
+  ClientInfo& info = clientInfo(clientId);
   info.pubKey = std::make_pair(key, fmt);
   std::string page(sizeOfReservedPage(), 0);
   std::ostringstream oss(page);
@@ -430,58 +447,56 @@ void ClientsManager::setClientPublicKey(NodeIdType clientId,
 }
 
 bool ClientsManager::isClientRequestInProcess(NodeIdType clientId, ReqId reqSeqNum) {
-  try {
-    const bool found = clientsInfo_.at(clientId).requestsInfo->findSafe(reqSeqNum);
-    if (found) LOG_DEBUG(CL_MNGR, "The request is executing right now" << KVLOG(clientId, reqSeqNum));
-    return found;
-  } catch (const std::out_of_range& e) {
+  if (!isValidClient(clientId)) {
     LOG_DEBUG(CL_MNGR, "No info found for client" << KVLOG(clientId, reqSeqNum));
     return false;
   }
+  const bool found = clientInfo(clientId).requestsInfo.findSafe(reqSeqNum);
+  if (found) LOG_DEBUG(CL_MNGR, "The request is executing right now" << KVLOG(clientId, reqSeqNum));
+  return found;
 }
 
 bool ClientsManager::isPending(NodeIdType clientId, ReqId reqSeqNum) const {
-  try {
-    return clientsInfo_.at(clientId).requestsInfo->isPending(reqSeqNum);
-  } catch (const std::out_of_range& e) {
+  if (!isValidClient(clientId)) {
     LOG_DEBUG(CL_MNGR, "No info found for client" << KVLOG(clientId, reqSeqNum));
     return false;
   }
+  return clientInfo(clientId).requestsInfo.isPendingSafe(reqSeqNum);
 }
 
 // Check that:
 // * max number of pending requests not reached for that client.
 // * request seq number is bigger than the last reply seq number.
 bool ClientsManager::canBecomePending(NodeIdType clientId, ReqId reqSeqNum) const {
-  try {
-    ReqId requestsNum = clientsInfo_.at(clientId).requestsInfo->size();
-    if (requestsNum == maxNumOfReqsPerClient_) {
-      LOG_DEBUG(CL_MNGR,
-                "Maximum number of requests per client reached" << KVLOG(maxNumOfReqsPerClient_, clientId, reqSeqNum));
-      return false;
-    }
-    if (clientsInfo_.at(clientId).requestsInfo->find(reqSeqNum)) {
-      LOG_DEBUG(CL_MNGR, "The request is executing right now" << KVLOG(clientId, reqSeqNum));
-      return false;
-    }
-    if (clientsInfo_.at(clientId).repliesInfo->find(reqSeqNum)) {
-      LOG_DEBUG(CL_MNGR, "The request has been already executed" << KVLOG(clientId, reqSeqNum));
-      return false;
-    }
-    LOG_DEBUG(CL_MNGR, "The request can become pending" << KVLOG(clientId, reqSeqNum, requestsNum));
-    return true;
-  } catch (const std::out_of_range& e) {
+  if (!isValidClient(clientId)) {
     LOG_DEBUG(CL_MNGR, "No info found for client" << KVLOG(clientId, reqSeqNum));
     return false;
   }
+  const auto& info = clientInfo(clientId);
+  ReqId requestsNum = info.requestsInfo.size();
+  if (requestsNum == maxNumOfReqsPerClient_) {
+    LOG_DEBUG(CL_MNGR,
+              "Maximum number of requests per client reached" << KVLOG(maxNumOfReqsPerClient_, clientId, reqSeqNum));
+    return false;
+  }
+  if (info.requestsInfo.findSafe(reqSeqNum)) {
+    LOG_DEBUG(CL_MNGR, "The request is executing right now" << KVLOG(clientId, reqSeqNum));
+    return false;
+  }
+  if (info.repliesInfo.findSafe(reqSeqNum)) {
+    LOG_DEBUG(CL_MNGR, "The request has been already executed" << KVLOG(clientId, reqSeqNum));
+    return false;
+  }
+  LOG_DEBUG(CL_MNGR, "The request can become pending" << KVLOG(clientId, reqSeqNum, requestsNum));
+  return true;
 }
 
 void ClientsManager::addPendingRequest(NodeIdType clientId, ReqId reqSeqNum, const std::string& cid) {
-  clientsInfo_[clientId].requestsInfo->emplaceSafe(clientId, reqSeqNum, cid);
+  clientInfo(clientId).requestsInfo.emplaceSafe(clientId, reqSeqNum, cid);
 }
 
 void ClientsManager::markRequestAsCommitted(NodeIdType clientId, ReqId reqSeqNum) {
-  clientsInfo_[clientId].requestsInfo->markRequestAsCommitted(clientId, reqSeqNum);
+  clientInfo(clientId).requestsInfo.markRequestAsCommittedSafe(clientId, reqSeqNum);
 }
 
 /*
@@ -493,17 +508,17 @@ void ClientsManager::markRequestAsCommitted(NodeIdType clientId, ReqId reqSeqNum
  * that we shouldn't have more than maxNumOfRequestsInBatch. Thus, we can safely remove them from the client manager.
  */
 void ClientsManager::removeRequestsOutOfBatchBounds(NodeIdType clientId, ReqId reqSequenceNum) {
-  if (clientsInfo_[clientId].requestsInfo->removeRequestsOutOfBatchBoundsSafe(clientId, reqSequenceNum))
+  if (clientInfo(clientId).requestsInfo.removeRequestsOutOfBatchBoundsSafe(clientId, reqSequenceNum))
     metric_removed_due_to_out_of_boundaries_++;
 }
 
 void ClientsManager::removePendingForExecutionRequest(NodeIdType clientId, ReqId reqSeqNum) {
   if (!isValidClient(clientId)) return;
-  clientsInfo_[clientId].requestsInfo->removePendingForExecutionRequestSafe(clientId, reqSeqNum);
+  clientInfo(clientId).requestsInfo.removePendingForExecutionRequestSafe(clientId, reqSeqNum);
 }
 
 void ClientsManager::clearAllPendingRequests() {
-  for (auto& clientInfo : clientsInfo_) clientInfo.second.requestsInfo->clearSafe();
+  for (auto& client : clients_) client.requestsInfo.clearSafe();
   LOG_DEBUG(CL_MNGR, "Cleared pending requests for all clients");
 }
 
@@ -511,8 +526,8 @@ void ClientsManager::clearAllPendingRequests() {
 Time ClientsManager::infoOfEarliestPendingRequest(std::string& cid) const {
   Time earliestTime = MaxTime;
   RequestInfo earliestPendingReqInfo{MaxTime, std::string()};
-  for (const auto& clientInfo : clientsInfo_)
-    clientInfo.second.requestsInfo->infoOfEarliestPendingRequest(earliestTime, earliestPendingReqInfo);
+  for (const auto& client : clients_)
+    client.requestsInfo.infoOfEarliestPendingRequestSafe(earliestTime, earliestPendingReqInfo);
   cid = earliestPendingReqInfo.cid;
   if (earliestPendingReqInfo.time != MaxTime) LOG_DEBUG(CL_MNGR, "Earliest pending request: " << KVLOG(cid));
   return earliestPendingReqInfo.time;
@@ -521,8 +536,8 @@ Time ClientsManager::infoOfEarliestPendingRequest(std::string& cid) const {
 // Iterate over all clients and log the ones that have not been committed for more than threshold milliseconds.
 void ClientsManager::logAllPendingRequestsExceedingThreshold(const int64_t threshold, const Time& currTime) const {
   int numExceeding = 0;
-  for (const auto& clientInfo : clientsInfo_)
-    clientInfo.second.requestsInfo->logAllPendingRequestsExceedingThreshold(threshold, currTime, numExceeding);
+  for (const auto& client : clients_)
+    client.requestsInfo.logAllPendingRequestsExceedingThresholdSafe(threshold, currTime, numExceeding);
   if (numExceeding) {
     LOG_INFO(CL_MNGR, "Total Client request with more than " << threshold << "ms delay: " << numExceeding);
   }
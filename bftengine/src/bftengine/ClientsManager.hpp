@@ -19,12 +19,15 @@
 #include "bftengine/IKeyExchanger.hpp"
 #include "PersistentStorage.hpp"
 #include "ReplicaSpecificInfoManager.hpp"
+#include "assertUtils.hpp"
+#include <atomic>
 #include <mutex>
 #include <map>
 #include <set>
 #include <unordered_map>
 #include <memory>
 #include <queue>
+#include <vector>
 
 namespace bftEngine {
 class IStateTransfer;
@@ -36,7 +39,10 @@ class ClientRequestMsg;
 // Keeps track of Client IDs, public keys, and pending requests and replies. Supports saving and loading client public
 // keys and pending reply messages to the reserved pages mechanism.
 //
-// Not thread-safe.
+// The table of clients is fixed at construction, and the requests and the replies of every client have locks of their
+// own, so threads that serve different clients don't contend. The most frequent checks take no lock at all: whether a
+// client is valid, whether a client that has no requests has a given one, and whether a client has a reply to a
+// request newer than all of its replies. Loading from and saving to the reserved pages is not thread-safe.
 class ClientsManager : public ResPagesClient<ClientsManager>, public IPendingRequest, public IClientPublicKeyStore {
  public:
   // As preconditions to this constructor:
@@ -86,7 +92,9 @@ class ClientsManager : public ResPagesClient<ClientsManager>, public IPendingReq
   // not make sense (too high) - this will prevent some potential attacks)
   bool hasReply(NodeIdType clientId, ReqId reqSeqNum);
 
-  bool isValidClient(NodeIdType clientId) const { return clientIds_.find(clientId) != clientIds_.end(); }
+  bool isValidClient(NodeIdType clientId) const {
+    return clientId < clientIndices_.size() && clientIndices_[clientId] != kNoClient;
+  }
 
   // First, if this ClientsManager has a number of reply records for the given clientId equalling or exceeding the
   // maximum client batch size configured at the time of this ClientManager's construction (or 1 if client batching was
@@ -139,6 +147,9 @@ class ClientsManager : public ResPagesClient<ClientsManager>, public IPendingReq
   // otherwise returns false.
   bool canBecomePending(NodeIdType clientId, ReqId reqSeqNum) const;
 
+  // The number of requests of all clients this ClientsManager currently has recorded. Safe to call from any thread.
+  uint64_t numOfPendingRequests() const { return numOfPendingRequests_; }
+
   // Returns true if there is a valid client with ID clientId, this ClientsManager currently has a recorded request with
   // ID reqSeqNum from that client, and that request has not been marked as committed; otherwise returns false.
   bool isPending(NodeIdType clientId, ReqId reqSeqNum) const override;
@@ -198,10 +209,16 @@ class ClientsManager : public ResPagesClient<ClientsManager>, public IPendingReq
   bool isInternal(NodeIdType clientId) const;
 
  protected:
+  static constexpr uint32_t kNoClient = UINT32_MAX;
+
   uint32_t getReplyFirstPageId(NodeIdType clientId) const { return getKeyPageId(clientId) + 1; }
 
-  uint32_t getKeyPageId(NodeIdType clientId) const {
-    return clientIdsToReservedPages_.at(clientId) * reservedPagesPerClient_;
+  uint32_t getKeyPageId(NodeIdType clientId) const { return clientIndex(clientId) * reservedPagesPerClient_; }
+
+  // The index of a valid client in clients_, which is also the index of its reserved pages
+  uint32_t clientIndex(NodeIdType clientId) const {
+    ConcordAssert(isValidClient(clientId));
+    return clientIndices_[clientId];
   }
 
   const ReplicaId myId_;
@@ -219,57 +236,74 @@ class ClientsManager : public ResPagesClient<ClientsManager>, public IPendingReq
     bool committed = false;
   };
 
+  // The methods that end with Safe take the lock of the requests, unless the client has none.
   class RequestsInfo {
    public:
     void emplaceSafe(NodeIdType clientId, ReqId reqSeqNum, const std::string& cid);
     bool removeRequestsOutOfBatchBoundsSafe(NodeIdType clientId, ReqId reqSequenceNum);
-    bool findSafe(ReqId reqSeqNum);
+    bool findSafe(ReqId reqSeqNum) const;
     void clearSafe();
     void removeOldPendingReqsSafe(NodeIdType clientId, ReqId reqSeqNum);
     void removePendingForExecutionRequestSafe(NodeIdType clientId, ReqId reqSeqNum);
+    bool isPendingSafe(ReqId reqSeqNum) const;
+    void markRequestAsCommittedSafe(NodeIdType clientId, ReqId reqSeqNum);
+    void infoOfEarliestPendingRequestSafe(Time& earliestTime, RequestInfo& earliestPendingReqInfo) const;
+    void logAllPendingRequestsExceedingThresholdSafe(const int64_t threshold,
+                                                     const Time& currTime,
+                                                     int& numExceeding) const;
 
-    size_t size() const { return requestsMap_.size(); }
-    bool find(ReqId reqSeqNum) const;
-    bool isPending(ReqId reqSeqNum) const;
-    void markRequestAsCommitted(NodeIdType clientId, ReqId reqSeqNum);
-    void infoOfEarliestPendingRequest(Time& earliestTime, RequestInfo& earliestPendingReqInfo) const;
-    void logAllPendingRequestsExceedingThreshold(const int64_t threshold,
-                                                 const Time& currTime,
-                                                 int& numExceeding) const;
+    size_t size() const { return size_; }
 
-   public:
-    std::mutex requestsMapMutex_;
+    // The count of the requests of all clients, kept up to date by every RequestsInfo. Set once, before any request.
+    std::atomic_uint64_t* numOfPendingRequests = nullptr;
+
+   private:
+    // Called with requestsMapMutex_ held, after requestsMap_ changed
+    void onSizeChanged();
+
+    mutable std::mutex requestsMapMutex_;
     std::map<ReqId, RequestInfo> requestsMap_;
+    // The size of requestsMap_, for the checks that don't need the lock when there are no requests
+    std::atomic_size_t size_{0};
   };
 
   class RepliesInfo {
    public:
     void deleteOldestReplyIfNeededSafe(NodeIdType clientId, uint16_t maxNumOfReqsPerClient);
     bool insertOrAssignSafe(ReqId reqSeqNum, Time time);
-    bool findSafe(ReqId reqSeqNum);
-
-    bool find(ReqId reqSeqNum) const;
+    bool findSafe(ReqId reqSeqNum) const;
 
-   public:
-    std::mutex repliesMapMutex_;
+   private:
+    mutable std::mutex repliesMapMutex_;
     std::map<ReqId, Time> repliesMap_;
+    // The greatest sequence number of a reply ever inserted. The sequence numbers of a client's requests grow, so a new
+    // request is above it, and is found to have no reply without taking the lock.
+    std::atomic<ReqId> maxReqSeqNum_{0};
   };
 
-  struct ClientInfo {
-    std::shared_ptr<RequestsInfo> requestsInfo;
-    std::shared_ptr<RepliesInfo> repliesInfo;
+  // Aligned to cache lines, so that the locks of neighbouring clients don't share one
+  struct alignas(64) ClientInfo {
+    RequestsInfo requestsInfo;
+    RepliesInfo repliesInfo;
     std::pair<std::string, concord::util::crypto::KeyFormat> pubKey;
   };
 
+  ClientInfo& clientInfo(NodeIdType clientId) { return clients_[clientIndex(clientId)]; }
+  const ClientInfo& clientInfo(NodeIdType clientId) const { return clients_[clientIndex(clientId)]; }
+
   std::set<NodeIdType> proxyClients_;
   std::set<NodeIdType> externalClients_;
   std::set<NodeIdType> clientServices_;
   std::set<NodeIdType> internalClients_;
-  std::set<NodeIdType> clientIds_;
-  std::map<NodeIdType, uint32_t> clientIdsToReservedPages_;
-  std::unordered_map<NodeIdType, ClientInfo> clientsInfo_;
+  // All the valid clients, sorted
+  std::vector<NodeIdType> clientIds_;
+  // By client id, the index of the client in clientIds_ and clients_, or kNoClient
+  std::vector<uint32_t> clientIndices_;
+  // Fixed at construction
+  std::vector<ClientInfo> clients_;
   const uint32_t maxReplySize_;
   const uint16_t maxNumOfReqsPerClient_;
+  std::atomic_uint64_t numOfPendingRequests_{0};
   concordMetrics::Component& metrics_;
   concordMetrics::CounterHandle metric_reply_inconsistency_detected_;
   concordMetrics::CounterHandle metric_removed_due_to_out_of_boundaries_;
@@ -12,9 +12,11 @@
 #pragma once
 
 #include <type_traits>
-#include <unordered_map>
+#include <map>
+#include <memory_resource>
 #include <set>
 #include <iterator>
+#include <chrono>
 
 #include "OpenTracing.hpp"
 #include "PrimitiveTypes.hpp"
@@ -37,7 +39,12 @@ template <typename PART, typename FULL, typename ExternalFunc>
 // TODO(GG): add ConcordAssert(ExternalFunc::numberOfRequiredSignatures(context) > 1);
 class CollectorOfThresholdSignatures {
  public:
-  CollectorOfThresholdSignatures(void* cnt) { this->context = cnt; }
+  // The map of partial signatures is allocated from arena, which should outlive the collector. Once the collector is
+  // reset, it holds no memory of the arena.
+  CollectorOfThresholdSignatures(void* cnt, std::pmr::memory_resource* arena = std::pmr::get_default_resource())
+      : replicasInfo{arena} {
+    this->context = cnt;
+  }
 
   ~CollectorOfThresholdSignatures() { resetAndFree(); }
 
@@ -114,6 +121,11 @@ class CollectorOfThresholdSignatures {
 
   bool isComplete() const { return (combinedValidSignatureMsg != nullptr); }
 
+  // Of the arena, for the partial signature of one replica
+  static constexpr size_t arenaBytesPerReplica() {
+    return sizeof(typename decltype(replicasInfo)::value_type) + 4 * sizeof(void*);
+  }
+
   void onCompletionOfSignaturesProcessing(SeqNum seqNumber,
                                           ViewNum view,
                                           const std::set<ReplicaId>& replicasWithBadSigs)  // if we found bad signatures
@@ -384,11 +396,26 @@ class CollectorOfThresholdSignatures {
         // if verification failed, use accumulator with share verification enabled.
         // this still can succeed if there're enough valid shares.
         // at least replica with bad   signatures will be identified.
+        // the accumulator verifies the shares in batches, splitting the batches that fail in halves, so a few bad
+        // shares are found with a few pairings rather than one pairing per share.
+        const auto start = std::chrono::steady_clock::now();
         std::unique_ptr<IThresholdAccumulator> acc{verifier->newAccumulator(true)};
         for (uint16_t i = 0; i < reqDataItems; i++) acc->add(sigDataItems[i].sigBody, sigDataItems[i].sigLength);
         acc->setExpectedDigest(reinterpret_cast<unsigned char*>(expectedDigest.content()), DIGEST_SIZE);
-        acc->getFullSignedData(bufferForSigComputations.data(), bufferSize);
-        if (!verifier->verify((char*)&expectedDigest, sizeof(Digest), bufferForSigComputations.data(), bufferSize)) {
+        const auto invalidShareIds = acc->getInvalidShareIds();
+        const auto checkDurationUs =
+            std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+        LOG_WARN(THRESHSIGN_LOG,
+                 "Combined signature failed verification, checked the shares"
+                     << KVLOG(expectedSeqNumber, invalidShareIds.size(), checkDurationUs));
+        // with invalid shares, less valid shares than required are left, and combining them can only fail
+        bool succeeded = false;
+        if (invalidShareIds.empty()) {
+          acc->getFullSignedData(bufferForSigComputations.data(), bufferSize);
+          succeeded =
+              verifier->verify((char*)&expectedDigest, sizeof(Digest), bufferForSigComputations.data(), bufferSize);
+        }
+        if (!succeeded) {
           // if verification failed again
           // signer index starts with 1, therefore shareId-1
           std::set<uint16_t> replicasWithBadSigs;
@@ -500,7 +527,9 @@ class CollectorOfThresholdSignatures {
   bool processingSignaturesInTheBackground = false;
 
   uint16_t numberOfUnknownSignatures = 0;
-  std::unordered_map<ReplicaId, RepInfo> replicasInfo;  // map from replica Id to RepInfo
+  // map from replica Id to RepInfo. Ordered, as an empty std::map holds no memory of the arena, unlike the buckets of
+  // an unordered map
+  std::pmr::map<ReplicaId, RepInfo> replicasInfo;
 
   FULL* combinedValidSignatureMsg = nullptr;
   FULL* candidateCombinedSignatureMsg = nullptr;  // holds msg when expectedSeqNumber is not known yet
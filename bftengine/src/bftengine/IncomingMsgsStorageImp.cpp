@@ -14,11 +14,14 @@
 #include "IncomingMsgsStorageImp.hpp"
 #include "messages/InternalMessage.hpp"
 #include "Logger.hpp"
+#include <algorithm>
 #include <future>
 
 using std::queue;
 using namespace std::chrono;
 using namespace concord::diagnostics;
+using bft::communication::NUM_TRAFFIC_CLASSES;
+using bft::communication::TrafficClass;
 
 namespace bftEngine::impl {
 
@@ -31,10 +34,10 @@ IncomingMsgsStorageImp::IncomingMsgsStorageImp(const std::shared_ptr<MsgHandlers
       take_lock_recorder_(histograms_.take_lock),
       wait_for_cv_recorder_(histograms_.wait_for_cv) {
   replicaId_ = replicaId;
-  ptrProtectedQueueForExternalMessages_ = new queue<MessageWithCallback>();
+  ptrProtectedQueueForExternalMessages_ = new ExternalMsgQueues();
   ptrProtectedQueueForInternalMessages_ = new queue<InternalMessage>();
   lastOverflowWarning_ = MinTime;
-  ptrThreadLocalQueueForExternalMessages_ = new queue<MessageWithCallback>();
+  ptrThreadLocalQueueForExternalMessages_ = new ExternalMsgQueues();
   ptrThreadLocalQueueForInternalMessages_ = new queue<InternalMessage>();
 }
 
@@ -70,12 +73,16 @@ bool IncomingMsgsStorageImp::pushExternalMsg(std::unique_ptr<MessageBase> msg) {
 bool IncomingMsgsStorageImp::pushExternalMsg(std::unique_ptr<MessageBase> msg, Callback onMsgPopped) {
   MsgCode::Type type = static_cast<MsgCode::Type>(msg->type());
   LOG_TRACE(MSGS, type);
+  // Every traffic class has its own limit, so that a flood of client requests doesn't drop consensus messages
+  const auto trafficClass = static_cast<size_t>(trafficClassOf(msg->type()));
   std::unique_lock<std::mutex> mlock(lock_);
-  if (ptrProtectedQueueForExternalMessages_->size() >= maxNumberOfPendingExternalMsgs_) {
+  auto& msgQueue = (*ptrProtectedQueueForExternalMessages_)[trafficClass];
+  if (msgQueue.size() >= maxNumberOfPendingExternalMsgs_) {
     Time now = getMonotonicTime();
     auto msg_type = static_cast<MsgCode::Type>(msg->type());
     if ((now - lastOverflowWarning_) > (milliseconds(minTimeBetweenOverflowWarningsMilli_))) {
-      LOG_WARN(GL, "Queue Full. Dropping some msgs." << KVLOG(maxNumberOfPendingExternalMsgs_, msg_type));
+      LOG_WARN(GL,
+               "Queue Full. Dropping some msgs." << KVLOG(maxNumberOfPendingExternalMsgs_, msg_type, trafficClass));
       lastOverflowWarning_ = now;
     }
     dropped_msgs++;
@@ -83,7 +90,8 @@ bool IncomingMsgsStorageImp::pushExternalMsg(std::unique_ptr<MessageBase> msg, C
   }
   histograms_.dropped_msgs_in_a_row->record(dropped_msgs);
   dropped_msgs = 0;
-  ptrProtectedQueueForExternalMessages_->push(std::make_pair(std::move(msg), std::move(onMsgPopped)));
+  msgQueue.push(std::make_pair(std::move(msg), std::move(onMsgPopped)));
+  numProtectedExternalMsgs_[trafficClass] = msgQueue.size();
   condVar_.notify_one();
   return true;
 }
@@ -114,7 +122,11 @@ IncomingMsg IncomingMsgsStorageImp::getMsgForProcessing() {
     std::unique_lock<std::mutex> mlock(lock_);
     take_lock_recorder_.end();
     {
-      if (ptrProtectedQueueForExternalMessages_->empty() && ptrProtectedQueueForInternalMessages_->empty()) {
+      const auto noExternalMsgs = [this]() {
+        const auto& queues = *ptrProtectedQueueForExternalMessages_;
+        return std::all_of(queues.begin(), queues.end(), [](const auto& msgQueue) { return msgQueue.empty(); });
+      };
+      if (noExternalMsgs() && ptrProtectedQueueForInternalMessages_->empty()) {
         LOG_TRACE(MSGS, "Waiting for condition variable");
         wait_for_cv_recorder_.start();
         condVar_.wait_for(mlock, msgWaitTimeout_);
@@ -122,7 +134,7 @@ IncomingMsg IncomingMsgsStorageImp::getMsgForProcessing() {
       }
 
       // no new message
-      if (ptrProtectedQueueForExternalMessages_->empty() && ptrProtectedQueueForInternalMessages_->empty()) {
+      if (noExternalMsgs() && ptrProtectedQueueForInternalMessages_->empty()) {
         LOG_DEBUG(MSGS, "No pending messages");
         return IncomingMsg();
       }
@@ -131,7 +143,14 @@ IncomingMsg IncomingMsgsStorageImp::getMsgForProcessing() {
       auto t1 = ptrThreadLocalQueueForExternalMessages_;
       ptrThreadLocalQueueForExternalMessages_ = ptrProtectedQueueForExternalMessages_;
       ptrProtectedQueueForExternalMessages_ = t1;
-      histograms_.external_queue_len_at_swap->record(ptrThreadLocalQueueForExternalMessages_->size());
+      size_t externalQueueLen = 0;
+      for (size_t i = 0; i < NUM_TRAFFIC_CLASSES; ++i) {
+        const auto len = (*ptrThreadLocalQueueForExternalMessages_)[i].size();
+        histograms_.external_queue_len_at_swap_by_class[i]->record(len);
+        externalQueueLen += len;
+        numProtectedExternalMsgs_[i] = 0;
+      }
+      histograms_.external_queue_len_at_swap->record(externalQueueLen);
 
       auto* t2 = ptrThreadLocalQueueForInternalMessages_;
       ptrThreadLocalQueueForInternalMessages_ = ptrProtectedQueueForInternalMessages_;
@@ -147,17 +166,39 @@ IncomingMsg IncomingMsgsStorageImp::popThreadLocal() {
     auto msg = IncomingMsg{std::move(ptrThreadLocalQueueForInternalMessages_->front())};
     ptrThreadLocalQueueForInternalMessages_->pop();
     return msg;
-  } else if (!ptrThreadLocalQueueForExternalMessages_->empty()) {
-    auto& item = ptrThreadLocalQueueForExternalMessages_->front();
-    if (item.second) {
-      item.second();
-    }
-    auto msg = IncomingMsg{std::move(item.first)};
-    ptrThreadLocalQueueForExternalMessages_->pop();
-    return msg;
-  } else {
+  }
+  auto& queues = *ptrThreadLocalQueueForExternalMessages_;
+  auto trafficClass = externalMsgsScheduler_.next(
+      [&queues](TrafficClass c) { return !queues[static_cast<size_t>(c)].empty(); });
+  if (!trafficClass) {
     return IncomingMsg{};
   }
+  // Messages of more urgent classes that arrived since the swap are served next, rather than after all of the queued
+  // messages of less urgent classes.
+  for (size_t moreUrgent = 0; moreUrgent < static_cast<size_t>(*trafficClass); ++moreUrgent) {
+    if (numProtectedExternalMsgs_[moreUrgent] > 0) takeProtectedExternalMsgs(static_cast<TrafficClass>(moreUrgent));
+  }
+  auto& msgQueue = queues[static_cast<size_t>(*trafficClass)];
+  externalMsgsScheduler_.served();
+  auto& item = msgQueue.front();
+  if (item.second) {
+    item.second();
+  }
+  auto msg = IncomingMsg{std::move(item.first)};
+  msgQueue.pop();
+  return msg;
+}
+
+void IncomingMsgsStorageImp::takeProtectedExternalMsgs(TrafficClass trafficClass) {
+  const auto i = static_cast<size_t>(trafficClass);
+  auto& local = (*ptrThreadLocalQueueForExternalMessages_)[i];
+  std::unique_lock<std::mutex> mlock(lock_);
+  auto& protectedQueue = (*ptrProtectedQueueForExternalMessages_)[i];
+  while (!protectedQueue.empty()) {
+    local.push(std::move(protectedQueue.front()));
+    protectedQueue.pop();
+  }
+  numProtectedExternalMsgs_[i] = 0;
 }
 
 void IncomingMsgsStorageImp::dispatchMessages(std::promise<void>& signalStarted) {
@@ -16,9 +16,11 @@
 #include "IncomingMsgsStorage.hpp"
 #include "MsgHandlersRegistrator.hpp"
 #include "Timers.hpp"
+#include "communication/TrafficClass.hpp"
 #include "diagnostics.h"
 #include "performance_handler.h"
 
+#include <array>
 #include <queue>
 #include <atomic>
 #include <thread>
@@ -58,6 +60,7 @@ class IncomingMsgsStorageImp : public IncomingMsgsStorage {
   void dispatchMessages(std::promise<void>& signalStarted);
   IncomingMsg getMsgForProcessing();
   IncomingMsg popThreadLocal();
+  void takeProtectedExternalMsgs(bft::communication::TrafficClass trafficClass);
 
  private:
   const uint64_t minTimeBetweenOverflowWarningsMilli_ = 5 * 1000;
@@ -72,18 +75,24 @@ class IncomingMsgsStorageImp : public IncomingMsgsStorage {
   std::chrono::milliseconds msgWaitTimeout_;
 
   using MessageWithCallback = std::pair<std::unique_ptr<MessageBase>, Callback>;
+  // External messages of every traffic class wait on their own queue, indexed by the class.
+  using ExternalMsgQueues = std::array<std::queue<MessageWithCallback>, bft::communication::NUM_TRAFFIC_CLASSES>;
 
   // New messages are pushed to ptrProtectedQueue.... ; protected by lock
-  std::queue<MessageWithCallback>* ptrProtectedQueueForExternalMessages_;
+  ExternalMsgQueues* ptrProtectedQueueForExternalMessages_;
   std::queue<InternalMessage>* ptrProtectedQueueForInternalMessages_;
+  // The number of messages on each protected external queue. Changed under the lock, but read by the dispatching
+  // thread without it, to tell whether more urgent messages arrived since the queues were swapped.
+  std::array<std::atomic<size_t>, bft::communication::NUM_TRAFFIC_CLASSES> numProtectedExternalMsgs_{};
 
   // Time of last queue overflow; protected by lock
   Time lastOverflowWarning_ = Time::min();
   size_t dropped_msgs = 0;
 
   // Messages are fetched from ptrThreadLocalQueue...; should be accessed only by the dispatching thread
-  std::queue<MessageWithCallback>* ptrThreadLocalQueueForExternalMessages_;
+  ExternalMsgQueues* ptrThreadLocalQueueForExternalMessages_;
   std::queue<InternalMessage>* ptrThreadLocalQueueForInternalMessages_;
+  bft::communication::TrafficScheduler externalMsgsScheduler_;
 
   std::thread dispatcherThread_;
   std::promise<void> signalStarted_;
@@ -102,6 +111,9 @@ class IncomingMsgsStorageImp : public IncomingMsgsStorage {
       if (!registrar.perf.isRegisteredComponent(component)) {
         registrar.perf.registerComponent(component,
                                          {external_queue_len_at_swap,
+                                          external_queue_len_at_swap_by_class[0],
+                                          external_queue_len_at_swap_by_class[1],
+                                          external_queue_len_at_swap_by_class[2],
                                           internal_queue_len_at_swap,
                                           evaluate_timers,
                                           take_lock,
@@ -110,6 +122,12 @@ class IncomingMsgsStorageImp : public IncomingMsgsStorage {
       }
     }
     DEFINE_SHARED_RECORDER(external_queue_len_at_swap, 1, 10000, 3, concord::diagnostics::Unit::COUNT);
+    // Indexed by TrafficClass
+    std::array<std::shared_ptr<Recorder>, bft::communication::NUM_TRAFFIC_CLASSES> external_queue_len_at_swap_by_class =
+        {MAKE_SHARED_RECORDER("external_consensus_queue_len_at_swap", 1, 10000, 3, concord::diagnostics::Unit::COUNT),
+         MAKE_SHARED_RECORDER("external_client_queue_len_at_swap", 1, 10000, 3, concord::diagnostics::Unit::COUNT),
+         MAKE_SHARED_RECORDER(
+             "external_state_transfer_queue_len_at_swap", 1, 10000, 3, concord::diagnostics::Unit::COUNT)};
     DEFINE_SHARED_RECORDER(internal_queue_len_at_swap, 1, 10000, 3, concord::diagnostics::Unit::COUNT);
     DEFINE_SHARED_RECORDER(take_lock, 1, MAX_VALUE_MICROSECONDS, 3, concord::diagnostics::Unit::MICROSECONDS);
     DEFINE_SHARED_RECORDER(wait_for_cv, 1, MAX_VALUE_MICROSECONDS, 3, concord::diagnostics::Unit::MICROSECONDS);
@@ -21,12 +21,16 @@ class IThresholdVerifier;
 namespace concord::util {
 class SimpleThreadPool;
 }
+namespace preprocessor {
+class ConflictScheduler;
+}
 
 namespace bftEngine {
 namespace impl {
 
 class PrePrepareMsg;
 class ReplicasInfo;
+class AdmissionControl;
 
 class InternalReplicaApi  // TODO(GG): rename + clean + split to several classes
 {
@@ -43,6 +47,10 @@ class InternalReplicaApi  // TODO(GG): rename + clean + split to several classes
   virtual bool isClientRequestInProcess(NodeIdType clientId, ReqId reqSeqNum) const = 0;
   virtual SeqNum getPrimaryLastUsedSeqNum() const = 0;
   virtual uint64_t getRequestsInQueue() const = 0;
+  // nullptr if admission control is disabled
+  virtual AdmissionControl* getAdmissionControl() const { return nullptr; }
+  // nullptr if preExecConflictAwareSchedulingEnabled is not set
+  virtual preprocessor::ConflictScheduler* getConflictScheduler() const { return nullptr; }
   virtual SeqNum getLastExecutedSeqNum() const = 0;
   virtual std::pair<PrePrepareMsg*, bool> buildPrePrepareMessage() { return std::make_pair(nullptr, false); }
   virtual bool tryToSendPrePrepareMsg(bool batchingLogic) { return false; }
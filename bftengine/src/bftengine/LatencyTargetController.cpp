@@ -0,0 +1,73 @@
+// Concord
+//
+// Copyright (c) 2022 VMware, Inc. All Rights Reserved.
+//
+// This product is licensed to you under the Apache 2.0 license (the "License"). You may not use this product except in
+// compliance with the Apache 2.0 License.
+//
+// This product may include a number of subcomponents with separate copyright notices and license terms.
+// Your use of these subcomponents is subject to the terms and conditions of the sub-component's license,
+// as noted in the LICENSE file.
+
+#include "LatencyTargetController.hpp"
+#include "Logger.hpp"
+#include "kvstream.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace bftEngine::batchingLogic {
+
+using namespace std::chrono;
+
+LatencyTargetController::LatencyTargetController(milliseconds target,
+                                                 uint32_t initialBatchSize,
+                                                 uint32_t maxBatchSize,
+                                                 milliseconds maxFlushPeriod)
+    : target_(target),
+      maxBatchSize_(std::max(maxBatchSize, 1u)),
+      maxFlushPeriod_(std::max(maxFlushPeriod, MIN_FLUSH_PERIOD)),
+      batchSize_(std::clamp(initialBatchSize, 1u, maxBatchSize_)),
+      flushPeriod_(std::clamp(duration_cast<milliseconds>(target), MIN_FLUSH_PERIOD, maxFlushPeriod_)) {
+  window_.reserve(WINDOW_SAMPLES);
+}
+
+void LatencyTargetController::onBatchCommitted(microseconds latency) {
+  if (window_.size() < WINDOW_SAMPLES) {
+    window_.push_back(latency);
+  } else {
+    window_[next_] = latency;
+    next_ = (next_ + 1) % WINDOW_SAMPLES;
+  }
+  // The percentile of a partial window is its maximum, so steps wait for a full one
+  if (++samplesSinceStep_ >= STEP_SAMPLES && window_.size() == WINDOW_SAMPLES) step();
+}
+
+void LatencyTargetController::onBatchClosed(uint64_t requestsInQueue) {
+  maxRequestsInQueueSinceStep_ = std::max(maxRequestsInQueueSinceStep_, requestsInQueue);
+}
+
+void LatencyTargetController::step() {
+  auto sorted = window_;
+  const auto p99Index = (sorted.size() * 99) / 100;
+  std::nth_element(sorted.begin(), sorted.begin() + static_cast<std::ptrdiff_t>(p99Index), sorted.end());
+  p99_ = sorted[p99Index];
+
+  if (p99_ > target_) {
+    batchSize_ = std::max(1u, static_cast<uint32_t>(batchSize_ * DECREASE_FACTOR));
+  } else if (p99_ < target_ * HEADROOM && maxRequestsInQueueSinceStep_ > batchSize_) {
+    const auto increase = std::max(1u, static_cast<uint32_t>(std::ceil(batchSize_ * INCREASE_RATE)));
+    batchSize_ = std::min(maxBatchSize_, batchSize_ + increase);
+  }
+  // Halfway to the budget left, to smooth the noise of the p99
+  const auto budget = p99_ < target_ ? duration_cast<milliseconds>(target_ - p99_) : MIN_FLUSH_PERIOD;
+  flushPeriod_ = std::clamp((flushPeriod_ + budget) / 2, MIN_FLUSH_PERIOD, maxFlushPeriod_);
+
+  LOG_DEBUG(GL,
+            "Latency target batching step" << KVLOG(
+                p99_.count(), target_.count(), maxRequestsInQueueSinceStep_, batchSize_, flushPeriod_.count()));
+  samplesSinceStep_ = 0;
+  maxRequestsInQueueSinceStep_ = 0;
+}
+
+}  // namespace bftEngine::batchingLogic
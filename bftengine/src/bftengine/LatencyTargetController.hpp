@@ -0,0 +1,73 @@
+// Concord
+//
+// Copyright (c) 2022 VMware, Inc. All Rights Reserved.
+//
+// This product is licensed to you under the Apache 2.0 license (the "License"). You may not use this product except in
+// compliance with the Apache 2.0 License.
+//
+// This product may include a number of subcomponents with separate copyright notices and license terms.
+// Your use of these subcomponents is subject to the terms and conditions of the sub-component's license,
+// as noted in the LICENSE file.
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace bftEngine::batchingLogic {
+
+// Feedback controller of the BATCH_LATENCY_TARGET policy. It sizes the batches of the primary and times their flush so
+// that the p99 latency of requests stays under a target, given the PrePrepare-to-commit latencies of recent batches
+// and the depth of the requests queue.
+//
+// A request waits for its batch to close, up to the flush period, and then for its batch to commit. So:
+// - The flush period gets the part of the target left after the p99 commit latency: at low load requests don't wait
+//   for batches to fill longer than the latency budget allows.
+// - The batch size grows additively while the p99 has headroom under the target and requests back up in the queue,
+//   trading the headroom for throughput, and shrinks multiplicatively once the p99 goes over the target.
+class LatencyTargetController {
+ public:
+  // The p99 is taken over this many recent commits, and the controller steps every STEP_SAMPLES commits once it has
+  // seen WINDOW_SAMPLES
+  static constexpr size_t WINDOW_SAMPLES = 128;
+  static constexpr size_t STEP_SAMPLES = 32;
+  // The batch size grows only while the p99 is under this fraction of the target
+  static constexpr double HEADROOM = 0.8;
+  static constexpr double INCREASE_RATE = 0.1;
+  static constexpr double DECREASE_FACTOR = 0.75;
+  static constexpr std::chrono::milliseconds MIN_FLUSH_PERIOD{1};
+
+  LatencyTargetController(std::chrono::milliseconds target,
+                          uint32_t initialBatchSize,
+                          uint32_t maxBatchSize,
+                          std::chrono::milliseconds maxFlushPeriod);
+
+  // A batch of this primary committed, latency after its PrePrepare
+  void onBatchCommitted(std::chrono::microseconds latency);
+  // A batch closed, with this many requests in the queue before it
+  void onBatchClosed(uint64_t requestsInQueue);
+
+  uint32_t batchSize() const { return batchSize_; }
+  std::chrono::milliseconds flushPeriod() const { return flushPeriod_; }
+  // Of the window at the last step
+  std::chrono::microseconds p99Latency() const { return p99_; }
+
+ private:
+  void step();
+
+  const std::chrono::microseconds target_;
+  const uint32_t maxBatchSize_;
+  const std::chrono::milliseconds maxFlushPeriod_;
+  uint32_t batchSize_;
+  std::chrono::milliseconds flushPeriod_;
+  std::chrono::microseconds p99_{0};
+
+  // Ring of the latencies of the last WINDOW_SAMPLES commits
+  std::vector<std::chrono::microseconds> window_;
+  size_t next_ = 0;
+  size_t samplesSinceStep_ = 0;
+  uint64_t maxRequestsInQueueSinceStep_ = 0;
+};
+
+}  // namespace bftEngine::batchingLogic
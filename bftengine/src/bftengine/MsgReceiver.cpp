@@ -21,18 +21,37 @@ using namespace bft::communication;
 
 MsgReceiver::MsgReceiver(std::shared_ptr<IncomingMsgsStorage> &storage) : incomingMsgsStorage_(storage) {}
 
-void MsgReceiver::onNewMessage(NodeNum sourceNode,
-                               const char *const message,
-                               size_t messageLength,
-                               NodeNum endpointNum) {
+bool MsgReceiver::isValidMessageLength(NodeNum sourceNode, size_t messageLength) const {
   if (messageLength > ReplicaConfig::instance().getmaxExternalMessageSize()) {
     LOG_WARN(GL, "Msg exceeds allowed max msg size, size " << messageLength << " source " << sourceNode);
-    return;
+    return false;
   }
   if (messageLength < sizeof(MessageBase::Header)) {
     LOG_WARN(GL, "Msg length is smaller than expected msg header, size " << messageLength << " source " << sourceNode);
-    return;
+    return false;
   }
+  return true;
+}
+
+std::optional<size_t> MsgReceiver::authenticatedLength(NodeNum sourceNode,
+                                                       const char *message,
+                                                       size_t messageLength) const {
+  if (!macAuthenticator_ || !macAuthenticator_->isReplica(sourceNode)) return messageLength;
+  auto length = macAuthenticator_->verify(static_cast<ReplicaId>(sourceNode), message, messageLength);
+  if (!length) {
+    LOG_WARN(GL, "Msg authenticator verification failed, size " << messageLength << " source " << sourceNode);
+  }
+  return length;
+}
+
+void MsgReceiver::onNewMessage(NodeNum sourceNode,
+                               const char *const message,
+                               size_t messageLength,
+                               NodeNum endpointNum) {
+  const auto length = authenticatedLength(sourceNode, message, messageLength);
+  if (!length) return;
+  messageLength = *length;
+  if (!isValidMessageLength(sourceNode, messageLength)) return;
 
   auto *msgBody = (MessageBase::Header *)std::malloc(messageLength);
   memcpy(msgBody, message, messageLength);
@@ -44,6 +63,21 @@ void MsgReceiver::onNewMessage(NodeNum sourceNode,
   incomingMsgsStorage_->pushExternalMsg(std::move(pMsg));
 }
 
+void MsgReceiver::onNewPooledMessage(NodeNum sourceNode,
+                                     ReceiveBuffer &&buffer,
+                                     size_t messageLength,
+                                     NodeNum endpointNum) {
+  const auto length = authenticatedLength(sourceNode, buffer.data(), messageLength);
+  if (!length) return;
+  messageLength = *length;
+  if (!isValidMessageLength(sourceNode, messageLength)) return;
+
+  auto *msgBody = reinterpret_cast<MessageBase::Header *>(buffer.release());
+  std::unique_ptr<MessageBase> pMsg(new MessageBase(sourceNode, msgBody, messageLength, ReceiveBufferPool::free));
+
+  incomingMsgsStorage_->pushExternalMsg(std::move(pMsg));
+}
+
 void MsgReceiver::onConnectionStatusChanged(const NodeNum node, const ConnectionStatus newStatus) {}
 
 }  // namespace bftEngine::impl
@@ -14,6 +14,7 @@
 #include "PrimitiveTypes.hpp"
 #include "communication/ICommunication.hpp"
 #include "IncomingMsgsStorage.hpp"
+#include "ReplicaMacAuthenticator.hpp"
 
 namespace bftEngine::impl {
 
@@ -26,11 +27,28 @@ class MsgReceiver : public bft::communication::IReceiver {
                     const char* const message,
                     size_t messageLength,
                     bft::communication::NodeNum endpointNum) override;
+  // Messages read into pool buffers are kept in these buffers, without a copy.
+  void onNewPooledMessage(bft::communication::NodeNum sourceNode,
+                          bft::communication::ReceiveBuffer&& buffer,
+                          size_t messageLength,
+                          bft::communication::NodeNum endpointNum) override;
   void onConnectionStatusChanged(const bft::communication::NodeNum node,
                                  const bft::communication::ConnectionStatus newStatus) override;
 
+  // When set, the MAC authenticators of messages from replicas are verified and removed.
+  void setMacAuthenticator(std::shared_ptr<ReplicaMacAuthenticator> authenticator) {
+    macAuthenticator_ = std::move(authenticator);
+  }
+
  private:
+  bool isValidMessageLength(bft::communication::NodeNum sourceNode, size_t messageLength) const;
+  // Returns the length of the message without its authenticator, or std::nullopt if the message should be dropped.
+  std::optional<size_t> authenticatedLength(bft::communication::NodeNum sourceNode,
+                                            const char* message,
+                                            size_t messageLength) const;
+
   std::shared_ptr<IncomingMsgsStorage> incomingMsgsStorage_;
+  std::shared_ptr<ReplicaMacAuthenticator> macAuthenticator_;
 };
 
 }  // namespace bftEngine::impl
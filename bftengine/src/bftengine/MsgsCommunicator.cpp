@@ -12,6 +12,9 @@
 #include "MsgsCommunicator.hpp"
 #include "assertUtils.hpp"
 #include "communication/CommDefs.hpp"
+#include "messages/MsgCode.hpp"
+
+#include <cstring>
 
 namespace bftEngine::impl {
 
@@ -21,7 +24,16 @@ using namespace bft::communication;
 MsgsCommunicator::MsgsCommunicator(ICommunication* comm,
                                    shared_ptr<IncomingMsgsStorage> incomingMsgsStorage,
                                    shared_ptr<IReceiver> msgReceiver)
-    : incomingMsgsStorage_(incomingMsgsStorage), msgReceiver_(msgReceiver), communication_(comm) {}
+    : incomingMsgsStorage_(incomingMsgsStorage), msgReceiver_(msgReceiver), communication_(comm) {
+  // Outgoing messages are queued by the traffic class of their type, as incoming messages are
+  if (communication_) {
+    communication_->setTrafficClassifier([](const uint8_t* msg, size_t size) {
+      MsgType type = MsgCode::None;
+      if (size >= sizeof(type)) std::memcpy(&type, msg, sizeof(type));
+      return trafficClassOf(type);
+    });
+  }
+}
 
 int MsgsCommunicator::startCommunication(uint16_t replicaId) {
   replicaId_ = replicaId;
@@ -49,11 +61,38 @@ void MsgsCommunicator::stopMsgsProcessing() {
   LOG_INFO(GL, "Messages processing for replica " << replicaId_ << " stopped");
 }
 
+void MsgsCommunicator::setMacAuthenticator(std::shared_ptr<ReplicaMacAuthenticator> authenticator) {
+  authenticator->setSend([communication = communication_](NodeNum dest, std::vector<uint8_t>&& message) {
+    communication->send(dest, std::move(message));
+  });
+  macAuthenticator_ = std::move(authenticator);
+}
+
 int MsgsCommunicator::sendAsyncMessage(NodeNum destNode, char* message, size_t messageLength) {
+  if (macAuthenticator_ && macAuthenticator_->isReplica(destNode)) {
+    return communication_->send(destNode, macAuthenticator_->authenticate(message, messageLength, {destNode}));
+  }
   return communication_->send(destNode, std::vector<uint8_t>(message, message + messageLength));
 }
 
 void MsgsCommunicator::send(std::set<NodeNum> dests, char* message, size_t messageLength) {
+  if (macAuthenticator_) {
+    // Only messages to replicas carry an authenticator
+    std::set<NodeNum> replicas;
+    for (auto it = dests.begin(); it != dests.end();) {
+      if (macAuthenticator_->isReplica(*it)) {
+        replicas.insert(*it);
+        it = dests.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    if (!replicas.empty()) {
+      auto authenticated = macAuthenticator_->authenticate(message, messageLength, replicas);
+      communication_->send(std::move(replicas), std::move(authenticated));
+    }
+    if (dests.empty()) return;
+  }
   communication_->send(std::move(dests), std::vector<uint8_t>(message, message + messageLength));
 }
 
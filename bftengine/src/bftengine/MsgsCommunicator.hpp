@@ -14,6 +14,7 @@
 #include "PrimitiveTypes.hpp"
 #include "communication/ICommunication.hpp"
 #include "IncomingMsgsStorage.hpp"
+#include "ReplicaMacAuthenticator.hpp"
 #include "messages/IncomingMsg.hpp"
 
 namespace bftEngine::impl {
@@ -39,11 +40,17 @@ class MsgsCommunicator {
 
   std::shared_ptr<IncomingMsgsStorage>& getIncomingMsgsStorage() { return incomingMsgsStorage_; }
 
+  // When set, messages to replicas carry MAC authenticators, and the authenticator sends its handshakes through the
+  // communication of this replica.
+  void setMacAuthenticator(std::shared_ptr<ReplicaMacAuthenticator> authenticator);
+  const std::shared_ptr<ReplicaMacAuthenticator>& macAuthenticator() const { return macAuthenticator_; }
+
  private:
   uint16_t replicaId_ = 0;
   std::shared_ptr<IncomingMsgsStorage> incomingMsgsStorage_;
   std::shared_ptr<bft::communication::IReceiver> msgReceiver_;
   bft::communication::ICommunication* communication_;
+  std::shared_ptr<ReplicaMacAuthenticator> macAuthenticator_;
 };
 
 }  // namespace bftEngine::impl
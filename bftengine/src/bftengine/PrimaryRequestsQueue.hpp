@@ -0,0 +1,115 @@
+// Concord
+//
+// Copyright (c) 2022 VMware, Inc. All Rights Reserved.
+//
+// This product is licensed to you under the Apache 2.0 license (the "License").  You may not use this product except in
+// compliance with the Apache 2.0 License.
+//
+// This product may include a number of subcomponents with separate copyright notices and license terms. Your use of
+// these subcomponents is subject to the terms and conditions of the subcomponent's license, as noted in the LICENSE
+// file.
+
+#pragma once
+
+#include <deque>
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "PrimitiveTypes.hpp"
+#include "assertUtils.hpp"
+
+namespace bftEngine {
+namespace impl {
+
+// The requests queue of the primary, from which it fills PrePrepare batches.
+//
+// Every client has its own queue, and the clients take turns, one request each, so that a client that sends many
+// requests (or a burst of retries) doesn't fill the batches while the requests of others wait. The requests of a client
+// keep their order. An index of the queued requests by (client, request sequence number) drops duplicates on arrival.
+//
+// Request is ClientRequestMsg, or any type with clientProxyId() and requestSeqNum(). The queue doesn't own requests.
+template <typename Request>
+class PrimaryRequestsQueue {
+ public:
+  // Returns false, and doesn't queue the request, if the same one is already queued
+  bool push(Request* request) {
+    if (!index_.insert(keyOf(request)).second) return false;
+    auto& clientRequests = queues_[request->clientProxyId()];
+    if (clientRequests.empty()) turns_.push_back(request->clientProxyId());
+    clientRequests.push_back(request);
+    ++size_;
+    return true;
+  }
+
+  // The next request of the client whose turn it is
+  Request* front() const {
+    ConcordAssert(!empty());
+    return queues_.at(turns_.front()).front();
+  }
+
+  // Removes front(), and passes the turn to the next client
+  void pop() {
+    ConcordAssert(!empty());
+    const auto clientId = turns_.front();
+    auto it = queues_.find(clientId);
+    index_.erase(keyOf(it->second.front()));
+    it->second.pop_front();
+    --size_;
+    if (it->second.empty()) {
+      turns_.pop_front();
+      queues_.erase(it);
+    } else {
+      turns_.splice(turns_.end(), turns_, turns_.begin());
+    }
+  }
+
+  // Makes room for a request of clientId in a full queue: removes and returns the newest request of the client with
+  // the most requests, if it would still have more than clientId. Otherwise returns nullptr, and clientId's request
+  // should be dropped: it is the client that takes too much of the queue.
+  Request* evictForClient(NodeIdType clientId) {
+    auto largest = queues_.end();
+    for (auto it = queues_.begin(); it != queues_.end(); ++it) {
+      if (largest == queues_.end() || it->second.size() > largest->second.size()) largest = it;
+    }
+    const auto it = queues_.find(clientId);
+    const size_t clientSize = it != queues_.end() ? it->second.size() : 0;
+    if (largest == queues_.end() || largest->second.size() <= clientSize + 1) return nullptr;
+
+    auto* evicted = largest->second.back();
+    largest->second.pop_back();
+    index_.erase(keyOf(evicted));
+    --size_;
+    return evicted;
+  }
+
+  bool contains(NodeIdType clientId, ReqId reqSeqNum) const { return index_.count({clientId, reqSeqNum}) > 0; }
+  bool empty() const { return size_ == 0; }
+  size_t size() const { return size_; }
+  size_t numClients() const { return queues_.size(); }
+
+ private:
+  struct RequestKey {
+    NodeIdType clientId;
+    ReqId reqSeqNum;
+    bool operator==(const RequestKey& other) const {
+      return clientId == other.clientId && reqSeqNum == other.reqSeqNum;
+    }
+  };
+  struct RequestKeyHash {
+    size_t operator()(const RequestKey& key) const {
+      return std::hash<uint64_t>{}(key.reqSeqNum ^ (static_cast<uint64_t>(key.clientId) << 48));
+    }
+  };
+  static RequestKey keyOf(const Request* request) { return {request->clientProxyId(), request->requestSeqNum()}; }
+
+  std::unordered_map<NodeIdType, std::deque<Request*>> queues_;
+  // The clients with queued requests, in the order of their turns
+  std::list<NodeIdType> turns_;
+  std::unordered_set<RequestKey, RequestKeyHash> index_;
+  size_t size_ = 0;
+};
+
+}  // namespace impl
+}  // namespace bftEngine
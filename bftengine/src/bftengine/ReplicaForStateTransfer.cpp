@@ -111,6 +111,8 @@ void ReplicaForStateTransfer::stop() {
 template <>
 void ReplicaForStateTransfer::onMessage(StateTransferMsg *m) {
   metric_received_state_transfers_++;
+  // The body is handed over to the state transfer module, which frees it in freeStateTransferMsg.
+  m->moveToMallocStorage();
   size_t h = sizeof(MessageBase::Header);
   stateTransfer->handleStateTransferMessage(m->body() + h, m->size() - h, m->senderId());
   m->releaseOwnership();
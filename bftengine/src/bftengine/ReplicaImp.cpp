@@ -36,6 +36,7 @@
 
 #include "messages/ClientRequestMsg.hpp"
 #include "messages/PrePrepareMsg.hpp"
+#include "messages/PrePrepareDigestsMsg.hpp"
 #include "messages/CheckpointMsg.hpp"
 #include "messages/ClientReplyMsg.hpp"
 #include "messages/StartSlowCommitMsg.hpp"
@@ -51,6 +52,7 @@
 #include "messages/ReplicaRestartReadyMsg.hpp"
 #include "messages/ReplicasRestartReadyProofMsg.hpp"
 #include "messages/PreProcessResultMsg.hpp"
+#include "ConflictScheduler.hpp"
 #include "messages/ViewChangeIndicatorInternalMsg.hpp"
 #include "messages/PrePrepareCarrierInternalMsg.hpp"
 #include "messages/ValidatedMessageCarrierInternalMsg.hpp"
@@ -99,6 +101,10 @@ void ReplicaImp::registerMsgHandlers() {
                                    bind(&ReplicaImp::messageHandler<PrePrepareMsg>, this, _1),
                                    bind(&ReplicaImp::validatedMessageHandler<PrePrepareMsg>, this, _1));
 
+  msgHandlers_->registerMsgHandler(MsgCode::PrePrepareDigests,
+                                   bind(&ReplicaImp::messageHandler<PrePrepareDigestsMsg>, this, _1),
+                                   bind(&ReplicaImp::validatedMessageHandler<PrePrepareDigestsMsg>, this, _1));
+
   msgHandlers_->registerMsgHandler(MsgCode::PartialCommitProof,
                                    bind(&ReplicaImp::messageHandler<PartialCommitProofMsg>, this, _1),
                                    bind(&ReplicaImp::validatedMessageHandler<PartialCommitProofMsg>, this, _1));
@@ -478,8 +484,17 @@ void ReplicaImp::onMessage<ClientRequestMsg>(ClientRequestMsg *m) {
   if (!isReplyAlreadySentToClient(clientId, reqSeqNum)) {
     if (isCurrentPrimary()) {
       histograms_.requestsQueueOfPrimarySize->record(requestsQueueOfPrimary.size());
+      if (requestsQueueOfPrimary.contains(clientId, reqSeqNum)) {
+        LOG_DEBUG(CNSUS, "ClientRequestMsg dropped. Already in the primary queue. " << KVLOG(clientId, reqSeqNum));
+        delete m;
+        return;
+      }
+      if (turnAwayIfOverloaded(clientId, reqSeqNum, flags)) {
+        delete m;
+        return;
+      }
       // TODO(GG): use config/parameter
-      if (requestsQueueOfPrimary.size() >= maxPrimaryQueueSize) {
+      if (requestsQueueOfPrimary.size() >= maxPrimaryQueueSize && !makeRoomInRequestsQueueOfPrimary(clientId)) {
         LOG_WARN(CNSUS,
                  "ClientRequestMsg dropped. Primary request queue is full. "
                      << KVLOG(clientId, reqSeqNum, requestsQueueOfPrimary.size()));
@@ -492,7 +507,7 @@ void ReplicaImp::onMessage<ClientRequestMsg>(ClientRequestMsg *m) {
         metric_primary_batching_duration_.addStartTimeStamp(m->getCid());
         requestsQueueOfPrimary.push(m);
         primaryCombinedReqSize += m->size();
-        primary_queue_size_.Get().Set(requestsQueueOfPrimary.size());
+        onRequestsQueueOfPrimaryChanged();
         tryToSendPrePrepareMsg(true);
         return;
       } else {
@@ -504,16 +519,25 @@ void ReplicaImp::onMessage<ClientRequestMsg>(ClientRequestMsg *m) {
       if (clientsManager->canBecomePending(clientId, reqSeqNum)) {
         clientsManager->addPendingRequest(clientId, reqSeqNum, m->getCid());
 
-        // Adding the message to a queue for future retransmission.
-        if (requestsOfNonPrimary.size() < NonPrimaryCombinedReqSize)
-          requestsOfNonPrimary[m->requestSeqNum()] = std::make_pair(getMonotonicTime(), m);
-        send(m, currentPrimary());
-        LOG_INFO(CNSUS, "Forwarding ClientRequestMsg to the current primary." << KVLOG(reqSeqNum, clientId));
+        // Adding the message to a queue for future retransmission. If it isn't queued, it is deleted once forwarded.
+        bool queued = false;
+        if (requestsOfNonPrimary.size() < NonPrimaryCombinedReqSize) {
+          queued = requestsOfNonPrimary
+                       .emplace(std::make_pair(clientId, reqSeqNum), std::make_pair(getMonotonicTime(), m))
+                       .second;
+        }
+        // With PrePrepare digests the client sends the request to the primary too, so it is forwarded only by the
+        // retransmission timer
+        if (!config_.prePrepareDigestsOnlyEnabled) {
+          send(m, currentPrimary());
+          LOG_INFO(CNSUS, "Forwarding ClientRequestMsg to the current primary." << KVLOG(reqSeqNum, clientId));
+        }
+        if (!queued) delete m;
         return;
       }
       if (clientsManager->isPending(clientId, reqSeqNum)) {
         // As long as this request is not committed, we want to continue and alert the primary about it
-        send(m, currentPrimary());
+        if (!config_.prePrepareDigestsOnlyEnabled) send(m, currentPrimary());
       } else {
         LOG_INFO(CNSUS,
                  "ClientRequestMsg is ignored because: request is old, or primary is currently working on it"
@@ -609,6 +633,50 @@ bool ReplicaImp::checkSendPrePrepareMsgPrerequisites() {
   return (!requestsQueueOfPrimary.empty());
 }
 
+bool ReplicaImp::makeRoomInRequestsQueueOfPrimary(NodeIdType clientId) {
+  auto *evicted = requestsQueueOfPrimary.evictForClient(clientId);
+  if (evicted == nullptr) return false;
+  LOG_WARN(CNSUS,
+           "Primary request queue is full, dropped the newest request of the client with the most queued requests"
+               << KVLOG(evicted->clientProxyId(), evicted->requestSeqNum(), clientId));
+  metric_primary_batching_duration_.deleteSingleEntry(evicted->getCid());
+  metric_primary_queue_evictions_++;
+  primaryCombinedReqSize -= evicted->size();
+  delete evicted;
+  onRequestsQueueOfPrimaryChanged();
+  return true;
+}
+
+void ReplicaImp::onRequestsQueueOfPrimaryChanged() {
+  primary_queue_size_.Get().Set(requestsQueueOfPrimary.size());
+  requestsInQueueOfPrimary_ = requestsQueueOfPrimary.size();
+}
+
+void ReplicaImp::releasePreExecutionKeys(NodeIdType clientId, ReqId reqSeqNum, uint64_t flags) {
+  if (conflictScheduler_ && (flags & HAS_PRE_PROCESSED_FLAG))
+    conflictScheduler_->release(preprocessor::ConflictScheduler::requestId(clientId, reqSeqNum));
+}
+
+bool ReplicaImp::turnAwayIfOverloaded(NodeIdType clientId, ReqId reqSeqNum, uint64_t flags) {
+  // Requests of the replicas themselves, requests admitted by the pre-processor, and retransmissions of requests
+  // already in progress are always admitted
+  constexpr uint64_t alwaysAdmittedFlags =
+      HAS_PRE_PROCESSED_FLAG | KEY_EXCHANGE_FLAG | TICK_FLAG | RECONFIG_FLAG | CLIENTS_PUB_KEYS_FLAG;
+  if (!admissionControl_ || repsInfo->isIdOfInternalClient(clientId) || (flags & alwaysAdmittedFlags) ||
+      !clientsManager->canBecomePending(clientId, reqSeqNum))
+    return false;
+  const auto retryAfter = admissionControl_->admit();
+  if (!retryAfter) return false;
+  LOG_DEBUG(CNSUS,
+            "ClientRequestMsg turned away. Replica is overloaded. " << KVLOG(clientId, reqSeqNum, retryAfter->count()));
+  if (admissionControl_->shouldSendBusyReply(clientId, *retryAfter)) {
+    const auto busyReply =
+        ClientReplyMsg::createBusyReply(config_.getreplicaId(), currentPrimary(), clientId, reqSeqNum, *retryAfter);
+    send(busyReply.get(), clientId);
+  }
+  return true;
+}
+
 void ReplicaImp::removeDuplicatedRequestsFromRequestsQueue() {
   TimeRecorder scoped_timer(*histograms_.removeDuplicatedRequestsFromQueue);
   // Remove duplicated requests that are result of client retrials from the head of the requestsQueueOfPrimary
@@ -619,7 +687,7 @@ void ReplicaImp::removeDuplicatedRequestsFromRequestsQueue() {
     delete first;
     first = (!requestsQueueOfPrimary.empty() ? requestsQueueOfPrimary.front() : nullptr);
   }
-  primary_queue_size_.Get().Set(requestsQueueOfPrimary.size());
+  onRequestsQueueOfPrimaryChanged();
 }
 
 // The preprepare message can be nullptr if the finalisation is happening in a separate thread.
@@ -727,7 +795,7 @@ ClientRequestMsg *ReplicaImp::addRequestToPrePrepareMessage(ClientRequestMsg *&n
   primaryCombinedReqSize -= nextRequest->size();
   requestsQueueOfPrimary.pop();
   delete nextRequest;
-  primary_queue_size_.Get().Set(requestsQueueOfPrimary.size());
+  onRequestsQueueOfPrimaryChanged();
   return (!requestsQueueOfPrimary.empty() ? requestsQueueOfPrimary.front() : nullptr);
 }
 
@@ -920,7 +988,7 @@ void ReplicaImp::startConsensusProcess(PrePrepareMsg *pp, bool isCreatedEarlier)
   {
     TimeRecorder scoped_timer1(*histograms_.broadcastPrePrepare);
     if (!retransmissionsLogicEnabled) {
-      sendToAllOtherReplicas(pp);
+      if (!config_.prePrepareDigestsOnlyEnabled || !sendPrePrepareDigests(pp)) sendToAllOtherReplicas(pp);
     } else {
       for (ReplicaId x : repsInfo->idsOfPeerReplicas()) {
         sendRetransmittableMsgToReplica(pp, x, primaryLastUsedSeqNum);
@@ -938,6 +1006,22 @@ void ReplicaImp::startConsensusProcess(PrePrepareMsg *pp, bool isCreatedEarlier)
   }
 }
 
+bool ReplicaImp::sendPrePrepareDigests(PrePrepareMsg *pp) {
+  // The requests of the internal clients, and the results of pre-execution, are known to the primary only
+  RequestsIterator reqIter(pp);
+  char *requestBody = nullptr;
+  while (reqIter.getAndGoToNext(requestBody)) {
+    const auto *hdr = reinterpret_cast<const ClientRequestMsgHeader *>(requestBody);
+    if (hdr->msgType != MsgCode::ClientRequest || clientsManager->isInternal(hdr->idOfClientProxy)) return false;
+  }
+  PrePrepareDigestsMsg digestsMsg(*pp);
+  // Not worth it for tiny requests
+  if (digestsMsg.size() >= pp->size()) return false;
+  sendToAllOtherReplicas(&digestsMsg);
+  metric_sent_preprepare_digests_++;
+  return true;
+}
+
 bool ReplicaImp::isSeqNumToStopAt(SeqNum seq_num) {
   if (ControlStateManager::instance().getPruningProcessStatus()) return true;
   if (ControlStateManager::instance().isWedged()) return true;
@@ -1016,12 +1100,16 @@ bool ReplicaImp::validatePreProcessedResults(const PrePrepareMsg *msg, const Vie
       const MessageBase::Header *hdr = (MessageBase::Header *)requestBody;
       if (hdr->msgType == MsgCode::PreProcessResult) {
         tasks.push_back(threadPool.async(
-            [&errors, requestBody, error_id](auto replicaId, auto fVal) {
+            [&errors, requestBody, error_id](auto replicaId, auto fVal, auto seqNum, auto thresholdAuth) {
               preprocessor::PreProcessResultMsg req((ClientRequestMsgHeader *)requestBody);
-              errors[error_id] = req.validatePreProcessResultSignatures(replicaId, fVal);
+              // One threshold signature to verify instead of fVal + 1 signatures
+              errors[error_id] = thresholdAuth ? req.validatePreProcessResultCertificate(seqNum)
+                                               : req.validatePreProcessResultSignatures(replicaId, fVal);
             },
             getReplicaConfig().replicaId,
-            getReplicaConfig().fVal));
+            getReplicaConfig().fVal,
+            msg->seqNumber(),
+            getReplicaConfig().preExecutionResultThresholdAuthEnabled));
         error_id++;
       }
     }
@@ -1119,9 +1207,10 @@ void ReplicaImp::onMessage<PrePrepareMsg>(PrePrepareMsg *msg) {
         clientsManager->removeRequestsOutOfBatchBounds(req.clientProxyId(), req.requestSeqNum());
         if (clientsManager->canBecomePending(req.clientProxyId(), req.requestSeqNum()))
           clientsManager->addPendingRequest(req.clientProxyId(), req.requestSeqNum(), req.getCid());
-        if (requestsOfNonPrimary.count(req.requestSeqNum())) {
-          delete std::get<1>(requestsOfNonPrimary.at(req.requestSeqNum()));
-          requestsOfNonPrimary.erase(req.requestSeqNum());
+        const auto it = requestsOfNonPrimary.find(std::make_pair(req.clientProxyId(), req.requestSeqNum()));
+        if (it != requestsOfNonPrimary.end()) {
+          delete std::get<1>(it->second);
+          requestsOfNonPrimary.erase(it);
         }
       }
       if (ps_) {
@@ -1145,6 +1234,51 @@ void ReplicaImp::onMessage<PrePrepareMsg>(PrePrepareMsg *msg) {
   if (!msgAdded) delete msg;
 }
 
+template <>
+void ReplicaImp::onMessage<PrePrepareDigestsMsg>(PrePrepareDigestsMsg *msg) {
+  metric_received_preprepare_digests_++;
+  const SeqNum msgSeqNum = msg->seqNumber();
+  SCOPED_MDC_SEQ_NUM(std::to_string(msgSeqNum));
+  LOG_DEBUG(CNSUS, "Received PrePrepareDigestsMsg" << KVLOG(msg->senderId(), msg->numberOfRequests(), msg->size()));
+
+  if (!relevantMsgForActiveView(msg) || (msg->senderId() != currentPrimary()) ||
+      (mainLog->get(msgSeqNum).getPrePrepareMsg() != nullptr)) {
+    delete msg;
+    return;
+  }
+
+  // The requests that this replica got from the clients wait in requestsOfNonPrimary until they are in a PrePrepare
+  std::vector<const ClientRequestMsg *> requests;
+  requests.reserve(msg->numberOfRequests());
+  for (uint16_t i = 0; i < msg->numberOfRequests(); i++) {
+    const auto ref = msg->requestRef(i);
+    auto it = requestsOfNonPrimary.find(std::make_pair(ref.clientId, ref.reqSeqNum));
+    if (it == requestsOfNonPrimary.end()) break;
+    // Another request under the same reference
+    const ClientRequestMsg *req = it->second.second;
+    if (!PrePrepareDigestsMsg::refersTo(ref, *req)) break;
+    requests.push_back(req);
+  }
+
+  if (requests.size() < msg->numberOfRequests()) {
+    metric_preprepare_digests_missing_requests_++;
+    LOG_INFO(CNSUS,
+             "Missing requests of a PrePrepareDigestsMsg, asking the primary for the PrePrepare"
+                 << KVLOG(msgSeqNum, requests.size(), msg->numberOfRequests()));
+    ReqMissingDataMsg reqData(config_.getreplicaId(), getCurrentView(), msgSeqNum);
+    reqData.setPrePrepareIsMissing();
+    send(&reqData, currentPrimary());
+    metric_sent_req_for_missing_data_++;
+    delete msg;
+    return;
+  }
+
+  // The rebuilt PrePrepare is validated and handled as if it came from the primary
+  PrePrepareMsg *pp = msg->rebuild(requests);
+  delete msg;
+  messageHandler<PrePrepareMsg>(pp);
+}
+
 void ReplicaImp::tryToStartSlowPaths() {
   if (!isCurrentPrimary() || isCollectingState() || !currentViewIsActive())
     return;  // TODO(GG): consider to stop the related timer when this method is not needed (to avoid useless
@@ -2465,6 +2599,12 @@ void ReplicaImp::startExecution(SeqNum seqNumber,
     metric_consensus_duration_.finishMeasurement(seqNumber);
     metric_post_exe_duration_.addStartTimeStamp(seqNumber);
     metric_consensus_end_to_core_exe_duration_.addStartTimeStamp(seqNumber);
+    if (mainLog->insideActiveWindow(seqNumber)) {
+      const Time prePrepareTime = mainLog->get(seqNumber).getTimeOfFirstRelevantInfoFromPrimary();
+      if (prePrepareTime != MinTime) {
+        reqBatchingLogic_.onBatchCommitted(duration_cast<microseconds>(getMonotonicTime() - prePrepareTime));
+      }
+    }
   }
 
   consensus_times_.end(seqNumber);
@@ -3248,7 +3388,7 @@ void ReplicaImp::onNewView(const std::vector<PrePrepareMsg *> &prePreparesForNew
     delete msg;
   }
 
-  primary_queue_size_.Get().Set(requestsQueueOfPrimary.size());
+  onRequestsQueueOfPrimaryChanged();
 
   // send messages
   if (newNewViewMsgToSend != nullptr) {
@@ -3875,6 +4015,11 @@ void ReplicaImp::onViewsChangeTimer(Timers::Handle timer)  // TODO(GG): review/u
 }
 
 void ReplicaImp::onStatusReportTimer(Timers::Handle timer) {
+  // Handshakes are repeated until every peer answers, and messages without a MAC are dropped until then
+  if (const auto &macAuthenticator = msgsCommunicator_->macAuthenticator()) {
+    macAuthenticator->sendHandshakes();
+    metric_mac_session_keys_.Get().Set(macAuthenticator->numOfSessionKeys());
+  }
   if (isCollectingState() || bftEngine::ControlStateManager::instance().getPruningProcessStatus()) return;
 
   tryToSendStatusReport(true);
@@ -4311,6 +4456,7 @@ ReplicaImp::ReplicaImp(bool firstTime,
       metric_primary_last_used_seq_num_{metrics_.RegisterGauge("primaryLastUsedSeqNum", primaryLastUsedSeqNum)},
       metric_on_call_back_of_super_stable_cp_{metrics_.RegisterGauge("OnCallBackOfSuperStableCP", 0)},
       metric_sent_replica_asks_to_leave_view_msg_{metrics_.RegisterGauge("sentReplicaAsksToLeaveViewMsg", 0)},
+      metric_mac_session_keys_{metrics_.RegisterGauge("macSessionKeys", 0)},
       metric_bft_batch_size_{metrics_.RegisterGauge("bft_batch_size", 0)},
       my_id{metrics_.RegisterGauge("my_id", config.replicaId)},
       primary_queue_size_{metrics_.RegisterGauge("primary_queue_size", 0)},
@@ -4321,6 +4467,7 @@ ReplicaImp::ReplicaImp(bool firstTime,
       metric_first_commit_path_{metrics_.RegisterStatus(
           "firstCommitPath", CommitPathToStr(ControllerWithSimpleHistory_debugInitialFirstPath))},
       batch_closed_on_logic_off_{metrics_.RegisterCounter("total_number_batch_closed_on_logic_off")},
+      metric_primary_queue_evictions_{metrics_.RegisterCounter("primaryQueueEvictions")},
       batch_closed_on_logic_on_{metrics_.RegisterCounter("total_number_batch_closed_on_logic_on")},
       metric_indicator_of_non_determinism_{metrics_.RegisterCounter("indicator_of_non_determinism")},
       metric_total_committed_sn_{metrics_.RegisterCounter("total_committed_seqNum")},
@@ -4373,8 +4520,12 @@ ReplicaImp::ReplicaImp(bool firstTime,
           metrics_.RegisterCounter("sentFullCommitProofMsgDueToReqMissingData")},
       metric_total_finished_consensuses_{metrics_.RegisterCounter("totalOrderedRequests")},
       metric_total_preexec_requests_executed_{metrics_.RegisterCounter("totalPreExecRequestsExecuted")},
+      metric_total_preexec_requests_aborted_{metrics_.RegisterCounter("totalPreExecRequestsAborted")},
       metric_received_restart_ready_{metrics_.RegisterCounter("receivedRestartReadyMsg", 0)},
       metric_received_restart_proof_{metrics_.RegisterCounter("receivedRestartProofMsg", 0)},
+      metric_sent_preprepare_digests_{metrics_.RegisterCounter("sentPrePrepareDigestsMsgs")},
+      metric_received_preprepare_digests_{metrics_.RegisterCounter("receivedPrePrepareDigestsMsgs")},
+      metric_preprepare_digests_missing_requests_{metrics_.RegisterCounter("prePrepareDigestsWithMissingRequests")},
       metric_consensus_duration_{metrics_, "consensusDuration", 1000, 100, true},
       metric_post_exe_duration_{metrics_, "postExeDuration", 1000, 100, true},
       metric_core_exe_func_duration_{metrics_, "postExeCoreFuncDuration", 1000, 100, true},
@@ -4416,6 +4567,35 @@ ReplicaImp::ReplicaImp(bool firstTime,
   registerMsgHandlers();
   replStatusHandlers_.registerStatusHandlers();
   maxQueueSize_ = config_.postExecutionQueuesSize;
+  // Admission control and the concurrency controllers register metrics of their own, so are built before metrics_ is
+  if (config_.admissionControlEnabled) {
+    admissionControl_ = std::make_unique<AdmissionControl>(
+        AdmissionControl::Limits{maxPrimaryQueueSize,
+                                 config_.admissionControlMaxPendingRequests,
+                                 config_.admissionControlMaxPreProcessorRequests,
+                                 std::chrono::milliseconds{config_.admissionControlMaxRetryAfterMs}},
+        [this]() { return requestsInQueueOfPrimary_.load(); },
+        [this]() { return clientsManager->numOfPendingRequests(); },
+        metrics_);
+  }
+  if (config_.preExecConflictAwareSchedulingEnabled)
+    conflictScheduler_ = std::make_unique<preprocessor::ConflictScheduler>();
+  if (config_.concurrencyControllerEnabled) {
+    const std::array<uint32_t, RequestThreadPool::PoolLevel::MAXLEVEL> levels = {config_.threadbagConcurrencyLevel1,
+                                                                                 config_.threadbagConcurrencyLevel2};
+    for (uint16_t level = RequestThreadPool::PoolLevel::STARTING; level < RequestThreadPool::PoolLevel::MAXLEVEL;
+         ++level) {
+      concurrencyControllers_.push_back(std::make_unique<concord::util::ConcurrencyController>(
+          "threadbagLevel" + std::to_string(level + 1),
+          concord::util::ConcurrencyController::Config{
+              config_.threadbagMinConcurrencyLevel,
+              config_.threadbagMaxConcurrencyLevel ? config_.threadbagMaxConcurrencyLevel : levels[level],
+              std::chrono::microseconds{config_.concurrencyControllerTargetQueueWaitMicros},
+              config_.concurrencyControllerMaxCpuUtilizationPercent / 100.0},
+          concord::util::ConcurrencyController::poolOf(RequestThreadPool::getThreadPool(level)),
+          metrics_));
+    }
+  }
   // Register metrics component with the default aggregator.
   metrics_.Register();
 
@@ -4549,6 +4729,7 @@ void ReplicaImp::stop() {
   timers_.cancel(infoReqTimer_);
   timers_.cancel(statusReportTimer_);
   timers_.cancel(clientRequestsRetransmissionTimer_);
+  if (!concurrencyControllers_.empty()) timers_.cancel(concurrencyControllerTimer_);
   if (viewChangeProtocolEnabled) timers_.cancel(viewChangeTimer_);
   ReplicaForStateTransfer::stop();
 }
@@ -4565,11 +4746,13 @@ void ReplicaImp::addTimers() {
       milliseconds(config_.clientRequestRetransmissionTimerMilli), Timers::Timer::RECURRING, [this](Timers::Handle h) {
         if (isCurrentPrimary() || isCollectingState() || ControlHandler::instance()->onPruningProcess()) return;
         auto currentTime = getMonotonicTime();
-        for (const auto &[sn, msg] : requestsOfNonPrimary) {
+        for (auto &[req, msg] : requestsOfNonPrimary) {
           auto timeout = duration_cast<milliseconds>(currentTime - std::get<0>(msg)).count();
           if (timeout > (3 * config_.clientRequestRetransmissionTimerMilli)) {
-            LOG_INFO(GL, "retransmitting client request in non primary due to timeout" << KVLOG(sn, timeout));
-            requestsOfNonPrimary[sn].first = getMonotonicTime();
+            const auto &[clientId, sn] = req;
+            LOG_INFO(GL,
+                     "retransmitting client request in non primary due to timeout" << KVLOG(clientId, sn, timeout));
+            msg.first = getMonotonicTime();
             send(std::get<1>(msg), currentPrimary());
           }
         }
@@ -4598,6 +4781,12 @@ void ReplicaImp::addTimers() {
   infoReqTimer_ = timers_.add(milliseconds(dynamicUpperLimitOfRounds->upperLimit() / 2),
                               Timers::Timer::RECURRING,
                               [this](Timers::Handle h) { onInfoRequestTimer(h); });
+  if (!concurrencyControllers_.empty()) {
+    concurrencyControllerTimer_ = timers_.add(
+        milliseconds(config_.concurrencyControllerPeriodMs), Timers::Timer::RECURRING, [this](Timers::Handle h) {
+          for (auto &concurrencyController : concurrencyControllers_) concurrencyController->tick();
+        });
+  }
 }
 
 void ReplicaImp::start() {
@@ -4625,6 +4814,7 @@ void ReplicaImp::start() {
     // If key exchange is disabled, first publish the replica's main (rsa) key to clients
     if (ReplicaConfig::instance().publishReplicasMasterKeyOnStartup) KeyExchangeManager::instance().sendMainPublicKey();
   }
+  if (const auto &macAuthenticator = msgsCommunicator_->macAuthenticator()) macAuthenticator->sendHandshakes();
   KeyExchangeManager::instance().sendInitialClientsKeys(SigManager::instance()->getClientsPublicKeys());
 }
 
@@ -4692,7 +4882,7 @@ void ReplicaImp::executeReadOnlyRequest(concordUtils::SpanWrapper &parent_span,
     if (actualReplyLength > 0) {
       reply.setReplyLength(actualReplyLength);
       reply.setReplicaSpecificInfoLength(actualReplicaSpecificInfoLength);
-      send(&reply, clientId);
+      sendReplyToClient(&reply, clientId, request->flags());
       return;
     } else {
       LOG_WARN(GL, "Received zero size response. " << KVLOG(clientId));
@@ -4712,6 +4902,18 @@ void ReplicaImp::executeReadOnlyRequest(concordUtils::SpanWrapper &parent_span,
   }
 }
 
+void ReplicaImp::sendReplyToClient(ClientReplyMsg *reply, NodeIdType clientId, uint64_t requestFlags) {
+  // The designated replier is chosen round-robin by the request sequence number, so that the load of sending full
+  // replies is spread among the replicas.
+  const auto designated = static_cast<ReplicaId>(reply->reqSeqNum() % config_.getnumReplicas());
+  if ((requestFlags & DIGEST_REPLIES_FLAG) == 0 || designated == config_.getreplicaId()) {
+    send(reply, clientId);
+    return;
+  }
+  auto digestReply = reply->createDigestReply();
+  send(digestReply.get(), clientId);
+}
+
 void ReplicaImp::setConflictDetectionBlockId(const ClientRequestMsg &clientReqMsg,
                                              IRequestsHandler::ExecutionRequest &execReq) {
   ConcordAssertGT(clientReqMsg.requestLength(), sizeof(uint64_t));
@@ -5033,6 +5235,7 @@ void ReplicaImp::executeRequests(PrePrepareMsg *ppMsg, Bitmap &requestSet, Times
     ClientRequestMsg req((ClientRequestMsgHeader *)requestBody);
 
     if (!requestSet.get(tmp) || req.requestLength() == 0) {
+      releasePreExecutionKeys(req.clientProxyId(), req.requestSeqNum(), req.flags());
       InternalMessage im = RemovePendingForExecutionRequest{req.clientProxyId(), req.requestSeqNum()};
       getIncomingMsgsStorage().pushInternalMsg(std::move(im));
       continue;
@@ -5428,6 +5631,8 @@ void ReplicaImp::executeRequestsInPrePrepareMsg(concordUtils::SpanWrapper &paren
         ClientRequestMsg req(reinterpret_cast<ClientRequestMsgHeader *>(requestBody));
         SCOPED_MDC_CID(req.getCid());
         NodeIdType clientId = req.clientProxyId();
+        // The request is committed, no need to keep it in the cache of verified requests.
+        SigManager::instance()->onClientRequestCommitted(clientId, req.requestSeqNum());
         const bool validNoop = ((clientId == currentPrimary()) && (req.requestLength() == 0));
         if (validNoop) {
           ++numValidNoOps;
@@ -5606,6 +5811,7 @@ void ReplicaImp::executeRequestsAndSendResponses(PrePrepareMsg *ppMsg,
     reqIdx++;
     ClientRequestMsg req(reinterpret_cast<ClientRequestMsgHeader *>(requestBody));
     if (!requestSet.get(tmp) || req.requestLength() == 0) {
+      releasePreExecutionKeys(req.clientProxyId(), req.requestSeqNum(), req.flags());
       clientsManager->removePendingForExecutionRequest(req.clientProxyId(), req.requestSeqNum());
       continue;
     }
@@ -5672,6 +5878,8 @@ void ReplicaImp::sendResponses(PrePrepareMsg *ppMsg, IRequestsHandler::Execution
   for (auto &req : accumulatedRequests) {
     auto executionResult = req.outExecutionStatus;
     std::unique_ptr<ClientReplyMsg> replyMsg;
+    // Executed, so the state that conflicting requests are pre-executed against is final
+    releasePreExecutionKeys(req.clientId, req.requestSequenceNum, req.flags);
 
     // Internal clients don't expect to be answered
     if (repsInfo->isIdOfInternalClient(req.clientId)) {
@@ -5680,6 +5888,10 @@ void ReplicaImp::sendResponses(PrePrepareMsg *ppMsg, IRequestsHandler::Execution
       continue;
     }
     if (executionResult != 0) {
+      // The pre-execution result was computed against a state that changed since
+      if ((req.flags & HAS_PRE_PROCESSED_FLAG) &&
+          executionResult == static_cast<uint32_t>(OperationResult::CONFLICT_DETECTED))
+        metric_total_preexec_requests_aborted_++;
       LOG_WARN(
           GL,
           "Request execution failed: " << KVLOG(
@@ -5694,7 +5906,7 @@ void ReplicaImp::sendResponses(PrePrepareMsg *ppMsg, IRequestsHandler::Execution
                                                                         req.outActualReplySize,
                                                                         req.outReplicaSpecificInfoSize,
                                                                         executionResult);
-        send(replyMsg.get(), req.clientId);
+        sendReplyToClient(replyMsg.get(), req.clientId, req.flags);
         free(req.outReply);
         req.outReply = nullptr;
         clientsManager->removePendingForExecutionRequest(req.clientId, req.requestSequenceNum);
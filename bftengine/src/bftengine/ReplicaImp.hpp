@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <string>
 #include <utility>
 
@@ -19,6 +20,7 @@
 #include "SeqNumInfo.hpp"
 #include "Digest.hpp"
 #include "SimpleThreadPool.hpp"
+#include "ConcurrencyController.hpp"
 #include "ControllerBase.hpp"
 #include "RetransmissionsManager.hpp"
 #include "DynamicUpperLimitWithSimpleFilter.hpp"
@@ -35,6 +37,8 @@
 #include "diagnostics.h"
 #include "performance_handler.h"
 #include "RequestsBatchingLogic.hpp"
+#include "PrimaryRequestsQueue.hpp"
+#include "AdmissionControl.hpp"
 #include "ReplicaStatusHandlers.hpp"
 #include "PerformanceManager.hpp"
 #include "secrets_manager_impl.h"
@@ -48,12 +52,14 @@
 
 namespace preprocessor {
 class PreProcessResultMsg;
+class ConflictScheduler;
 }
 namespace bftEngine::impl {
 
 class ClientRequestMsg;
 class ClientReplyMsg;
 class PrePrepareMsg;
+class PrePrepareDigestsMsg;
 class CheckpointMsg;
 class ViewChangeMsg;
 class NewViewMsg;
@@ -114,11 +120,11 @@ class ReplicaImp : public InternalReplicaApi, public ReplicaForStateTransfer {
   SeqNum maxSeqNumTransferredFromPrevViews = 0;
 
   // requests queue (used by the primary)
-  std::queue<ClientRequestMsg*> requestsQueueOfPrimary;  // only used by the primary
-  size_t primaryCombinedReqSize = 0;                     // only used by the primary
+  PrimaryRequestsQueue<ClientRequestMsg> requestsQueueOfPrimary;  // only used by the primary
+  size_t primaryCombinedReqSize = 0;                              // only used by the primary
 
-  std::map<uint64_t, std::pair<Time, ClientRequestMsg*>>
-      requestsOfNonPrimary;  // used to retransmit client requests by a non primary replica
+  // used to retransmit client requests by a non primary replica, by client id and request seq num
+  std::map<std::pair<NodeIdType, ReqId>, std::pair<Time, ClientRequestMsg*>> requestsOfNonPrimary;
   size_t NonPrimaryCombinedReqSize = 1000;
   //
   const std::thread::id MAIN_THREAD_ID;
@@ -183,6 +189,14 @@ class ReplicaImp : public InternalReplicaApi, public ReplicaForStateTransfer {
   // managing information about the clients
   std::shared_ptr<ClientsManager> clientsManager;
   std::shared_ptr<InternalBFTClient> internalBFTClient_;
+  // Of the new requests of external clients, when the replica is the primary
+  std::unique_ptr<AdmissionControl> admissionControl_;
+  // The size of requestsQueueOfPrimary, that the admission control of the pre-processor thread reads
+  std::atomic_uint64_t requestsInQueueOfPrimary_{0};
+  // Orders the pre-executions of conflicting requests. Pre-processed requests hold their keys until they are executed.
+  std::unique_ptr<preprocessor::ConflictScheduler> conflictScheduler_;
+  // Resize the RequestThreadPool levels at runtime, if enabled
+  std::vector<std::unique_ptr<concord::util::ConcurrencyController>> concurrencyControllers_;
 
   size_t numInvalidClients = 0;
   size_t numValidNoOps = 0;
@@ -214,6 +228,7 @@ class ReplicaImp : public InternalReplicaApi, public ReplicaForStateTransfer {
   concordUtil::Timers::Handle statusReportTimer_;
   concordUtil::Timers::Handle viewChangeTimer_;
   concordUtil::Timers::Handle clientRequestsRetransmissionTimer_;
+  concordUtil::Timers::Handle concurrencyControllerTimer_;
 
   int viewChangeTimerMilli = 0;
   int autoPrimaryRotationTimerMilli = 0;
@@ -250,6 +265,8 @@ class ReplicaImp : public InternalReplicaApi, public ReplicaForStateTransfer {
   GaugeHandle metric_primary_last_used_seq_num_;
   GaugeHandle metric_on_call_back_of_super_stable_cp_;
   GaugeHandle metric_sent_replica_asks_to_leave_view_msg_;
+  // The peers with which the MAC authenticator has session keys
+  GaugeHandle metric_mac_session_keys_;
   GaugeHandle metric_bft_batch_size_;
   GaugeHandle my_id;
   GaugeHandle primary_queue_size_;
@@ -260,6 +277,7 @@ class ReplicaImp : public InternalReplicaApi, public ReplicaForStateTransfer {
   // The first commit path being attempted for a new request.
   StatusHandle metric_first_commit_path_;
   CounterHandle batch_closed_on_logic_off_;
+  CounterHandle metric_primary_queue_evictions_;
   CounterHandle batch_closed_on_logic_on_;
   CounterHandle metric_indicator_of_non_determinism_;
   CounterHandle metric_total_committed_sn_;
@@ -311,8 +329,12 @@ class ReplicaImp : public InternalReplicaApi, public ReplicaForStateTransfer {
   CounterHandle metric_sent_fullCommitProof_msg_due_to_reqMissingData_;
   CounterHandle metric_total_finished_consensuses_;
   CounterHandle metric_total_preexec_requests_executed_;
+  CounterHandle metric_total_preexec_requests_aborted_;
   CounterHandle metric_received_restart_ready_;
   CounterHandle metric_received_restart_proof_;
+  CounterHandle metric_sent_preprepare_digests_;
+  CounterHandle metric_received_preprepare_digests_;
+  CounterHandle metric_preprepare_digests_missing_requests_;
   PerfMetric<uint64_t> metric_consensus_duration_;
   PerfMetric<uint64_t> metric_post_exe_duration_;
   PerfMetric<uint64_t> metric_core_exe_func_duration_;
@@ -384,6 +406,8 @@ class ReplicaImp : public InternalReplicaApi, public ReplicaForStateTransfer {
   }
   SeqNum getPrimaryLastUsedSeqNum() const override { return primaryLastUsedSeqNum; }
   uint64_t getRequestsInQueue() const override { return requestsQueueOfPrimary.size(); }
+  AdmissionControl* getAdmissionControl() const override { return admissionControl_.get(); }
+  preprocessor::ConflictScheduler* getConflictScheduler() const override { return conflictScheduler_.get(); }
   SeqNum getLastExecutedSeqNum() const override { return lastExecutedSeqNum; }
   std::pair<PrePrepareMsg*, bool> buildPrePrepareMessage() override;
   bool tryToSendPrePrepareMsg(bool batchingLogic = false) override;
@@ -507,6 +531,13 @@ class ReplicaImp : public InternalReplicaApi, public ReplicaForStateTransfer {
   void asyncValidateMessage(MSG* msg);
 
   void removeDuplicatedRequestsFromRequestsQueue();
+  // When the primary queue is full, drops a request of the client that takes most of it to make room for clientId
+  bool makeRoomInRequestsQueueOfPrimary(NodeIdType clientId);
+  void onRequestsQueueOfPrimaryChanged();
+  // Lets the pre-executions that wait on the keys of a pre-processed request start
+  void releasePreExecutionKeys(NodeIdType clientId, ReqId reqSeqNum, uint64_t flags);
+  // Returns true, after sending a busy reply to the client, if admission control turns the new request away
+  bool turnAwayIfOverloaded(NodeIdType clientId, ReqId reqSeqNum, uint64_t flags);
 
   void tryToStartSlowPaths();
 
@@ -529,6 +560,9 @@ class ReplicaImp : public InternalReplicaApi, public ReplicaForStateTransfer {
 
   void executeRequestsAndSendResponses(PrePrepareMsg* pp, Bitmap& requestSet, concordUtils::SpanWrapper& span);
   void sendResponses(PrePrepareMsg* ppMsg, IRequestsHandler::ExecutionRequestsQueue& accumulatedRequests);
+  // Sends a successful reply, or only its digest if the client asked for digest replies and this replica is not the
+  // designated replier of the request.
+  void sendReplyToClient(ClientReplyMsg* reply, NodeIdType clientId, uint64_t requestFlags);
 
   void onSeqNumIsStable(
       SeqNum newStableSeqNum,
@@ -613,6 +647,8 @@ class ReplicaImp : public InternalReplicaApi, public ReplicaForStateTransfer {
   void addTimers();
   void startConsensusProcess(PrePrepareMsg* pp, bool isCreatedEarlier);
   void startConsensusProcess(PrePrepareMsg* pp);
+  // Sends pp to the other replicas as a PrePrepareDigestsMsg, unless they might miss some of its requests
+  bool sendPrePrepareDigests(PrePrepareMsg* pp);
   /**
    * Updates both seqNumInfo and slow_path metric
    * @param seqNumInfo
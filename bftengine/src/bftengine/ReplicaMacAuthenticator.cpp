@@ -0,0 +1,310 @@
+// Concord
+//
+// Copyright (c) 2022 VMware, Inc. All Rights Reserved.
+//
+// This product is licensed to you under the Apache 2.0 license (the "License").  You may not use this product except in
+// compliance with the Apache 2.0 License.
+//
+// This product may include a number of subcomponents with separate copyright notices and license terms. Your use of
+// these subcomponents is subject to the terms and conditions of the subcomponent's license, as noted in the LICENSE
+// file.
+
+#include "ReplicaMacAuthenticator.hpp"
+#include "assertUtils.hpp"
+#include "messages/MsgCode.hpp"
+#include "sha_hash.hpp"
+
+#include <openssl/crypto.h>
+#include <openssl/hmac.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+
+namespace bftEngine::impl {
+
+using bft::communication::NodeNum;
+using namespace std::chrono;
+
+namespace {
+
+const char kKeyDerivationLabel[] = "concord replica mac";
+
+struct EVPPKEYCTXDeleter {
+  void operator()(EVP_PKEY_CTX* ctx) const { EVP_PKEY_CTX_free(ctx); }
+};
+using EvpPkeyCtxPtr = std::unique_ptr<EVP_PKEY_CTX, EVPPKEYCTXDeleter>;
+
+// Messages that are authenticated by other means: client requests are signed and state transfer data is verified
+// against checkpoint digests. A replica that misses the keys of its peers, or whose peers miss its key, can still send
+// these, and in particular the requests of its internal client.
+bool isSelfAuthenticated(const char* message, size_t length) {
+  MsgType type;
+  if (length < sizeof(type)) return false;
+  std::memcpy(&type, message, sizeof(type));
+  return type == MsgCode::ClientRequest || type == MsgCode::StateTransfer;
+}
+
+}  // namespace
+
+ReplicaMacAuthenticator::ReplicaMacAuthenticator(ReplicaId myId,
+                                                 uint16_t numReplicas,
+                                                 Sign sign,
+                                                 VerifySignature verifySignature)
+    : myId_{myId},
+      numReplicas_{numReplicas},
+      sign_{std::move(sign)},
+      verifySignature_{std::move(verifySignature)},
+      keyCreationTime_{static_cast<uint64_t>(
+          duration_cast<microseconds>(system_clock::now().time_since_epoch()).count())},
+      sessionKeys_(numReplicas) {
+  EvpPkeyCtxPtr ctx{EVP_PKEY_CTX_new_id(EVP_PKEY_X25519, nullptr)};
+  ConcordAssertNE(ctx, nullptr);
+  ConcordAssertEQ(EVP_PKEY_keygen_init(ctx.get()), 1);
+  EVP_PKEY* key = nullptr;
+  ConcordAssertEQ(EVP_PKEY_keygen(ctx.get(), &key), 1);
+  privateKey_.reset(key);
+
+  size_t pubLength = publicKey_.size();
+  ConcordAssertEQ(EVP_PKEY_get_raw_public_key(privateKey_.get(), publicKey_.data(), &pubLength), 1);
+  ConcordAssertEQ(pubLength, kPublicKeySize);
+}
+
+bool ReplicaMacAuthenticator::setPeerPublicKey(ReplicaId peer, const PublicKey& publicKey, uint64_t keyCreationTime) {
+  std::unique_ptr<EVP_PKEY, EVPPKEYDeleter> peerKey{
+      EVP_PKEY_new_raw_public_key(EVP_PKEY_X25519, nullptr, publicKey.data(), publicKey.size())};
+  if (!peerKey) {
+    LOG_WARN(GL, "Invalid MAC public key" << KVLOG(peer));
+    return false;
+  }
+
+  EvpPkeyCtxPtr ctx{EVP_PKEY_CTX_new(privateKey_.get(), nullptr)};
+  ConcordAssertNE(ctx, nullptr);
+  size_t secretLength = 0;
+  if (EVP_PKEY_derive_init(ctx.get()) != 1 || EVP_PKEY_derive_set_peer(ctx.get(), peerKey.get()) != 1 ||
+      EVP_PKEY_derive(ctx.get(), nullptr, &secretLength) != 1) {
+    LOG_WARN(GL, "Failed to derive a shared secret" << KVLOG(peer));
+    return false;
+  }
+  std::vector<uint8_t> secret(secretLength);
+  if (EVP_PKEY_derive(ctx.get(), secret.data(), &secretLength) != 1) {
+    LOG_WARN(GL, "Failed to derive a shared secret" << KVLOG(peer));
+    return false;
+  }
+
+  auto keys = SessionKeys{publicKey, keyCreationTime, deriveKey(secret, myId_, peer), deriveKey(secret, peer, myId_)};
+  OPENSSL_cleanse(secret.data(), secret.size());
+  std::unique_lock lock(lock_);
+  sessionKeys_[peer] = std::move(keys);
+  LOG_INFO(GL, "Established MAC session keys" << KVLOG(myId_, peer, keyCreationTime));
+  return true;
+}
+
+bool ReplicaMacAuthenticator::hasSessionKey(ReplicaId peer) const {
+  std::shared_lock lock(lock_);
+  return peer < numReplicas_ && sessionKeys_[peer].has_value();
+}
+
+uint16_t ReplicaMacAuthenticator::numOfSessionKeys() const {
+  std::shared_lock lock(lock_);
+  return std::count_if(sessionKeys_.begin(), sessionKeys_.end(), [](const auto& keys) { return keys.has_value(); });
+}
+
+const std::vector<uint8_t>& ReplicaMacAuthenticator::handshake(ReplicaId dest, bool replyRequested) {
+  std::lock_guard<std::mutex> lock(handshakesLock_);
+  auto& message = handshakes_[{dest, replyRequested}];
+  if (!message.empty()) return message;
+
+  Handshake handshake;
+  handshake.msgType = MsgCode::ReplicaMacHandshake;
+  handshake.senderId = myId_;
+  handshake.destId = dest;
+  handshake.keyCreationTime = keyCreationTime_;
+  std::memcpy(handshake.publicKey, publicKey_.data(), publicKey_.size());
+  handshake.replyRequested = replyRequested;
+  const auto signature = sign_(reinterpret_cast<const char*>(&handshake), offsetof(Handshake, sigLength));
+  handshake.sigLength = signature.size();
+
+  const auto* bytes = reinterpret_cast<const uint8_t*>(&handshake);
+  message.insert(message.end(), bytes, bytes + sizeof(handshake));
+  message.insert(message.end(), signature.begin(), signature.end());
+  // An empty trailer, as verify() expects on every message from a replica
+  const NumEntries numEntries = 0;
+  bytes = reinterpret_cast<const uint8_t*>(&numEntries);
+  message.insert(message.end(), bytes, bytes + sizeof(numEntries));
+  return message;
+}
+
+void ReplicaMacAuthenticator::sendHandshakes() {
+  for (ReplicaId peer = 0; peer < numReplicas_; ++peer) {
+    if (peer == myId_ || hasSessionKey(peer)) continue;
+    auto message = handshake(peer, true);
+    send_(peer, std::move(message));
+  }
+}
+
+void ReplicaMacAuthenticator::onHandshake(ReplicaId sender, const char* message, size_t length) {
+  Handshake handshake;
+  if (length < sizeof(handshake)) {
+    stats_.rejected++;
+    return;
+  }
+  std::memcpy(&handshake, message, sizeof(handshake));
+  if (handshake.senderId != sender || handshake.destId != myId_ || length != sizeof(handshake) + handshake.sigLength) {
+    LOG_WARN(GL, "Malformed MAC handshake" << KVLOG(sender, handshake.senderId, handshake.destId, length));
+    stats_.rejected++;
+    return;
+  }
+  PublicKey publicKey;
+  std::memcpy(publicKey.data(), handshake.publicKey, publicKey.size());
+
+  bool known = false;
+  {
+    std::shared_lock lock(lock_);
+    const auto& keys = sessionKeys_[sender];
+    if (keys && handshake.keyCreationTime < keys->peerKeyCreationTime) {
+      LOG_WARN(GL, "MAC handshake with an old key" << KVLOG(sender, handshake.keyCreationTime));
+      stats_.rejected++;
+      return;
+    }
+    known = keys && keys->peerKeyCreationTime == handshake.keyCreationTime && keys->peerPublicKey == publicKey;
+  }
+  // A handshake with the current key of the sender needs no verification, it's answered with a presigned handshake
+  if (!known) {
+    if (!verifySignature_(sender,
+                          message,
+                          offsetof(Handshake, sigLength),
+                          message + sizeof(handshake),
+                          handshake.sigLength) ||
+        !setPeerPublicKey(sender, publicKey, handshake.keyCreationTime)) {
+      LOG_WARN(GL, "Invalid MAC handshake" << KVLOG(sender));
+      stats_.rejected++;
+      return;
+    }
+    stats_.handshakes++;
+  }
+  // The sender has (re)started and misses our key
+  if (handshake.replyRequested) {
+    auto reply = this->handshake(sender, false);
+    send_(sender, std::move(reply));
+  }
+}
+
+std::vector<uint8_t> ReplicaMacAuthenticator::authenticate(const char* message,
+                                                           size_t messageLength,
+                                                           const std::set<NodeNum>& dests) const {
+  std::vector<uint8_t> out;
+  out.reserve(messageLength + dests.size() * sizeof(Entry) + sizeof(NumEntries));
+  out.insert(out.end(), message, message + messageLength);
+
+  NumEntries numEntries = 0;
+  std::optional<concord::util::SHA2_256::Digest> digest;
+  {
+    std::shared_lock lock(lock_);
+    for (auto dest : dests) {
+      ConcordAssert(isReplica(dest));
+      if (!sessionKeys_[dest]) continue;
+      if (!digest) digest = concord::util::SHA2_256().digest(message, messageLength);
+      Entry entry;
+      entry.replicaId = static_cast<uint16_t>(dest);
+      mac(sessionKeys_[dest]->sendKey, digest->data(), digest->size(), entry.mac);
+      const auto* bytes = reinterpret_cast<const uint8_t*>(&entry);
+      out.insert(out.end(), bytes, bytes + sizeof(entry));
+      ++numEntries;
+    }
+  }
+  const auto* bytes = reinterpret_cast<const uint8_t*>(&numEntries);
+  out.insert(out.end(), bytes, bytes + sizeof(numEntries));
+  return out;
+}
+
+std::optional<size_t> ReplicaMacAuthenticator::verify(ReplicaId sender, const char* message, size_t length) {
+  ConcordAssert(isReplica(sender));
+  NumEntries numEntries = 0;
+  if (length < sizeof(numEntries)) {
+    stats_.rejected++;
+    return std::nullopt;
+  }
+  std::memcpy(&numEntries, message + length - sizeof(numEntries), sizeof(numEntries));
+  const auto trailerLength = sizeof(numEntries) + size_t{numEntries} * sizeof(Entry);
+  if (trailerLength > length) {
+    stats_.rejected++;
+    return std::nullopt;
+  }
+  const auto messageLength = length - trailerLength;
+
+  MsgType type = MsgCode::None;
+  if (messageLength >= sizeof(type)) std::memcpy(&type, message, sizeof(type));
+  if (type == MsgCode::ReplicaMacHandshake) {
+    onHandshake(sender, message, messageLength);
+    return std::nullopt;
+  }
+
+  std::optional<Key> receiveKey;
+  {
+    std::shared_lock lock(lock_);
+    if (sessionKeys_[sender]) receiveKey = sessionKeys_[sender]->receiveKey;
+  }
+  const char* entries = message + messageLength;
+  for (NumEntries i = 0; receiveKey && i < numEntries; ++i) {
+    Entry entry;
+    std::memcpy(&entry, entries + i * sizeof(Entry), sizeof(entry));
+    if (entry.replicaId != myId_) continue;
+    const auto digest = concord::util::SHA2_256().digest(message, messageLength);
+    uint8_t expected[kMacSize];
+    mac(*receiveKey, digest.data(), digest.size(), expected);
+    if (CRYPTO_memcmp(expected, entry.mac, kMacSize) != 0) {
+      stats_.rejected++;
+      return std::nullopt;
+    }
+    stats_.authenticated++;
+    return messageLength;
+  }
+  // There is no session key with the sender yet, or the sender doesn't have our key
+  if (isSelfAuthenticated(message, messageLength)) {
+    stats_.selfAuthenticated++;
+    return messageLength;
+  }
+  stats_.rejected++;
+  return std::nullopt;
+}
+
+// HKDF-SHA256 with a single output block, see RFC 5869. The info binds the key to its direction.
+ReplicaMacAuthenticator::Key ReplicaMacAuthenticator::deriveKey(const std::vector<uint8_t>& secret,
+                                                                ReplicaId from,
+                                                                ReplicaId to) {
+  Key prk;
+  unsigned int prkLength = prk.size();
+  ConcordAssertNE(HMAC(EVP_sha256(),
+                       kKeyDerivationLabel,
+                       sizeof(kKeyDerivationLabel) - 1,
+                       secret.data(),
+                       secret.size(),
+                       prk.data(),
+                       &prkLength),
+                  nullptr);
+
+  std::vector<uint8_t> info(kKeyDerivationLabel, kKeyDerivationLabel + sizeof(kKeyDerivationLabel) - 1);
+  const auto* fromBytes = reinterpret_cast<const uint8_t*>(&from);
+  const auto* toBytes = reinterpret_cast<const uint8_t*>(&to);
+  info.insert(info.end(), fromBytes, fromBytes + sizeof(from));
+  info.insert(info.end(), toBytes, toBytes + sizeof(to));
+  info.push_back(0x01);
+
+  Key key;
+  unsigned int keyLength = key.size();
+  ConcordAssertNE(HMAC(EVP_sha256(), prk.data(), prk.size(), info.data(), info.size(), key.data(), &keyLength),
+                  nullptr);
+  OPENSSL_cleanse(prk.data(), prk.size());
+  return key;
+}
+
+void ReplicaMacAuthenticator::mac(const Key& key, const uint8_t* digest, size_t digestLength, uint8_t* out) {
+  uint8_t full[EVP_MAX_MD_SIZE];
+  unsigned int fullLength = 0;
+  ConcordAssertNE(HMAC(EVP_sha256(), key.data(), key.size(), digest, digestLength, full, &fullLength), nullptr);
+  std::memcpy(out, full, kMacSize);
+}
+
+}  // namespace bftEngine::impl
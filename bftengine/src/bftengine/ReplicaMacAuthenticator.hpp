@@ -0,0 +1,156 @@
+// Concord
+//
+// Copyright (c) 2022 VMware, Inc. All Rights Reserved.
+//
+// This product is licensed to you under the Apache 2.0 license (the "License").  You may not use this product except in
+// compliance with the Apache 2.0 License.
+//
+// This product may include a number of subcomponents with separate copyright notices and license terms. Your use of
+// these subcomponents is subject to the terms and conditions of the subcomponent's license, as noted in the LICENSE
+// file.
+
+#pragma once
+
+#include "PrimitiveTypes.hpp"
+#include "communication/CommDefs.hpp"
+
+#include <openssl/evp.h>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+namespace bftEngine::impl {
+
+// Pairwise MAC authenticators for messages between replicas.
+//
+// Every replica generates an X25519 key pair when it starts, and sends its public key to each peer in a handshake
+// message signed with its RSA key. A pair of replicas derives a shared secret, and from it one HMAC-SHA256 key for each
+// direction. A message sent to a set of replicas carries a trailer with a truncated MAC of the message digest for every
+// destination:
+//
+// | message | Entry[numEntries] | numEntries (uint16_t) |
+//
+// A message from a replica must carry a valid MAC for this replica, and is dropped otherwise, also before a session
+// key with that replica exists. The exceptions are the handshakes, client requests and state transfer messages, which
+// are authenticated by signatures or by checkpoint digests.
+//
+// Signatures of messages that must be proven to third parties (view change, checkpoints) are not affected. The
+// signatures of pre-execution replies are dropped unless the primary forwards them, see PreProcessReplyMsg.
+class ReplicaMacAuthenticator {
+ public:
+  static constexpr size_t kMacSize = 16;
+  static constexpr size_t kPublicKeySize = 32;
+
+#pragma pack(push, 1)
+  struct Entry {
+    uint16_t replicaId;
+    uint8_t mac[kMacSize];
+  };
+  // Followed by the RSA signature of its sender on everything before sigLength
+  struct Handshake {
+    MsgType msgType;
+    uint16_t senderId;
+    uint16_t destId;
+    // Distinguishes the keys of successive runs of the sender, so that the handshakes of a previous run can't be
+    // replayed to replace its current key
+    uint64_t keyCreationTime;
+    uint8_t publicKey[kPublicKeySize];
+    uint8_t replyRequested;
+    uint16_t sigLength;
+  };
+#pragma pack(pop)
+  using NumEntries = uint16_t;
+
+  // Signs the handshakes of this replica
+  using Sign = std::function<std::string(const char* data, size_t dataLength)>;
+  // Verifies the signature of the replica `signer` on a handshake
+  using VerifySignature =
+      std::function<bool(ReplicaId signer, const char* data, size_t dataLength, const char* sig, size_t sigLength)>;
+  using Send = std::function<void(bft::communication::NodeNum dest, std::vector<uint8_t>&& message)>;
+
+  struct Stats {
+    std::atomic_uint64_t authenticated{0};      // messages with a valid MAC
+    std::atomic_uint64_t selfAuthenticated{0};  // messages accepted without a MAC entry
+    std::atomic_uint64_t rejected{0};           // malformed trailers, missing or invalid MACs and invalid handshakes
+    std::atomic_uint64_t handshakes{0};         // handshakes that established a session key
+  };
+
+  ReplicaMacAuthenticator(ReplicaId myId, uint16_t numReplicas, Sign sign, VerifySignature verifySignature);
+
+  // Sets how handshakes are sent, before messages are received
+  void setSend(Send send) { send_ = std::move(send); }
+  // Sends a handshake to every peer with which there is no session key yet, and asks it to reply with its own. Called
+  // periodically, until there are session keys with all the peers.
+  void sendHandshakes();
+
+  bool hasSessionKey(ReplicaId peer) const;
+  uint16_t numOfSessionKeys() const;
+
+  bool isReplica(bft::communication::NodeNum node) const { return node < numReplicas_; }
+
+  // The message followed by an authenticator for `dests`, which must all be replicas.
+  std::vector<uint8_t> authenticate(const char* message,
+                                    size_t messageLength,
+                                    const std::set<bft::communication::NodeNum>& dests) const;
+
+  // Verify the authenticator of a message from the replica `sender`. Returns the length of the message without the
+  // authenticator, or std::nullopt if the message should be dropped. Handshakes are handled here, and dropped.
+  std::optional<size_t> verify(ReplicaId sender, const char* message, size_t length);
+
+  const Stats& stats() const { return stats_; }
+
+  ReplicaMacAuthenticator(const ReplicaMacAuthenticator&) = delete;
+  ReplicaMacAuthenticator& operator=(const ReplicaMacAuthenticator&) = delete;
+
+ private:
+  using Key = std::array<uint8_t, 32>;
+  using PublicKey = std::array<uint8_t, kPublicKeySize>;
+
+  struct EVPPKEYDeleter {
+    void operator()(EVP_PKEY* key) const { EVP_PKEY_free(key); }
+  };
+
+  struct SessionKeys {
+    PublicKey peerPublicKey;
+    uint64_t peerKeyCreationTime;
+    Key sendKey;
+    Key receiveKey;
+  };
+
+  void onHandshake(ReplicaId sender, const char* message, size_t length);
+  // The signed handshake to `dest`, which is built once as it doesn't change while the replica runs
+  const std::vector<uint8_t>& handshake(ReplicaId dest, bool replyRequested);
+  // Derive the session keys with `peer` from its public key. Returns false if the key is invalid.
+  bool setPeerPublicKey(ReplicaId peer, const PublicKey& publicKey, uint64_t keyCreationTime);
+
+  static Key deriveKey(const std::vector<uint8_t>& secret, ReplicaId from, ReplicaId to);
+  static void mac(const Key& key, const uint8_t* digest, size_t digestLength, uint8_t* out);
+
+  const ReplicaId myId_;
+  const uint16_t numReplicas_;
+  const Sign sign_;
+  const VerifySignature verifySignature_;
+  Send send_;
+  std::unique_ptr<EVP_PKEY, EVPPKEYDeleter> privateKey_;
+  PublicKey publicKey_;
+  const uint64_t keyCreationTime_;
+
+  mutable std::shared_mutex lock_;
+  std::vector<std::optional<SessionKeys>> sessionKeys_;
+  // Signed handshakes by destination, and whether they ask for a reply
+  std::mutex handshakesLock_;
+  std::map<std::pair<ReplicaId, bool>, std::vector<uint8_t>> handshakes_;
+  mutable Stats stats_;
+};
+
+}  // namespace bftEngine::impl
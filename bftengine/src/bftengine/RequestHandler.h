@@ -68,6 +68,10 @@ class RequestHandler : public IRequestsHandler {
   }
   void setPersistentStorage(const std::shared_ptr<bftEngine::impl::PersistentStorage> &persistent_storage) override;
   void onFinishExecutingReadWriteRequests() override { userRequestsHandler_->onFinishExecutingReadWriteRequests(); }
+  std::optional<KeySets> preExecutionKeySets(uint16_t clientId, const char *request, uint32_t requestSize) override {
+    if (userRequestsHandler_) return userRequestsHandler_->preExecutionKeySets(clientId, request, requestSize);
+    return std::nullopt;
+  }
   std::shared_ptr<IRequestsHandler> getUserHandler() { return userRequestsHandler_; }
 
  private:
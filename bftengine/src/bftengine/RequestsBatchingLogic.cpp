@@ -23,6 +23,9 @@ RequestsBatchingLogic::RequestsBatchingLogic(InternalReplicaApi &replica,
                                              concordUtil::Timers &timers)
     : replica_(replica),
       metric_not_enough_client_requests_event_{metrics.RegisterCounter("notEnoughClientRequestsEvent")},
+      metric_latency_target_batch_size_{metrics.RegisterGauge("latencyTargetBatchSize", 0)},
+      metric_latency_target_flush_period_ms_{metrics.RegisterGauge("latencyTargetFlushPeriodMs", 0)},
+      metric_latency_target_p99_commit_us_{metrics.RegisterGauge("latencyTargetP99CommitUs", 0)},
       batchingPolicy_((BatchingPolicy)config.batchingPolicy),
       batchingFactorCoefficient_(config.batchingFactorCoefficient),
       maxInitialBatchSize_(config.maxInitialBatchSize),
@@ -36,8 +39,17 @@ RequestsBatchingLogic::RequestsBatchingLogic(InternalReplicaApi &replica,
       initialBatchSize_(config.maxNumOfRequestsInBatch),
       maxBatchSizeInBytes_(config.maxBatchSizeInBytes),
       timers_(timers) {
+  if (batchingPolicy_ == BATCH_LATENCY_TARGET) {
+    // The configured batch size and flush period are the upper bounds
+    latencyTargetController_ = std::make_unique<LatencyTargetController>(milliseconds(config.batchingLatencyTargetMs),
+                                                                         config.maxNumOfRequestsInBatch,
+                                                                         config.maxNumOfRequestsInBatch,
+                                                                         milliseconds(batchFlushPeriodMs_));
+    metric_latency_target_batch_size_.Get().Set(latencyTargetController_->batchSize());
+    metric_latency_target_flush_period_ms_.Get().Set(latencyTargetController_->flushPeriod().count());
+  }
   if (batchingPolicy_ != BATCH_SELF_ADJUSTED)
-    batchFlushTimer_ = timers_.add(milliseconds(batchFlushPeriodMs_),
+    batchFlushTimer_ = timers_.add(flushPeriod(),
                                    Timers::Timer::RECURRING,
                                    [this](Timers::Handle h) { onBatchFlushTimer(h); });
 }
@@ -50,13 +62,27 @@ void RequestsBatchingLogic::onBatchFlushTimer(Timers::Handle) {
   if (replica_.isCurrentPrimary()) {
     lock_guard<mutex> lock(batchProcessingLock_);
     if (replica_.tryToSendPrePrepareMsg(false)) {
-      LOG_INFO(GL, "Batching flush period expired" << KVLOG(batchFlushPeriodMs_));
+      const auto flushPeriodMs = flushPeriod().count();
+      LOG_INFO(GL, "Batching flush period expired" << KVLOG(flushPeriodMs));
       closedOnFlush_ += 1;
-      timers_.reset(batchFlushTimer_, milliseconds(batchFlushPeriodMs_));
+      timers_.reset(batchFlushTimer_, flushPeriod());
     }
   }
 }
 
+milliseconds RequestsBatchingLogic::flushPeriod() const {
+  return latencyTargetController_ ? latencyTargetController_->flushPeriod() : milliseconds(batchFlushPeriodMs_);
+}
+
+void RequestsBatchingLogic::onBatchCommitted(microseconds latency) {
+  if (!latencyTargetController_) return;
+  lock_guard<mutex> lock(batchProcessingLock_);
+  latencyTargetController_->onBatchCommitted(latency);
+  metric_latency_target_batch_size_.Get().Set(latencyTargetController_->batchSize());
+  metric_latency_target_flush_period_ms_.Get().Set(latencyTargetController_->flushPeriod().count());
+  metric_latency_target_p99_commit_us_.Get().Set(latencyTargetController_->p99Latency().count());
+}
+
 std::pair<PrePrepareMsg *, bool> RequestsBatchingLogic::batchRequestsSelfAdjustedPolicy(SeqNum primaryLastUsedSeqNum,
                                                                                         uint64_t requestsInQueue,
                                                                                         SeqNum lastExecutedSeqNum) {
@@ -128,7 +154,7 @@ std::pair<PrePrepareMsg *, bool> RequestsBatchingLogic::batchRequests() {
         prePrepareMsgWithResult = replica_.buildPrePrepareMsgBatchByRequestsNum(maxNumOfRequestsInBatch_);
         resetTimer = prePrepareMsgWithResult.second;
       }
-      if (resetTimer) timers_.reset(batchFlushTimer_, milliseconds(batchFlushPeriodMs_));
+      if (resetTimer) timers_.reset(batchFlushTimer_, flushPeriod());
     } break;
     case BATCH_BY_REQ_SIZE: {
       bool resetTimer = false;
@@ -137,7 +163,7 @@ std::pair<PrePrepareMsg *, bool> RequestsBatchingLogic::batchRequests() {
         prePrepareMsgWithResult = replica_.buildPrePrepareMsgBatchByOverallSize(maxBatchSizeInBytes_);
         resetTimer = prePrepareMsgWithResult.second;
       }
-      if (resetTimer) timers_.reset(batchFlushTimer_, milliseconds(batchFlushPeriodMs_));
+      if (resetTimer) timers_.reset(batchFlushTimer_, flushPeriod());
     } break;
     case BATCH_ADAPTIVE: {
       bool resetTimer = false;
@@ -154,8 +180,20 @@ std::pair<PrePrepareMsg *, bool> RequestsBatchingLogic::batchRequests() {
         }
       }
       if (resetTimer) {
-        timers_.reset(batchFlushTimer_, milliseconds(batchFlushPeriodMs_));
+        timers_.reset(batchFlushTimer_, flushPeriod());
+      }
+    } break;
+    case BATCH_LATENCY_TARGET: {
+      bool resetTimer = false;
+      milliseconds period;
+      {
+        lock_guard<mutex> lock(batchProcessingLock_);
+        prePrepareMsgWithResult = replica_.buildPrePrepareMsgBatchByRequestsNum(latencyTargetController_->batchSize());
+        resetTimer = prePrepareMsgWithResult.second;
+        if (resetTimer) latencyTargetController_->onBatchClosed(requestsInQueue);
+        period = flushPeriod();
       }
+      if (resetTimer) timers_.reset(batchFlushTimer_, period);
     } break;
   }
   return prePrepareMsgWithResult;
@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <memory>
 #include <utility>
 
 #include "Metrics.hpp"
@@ -19,6 +20,7 @@
 #include "messages/PrePrepareMsg.hpp"
 #include "Timers.hpp"
 #include "performance_handler.h"
+#include "LatencyTargetController.hpp"
 
 namespace bftEngine::batchingLogic {
 
@@ -34,9 +36,12 @@ class RequestsBatchingLogic {
   uint32_t getBatchingFactor() const { return batchingFactor_; }
 
   std::pair<PrePrepareMsg *, bool> batchRequests();
+  // A batch of this primary committed, latency after its PrePrepare. Feeds the BATCH_LATENCY_TARGET policy.
+  void onBatchCommitted(std::chrono::microseconds latency);
 
  private:
   void onBatchFlushTimer(concordUtil::Timers::Handle timer);
+  std::chrono::milliseconds flushPeriod() const;
   std::pair<PrePrepareMsg *, bool> batchRequestsSelfAdjustedPolicy(SeqNum primaryLastUsedSeqNum,
                                                                    uint64_t requestsInQueue,
                                                                    SeqNum lastExecutedSeqNum);
@@ -45,6 +50,9 @@ class RequestsBatchingLogic {
  private:
   InternalReplicaApi &replica_;
   concordMetrics::CounterHandle metric_not_enough_client_requests_event_;
+  concordMetrics::GaugeHandle metric_latency_target_batch_size_;
+  concordMetrics::GaugeHandle metric_latency_target_flush_period_ms_;
+  concordMetrics::GaugeHandle metric_latency_target_p99_commit_us_;
   BatchingPolicy batchingPolicy_;
   // Variables used to heuristically compute the 'optimal' batch size
   uint32_t maxNumberOfPendingRequestsInRecentHistory_ = 0;
@@ -66,6 +74,8 @@ class RequestsBatchingLogic {
   concordUtil::Timers &timers_;
   concordUtil::Timers::Handle batchFlushTimer_;
   std::mutex batchProcessingLock_;
+  // Only with BATCH_LATENCY_TARGET, guarded by batchProcessingLock_
+  std::unique_ptr<LatencyTargetController> latencyTargetController_;
 
   static constexpr uint64_t MAX_VALUE_MICROSECONDS = 1000lu * 1000 * 60;
 };
@@ -69,6 +69,8 @@ void SeqNumInfo::resetAndFree() {
   commitMsgsCollector->resetAndFree();
   fastPathOptimisticCollector->resetAndFree();
   fastPathThresholdCollector->resetAndFree();
+  // The collectors are empty, so nothing refers to the arena
+  arena->release();
   fastPathTimeOfSelfPartialProof = MinTime;
 
   primary = false;
@@ -755,13 +757,22 @@ void SeqNumInfo::init(SeqNumInfo& i, void* d) {
 
   i.replica = r;
 
+  // Enough for a partial signature of every replica in each of the 4 collectors. More goes to the heap until the slot
+  // is reset.
+  const size_t arenaSize = 4 * static_cast<size_t>(r->getReplicasInfo().numberOfReplicas()) *
+                           FastPathOptimisticCollector::arenaBytesPerReplica();
+  i.arenaBuffer.reset(new char[arenaSize]);
+  i.arena.reset(new std::pmr::monotonic_buffer_resource(i.arenaBuffer.get(), arenaSize));
+
   i.prepareSigCollector =
-      new CollectorOfThresholdSignatures<PreparePartialMsg, PrepareFullMsg, ExFuncForPrepareCollector>(context);
+      new CollectorOfThresholdSignatures<PreparePartialMsg, PrepareFullMsg, ExFuncForPrepareCollector>(context,
+                                                                                                       i.arena.get());
   i.commitMsgsCollector =
-      new CollectorOfThresholdSignatures<CommitPartialMsg, CommitFullMsg, ExFuncForCommitCollector>(context);
+      new CollectorOfThresholdSignatures<CommitPartialMsg, CommitFullMsg, ExFuncForCommitCollector>(context,
+                                                                                                    i.arena.get());
 
-  i.fastPathOptimisticCollector = new FastPathOptimisticCollector(context);
-  i.fastPathThresholdCollector = new FastPathThresholdCollector(context);
+  i.fastPathOptimisticCollector = new FastPathOptimisticCollector(context, i.arena.get());
+  i.fastPathThresholdCollector = new FastPathThresholdCollector(context, i.arena.get());
 }
 
 }  // namespace impl
@@ -11,6 +11,8 @@
 
 #pragma once
 
+#include <memory>
+#include <memory_resource>
 #include <set>
 
 // TODO(GG): clean/move 'include' statements
@@ -244,6 +246,11 @@ class SeqNumInfo {
 
   InternalReplicaApi* replica = nullptr;
 
+  // The partial signatures of the collectors are allocated from the arena of the slot, and released at once when the
+  // slot is reset. Messages are not, as their ownership may leave the slot.
+  std::unique_ptr<char[]> arenaBuffer;
+  std::unique_ptr<std::pmr::monotonic_buffer_resource> arena;
+
   PrePrepareMsg* prePrepareMsg;
 
   // Slow path
@@ -16,6 +16,7 @@
 #include <algorithm>
 #include "keys_and_signatures.cmf.hpp"
 #include "ReplicaConfig.hpp"
+#include "bftengine/ClientRequestBatchSignature.hpp"
 
 using namespace std;
 
@@ -129,10 +130,20 @@ SigManager::SigManager(PrincipalId myId,
           metrics_component_.RegisterAtomicCounter("external_client_request_signatures_verified"),
           metrics_component_.RegisterAtomicCounter("peer_replicas_signature_verification_failed"),
           metrics_component_.RegisterAtomicCounter("peer_replicas_signatures_verified"),
-          metrics_component_.RegisterAtomicCounter("signature_verification_failed_on_unrecognized_participant_id")} {
+          metrics_component_.RegisterAtomicCounter("signature_verification_failed_on_unrecognized_participant_id"),
+          metrics_component_.RegisterAtomicCounter("external_client_batch_signature_verifications_saved"),
+          metrics_component_.RegisterAtomicCounter("replica_batch_signature_verifications_saved"),
+          metrics_component_.RegisterAtomicCounter("verified_client_requests_cache_hits"),
+          metrics_component_.RegisterAtomicCounter("verified_client_requests_cache_misses")} {
   map<KeyIndex, std::shared_ptr<concord::util::crypto::IVerifier>> publicKeyIndexToVerifier;
   size_t numPublickeys = publickeys.size();
 
+  numVerifierSlots_ = size_t{replicasInfo_.maxValidPrincipalId()} + 1;
+  if (!publicKeysMapping.empty()) {
+    numVerifierSlots_ = std::max(numVerifierSlots_, size_t{publicKeysMapping.rbegin()->first} + 1);
+  }
+  verifierSlots_.reset(new std::shared_ptr<const concord::util::crypto::IVerifier>[numVerifierSlots_]);
+
   ConcordAssert(publicKeysMapping.size() >= numPublickeys);
   if (!mySigPrivateKey.first.empty())
     mySigner_.reset(new concord::util::crypto::RSASigner(mySigPrivateKey.first.c_str(), mySigPrivateKey.second));
@@ -143,10 +154,10 @@ SigManager::SigManager(PrincipalId myId,
     auto iter = publicKeyIndexToVerifier.find(p.second);
     const auto& [key, format] = publickeys[p.second];
     if (iter == publicKeyIndexToVerifier.end()) {
-      verifiers_[p.first] = std::make_shared<concord::util::crypto::RSAVerifier>(key.c_str(), format);
+      setVerifier(p.first, std::make_shared<concord::util::crypto::RSAVerifier>(key.c_str(), format));
       publicKeyIndexToVerifier[p.second] = verifiers_[p.first];
     } else {
-      verifiers_[p.first] = iter->second;
+      setVerifier(p.first, iter->second);
     }
     if (replicasInfo_.isIdOfExternalClient(p.first)) {
       clientsPublicKeys_.ids_to_keys[p.first] = concord::messages::keys_and_signatures::PublicKey{key, (uint8_t)format};
@@ -180,13 +191,20 @@ SigManager::SigManager(PrincipalId myId,
   ConcordAssert(verifiers_.size() >= publickeys.size());
 }
 
+void SigManager::setVerifier(PrincipalId pid, std::shared_ptr<concord::util::crypto::IVerifier> verifier) {
+  ConcordAssertLT(pid, numVerifierSlots_);
+  std::atomic_store_explicit(&verifierSlots_[pid],
+                             std::shared_ptr<const concord::util::crypto::IVerifier>(verifier),
+                             std::memory_order_release);
+  verifiers_[pid] = std::move(verifier);
+}
+
 uint16_t SigManager::getSigLength(PrincipalId pid) const {
   if (pid == myId_) {
     return (uint16_t)mySigner_->signatureLength();
   } else {
-    std::shared_lock lock(mutex_);
-    if (auto pos = verifiers_.find(pid); pos != verifiers_.end()) {
-      return pos->second->signatureLength();
+    if (auto verifier = getVerifier(pid)) {
+      return verifier->signatureLength();
     } else {
       LOG_ERROR(GL, "Unrecognized pid " << pid);
       return 0;
@@ -200,9 +218,8 @@ bool SigManager::verifySig(
   {
     std::string str_data(data, dataLength);
     std::string str_sig(sig, sigLength);
-    std::shared_lock lock(mutex_);
-    if (auto pos = verifiers_.find(pid); pos != verifiers_.end()) {
-      result = pos->second->verify(str_data, str_sig);
+    if (auto verifier = getVerifier(pid)) {
+      result = verifier->verify(str_data, str_sig);
     } else {
       LOG_ERROR(GL, "Unrecognized pid " << pid);
       metrics_.sigVerificationFailedOnUnrecognizedParticipantId_++;
@@ -237,6 +254,80 @@ bool SigManager::verifySig(
   return result;
 }
 
+uint16_t SigManager::getClientRequestSigLength(PrincipalId pid, const char* sig, uint16_t sigLength) const {
+  const auto clientSigLength = getSigLength(pid);
+  if (clientSigLength == 0 || sigLength <= clientSigLength) return clientSigLength;
+  if (!batch_signature::parse(sig, sigLength, clientSigLength)) {
+    LOG_WARN(GL, "Malformed batched request signature" << KVLOG(pid, sigLength, clientSigLength));
+    return 0;
+  }
+  return sigLength;
+}
+
+bool SigManager::verifyClientRequestSig(
+    PrincipalId pid, const char* request, size_t requestLength, const char* sig, uint16_t sigLength) const {
+  return verifyBatchedSig(
+      pid, request, requestLength, sig, sigLength, metrics_.externalClientBatchSigVerificationsSaved_);
+}
+
+bool SigManager::verifyReplicaResultSig(
+    PrincipalId pid, const char* resultHash, size_t resultHashLength, const char* sig, size_t sigLength) const {
+  return verifyBatchedSig(
+      pid, resultHash, resultHashLength, sig, sigLength, metrics_.replicaBatchSigVerificationsSaved_);
+}
+
+bool SigManager::verifyBatchedSig(PrincipalId pid,
+                                  const char* data,
+                                  size_t dataLength,
+                                  const char* sig,
+                                  size_t sigLength,
+                                  AtomicCounterHandle& verificationsSaved) const {
+  const auto plainSigLength = getSigLength(pid);
+  if (plainSigLength == 0 || sigLength <= plainSigLength) {
+    return verifySig(pid, data, dataLength, sig, static_cast<uint16_t>(std::min<size_t>(sigLength, plainSigLength)));
+  }
+  const auto parsed = batch_signature::parse(sig, sigLength, plainSigLength);
+  if (!parsed) return false;
+  const auto digest = batch_signature::batchDigestFromPath(data, dataLength, *parsed);
+  auto key = std::make_pair(pid, std::string(digest.begin(), digest.end()));
+  {
+    std::lock_guard<std::mutex> lock(verifiedBatchDigestsLock_);
+    if (verifiedBatchDigests_.count(key)) {
+      verificationsSaved++;
+      return true;
+    }
+  }
+  if (!verifySig(pid, key.second.data(), key.second.size(), parsed->rootSignature, parsed->rootSignatureLength)) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(verifiedBatchDigestsLock_);
+  if (verifiedBatchDigests_.insert(key).second) {
+    verifiedBatchDigestsOrder_.push_back(std::move(key));
+    if (verifiedBatchDigestsOrder_.size() > verifiedBatchDigestsCacheSize) {
+      verifiedBatchDigests_.erase(verifiedBatchDigestsOrder_.front());
+      verifiedBatchDigestsOrder_.pop_front();
+    }
+  }
+  return true;
+}
+
+bool SigManager::verifyClientRequestSig(PrincipalId pid,
+                                        ReqId reqSeqNum,
+                                        const char* request,
+                                        size_t requestLength,
+                                        const char* sig,
+                                        uint16_t sigLength) const {
+  const auto digest = VerifiedRequestsCache::digestOf(request, requestLength, sig, sigLength);
+  if (verifiedRequests_.contains(pid, reqSeqNum, digest)) {
+    metrics_.verifiedRequestsCacheHits_++;
+    return true;
+  }
+  metrics_.verifiedRequestsCacheMisses_++;
+  if (!verifyClientRequestSig(pid, request, requestLength, sig, sigLength)) return false;
+  verifiedRequests_.insert(pid, reqSeqNum, digest);
+  return true;
+}
+
 void SigManager::sign(const char* data, size_t dataLength, char* outSig, uint16_t outSigLength) const {
   std::string str_data(data, dataLength);
   std::string sig;
@@ -252,17 +343,30 @@ void SigManager::setClientPublicKey(const std::string& key, PrincipalId id, conc
   if (replicasInfo_.isIdOfExternalClient(id) || replicasInfo_.isIdOfClientService(id)) {
     try {
       std::unique_lock lock(mutex_);
-      verifiers_.insert_or_assign(id, std::make_shared<concord::util::crypto::RSAVerifier>(key.c_str(), format));
+      setVerifier(id, std::make_shared<concord::util::crypto::RSAVerifier>(key.c_str(), format));
     } catch (const std::exception& e) {
       LOG_ERROR(KEY_EX_LOG, "failed to add a key for client: " << id << " reason: " << e.what());
       throw;
     }
+    {
+      // Batches signed with the previous key must be verified again.
+      std::lock_guard<std::mutex> lock(verifiedBatchDigestsLock_);
+      for (auto it = verifiedBatchDigests_.begin(); it != verifiedBatchDigests_.end();) {
+        it = (it->first == id) ? verifiedBatchDigests_.erase(it) : std::next(it);
+      }
+      verifiedBatchDigestsOrder_.erase(
+          std::remove_if(verifiedBatchDigestsOrder_.begin(),
+                         verifiedBatchDigestsOrder_.end(),
+                         [id](const auto& entry) { return entry.first == id; }),
+          verifiedBatchDigestsOrder_.end());
+    }
+    verifiedRequests_.clear(id);
     clientsPublicKeys_.ids_to_keys[id] = concord::messages::keys_and_signatures::PublicKey{key, (uint8_t)format};
   } else {
     LOG_WARN(KEY_EX_LOG, "Illegal id for client " << id);
   }
 }
-bool SigManager::hasVerifier(PrincipalId pid) { return verifiers_.find(pid) != verifiers_.end(); }
+bool SigManager::hasVerifier(PrincipalId pid) { return getVerifier(pid) != nullptr; }
 
 }  // namespace impl
 }  // namespace bftEngine
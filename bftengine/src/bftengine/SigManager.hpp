@@ -14,13 +14,18 @@
 #include "assertUtils.hpp"
 #include "Metrics.hpp"
 #include "crypto_utils.hpp"
+#include "VerifiedRequestsCache.hpp"
 
+#include <atomic>
 #include <utility>
 #include <vector>
 #include <map>
 #include <string>
 #include <memory>
 #include <shared_mutex>
+#include <deque>
+#include <mutex>
+#include <set>
 
 using concordMetrics::AtomicCounterHandle;
 
@@ -59,6 +64,30 @@ class SigManager {
   uint16_t getSigLength(PrincipalId pid) const;
   // returns false if actual verification failed, or if pid is invalid
   bool verifySig(PrincipalId pid, const char* data, size_t dataLength, const char* sig, uint16_t sigLength) const;
+  // Returns the expected length of the signature field of a client request: the signature length of the client, or the
+  // length of a merkle-batched signature (see ClientRequestBatchSignature.hpp) if `sig` holds one.
+  // Returns 0 if pid is invalid or the batched signature is malformed.
+  uint16_t getClientRequestSigLength(PrincipalId pid, const char* sig, uint16_t sigLength) const;
+  // Verifies the signature field of a client request, which can hold a plain or a merkle-batched signature. Verified
+  // batch digests are cached, so all the requests of a batch cost a single signature verification.
+  bool verifyClientRequestSig(
+      PrincipalId pid, const char* request, size_t requestLength, const char* sig, uint16_t sigLength) const;
+  // Same as above, but first looks up the request in the cache of verified requests, and adds it there if verified.
+  // A request that was verified when it arrived from the client costs only a digest when it arrives again inside a
+  // PrePrepare.
+  bool verifyClientRequestSig(PrincipalId pid,
+                              ReqId reqSeqNum,
+                              const char* request,
+                              size_t requestLength,
+                              const char* sig,
+                              uint16_t sigLength) const;
+  // Verifies the signature of a replica on a pre-execution result hash, which can be a plain signature, or a
+  // merkle-batched one over the result hashes of a batch of pre-processed requests. Verified batch digests are cached
+  // as for client requests. A batched signature grows with the batch, so its length is not bounded by a plain one.
+  bool verifyReplicaResultSig(
+      PrincipalId pid, const char* resultHash, size_t resultHashLength, const char* sig, size_t sigLength) const;
+  // Called once a client request is committed, as it is not going to be verified again.
+  void onClientRequestCommitted(PrincipalId pid, ReqId reqSeqNum) const { verifiedRequests_.erase(pid, reqSeqNum); }
   void sign(const char* data, size_t dataLength, char* outSig, uint16_t outSigLength) const;
   uint16_t getMySigLength() const;
   bool isClientTransactionSigningEnabled() { return clientTransactionSigningEnabled_; }
@@ -74,8 +103,8 @@ class SigManager {
 
   std::string getClientsPublicKeys();
   std::string getPublicKeyOfVerifier(uint32_t id) const {
-    if (!verifiers_.count(id)) return std::string();
-    return verifiers_.at(id)->getPubKey();
+    auto verifier = getVerifier(id);
+    return verifier ? verifier->getPubKey() : std::string();
   }
   std::string getSelfPrivKey() const { return mySigner_->getPrivKey(); }
 
@@ -98,9 +127,31 @@ class SigManager {
                               concord::util::crypto::KeyFormat clientsKeysFormat,
                               ReplicasInfo& replicasInfo);
 
+  // Lookups of verifiers don't take mutex_, as they are done for every verified signature by many threads at once.
+  // The returned reference keeps the verifier alive even if the key of pid is rotated meanwhile.
+  std::shared_ptr<const concord::util::crypto::IVerifier> getVerifier(uint32_t pid) const {
+    return pid < numVerifierSlots_ ? std::atomic_load_explicit(&verifierSlots_[pid], std::memory_order_acquire)
+                                   : nullptr;
+  }
+  // Verifies a plain or a merkle-batched signature of pid on data. verificationsSaved is incremented when the batch
+  // digest is found in the cache.
+  bool verifyBatchedSig(PrincipalId pid,
+                        const char* data,
+                        size_t dataLength,
+                        const char* sig,
+                        size_t sigLength,
+                        AtomicCounterHandle& verificationsSaved) const;
+  // Publishes the verifier of a principal, which replaces its previous verifier. Called with mutex_ held.
+  void setVerifier(PrincipalId pid, std::shared_ptr<concord::util::crypto::IVerifier> verifier);
+
   const PrincipalId myId_;
   std::unique_ptr<concord::util::crypto::ISigner> mySigner_;
+  // Owners of the verifiers, guarded by mutex_.
   std::map<PrincipalId, std::shared_ptr<concord::util::crypto::IVerifier>> verifiers_;
+  // Verifiers indexed by principal id, only accessed with the atomic shared_ptr operations. A slot is replaced when a
+  // key is rotated, and the replaced verifier is freed once the last reader that loaded it is done with it.
+  std::unique_ptr<std::shared_ptr<const concord::util::crypto::IVerifier>[]> verifierSlots_;
+  size_t numVerifierSlots_ = 0;
   bool clientTransactionSigningEnabled_ = true;
   ReplicasInfo& replicasInfo_;
 
@@ -112,11 +163,25 @@ class SigManager {
     AtomicCounterHandle replicaSigVerified_;
 
     AtomicCounterHandle sigVerificationFailedOnUnrecognizedParticipantId_;
+
+    AtomicCounterHandle externalClientBatchSigVerificationsSaved_;
+    AtomicCounterHandle replicaBatchSigVerificationsSaved_;
+
+    AtomicCounterHandle verifiedRequestsCacheHits_;
+    AtomicCounterHandle verifiedRequestsCacheMisses_;
   };
 
   mutable concordMetrics::Component metrics_component_;
   mutable Metrics metrics_;
   mutable std::shared_mutex mutex_;
+
+  // Batch digests of merkle-batched client and replica signatures that were verified, in insertion order for eviction.
+  static constexpr size_t verifiedBatchDigestsCacheSize = 1024;
+  mutable std::mutex verifiedBatchDigestsLock_;
+  mutable std::set<std::pair<PrincipalId, std::string>> verifiedBatchDigests_;
+  mutable std::deque<std::pair<PrincipalId, std::string>> verifiedBatchDigestsOrder_;
+
+  mutable VerifiedRequestsCache verifiedRequests_;
   // These methods bypass the singelton, and can be used (STRICTLY) for testing.
   // Define the below flag in order to use them in your test.
 #ifdef CONCORD_BFT_TESTING
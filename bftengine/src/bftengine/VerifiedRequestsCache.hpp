@@ -0,0 +1,127 @@
+// Concord
+//
+// Copyright (c) 2022 VMware, Inc. All Rights Reserved.
+//
+// This product is licensed to you under the Apache 2.0 license (the "License").  You may not use this product except in
+// compliance with the Apache 2.0 License.
+//
+// This product may include a number of subcomponents with separate copyright notices and license terms. Your use of
+// these subcomponents is subject to the terms and conditions of the subcomponent's license, as noted in the LICENSE
+// file.
+
+#pragma once
+
+#include "PrimitiveTypes.hpp"
+#include "assertUtils.hpp"
+#include "sha_hash.hpp"
+
+#include <array>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace bftEngine::impl {
+
+// Client requests whose signature was successfully verified.
+//
+// A request is identified by (client id, request sequence number) and its digest, which covers the request and its
+// signature, so a different request with the same sequence number is never considered verified. A replica sees most
+// requests twice - directly from the client and inside the PrePrepare of the primary - and the second time can be a
+// hash lookup instead of a signature verification. Entries are erased once the request is committed.
+//
+// The cache is split into shards by client id, each with its own lock and a bounded number of entries. When a shard is
+// full, its oldest entry is evicted.
+class VerifiedRequestsCache {
+ public:
+  using Digest = concord::util::SHA2_256::Digest;
+
+  static constexpr size_t kNumShards = 16;
+
+  explicit VerifiedRequestsCache(size_t capacityPerShard = 1024) : capacityPerShard_{capacityPerShard} {
+    ConcordAssertGT(capacityPerShard_, 0);
+  }
+
+  static Digest digestOf(const char* request, size_t requestLength, const char* sig, size_t sigLength) {
+    concord::util::SHA2_256 hasher;
+    hasher.init();
+    hasher.update(request, requestLength);
+    hasher.update(sig, sigLength);
+    return hasher.finish();
+  }
+
+  bool contains(PrincipalId clientId, ReqId reqSeqNum, const Digest& digest) const {
+    const auto& shard = shardOf(clientId);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    const auto it = shard.entries.find(Key{clientId, reqSeqNum});
+    return it != shard.entries.end() && it->second.digest == digest;
+  }
+
+  void insert(PrincipalId clientId, ReqId reqSeqNum, const Digest& digest) {
+    auto& shard = shardOf(clientId);
+    const auto key = Key{clientId, reqSeqNum};
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    const auto stamp = ++shard.lastStamp;
+    shard.entries[key] = Entry{digest, stamp};
+    shard.order.emplace_back(key, stamp);
+    // The order queue might hold entries that were already erased; an entry is evicted only if it wasn't re-inserted.
+    while (shard.order.size() > capacityPerShard_) {
+      const auto& [oldKey, oldStamp] = shard.order.front();
+      const auto it = shard.entries.find(oldKey);
+      if (it != shard.entries.end() && it->second.stamp == oldStamp) shard.entries.erase(it);
+      shard.order.pop_front();
+    }
+  }
+
+  void erase(PrincipalId clientId, ReqId reqSeqNum) {
+    auto& shard = shardOf(clientId);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.entries.erase(Key{clientId, reqSeqNum});
+  }
+
+  void clear(PrincipalId clientId) {
+    auto& shard = shardOf(clientId);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    for (auto it = shard.entries.begin(); it != shard.entries.end();) {
+      it = (it->first.first == clientId) ? shard.entries.erase(it) : std::next(it);
+    }
+  }
+
+  size_t size() const {
+    size_t total = 0;
+    for (const auto& shard : shards_) {
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      total += shard.entries.size();
+    }
+    return total;
+  }
+
+ private:
+  using Key = std::pair<PrincipalId, ReqId>;
+
+  struct KeyHash {
+    size_t operator()(const Key& key) const { return std::hash<ReqId>{}(key.second) ^ (size_t{key.first} << 48); }
+  };
+
+  struct Entry {
+    Digest digest;
+    uint64_t stamp;
+  };
+
+  struct Shard {
+    mutable std::mutex mutex;
+    std::unordered_map<Key, Entry, KeyHash> entries;
+    std::deque<std::pair<Key, uint64_t>> order;
+    uint64_t lastStamp{0};
+  };
+
+  Shard& shardOf(PrincipalId clientId) { return shards_[clientId % kNumShards]; }
+  const Shard& shardOf(PrincipalId clientId) const { return shards_[clientId % kNumShards]; }
+
+  const size_t capacityPerShard_;
+  std::array<Shard, kNumShards> shards_;
+};
+
+}  // namespace bftEngine::impl
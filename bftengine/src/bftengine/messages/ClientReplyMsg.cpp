@@ -10,9 +10,13 @@
 // file.
 
 #include <string.h>
+#include <algorithm>
 #include "ClientReplyMsg.hpp"
 #include "assertUtils.hpp"
 #include "ReplicaConfig.hpp"
+#include "sha_hash.hpp"
+#include "SigManager.hpp"
+#include "SharedTypes.hpp"
 
 namespace bftEngine {
 namespace impl {
@@ -68,6 +72,49 @@ void ClientReplyMsg::validate(const ReplicasInfo&) const {
   // TODO(GG): the client should make sure that the message was actually sent by a valid replica
 }
 
+std::unique_ptr<ClientReplyMsg> ClientReplyMsg::createDigestReply() const {
+  const auto rsiLength = b()->replicaSpecificInfoLength;
+  const auto commonLength = replyLength() - rsiLength;
+  const auto digest = concord::util::SHA2_256{}.digest(replyBuf(), commonLength);
+  static_assert(std::tuple_size<decltype(digest)>::value == REPLY_DIGEST_LENGTH, "");
+
+  auto r = std::make_unique<ClientReplyMsg>(senderId(), REPLY_DIGEST_LENGTH + rsiLength, b()->result);
+  memcpy(r->replyBuf(), digest.data(), REPLY_DIGEST_LENGTH);
+  memcpy(r->replyBuf() + REPLY_DIGEST_LENGTH, replyBuf() + commonLength, rsiLength);
+  r->b()->msgType = REPLY_DIGEST_MSG_TYPE;
+  r->b()->reqSeqNum = reqSeqNum();
+  r->setPrimaryId(currentPrimaryId());
+  r->setReplicaSpecificInfoLength(rsiLength);
+  return r;
+}
+
+std::unique_ptr<ClientReplyMsg> ClientReplyMsg::createBusyReply(ReplicaId replicaId,
+                                                               ReplicaId primaryId,
+                                                               NodeIdType clientId,
+                                                               ReqId reqSeqNum,
+                                                               std::chrono::milliseconds retryAfter) {
+  const ClientBusyReplySignedData signedData{REPLY_BUSY_MSG_TYPE,
+                                             replicaId,
+                                             clientId,
+                                             reqSeqNum,
+                                             static_cast<uint32_t>(std::min<int64_t>(retryAfter.count(), UINT32_MAX))};
+  const auto* sigManager = SigManager::instance();
+  const auto sigLength = sigManager->getMySigLength();
+
+  const uint32_t replyLength = sizeof(signedData.retryAfterMilli) + sigLength;
+  auto r = std::make_unique<ClientReplyMsg>(replicaId, replyLength, static_cast<uint32_t>(OperationResult::OVERLOADED));
+  memcpy(r->replyBuf(), &signedData.retryAfterMilli, sizeof(signedData.retryAfterMilli));
+  sigManager->sign(reinterpret_cast<const char*>(&signedData),
+                   sizeof(signedData),
+                   r->replyBuf() + sizeof(signedData.retryAfterMilli),
+                   sigLength);
+  r->b()->msgType = REPLY_BUSY_MSG_TYPE;
+  r->b()->reqSeqNum = reqSeqNum;
+  r->setPrimaryId(primaryId);
+  r->setReplicaSpecificInfoLength(sigLength);
+  return r;
+}
+
 uint64_t ClientReplyMsg::debugHash() const {
   uint64_t retVal = 0;
 
@@ -11,6 +11,9 @@
 
 #pragma once
 
+#include <chrono>
+#include <memory>
+
 #include "MessageBase.hpp"
 #include "ClientMsgs.hpp"
 
@@ -54,6 +57,16 @@ class ClientReplyMsg : public MessageBase {
 
   uint64_t debugHash() const;
 
+  // Create a REPLY_DIGEST_MSG_TYPE copy of this reply, in which the common reply data is replaced by its digest.
+  std::unique_ptr<ClientReplyMsg> createDigestReply() const;
+
+  // Create a REPLY_BUSY_MSG_TYPE reply, signed by this replica, that asks the client to retry after retryAfter.
+  static std::unique_ptr<ClientReplyMsg> createBusyReply(ReplicaId replicaId,
+                                                         ReplicaId primaryId,
+                                                         NodeIdType clientId,
+                                                         ReqId reqSeqNum,
+                                                         std::chrono::milliseconds retryAfter);
+
   void validate(const ReplicasInfo&) const override;
 
   void setMsgSize(MsgSize size) { MessageBase::setMsgSize(size); }
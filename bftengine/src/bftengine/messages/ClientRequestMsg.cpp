@@ -111,8 +111,9 @@ void ClientRequestMsg::validateImp(const ReplicasInfo& repInfo) const {
   PrincipalId clientId = header->idOfClientProxy;
   if ((header->flags & RECONFIG_FLAG) == 0) ConcordAssert(this->senderId() != repInfo.myId());
 
-  /// to do - should it be just the header?
-  auto minMsgSize = sizeof(ClientRequestMsgHeader) + header->cidLength + spanContextSize() + header->reqSignatureLength;
+  // Everything up to the end of the signature, which is parsed below before the exact size is known
+  auto minMsgSize = sizeof(ClientRequestMsgHeader) + spanContextSize() + uint64_t{header->requestLength} +
+                    header->cidLength + header->reqSignatureLength;
   if (msgSize < minMsgSize) {
     msg << "Invalid msgSize: " << KVLOG(msgSize, minMsgSize);
     LOG_WARN(CNSUS, msg.str());
@@ -153,7 +154,9 @@ void ClientRequestMsg::validateImp(const ReplicasInfo& repInfo) const {
       if (emptyReq) {
         expectedSigLen = 0;
       } else {
-        expectedSigLen = sigManager->getSigLength(clientId);
+        // Either the client's signature length or the length of a merkle-batched signature.
+        expectedSigLen =
+            sigManager->getClientRequestSigLength(clientId, requestSignature(), header->reqSignatureLength);
         if (0 == expectedSigLen) {
           msg << "Invalid expectedSigLen" << KVLOG(clientId, this->senderId());
           LOG_ERROR(GL, msg.str());
@@ -195,8 +198,12 @@ void ClientRequestMsg::validateImp(const ReplicasInfo& repInfo) const {
     throw std::runtime_error(msg.str());
   }
   if (doSigVerify) {
-    if (!sigManager->verifySig(
-            clientId, requestBuf(), header->requestLength, requestSignature(), header->reqSignatureLength)) {
+    if (!sigManager->verifyClientRequestSig(clientId,
+                                            header->reqSeqNum,
+                                            requestBuf(),
+                                            header->requestLength,
+                                            requestSignature(),
+                                            header->reqSignatureLength)) {
       std::stringstream msg;
       LOG_WARN(CNSUS, "Signature verification failed for" << KVLOG(header->reqSeqNum, this->senderId(), clientId));
       msg << "Signature verification failed for: "
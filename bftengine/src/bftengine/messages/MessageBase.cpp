@@ -49,11 +49,22 @@ MessageBase::~MessageBase() {
 #ifdef DEBUG_MEMORY_MSG
   liveMessagesDebug.erase(this);
 #endif
-  if (owner_) std::free((char *)msgBody_);
+  if (owner_) storageDeleter_(msgBody_);
+}
+
+void MessageBase::moveToMallocStorage() {
+  ConcordAssert(owner_);
+  if (storageDeleter_ == std::free) return;
+  auto *body = static_cast<MessageBase::Header *>(std::malloc(storageSize_));
+  memcpy(body, msgBody_, msgSize_);
+  storageDeleter_(msgBody_);
+  msgBody_ = body;
+  storageDeleter_ = std::free;
 }
 
 void MessageBase::shrinkToFit() {
   ConcordAssert(owner_);
+  moveToMallocStorage();
 
   // TODO(GG): need to verify more conditions??
 
@@ -68,6 +79,7 @@ void MessageBase::shrinkToFit() {
 bool MessageBase::reallocSize(uint32_t size) {
   ConcordAssert(owner_);
   ConcordAssert(size >= msgSize_);
+  moveToMallocStorage();
 
   void *p = (void *)msgBody_;
   p = std::realloc(p, size);
@@ -125,6 +137,11 @@ MessageBase::MessageBase(NodeIdType sender, MessageBase::Header *body, MsgSize s
 #endif
 }
 
+MessageBase::MessageBase(NodeIdType sender, MessageBase::Header *body, MsgSize size, StorageDeleter deleter)
+    : MessageBase(sender, body, size, true) {
+  storageDeleter_ = deleter;
+}
+
 void MessageBase::validate(const ReplicasInfo &) const {
   LOG_DEBUG(GL, "Calling MessageBase::validate on a message of type " << type());
 }
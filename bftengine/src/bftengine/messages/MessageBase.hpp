@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <cstdlib>
 #include <type_traits>
 #include "OpenTracing.hpp"
 #include "SysConsts.hpp"
@@ -35,6 +36,10 @@ class MessageBase {
 
   static_assert(sizeof(Header) == 6, "MessageBase::Header is 6B");
 
+  // Frees the storage of the message body. Bodies are allocated with std::malloc, unless the message was created with a
+  // different deleter (e.g. for bodies that are buffers of the communication receive buffer pool).
+  using StorageDeleter = void (*)(void *);
+
   explicit MessageBase(NodeIdType sender);
 
   MessageBase(NodeIdType sender, MsgType type, MsgSize size);
@@ -42,10 +47,18 @@ class MessageBase {
 
   MessageBase(NodeIdType sender, Header *body, MsgSize size, bool ownerOfStorage);
 
+  // Takes ownership of a body that has to be freed by `deleter`.
+  MessageBase(NodeIdType sender, Header *body, MsgSize size, StorageDeleter deleter);
+
   void acquireOwnership() { owner_ = true; }
 
   void releaseOwnership() { owner_ = false; }
 
+  StorageDeleter storageDeleter() const { return storageDeleter_; }
+
+  // Moves the body to storage allocated with std::malloc, for code that frees the body with std::free.
+  void moveToMallocStorage();
+
   virtual ~MessageBase();
 
   virtual void validate(const ReplicasInfo &) const;
@@ -102,6 +115,7 @@ class MessageBase {
   NodeIdType sender_;
   // true IFF this instance is not responsible for de-allocating the body:
   bool owner_ = true;
+  StorageDeleter storageDeleter_ = std::free;
   static constexpr uint32_t magicNumOfRawFormat = 0x5555897BU;
 
   template <typename MessageT>
@@ -133,6 +147,7 @@ class MessageBase {
   TrueTypeName(MessageBase *msgBase)                                                                                \
       : MessageBase(                                                                                                \
             msgBase->senderId(), reinterpret_cast<MessageBase::Header *>(msgBase->body()), msgBase->size(), true) { \
+    storageDeleter_ = msgBase->storageDeleter();                                                                    \
     msgBase->releaseOwnership();                                                                                    \
   }
 
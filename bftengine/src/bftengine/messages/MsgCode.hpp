@@ -14,6 +14,8 @@
 #include <cstdint>
 #include <sstream>
 
+#include "communication/TrafficClass.hpp"
+
 namespace bftEngine::impl {
 
 class MsgCode {
@@ -42,6 +44,8 @@ class MsgCode {
     ReplicaAsksToLeaveView,
     ReplicaRestartReady,
     ReplicasRestartReadyProof,
+    PrePrepareDigests,
+    ReplicaMacHandshake,
 
     ClientPreProcessRequest = 500,
     PreProcessRequest,
@@ -125,6 +129,12 @@ inline std::ostream& operator<<(std::ostream& os, const MsgCode::Type& c) {
     case MsgCode::ReplicasRestartReadyProof:
       os << "ReplicasRestartReadyProof";
       break;
+    case MsgCode::PrePrepareDigests:
+      os << "PrePrepareDigests";
+      break;
+    case MsgCode::ReplicaMacHandshake:
+      os << "ReplicaMacHandshake";
+      break;
     case MsgCode::ClientPreProcessRequest:
       os << "ClientPreProcessRequest";
       break;
@@ -146,4 +156,25 @@ inline std::ostream& operator<<(std::ostream& os, const MsgCode::Type& c) {
   return os;
 }
 
+// Messages are queued for sending and for handling by their traffic class. Client requests and their pre-execution are
+// served after the consensus messages, and state transfer after both.
+inline bft::communication::TrafficClass trafficClassOf(uint16_t msgType) {
+  switch (msgType) {
+    case MsgCode::StateTransfer:
+      return bft::communication::TrafficClass::StateTransfer;
+    case MsgCode::ClientPreProcessRequest:
+    case MsgCode::PreProcessRequest:
+    case MsgCode::PreProcessReply:
+    case MsgCode::PreProcessBatchRequest:
+    case MsgCode::PreProcessBatchReply:
+    case MsgCode::PreProcessResult:
+    case MsgCode::ClientRequest:
+    case MsgCode::ClientBatchRequest:
+    case MsgCode::ClientReply:
+      return bft::communication::TrafficClass::Client;
+    default:
+      return bft::communication::TrafficClass::Consensus;
+  }
+}
+
 }  // namespace bftEngine::impl
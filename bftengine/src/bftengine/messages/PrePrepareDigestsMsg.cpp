@@ -0,0 +1,111 @@
+// Concord
+//
+// Copyright (c) 2022 VMware, Inc. All Rights Reserved.
+//
+// This product is licensed to you under the Apache 2.0 license (the "License"). You may not use this product except in
+// compliance with the Apache 2.0 License.
+//
+// This product may include a number of subcomponents with separate copyright notices and license terms. Your use of
+// these subcomponents is subject to the terms and conditions of the subcomponent's license, as noted in the LICENSE
+// file.
+
+#include <cstring>
+#include "PrePrepareDigestsMsg.hpp"
+#include "PrePrepareMsg.hpp"
+#include "ClientRequestMsg.hpp"
+#include "assertUtils.hpp"
+#include "EpochManager.hpp"
+
+namespace bftEngine {
+namespace impl {
+
+using concord::util::digest::DigestUtil;
+
+namespace {
+Digest digestOf(const ClientRequestMsg& req) {
+  Digest digest;
+  DigestUtil::compute(req.body(), req.size(), reinterpret_cast<char*>(&digest), sizeof(Digest));
+  return digest;
+}
+}  // namespace
+
+PrePrepareDigestsMsg::PrePrepareDigestsMsg(const PrePrepareMsg& pp)
+    : MessageBase(pp.senderId(),
+                  MsgCode::PrePrepareDigests,
+                  pp.spanContextSize(),
+                  sizeof(Header) + pp.b()->batchCidLength + pp.numberOfRequests() * sizeof(RequestRef)) {
+  b()->viewNum = pp.b()->viewNum;
+  b()->seqNum = pp.b()->seqNum;
+  b()->epochNum = pp.b()->epochNum;
+  b()->flags = pp.b()->flags;
+  b()->batchCidLength = pp.b()->batchCidLength;
+  b()->time = pp.b()->time;
+  b()->digestOfRequests = pp.b()->digestOfRequests;
+  b()->numberOfRequests = pp.numberOfRequests();
+
+  // The span context and the batch cid follow the header in both messages
+  std::memcpy(body() + sizeof(Header), pp.body() + sizeof(PrePrepareMsg::Header), requestRefsShift() - sizeof(Header));
+
+  char* position = body() + requestRefsShift();
+  RequestsIterator it(&pp);
+  char* requestBody = nullptr;
+  while (it.getAndGoToNext(requestBody)) {
+    ClientRequestMsg req(reinterpret_cast<ClientRequestMsgHeader*>(requestBody));
+    const RequestRef ref{req.clientProxyId(), req.requestSeqNum(), req.size(), digestOf(req)};
+    std::memcpy(position, &ref, sizeof(RequestRef));
+    position += sizeof(RequestRef);
+  }
+}
+
+bool PrePrepareDigestsMsg::refersTo(const RequestRef& ref, const ClientRequestMsg& req) {
+  return req.clientProxyId() == ref.clientId && req.requestSeqNum() == ref.reqSeqNum &&
+         req.size() == ref.requestSize && digestOf(req) == ref.digest;
+}
+
+PrePrepareDigestsMsg::RequestRef PrePrepareDigestsMsg::requestRef(uint16_t index) const {
+  ConcordAssertLT(index, numberOfRequests());
+  // Packed, so aligned to a byte
+  return *reinterpret_cast<const RequestRef*>(body() + requestRefsShift() + index * sizeof(RequestRef));
+}
+
+PrePrepareMsg* PrePrepareDigestsMsg::rebuild(const std::vector<const ClientRequestMsg*>& requests) const {
+  ConcordAssertEQ(requests.size(), numberOfRequests());
+  size_t requestsSize = 0;
+  for (const auto* req : requests) requestsSize += req->size();
+
+  const std::string batchCid(body() + sizeof(Header) + spanContextSize(), b()->batchCidLength);
+  auto* pp = new PrePrepareMsg(senderId(),
+                               b()->viewNum,
+                               b()->seqNum,
+                               CommitPath::SLOW,
+                               spanContext<PrePrepareDigestsMsg>(),
+                               batchCid,
+                               requestsSize);
+  for (const auto* req : requests) pp->addRequest(req->body(), req->size());
+
+  // As PrePrepareMsg::finishAddingRequests(), but with the primary's flags, time and digest of requests
+  pp->b()->epochNum = b()->epochNum;
+  pp->b()->flags = b()->flags;
+  pp->b()->time = b()->time;
+  pp->b()->digestOfRequests = b()->digestOfRequests;
+  pp->setMsgSize(pp->b()->endLocationOfLastRequest);
+  pp->shrinkToFit();
+  return pp;
+}
+
+void PrePrepareDigestsMsg::validate(const ReplicasInfo& repInfo) const {
+  if (size() < sizeof(Header) + spanContextSize() || b()->epochNum != EpochManager::instance().getSelfEpochNumber() ||
+      repInfo.primaryOfView(viewNumber()) != senderId())
+    throw std::runtime_error(__PRETTY_FUNCTION__ + std::string(": basic"));
+
+  // As the flags of a PrePrepareMsg: non-null, ready, a valid first path and no reserved bits
+  const uint16_t flags = b()->flags;
+  const uint64_t expectedSize = uint64_t{sizeof(Header)} + spanContextSize() + b()->batchCidLength +
+                                uint64_t{b()->numberOfRequests} * sizeof(RequestRef);
+  if (b()->seqNum == 0 || (flags & 0x3) != 0x3 || ((flags >> 2) & 0x3) >= 3 || (flags >> 4) != 0 ||
+      b()->numberOfRequests == 0 || size() != expectedSize)
+    throw std::runtime_error(__PRETTY_FUNCTION__ + std::string(": advanced"));
+}
+
+}  // namespace impl
+}  // namespace bftEngine
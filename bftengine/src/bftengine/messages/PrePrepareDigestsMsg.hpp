@@ -0,0 +1,98 @@
+// Concord
+//
+// Copyright (c) 2022 VMware, Inc. All Rights Reserved.
+//
+// This product is licensed to you under the Apache 2.0 license (the "License"). You may not use this product except in
+// compliance with the Apache 2.0 License.
+//
+// This product may include a number of subcomponents with separate copyright notices and license terms. Your use of
+// these subcomponents is subject to the terms and conditions of the subcomponent's license, as noted in the LICENSE
+// file.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "PrimitiveTypes.hpp"
+#include "Digest.hpp"
+#include "MessageBase.hpp"
+#include "ReplicaConfig.hpp"
+
+using concord::util::digest::Digest;
+
+namespace bftEngine {
+namespace impl {
+class PrePrepareMsg;
+class ClientRequestMsg;
+
+// A PrePrepare that references its client requests instead of carrying them. Clients send their requests to all the
+// replicas, so a replica rebuilds the PrePrepare from the requests it already has, and asks the primary for the full
+// PrePrepare with a ReqMissingDataMsg if it misses any of them, or has another request under the same reference. The
+// rebuilt PrePrepare keeps the primary's digest of requests, so it is validated like the one that the primary built.
+class PrePrepareDigestsMsg : public MessageBase {
+ public:
+#pragma pack(push, 1)
+  struct RequestRef {
+    NodeIdType clientId;
+    ReqId reqSeqNum;
+    uint32_t requestSize;
+    Digest digest;
+  };
+#pragma pack(pop)
+  static_assert(sizeof(RequestRef) == (2 + 8 + 4 + DIGEST_SIZE), "RequestRef is 46B");
+
+  // If req is the request that ref references
+  static bool refersTo(const RequestRef& ref, const ClientRequestMsg& req);
+
+  // pp should be ready, and hold client requests only
+  explicit PrePrepareDigestsMsg(const PrePrepareMsg& pp);
+
+  BFTENGINE_GEN_CONSTRUCT_FROM_BASE_MESSAGE(PrePrepareDigestsMsg)
+
+  ViewNum viewNumber() const { return b()->viewNum; }
+
+  SeqNum seqNumber() const { return b()->seqNum; }
+
+  uint16_t numberOfRequests() const { return b()->numberOfRequests; }
+
+  RequestRef requestRef(uint16_t index) const;
+
+  // The PrePrepare of the primary, with the given requests in the order of their references. The caller owns it.
+  PrePrepareMsg* rebuild(const std::vector<const ClientRequestMsg*>& requests) const;
+
+  void validate(const ReplicasInfo&) const override;
+
+ protected:
+  template <typename MessageT>
+  friend size_t sizeOfHeader();
+
+#pragma pack(push, 1)
+  // The fields of the PrePrepare header. Followed by the span context, the batch cid and the request references.
+  struct Header {
+    MessageBase::Header header;
+    ViewNum viewNum;
+    SeqNum seqNum;
+    EpochNum epochNum;
+    uint16_t flags;
+    uint64_t batchCidLength;
+    int64_t time;
+    Digest digestOfRequests;
+    uint16_t numberOfRequests;
+  };
+#pragma pack(pop)
+  static_assert(sizeof(Header) == (6 + 8 + 8 + 8 + 2 + 8 + 8 + DIGEST_SIZE + 2), "Header is 82B");
+
+  uint32_t requestRefsShift() const { return sizeof(Header) + spanContextSize() + b()->batchCidLength; }
+
+  Header* b() const { return (Header*)msgBody_; }
+};
+
+template <>
+inline MsgSize maxMessageSize<PrePrepareDigestsMsg>() {
+  return ReplicaConfig::instance().getmaxExternalMessageSize();
+}
+
+}  // namespace impl
+}  // namespace bftEngine
@@ -9,6 +9,7 @@
 // these subcomponents is subject to the terms and conditions of the subcomponent's license, as noted in the LICENSE
 // file.
 
+#include <algorithm>
 #include <utility>
 #include <bftengine/ClientMsgs.hpp>
 #include "OpenTracing.hpp"
@@ -35,8 +36,13 @@ static Digest nullDigest(0x18);
 const Digest& PrePrepareMsg::digestOfNullPrePrepareMsg() { return nullDigest; }
 
 void PrePrepareMsg::calculateDigestOfRequests(Digest& digest) const {
+  // Unsigned requests are hashed in chunks of this many per thread pool task, with DigestUtil::computeBatch
+  constexpr size_t REQUESTS_PER_DIGEST_TASK = 8;
+
   std::vector<std::pair<char*, size_t>> sigOrDigestOfRequest(b()->numberOfRequests, std::make_pair(nullptr, 0));
-  auto digestBuffer = std::make_unique<char[]>(b()->numberOfRequests * sizeof(Digest));
+  std::vector<const char*> unsignedRequests;
+  std::vector<size_t> unsignedRequestLengths;
+  std::vector<size_t> unsignedRequestIds;
 
   std::vector<std::future<void>> tasks;
   auto it = RequestsIterator(this);
@@ -56,21 +62,28 @@ void PrePrepareMsg::calculateDigestOfRequests(Digest& digest) const {
         sigOrDigestOfRequest[local_id].first = sig;
         sigOrDigestOfRequest[local_id].second = req.requestSignatureLength();
       } else {
-        tasks.push_back(threadPool.async(
-            [&sigOrDigestOfRequest, &digestBuffer, local_id](auto* request, auto requestLength) {
-              DigestUtil::compute(
-                  request, requestLength, digestBuffer.get() + local_id * sizeof(Digest), sizeof(Digest));
-              sigOrDigestOfRequest[local_id].first = digestBuffer.get() + local_id * sizeof(Digest);
-              sigOrDigestOfRequest[local_id].second = sizeof(Digest);
-            },
-            req.body(),
-            req.size()));
+        unsignedRequests.push_back(req.body());
+        unsignedRequestLengths.push_back(req.size());
+        unsignedRequestIds.push_back(local_id);
       }
       local_id++;
     }
+
+    std::vector<Digest> digests(unsignedRequests.size());
+    for (size_t first = 0; first < unsignedRequests.size(); first += REQUESTS_PER_DIGEST_TASK) {
+      const size_t count = std::min(REQUESTS_PER_DIGEST_TASK, unsignedRequests.size() - first);
+      tasks.push_back(threadPool.async([&unsignedRequests, &unsignedRequestLengths, &digests, first, count]() {
+        DigestUtil::computeBatch(
+            unsignedRequests.data() + first, unsignedRequestLengths.data() + first, count, digests.data() + first);
+      }));
+    }
     for (const auto& t : tasks) {
       t.wait();
     }
+    for (size_t i = 0; i < digests.size(); ++i) {
+      sigOrDigestOfRequest[unsignedRequestIds[i]].first = digests[i].getForUpdate();
+      sigOrDigestOfRequest[unsignedRequestIds[i]].second = sizeof(Digest);
+    }
 
     std::string sigOrDig;
     for (const auto& sod : sigOrDigestOfRequest) {
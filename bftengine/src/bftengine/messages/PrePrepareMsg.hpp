@@ -132,6 +132,7 @@ class PrePrepareMsg : public MessageBase {
 
   uint32_t payloadShift() const;
   friend class RequestsIterator;
+  friend class PrePrepareDigestsMsg;
 };
 
 class RequestsIterator {
@@ -0,0 +1,160 @@
+// Concord
+//
+// Copyright (c) 2022 VMware, Inc. All Rights Reserved.
+//
+// This product is licensed to you under the Apache 2.0 license (the "License"). You may not use this product except in
+// compliance with the Apache 2.0 License.
+//
+// This product may include a number of subcomponents with separate copyright notices and license terms. Your use of
+// these subcomponents is subject to the terms and conditions of the sub-component's license, as noted in the LICENSE
+// file.
+
+#include "ConflictScheduler.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace preprocessor {
+
+using namespace std;
+
+namespace {
+
+void sortAndDedup(vector<string>& keys) {
+  sort(keys.begin(), keys.end());
+  keys.erase(unique(keys.begin(), keys.end()), keys.end());
+}
+
+// Both sorted
+bool intersect(const vector<string>& lhs, const vector<string>& rhs) {
+  auto l = lhs.cbegin();
+  auto r = rhs.cbegin();
+  while (l != lhs.cend() && r != rhs.cend()) {
+    if (*l < *r) {
+      ++l;
+    } else if (*r < *l) {
+      ++r;
+    } else {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
+bool ConflictScheduler::conflict(const KeySets& lhs, const KeySets& rhs) {
+  return intersect(lhs.writeKeys, rhs.writeKeys) || intersect(lhs.writeKeys, rhs.readKeys) ||
+         intersect(lhs.readKeys, rhs.writeKeys);
+}
+
+bool ConflictScheduler::conflictsWithEarlier(RequestId id,
+                                             const string& batchCid,
+                                             const KeySets& keySets,
+                                             list<Waiting>::const_iterator end) const {
+  for (const auto& [inFlightId, inFlight] : inFlight_) {
+    const bool sameBatch = inFlightId.first == id.first && inFlight.batchCid == batchCid;
+    if ((inFlight.preExecuting || !sameBatch) && conflict(keySets, inFlight.keySets)) return true;
+  }
+  for (auto it = waiting_.cbegin(); it != end; ++it) {
+    if (conflict(keySets, it->keySets)) return true;
+  }
+  return false;
+}
+
+bool ConflictScheduler::schedule(RequestId id, const string& batchCid, KeySets keySets, const Start& start) {
+  sortAndDedup(keySets.readKeys);
+  sortAndDedup(keySets.writeKeys);
+  {
+    lock_guard<mutex> lock(lock_);
+    if (!inFlight_.count(id)) {
+      if (conflictsWithEarlier(id, batchCid, keySets, waiting_.cend())) {
+        waiting_.push_back(Waiting{id, batchCid, move(keySets), start});
+        return false;
+      }
+      inFlight_.emplace(id, InFlight{batchCid, move(keySets), chrono::steady_clock::now()});
+    }
+  }
+  start(true);
+  return true;
+}
+
+vector<ConflictScheduler::Start> ConflictScheduler::startWaiting() {
+  vector<Start> started;
+  // In arrival order, as a request still waits for the earlier ones it conflicts with
+  for (auto it = waiting_.begin(); it != waiting_.end();) {
+    if (conflictsWithEarlier(it->id, it->batchCid, it->keySets, it)) {
+      ++it;
+      continue;
+    }
+    inFlight_.emplace(it->id, InFlight{move(it->batchCid), move(it->keySets), chrono::steady_clock::now()});
+    started.push_back(move(it->start));
+    it = waiting_.erase(it);
+  }
+  return started;
+}
+
+void ConflictScheduler::release(RequestId id) {
+  vector<Start> dropped;
+  vector<Start> started;
+  {
+    lock_guard<mutex> lock(lock_);
+    inFlight_.erase(id);
+    for (auto it = waiting_.begin(); it != waiting_.end();) {
+      if (it->id == id) {
+        dropped.push_back(move(it->start));
+        it = waiting_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    started = startWaiting();
+  }
+  // Out of the lock, as starting a request might take other locks
+  for (const auto& start : dropped) start(false);
+  for (const auto& start : started) start(true);
+}
+
+void ConflictScheduler::preExecuted(RequestId id) {
+  vector<Start> started;
+  {
+    lock_guard<mutex> lock(lock_);
+    const auto it = inFlight_.find(id);
+    if (it == inFlight_.end() || !it->second.preExecuting) return;
+    it->second.preExecuting = false;
+    started = startWaiting();
+  }
+  for (const auto& start : started) start(true);
+}
+
+size_t ConflictScheduler::releaseExpired(chrono::milliseconds maxInFlightTime) {
+  size_t numOfExpired = 0;
+  vector<Start> started;
+  {
+    lock_guard<mutex> lock(lock_);
+    const auto now = chrono::steady_clock::now();
+    for (auto it = inFlight_.begin(); it != inFlight_.end();) {
+      if (now - it->second.since > maxInFlightTime) {
+        it = inFlight_.erase(it);
+        numOfExpired++;
+      } else {
+        ++it;
+      }
+    }
+    if (numOfExpired) started = startWaiting();
+  }
+  for (const auto& start : started) start(true);
+  return numOfExpired;
+}
+
+size_t ConflictScheduler::numOfInFlight() const {
+  lock_guard<mutex> lock(lock_);
+  return inFlight_.size();
+}
+
+size_t ConflictScheduler::numOfWaiting() const {
+  lock_guard<mutex> lock(lock_);
+  return waiting_.size();
+}
+
+}  // namespace preprocessor
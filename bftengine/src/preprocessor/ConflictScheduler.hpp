@@ -0,0 +1,91 @@
+// Concord
+//
+// Copyright (c) 2022 VMware, Inc. All Rights Reserved.
+//
+// This product is licensed to you under the Apache 2.0 license (the "License"). You may not use this product except in
+// compliance with the Apache 2.0 License.
+//
+// This product may include a number of subcomponents with separate copyright notices and license terms. Your use of
+// these subcomponents is subject to the terms and conditions of the sub-component's license, as noted in the LICENSE
+// file.
+
+#pragma once
+
+#include "IRequestHandler.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace preprocessor {
+
+// Orders the pre-execution of requests by the keys they read and write. A request that is pre-executed while another
+// one that changes its keys is in flight reads a state that is about to change, and is likely to be aborted at
+// execution. Two requests conflict if one of them writes a key that the other one reads or writes.
+// A request that conflicts with an in-flight request, or with an earlier waiting one, waits until they are released,
+// so conflicting requests are pre-executed in arrival order. Requests without key sets are not scheduled at all.
+// A request holds its keys until it is executed, as its pre-execution result is only valid against the state it read
+// until then, or until its pre-execution fails. Against the requests of its own batch, though, it only holds them until
+// its pre-execution finishes: the replies of a batch are sent once all its requests are pre-executed, so its requests
+// can't wait for each other's execution, and conflicting ones are pre-executed in order instead.
+class ConflictScheduler {
+ public:
+  using RequestId = std::pair<uint16_t, uint64_t>;
+  using KeySets = bftEngine::IRequestsHandler::KeySets;
+  // Called with true to start the pre-execution of a request, or with false if the request was released while waiting
+  using Start = std::function<void(bool)>;
+
+  static RequestId requestId(uint16_t clientId, uint64_t reqSeqNum) { return {clientId, reqSeqNum}; }
+
+  // Starts the request and returns true, unless it conflicts. Then the request waits, and is started by the release()
+  // of the last request it conflicts with. A request that is in flight already, like a retry, is started right away.
+  // The requests of a batch are the requests of the same client with the same batchCid.
+  bool schedule(RequestId id, const std::string& batchCid, KeySets keySets, const Start& start);
+  // The pre-execution of an in-flight request finished, so it doesn't hold its keys against its own batch anymore
+  void preExecuted(RequestId id);
+  // The request is not in flight anymore, or is dropped if it is waiting
+  void release(RequestId id);
+  // Releases the requests that have been in flight for longer than maxInFlightTime, e.g. pre-executed requests that the
+  // primary never ordered. Returns their number.
+  size_t releaseExpired(std::chrono::milliseconds maxInFlightTime);
+
+  size_t numOfInFlight() const;
+  size_t numOfWaiting() const;
+
+ private:
+  struct Waiting {
+    RequestId id;
+    std::string batchCid;
+    KeySets keySets;
+    Start start;
+  };
+  struct InFlight {
+    std::string batchCid;
+    KeySets keySets;
+    std::chrono::steady_clock::time_point since;
+    bool preExecuting = true;
+  };
+
+  static bool conflict(const KeySets& lhs, const KeySets& rhs);
+  // Whether the request conflicts with an in-flight request that holds its keys against it, or with a waiting one
+  // before `end`. Called with lock_ held.
+  bool conflictsWithEarlier(RequestId id,
+                            const std::string& batchCid,
+                            const KeySets& keySets,
+                            std::list<Waiting>::const_iterator end) const;
+  // Moves the waiting requests that don't conflict anymore to inFlight_, and returns them to be started. Called with
+  // lock_ held.
+  std::vector<Start> startWaiting();
+
+  mutable std::mutex lock_;
+  std::map<RequestId, InFlight> inFlight_;
+  std::list<Waiting> waiting_;
+};
+
+}  // namespace preprocessor
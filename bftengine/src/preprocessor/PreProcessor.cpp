@@ -12,6 +12,7 @@
 #include "PreProcessor.hpp"
 #include <optional>
 #include "InternalReplicaApi.hpp"
+#include "AdmissionControl.hpp"
 #include "Logger.hpp"
 #include "MsgHandlersRegistrator.hpp"
 #include "OpenTracing.hpp"
@@ -193,6 +194,7 @@ void RequestsBatch::releaseReqsAndSendBatchedReplyIfCompleted(PreProcessReplyMsg
     batchCid = batchCid_;
     batchSize = batchSize_;
     // The last batch request has pre-processed => send batched reply message
+    if (preProcessor_.batchedResultSigningEnabled_) PreProcessReplyMsg::signBatch(repliesList_);
     for (auto const &reply : repliesList_) {
       replyMsgsSize += reply->size();
       reqOffsetsInBatch.emplace_front(reply->reqOffsetInBatch());
@@ -354,6 +356,7 @@ PreProcessor::PreProcessor(shared_ptr<MsgsCommunicator> &msgsCommunicator,
       numOfReplicas_(myReplica.getReplicaConfig().numReplicas + myReplica.getReplicaConfig().numRoReplicas),
       numOfClientProxies_(myReplica.getReplicaConfig().numOfClientProxies),
       clientBatchingEnabled_(myReplica.getReplicaConfig().clientBatchingEnabled),
+      conflictScheduler_(myReplica.getConflictScheduler()),
       memoryPool_(maxExternalMsgSize_, timers),
       metricsComponent_{concordMetrics::Component("preProcessor", std::make_shared<concordMetrics::Aggregator>())},
       metricsLastDumpTime_(0),
@@ -370,7 +373,10 @@ PreProcessor::PreProcessor(shared_ptr<MsgsCommunicator> &msgsCommunicator,
                            metricsComponent_.RegisterCounter("preProcReqRetried"),
                            metricsComponent_.RegisterAtomicGauge("preProcessingTimeAvg", 0),
                            metricsComponent_.RegisterAtomicGauge("launchAsyncPreProcessJobTimeAvg", 0),
-                           metricsComponent_.RegisterAtomicGauge("PreProcInFlyRequestsNum", 0)},
+                           metricsComponent_.RegisterAtomicGauge("PreProcInFlyRequestsNum", 0),
+                           metricsComponent_.RegisterAtomicCounter("preExecReqScheduledByKeys"),
+                           metricsComponent_.RegisterAtomicCounter("preExecReqConflicts"),
+                           metricsComponent_.RegisterAtomicGauge("preExecReqWaitingOnConflicts", 0)},
       metric_pre_exe_duration_{metricsComponent_, "metric_pre_exe_duration_", 10000, 1000, true},
       totalPreProcessingTime_(true),
       launchAsyncJobTimeAvg_(true),
@@ -380,10 +386,13 @@ PreProcessor::PreProcessor(shared_ptr<MsgsCommunicator> &msgsCommunicator,
       launchAsyncPreProcessJobRecorder_{histograms_.launchAsyncPreProcessJob},
       pm_{pm},
       batchedPreProcessEnabled_(myReplica_.getReplicaConfig().batchedPreProcessEnabled),
+      batchedResultSigningEnabled_(PreProcessReplyMsg::batchedSignaturesEnabled()),
       memoryPoolEnabled_(myReplica_.getReplicaConfig().enablePreProcessorMemoryPool) {
+  // The certificate replaces the signatures of the result, which are only sent when the result is authenticated
+  ConcordAssert(!myReplica.getReplicaConfig().preExecutionResultThresholdAuthEnabled ||
+                myReplica.getReplicaConfig().preExecutionResultAuthEnabled);
   clientMaxBatchSize_ = clientBatchingEnabled_ ? myReplica.getReplicaConfig().clientBatchingMaxMsgsNbr : 1,
   registerMsgHandlers();
-  metricsComponent_.Register();
   const uint16_t numOfExternalClients = myReplica.getReplicaConfig().numOfExternalClients;
   const uint16_t numOfReqEntries = numOfExternalClients * clientMaxBatchSize_;
   for (uint16_t i = 0; i < numOfReqEntries; i++) {
@@ -410,6 +419,20 @@ PreProcessor::PreProcessor(shared_ptr<MsgsCommunicator> &msgsCommunicator,
       numOfThreads = myReplica.getReplicaConfig().numOfClientProxies / numOfReplicas_;
   }
   threadPool_.start(numOfThreads);
+  const auto &config = myReplica.getReplicaConfig();
+  if (config.concurrencyControllerEnabled) {
+    concurrencyController_ = make_unique<ConcurrencyController>(
+        "preExecThreadPool",
+        ConcurrencyController::Config{
+            config.preExecMinConcurrencyLevel,
+            config.preExecMaxConcurrencyLevel ? config.preExecMaxConcurrencyLevel : threadPool_.getNumOfThreads(),
+            chrono::microseconds{config.concurrencyControllerTargetQueueWaitMicros},
+            config.concurrencyControllerMaxCpuUtilizationPercent / 100.0},
+        ConcurrencyController::poolOf(threadPool_),
+        metricsComponent_);
+  }
+  // After all the metrics are registered
+  metricsComponent_.Register();
   msgLoopThread_ = std::thread{&PreProcessor::msgProcessingLoop, this};
   LOG_INFO(logger(),
            "PreProcessor initialization:" << KVLOG(numOfReplicas_,
@@ -422,7 +445,10 @@ PreProcessor::PreProcessor(shared_ptr<MsgsCommunicator> &msgsCommunicator,
                                                    maxPreExecResultSize_,
                                                    preExecReqStatusCheckPeriodMilli_,
                                                    numOfThreads,
-                                                   ReplicaConfig::instance().preExecutionResultAuthEnabled));
+                                                   ReplicaConfig::instance().preExecutionResultAuthEnabled,
+                                                   ReplicaConfig::instance().preExecutionResultThresholdAuthEnabled,
+                                                   batchedResultSigningEnabled_,
+                                                   config.preExecConflictAwareSchedulingEnabled));
   RequestProcessingState::init(numOfRequiredReplies(), &histograms_);
   PreProcessReplyMsg::setPreProcessorHistograms(&histograms_);
   addTimers();
@@ -447,10 +473,16 @@ void PreProcessor::addTimers() {
                                             [this](Timers::Handle h) { onRequestsStatusCheckTimer(); });
   metricsTimer_ =
       timers_.add(100ms, Timers::Timer::RECURRING, [this](Timers::Handle h) { updateAggregatorAndDumpMetrics(); });
+  if (concurrencyController_)
+    concurrencyControllerTimer_ =
+        timers_.add(chrono::milliseconds(myReplica_.getReplicaConfig().concurrencyControllerPeriodMs),
+                    Timers::Timer::RECURRING,
+                    [this](Timers::Handle h) { concurrencyController_->tick(); });
 }
 
 void PreProcessor::cancelTimers() {
   timers_.cancel(metricsTimer_);
+  if (concurrencyController_) timers_.cancel(concurrencyControllerTimer_);
   if (preExecReqStatusCheckPeriodMilli_ != 0) {
     timers_.cancel(requestsStatusCheckTimer_);
   }
@@ -500,6 +532,13 @@ void PreProcessor::onRequestsStatusCheckTimer() {
   concord::diagnostics::TimeRecorder scoped_timer(*histograms_.onRequestsStatusCheckTimer);
   // Pass through all ongoing requests and abort the pre-execution for those that are timed out.
   for (auto &batchEntry : ongoingReqBatches_) batchEntry.second->handlePossiblyExpiredRequests();
+  if (conflictScheduler_) {
+    // A pre-processed request that is not executed by then is not going to be ordered in this view
+    const auto numOfExpired =
+        conflictScheduler_->releaseExpired(chrono::milliseconds{myReplica_.getReplicaConfig().viewChangeTimerMillisec});
+    if (numOfExpired) LOG_INFO(logger(), "Released the keys of requests that were not executed" << KVLOG(numOfExpired));
+    preProcessorMetrics_.preExecReqWaitingOnConflicts.Get().Set(conflictScheduler_->numOfWaiting());
+  }
 }
 
 bool PreProcessor::checkClientMsgCorrectness(uint64_t reqSeqNum,
@@ -750,6 +789,11 @@ bool PreProcessor::handleSingleClientRequestMessage(ClientPreProcessReqMsgUnique
       incomingMsgsStorage_->pushExternalMsg(clientMsg->convertToClientRequestMsg(false));
       return false;
     }
+    if (myReplica_.isCurrentPrimary() && turnAwayIfOverloaded(clientId, reqSeqNum, reqCid)) {
+      if (!batchedPreProcessEnabled_ && (senderId != clientId))
+        cancelPreProcessingOnNonPrimary(clientMsg, senderId, reqOffsetInBatch, (reqEntry->reqRetryId)++, batchCid);
+      return false;
+    }
     if (myReplica_.isCurrentPrimary())
       registerSucceeded = registerRequestOnPrimaryReplica(
           batchCid, batchSize, move(clientMsg), preProcessRequestMsg, reqOffsetInBatch, reqEntry);
@@ -1161,6 +1205,13 @@ bool PreProcessor::checkPreProcessBatchReplyMsgCorrectness(const PreProcessBatch
     return false;
   }
 
+  if (preProcessReplyMsgs.size() != batchReply->numOfMessagesInBatch()) {
+    LOG_WARN(logger(),
+             "Ignore malformed PreProcessBatchReplyMsg" << KVLOG(
+                 batchCid, senderId, batchReply->numOfMessagesInBatch(), preProcessReplyMsgs.size()));
+    return false;
+  }
+
   for (const auto &replyMsg : preProcessReplyMsgs) {
     if (!checkPreProcessReplyPrerequisites(
             senderId, batchCid, replyMsg->reqSeqNum(), replyMsg->getCid(), replyMsg->reqOffsetInBatch()) ||
@@ -1356,8 +1407,13 @@ void PreProcessor::finalizePreProcessing(NodeIdType clientId, uint16_t reqOffset
         preProcessResult = static_cast<uint32_t>(OperationResult::UNKNOWN);
       }
       if (ReplicaConfig::instance().preExecutionResultAuthEnabled) {
-        const auto &sigsSet = reqProcessingStatePtr->getPreProcessResultSignatures();
-        auto sigsBuf = PreProcessResultSignature::serializeResultSignatures(sigsSet, numOfRequiredReplies());
+        std::string sigsBuf;
+        if (ReplicaConfig::instance().preExecutionResultThresholdAuthEnabled) {
+          sigsBuf = reqProcessingStatePtr->getPreProcessResultCertificate().serialize();
+        } else {
+          const auto &sigsSet = reqProcessingStatePtr->getPreProcessResultSignatures();
+          sigsBuf = PreProcessResultSignature::serializeResultSignatures(sigsSet, numOfRequiredReplies());
+        }
         preProcessMsg = make_unique<PreProcessResultMsg>(clientId,
                                                          preProcessResult,
                                                          reqSeqNum,
@@ -1443,6 +1499,7 @@ bool PreProcessor::registerRequest(const string &batchCid,
       ongoingReqBatches_[clientId]->registerBatch(senderId, batchCid, batchSize);
   }
   if (!reqEntry->reqProcessingStatePtr) {
+    if (auto *admissionControl = myReplica_.getAdmissionControl()) admissionControl->onPreProcessorRequestStarted();
     reqEntry->reqProcessingStatePtr = make_unique<RequestProcessingState>(myReplicaId_,
                                                                           numOfReplicas_,
                                                                           batchCid,
@@ -1540,10 +1597,32 @@ void PreProcessor::releaseClientPreProcessRequest(const RequestStateSharedPtr &r
     if (!myReplica_.isCurrentPrimary()) {
       preProcessorMetrics_.preProcInFlyRequestsNum--;
     }
+    if (auto *admissionControl = myReplica_.getAdmissionControl()) admissionControl->onPreProcessorRequestReleased();
+    // A pre-processed request holds its keys until the replica executes it
+    if (conflictScheduler_ && result != COMPLETE) {
+      conflictScheduler_->release(ConflictScheduler::requestId(clientId, reqSeqNum));
+      preProcessorMetrics_.preExecReqWaitingOnConflicts.Get().Set(conflictScheduler_->numOfWaiting());
+    }
     if (memoryPoolEnabled_) releasePreProcessResultBuffer(clientId, reqSeqNum, reqOffsetInBatch);
   }
 }
 
+bool PreProcessor::turnAwayIfOverloaded(NodeIdType clientId, ReqId reqSeqNum, const string &reqCid) {
+  auto *admissionControl = myReplica_.getAdmissionControl();
+  if (!admissionControl) return false;
+  const auto retryAfter = admissionControl->admit();
+  if (!retryAfter) return false;
+  LOG_DEBUG(logger(),
+            "Request turned away. Replica is overloaded" << KVLOG(reqSeqNum, reqCid, clientId, retryAfter->count()));
+  preProcessorMetrics_.preProcReqRejected++;
+  if (admissionControl->shouldSendBusyReply(clientId, *retryAfter)) {
+    const auto busyReply =
+        ClientReplyMsg::createBusyReply(myReplicaId_, myReplica_.currentPrimary(), clientId, reqSeqNum, *retryAfter);
+    sendMsg(busyReply->body(), clientId, busyReply->type(), busyReply->size());
+  }
+  return true;
+}
+
 void PreProcessor::sendMsg(char *msg, NodeIdType dest, uint16_t msgType, MsgSize msgSize) {
   int errorCode = msgsCommunicator_->sendAsyncMessage(dest, msg, msgSize);
   if (errorCode != 0) {
@@ -1604,7 +1683,9 @@ bool PreProcessor::registerRequestOnPrimaryReplica(const string &batchCid,
                                         blockId,
                                         myReplica_.getCurrentView(),
                                         clientReqMsg->spanContext<ClientPreProcessReqMsgUniquePtr::element_type>(),
-                                        clientReqMsg->result());
+                                        clientReqMsg->result(),
+                                        // The keys the replicas would commit the next seq num with
+                                        myReplica_.getLastExecutedSeqNum() + 1);
   const auto registerSucceeded =
       registerRequest(batchCid, batchSize, move(clientReqMsg), preProcessRequestMsg, reqOffsetInBatch);
   if (registerSucceeded) {
@@ -1736,6 +1817,33 @@ void PreProcessor::launchAsyncReqPreProcessingJob(const PreProcessRequestMsgShar
                                                isRetry,
                                                std::move(totalPreExecDurationRecorder),
                                                std::move(launchAsyncPreProcessJobRecorder));
+  // A retry is pre-executed by the primary for a request that holds its keys already
+  if (conflictScheduler_ && !isRetry) {
+    auto keySets = requestsHandler_.preExecutionKeySets(
+        preProcessReqMsg->clientId(), preProcessReqMsg->requestBuf(), preProcessReqMsg->requestLength());
+    if (keySets) {
+      preProcessorMetrics_.preExecReqScheduledByKeys++;
+      const bool started = conflictScheduler_->schedule(
+          ConflictScheduler::requestId(preProcessReqMsg->clientId(), preProcessReqMsg->reqSeqNum()),
+          batchCid,
+          std::move(*keySets),
+          [this, preProcessJob](bool start) {
+            if (start) {
+              threadPool_.add(preProcessJob);
+            } else {
+              preProcessJob->release();
+            }
+          });
+      if (!started) {
+        preProcessorMetrics_.preExecReqConflicts++;
+        LOG_DEBUG(logger(),
+                  "Pre-execution waits for conflicting requests"
+                      << KVLOG(batchCid, preProcessReqMsg->reqSeqNum(), preProcessReqMsg->getCid()));
+      }
+      preProcessorMetrics_.preExecReqWaitingOnConflicts.Get().Set(conflictScheduler_->numOfWaiting());
+      return;
+    }
+  }
   threadPool_.add(preProcessJob);
 }
 
@@ -1871,10 +1979,14 @@ void PreProcessor::handleReqPreProcessedByNonPrimary(uint16_t clientId,
                                                      uint64_t reqRetryId,
                                                      uint32_t resBufLen,
                                                      const std::string &reqCid,
-                                                     OperationResult preProcessResult) {
+                                                     OperationResult preProcessResult,
+                                                     SeqNum keySeqNum) {
   concord::diagnostics::TimeRecorder scoped_timer(*histograms_.handlePreProcessedReqByNonPrimary);
   setPreprocessingRightNow(clientId, reqOffsetInBatch, false);
   const auto status = (preProcessResult == OperationResult::SUCCESS) ? STATUS_GOOD : STATUS_FAILED;
+  const auto &batchEntry = ongoingReqBatches_[clientId];
+  const bool batchedReply = batchedPreProcessEnabled_ && batchEntry->isBatchInProcess();
+  // A batched reply is signed together with the rest of the batch, once all of them are ready
   auto replyMsg = make_shared<PreProcessReplyMsg>(myReplicaId_,
                                                   clientId,
                                                   reqOffsetInBatch,
@@ -1885,9 +1997,10 @@ void PreProcessor::handleReqPreProcessedByNonPrimary(uint16_t clientId,
                                                   reqCid,
                                                   status,
                                                   preProcessResult,
-                                                  myReplica_.getCurrentView());
-  const auto &batchEntry = ongoingReqBatches_[clientId];
-  if (batchedPreProcessEnabled_ && batchEntry->isBatchInProcess()) {
+                                                  myReplica_.getCurrentView(),
+                                                  keySeqNum,
+                                                  !(batchedReply && batchedResultSigningEnabled_));
+  if (batchedReply) {
     batchEntry->releaseReqsAndSendBatchedReplyIfCompleted(replyMsg);
   } else {
     releaseReqAndSendReplyMsg(replyMsg);
@@ -1904,6 +2017,9 @@ void PreProcessor::handleReqPreProcessingJob(const PreProcessRequestMsgSharedPtr
   const SeqNum &reqSeqNum = preProcessReqMsg->reqSeqNum();
   uint32_t actualResultBufLen = 0;
   const auto preProcessResult = launchReqPreProcessing(batchCid, preProcessReqMsg, actualResultBufLen);
+  // Lets the conflicting requests of the same batch be pre-executed, as the batch is replied to once all are
+  if (conflictScheduler_ && !isRetry)
+    conflictScheduler_->preExecuted(ConflictScheduler::requestId(clientId, reqSeqNum));
   if (isPrimary && isRetry) {
     handlePreProcessedReqPrimaryRetry(clientId, reqOffsetInBatch, actualResultBufLen, batchCid, preProcessResult);
     return;
@@ -1920,7 +2036,8 @@ void PreProcessor::handleReqPreProcessingJob(const PreProcessRequestMsgSharedPtr
                                       preProcessReqMsg->reqRetryId(),
                                       actualResultBufLen,
                                       preProcessReqMsg->getCid(),
-                                      preProcessResult);
+                                      preProcessResult,
+                                      preProcessReqMsg->keySeqNum());
   }
 }
 
@@ -18,6 +18,8 @@
 #include "MsgsCommunicator.hpp"
 #include "MsgHandlersRegistrator.hpp"
 #include "SimpleThreadPool.hpp"
+#include "ConcurrencyController.hpp"
+#include "ConflictScheduler.hpp"
 #include "IRequestHandler.hpp"
 #include "Replica.hpp"
 #include "RequestProcessingState.hpp"
@@ -250,7 +252,8 @@ class PreProcessor {
                                          uint64_t reqRetryId,
                                          uint32_t resBufLen,
                                          const std::string &reqCid,
-                                         bftEngine::OperationResult preProcessResult);
+                                         bftEngine::OperationResult preProcessResult,
+                                         SeqNum keySeqNum);
   void handleReqPreProcessedByPrimary(const PreProcessRequestMsgSharedPtr &preProcessReqMsg,
                                       const std::string &batchCid,
                                       uint16_t clientId,
@@ -305,6 +308,8 @@ class PreProcessor {
                                            const std::string &batchCid,
                                            const std::string &reqCid);
   void releaseReqAndSendReplyMsg(PreProcessReplyMsgSharedPtr replyMsg);
+  // Returns true, after sending a busy reply to the client, if the admission control of the replica turns it away
+  bool turnAwayIfOverloaded(NodeIdType clientId, ReqId reqSeqNum, const std::string &reqCid);
   bool handlePossiblyExpiredRequest(const RequestStateSharedPtr &reqStateEntry);
 
   static logging::Logger &logger() {
@@ -338,6 +343,11 @@ class PreProcessor {
   const bool clientBatchingEnabled_;
   inline static uint16_t clientMaxBatchSize_ = 0;
   concord::util::SimpleThreadPool threadPool_;
+  // Resizes threadPool_ at runtime, if enabled
+  std::unique_ptr<concord::util::ConcurrencyController> concurrencyController_;
+  // Owned by the replica, which releases the keys of the requests it executes. Set when
+  // preExecConflictAwareSchedulingEnabled.
+  ConflictScheduler *const conflictScheduler_;
   // One-time allocated buffers (one per client) for the pre-execution results storage
   PreProcessResultBuffers preProcessResultBuffers_;
   OngoingReqBatchesMap ongoingReqBatches_;  // clientId -> RequestsBatch
@@ -360,6 +370,9 @@ class PreProcessor {
     concordMetrics::AtomicGaugeHandle preProcessingTimeAvg;
     concordMetrics::AtomicGaugeHandle launchAsyncPreProcessJobTimeAvg;
     concordMetrics::AtomicGaugeHandle preProcInFlyRequestsNum;
+    concordMetrics::AtomicCounterHandle preExecReqScheduledByKeys;
+    concordMetrics::AtomicCounterHandle preExecReqConflicts;
+    concordMetrics::AtomicGaugeHandle preExecReqWaitingOnConflicts;
   } preProcessorMetrics_;
 
   PerfMetric<std::string> metric_pre_exe_duration_;
@@ -368,6 +381,7 @@ class PreProcessor {
   bftEngine::impl::RollingAvgAndVar launchAsyncJobTimeAvg_;
   concordUtil::Timers::Handle requestsStatusCheckTimer_;
   concordUtil::Timers::Handle metricsTimer_;
+  concordUtil::Timers::Handle concurrencyControllerTimer_;
   const uint64_t preExecReqStatusCheckPeriodMilli_;
   concordUtil::Timers &timers_;
   PreProcessorRecorder histograms_;
@@ -375,6 +389,8 @@ class PreProcessor {
   std::shared_ptr<concord::diagnostics::Recorder> launchAsyncPreProcessJobRecorder_;
   std::shared_ptr<concord::performance::PerformanceManager> pm_ = nullptr;
   bool batchedPreProcessEnabled_;
+  // Non-primary replicas sign one merkle root per batch of replies instead of each reply
+  bool batchedResultSigningEnabled_;
   bool memoryPoolEnabled_;
 };
 
@@ -12,6 +12,7 @@
 #include "RequestProcessingState.hpp"
 #include "sparse_merkle/base_types.h"
 #include "SigManager.hpp"
+#include "CryptoManager.hpp"
 #include "TimeUtils.hpp"
 #include "messages/PreProcessResultHashCreator.hpp"
 
@@ -101,14 +102,8 @@ void RequestProcessingState::handlePrimaryPreProcessed(const char *preProcessRes
   // In case the pre-processing failed on the primary replica, fill primaryPreProcessResultData_ by the result-related
   // information.
   if (preProcessResult != OperationResult::SUCCESS) setupPreProcessResultData(preProcessResult);
-  auto sm = SigManager::instance();
-  std::vector<char> sig(sm->getMySigLength());
-  sm->sign(reinterpret_cast<const char *>(primaryPreProcessResultHash_.data()),
-           primaryPreProcessResultHash_.size(),
-           sig.data(),
-           sig.size());
   if (!preProcessingResultHashes_[primaryPreProcessResultHash_]
-           .emplace(std::move(sig), myReplicaId_, preProcessResult)
+           .emplace(signPrimaryResultHash(), myReplicaId_, preProcessResult)
            .second) {
     LOG_INFO(logger(), "Failed to add signature, primary already has a signature");
     return;
@@ -118,6 +113,21 @@ void RequestProcessingState::handlePrimaryPreProcessed(const char *preProcessRes
   numOfReceivedReplies_++;
 }
 
+std::vector<char> RequestProcessingState::signPrimaryResultHash() const {
+  if (!PreProcessReplyMsg::resultSignaturesEnabled()) return {};
+  const auto *hash = reinterpret_cast<const char *>(primaryPreProcessResultHash_.data());
+  if (ReplicaConfig::instance().preExecutionResultThresholdAuthEnabled) {
+    const auto signer = CryptoManager::instance().thresholdSignerForPreExecution(keySeqNum());
+    std::vector<char> sigShare(signer->requiredLengthForSignedData());
+    signer->signData(hash, primaryPreProcessResultHash_.size(), sigShare.data(), sigShare.size());
+    return sigShare;
+  }
+  auto sm = SigManager::instance();
+  std::vector<char> sig(sm->getMySigLength());
+  sm->sign(hash, primaryPreProcessResultHash_.size(), sig.data(), sig.size());
+  return sig;
+}
+
 void RequestProcessingState::releaseResources() {
   clientPreProcessReqMsg_.reset();
   preProcessRequestMsg_.reset();
@@ -143,6 +153,14 @@ void RequestProcessingState::detectNonDeterministicPreProcessing(const uint8_t *
 
 void RequestProcessingState::handlePreProcessReplyMsg(const PreProcessReplyMsgSharedPtr &preProcessReplyMsg) {
   const auto &senderId = preProcessReplyMsg->senderId();
+  if (ReplicaConfig::instance().preExecutionResultThresholdAuthEnabled &&
+      preProcessReplyMsg->status() != STATUS_REJECT && preProcessReplyMsg->keySeqNum() != keySeqNum()) {
+    // The signature share was made with other keys than the ones the primary asked for, and could not be combined
+    LOG_INFO(logger(),
+             "Ignore a reply signed with the keys of another seq num"
+                 << KVLOG(senderId, clientId_, batchCid_, reqSeqNum_, reqCid_, preProcessReplyMsg->keySeqNum()));
+    return;
+  }
   if (preProcessReplyMsg->status() != STATUS_REJECT) {
     const auto &newHashArray = convertToArray(preProcessReplyMsg->resultsHash());
     // Counts equal hashes and saves the signatures with the replica ID. They will be used as a proof that the primary
@@ -224,14 +242,8 @@ void RequestProcessingState::modifyPrimaryResult(
     const std::pair<std::string, concord::util::SHA3_256::Digest> &result) {
   memcpy(const_cast<char *>(primaryPreProcessResultData_), result.first.c_str(), primaryPreProcessResultLen_);
   primaryPreProcessResultHash_ = result.second;
-  auto sm = SigManager::instance();
-  std::vector<char> sig(sm->getMySigLength());
-  sm->sign(reinterpret_cast<const char *>(primaryPreProcessResultHash_.data()),
-           primaryPreProcessResultHash_.size(),
-           sig.data(),
-           sig.size());
   if (!preProcessingResultHashes_[primaryPreProcessResultHash_]
-           .emplace(std::move(sig), myReplicaId_, primaryPreProcessResult_)
+           .emplace(signPrimaryResultHash(), myReplicaId_, primaryPreProcessResult_)
            .second) {
     LOG_INFO(logger(), "Failed to add signature, primary already has a signature");
   }
@@ -273,7 +285,7 @@ PreProcessingResult RequestProcessingState::definePreProcessingConsensusResult()
         LOG_INFO(logger(),
                  "The replicas agreed on an error execution result:"
                      << KVLOG(static_cast<uint32_t>(agreedPreProcessResult_)));
-      return COMPLETE;  // Pre-execution consensus reached
+      return certifyPreProcessingResult();  // Pre-execution consensus reached
     }
     if (primaryPreProcessResult_ == OperationResult::SUCCESS && agreedPreProcessResult_ != OperationResult::SUCCESS) {
       // The pre-execution succeeded on a primary replica while failed on non-primaries. The consensus for an error
@@ -282,7 +294,7 @@ PreProcessingResult RequestProcessingState::definePreProcessingConsensusResult()
       LOG_INFO(logger(),
                "The replicas (except the primary) agreed on an error execution result:"
                    << KVLOG(static_cast<uint32_t>(agreedPreProcessResult_)) << ", we are done");
-      return COMPLETE;
+      return certifyPreProcessingResult();
     }
     // A known scenario that can cause a mismatch, is due to rejection of the block id sent by the primary.
     // In this case the difference should be only the last 64 bits that encodes the `0` as the rejection value.
@@ -290,7 +302,7 @@ PreProcessingResult RequestProcessingState::definePreProcessingConsensusResult()
       const auto modifiedResult = detectFailureDueToBlockID(itOfChosenHash->first, 0);
       if (modifiedResult.first.size() > 0) {
         modifyPrimaryResult(modifiedResult);
-        return COMPLETE;
+        return certifyPreProcessingResult();
       }
       reportNonEqualHashes(itOfChosenHash->first.data(), itOfChosenHash->first.size());
       return CANCEL;
@@ -312,6 +324,68 @@ PreProcessingResult RequestProcessingState::definePreProcessingConsensusResult()
   return CONTINUE;
 }
 
+PreProcessingResult RequestProcessingState::certifyPreProcessingResult() {
+  if (!ReplicaConfig::instance().preExecutionResultThresholdAuthEnabled) return COMPLETE;
+  if (combineResultSignatureShares()) return COMPLETE;
+  LOG_INFO(logger(),
+           "Result signature shares not combined yet, continue waiting"
+               << KVLOG(batchCid_, reqSeqNum_, reqCid_, numOfReceivedReplies_, numOfRequiredEqualReplies_));
+  return CONTINUE;
+}
+
+// Like the shares of commit signatures, the result signature shares are verified only if the signature combined from
+// them fails verification. The invalid shares are then dropped, so that the shares of other replicas are waited for.
+bool RequestProcessingState::combineResultSignatureShares() {
+  const auto it = preProcessingResultHashes_.find(primaryPreProcessResultHash_);
+  if (it == preProcessingResultHashes_.end()) return false;
+  auto &sigShares = it->second;
+  const auto keySeqNum = this->keySeqNum();
+  const auto verifier = CryptoManager::instance().thresholdVerifierForPreExecution(keySeqNum);
+  const auto *digest = reinterpret_cast<const unsigned char *>(primaryPreProcessResultHash_.data());
+  const int digestLen = primaryPreProcessResultHash_.size();
+  std::vector<char> signature(verifier->requiredLengthForSignedData());
+  // Combines the shares into signature, unless they are of fewer signers than required
+  const auto combine = [&]() {
+    std::unique_ptr<IThresholdAccumulator> acc{verifier->newAccumulator(false)};
+    int numOfSigners = 0;
+    for (const auto &sigShare : sigShares)
+      numOfSigners = acc->add(sigShare.signature.data(), sigShare.signature.size());
+    // A faulty replica may send the share of another one
+    if (numOfSigners < numOfRequiredEqualReplies_) return false;
+    acc->setExpectedDigest(digest, digestLen);
+    acc->getFullSignedData(signature.data(), signature.size());
+    return true;
+  };
+  const auto verify = [&]() {
+    return verifier->verify(reinterpret_cast<const char *>(digest), digestLen, signature.data(), signature.size());
+  };
+  if (!combine()) return false;
+  if (!verify()) {
+    // Each share is verified on its own, so that an invalid share is dropped along with the replica that sent it,
+    // whatever signer id it carries
+    std::set<NodeIdType> invalidSenders;
+    for (auto sigShare = sigShares.begin(); sigShare != sigShares.end();) {
+      std::unique_ptr<IThresholdAccumulator> acc{verifier->newAccumulator(true)};
+      acc->setExpectedDigest(digest, digestLen);
+      acc->add(sigShare->signature.data(), sigShare->signature.size());
+      if (acc->getNumValidShares() == 1) {
+        ++sigShare;
+        continue;
+      }
+      invalidSenders.insert(sigShare->sender_replica);
+      sigShare = sigShares.erase(sigShare);
+      numOfReceivedReplies_--;
+    }
+    LOG_WARN(logger(),
+             "Combined result signature failed verification, dropped the invalid shares"
+                 << KVLOG(batchCid_, reqSeqNum_, reqCid_, keySeqNum, invalidSenders.size()));
+    if (invalidSenders.empty() || !combine() || !verify()) return false;
+  }
+  preProcessResultCertificate_ =
+      PreProcessResultCertificate{keySeqNum, sigShares.cbegin()->getPreProcessResult(), std::move(signature)};
+  return true;
+}
+
 unique_ptr<MessageBase> RequestProcessingState::buildClientRequestMsg(bool emptyReq) {
   return clientPreProcessReqMsg_->convertToClientRequestMsg(emptyReq);
 }
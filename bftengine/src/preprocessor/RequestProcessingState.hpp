@@ -80,6 +80,7 @@ class RequestProcessingState {
   void resetRejectedReplicasList() { rejectedReplicaIds_.clear(); }
   void setPreprocessingRightNow(bool set) { preprocessingRightNow_ = set; }
   const std::set<PreProcessResultSignature>& getPreProcessResultSignatures();
+  const PreProcessResultCertificate& getPreProcessResultCertificate() const { return preProcessResultCertificate_; }
   const concord::util::SHA3_256::Digest& getResultHash() { return primaryPreProcessResultHash_; };
   const bftEngine::OperationResult getAgreedPreProcessResult() const { return agreedPreProcessResult_; }
 
@@ -109,6 +110,13 @@ class RequestProcessingState {
   // Set a new block id at the end of the result.
   void modifyPrimaryResult(const std::pair<std::string, concord::util::SHA3_256::Digest>&);
 
+  SeqNum keySeqNum() const { return preProcessRequestMsg_ ? preProcessRequestMsg_->keySeqNum() : 0; }
+  std::vector<char> signPrimaryResultHash() const;
+  // COMPLETE, or CONTINUE until the result signature shares combine into a certificate when
+  // preExecutionResultThresholdAuthEnabled
+  PreProcessingResult certifyPreProcessingResult();
+  bool combineResultSignatureShares();
+
  private:
   static uint16_t numOfRequiredEqualReplies_;
   static preprocessor::PreProcessorRecorder* preProcessorHistograms_;
@@ -136,6 +144,7 @@ class RequestProcessingState {
   // Maps result hash to a list of replica signatures sent for this hash. This also implicitly gives the number of
   // replicas returning a specific hash.
   std::map<concord::util::SHA3_256::Digest, std::set<PreProcessResultSignature>> preProcessingResultHashes_;
+  PreProcessResultCertificate preProcessResultCertificate_;
   bool preprocessingRightNow_ = false;
   uint64_t reqRetryId_ = 0;
 };
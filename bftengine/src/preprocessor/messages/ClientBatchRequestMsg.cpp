@@ -79,7 +79,16 @@ bool ClientBatchRequestMsg::checkElements() const {
   for (auto i = 0u; i < numOfMessagesInBatch; i++) {
     const auto& singleMsgHeader = *(ClientRequestMsgHeader*)dataPosition;
     PrincipalId clientId = singleMsgHeader.idOfClientProxy;
-    auto expectedSigLen = (isClientTransactionSigningEnabled ? sigManager->getSigLength(clientId) : 0);
+    const char* sigPosition = dataPosition + sizeof(ClientRequestMsgHeader) + singleMsgHeader.spanContextSize +
+                              singleMsgHeader.requestLength + singleMsgHeader.cidLength;
+    if (sigPosition + singleMsgHeader.reqSignatureLength > body() + totalMsgSize) {
+      LOG_WARN(logger(), "Request exceeds the batch" << KVLOG(clientId, totalMsgSize, i));
+      return false;
+    }
+    auto expectedSigLen =
+        (isClientTransactionSigningEnabled
+             ? sigManager->getClientRequestSigLength(clientId, sigPosition, singleMsgHeader.reqSignatureLength)
+             : 0);
     if ((expectedSigLen != singleMsgHeader.reqSignatureLength) || (totalMsgSize < singleMsgHeader.requestLength) ||
         (totalMsgSize < singleMsgHeader.cidLength)) {
       LOG_WARN(logger(),
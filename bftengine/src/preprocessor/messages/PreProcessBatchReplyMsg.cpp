@@ -10,7 +10,6 @@
 // file.
 
 #include "PreProcessBatchReplyMsg.hpp"
-#include "SigManager.hpp"
 #include "assertUtils.hpp"
 
 namespace preprocessor {
@@ -86,11 +85,22 @@ PreProcessReplyMsgsList& PreProcessBatchReplyMsg::getPreProcessReplyMsgs() {
   const string& batchCid = getCid();
   const auto& clientId = msgBody()->clientId;
   const auto& senderId = msgBody()->senderId;
-  const auto sigLen = SigManager::instance()->getSigLength(msgBody()->senderId);
+  const bool batchedSignatures = PreProcessReplyMsg::batchedSignaturesEnabled();
   char* dataPosition = body() + sizeof(Header) + msgBody()->cidLength;
+  const char* dataEnd = body() + size();
   for (uint32_t i = 0; i < numOfMessagesInBatch; i++) {
+    if (dataPosition + sizeof(PreProcessReplyMsg::Header) > dataEnd) break;
     const auto& singleMsgHeader = *(PreProcessReplyMsg::Header*)dataPosition;
     const auto& reqSeqNum = singleMsgHeader.reqSeqNum;
+    // The length of a batched signature depends on the position of the reply in the merkle tree
+    const uint64_t sigLen = batchedSignatures
+                                ? singleMsgHeader.replyLength
+                                : PreProcessReplyMsg::resultSigLength(senderId, singleMsgHeader.keySeqNum);
+    if (sizeof(PreProcessReplyMsg::Header) + sigLen + singleMsgHeader.cidLength >
+        static_cast<uint64_t>(dataEnd - dataPosition)) {
+      LOG_WARN(logger(), "Reply exceeds the batch" << KVLOG(batchCid, clientId, senderId, i, sigLen));
+      break;
+    }
     const char* sigPosition = dataPosition + sizeof(PreProcessReplyMsg::Header);
     const char* cidPosition = sigPosition + sigLen;
     const string cid(cidPosition, singleMsgHeader.cidLength);
@@ -102,10 +112,12 @@ PreProcessReplyMsgsList& PreProcessBatchReplyMsg::getPreProcessReplyMsgs() {
                                                       singleMsgHeader.reqRetryId,
                                                       (const uint8_t*)&singleMsgHeader.resultsHash,
                                                       sigPosition,
+                                                      sigLen,
                                                       cid,
                                                       singleMsgHeader.status,
                                                       singleMsgHeader.preProcessResult,
-                                                      singleMsgHeader.viewNum);
+                                                      singleMsgHeader.viewNum,
+                                                      singleMsgHeader.keySeqNum);
     preProcessReplyMsgsList_.push_back(move(preProcessReplyMsg));
     dataPosition += sizeof(PreProcessReplyMsg::Header) + sigLen + singleMsgHeader.cidLength;
   }
@@ -72,7 +72,16 @@ bool PreProcessBatchRequestMsg::checkElements() const {
   for (auto i = 0u; i < numOfMessagesInBatch; i++) {
     const auto& singleMsgHeader = *(PreProcessRequestMsg::Header*)dataPosition;
     auto clientId = singleMsgHeader.clientId;
-    auto expectedSigLen = (isClientTransactionSigningEnabled ? sigManager->getSigLength(clientId) : 0);
+    const char* sigPosition = dataPosition + sizeof(PreProcessRequestMsg::Header) + singleMsgHeader.spanContextSize +
+                              singleMsgHeader.requestLength + singleMsgHeader.cidLength;
+    if (sigPosition + singleMsgHeader.reqSignatureLength > body() + totalMsgSize) {
+      LOG_WARN(logger(), "Request exceeds the batch" << KVLOG(clientId, totalMsgSize, i));
+      return false;
+    }
+    auto expectedSigLen =
+        (isClientTransactionSigningEnabled
+             ? sigManager->getClientRequestSigLength(clientId, sigPosition, singleMsgHeader.reqSignatureLength)
+             : 0);
     if ((expectedSigLen != singleMsgHeader.reqSignatureLength) || (totalMsgSize < singleMsgHeader.requestLength) ||
         (totalMsgSize < singleMsgHeader.cidLength)) {
       LOG_WARN(logger(),
@@ -137,7 +146,9 @@ PreProcessReqMsgsList& PreProcessBatchRequestMsg::getPreProcessRequestMsgs() {
                                                                             singleMsgHeader.reqSignatureLength,
                                                                             singleMsgHeader.primaryBlockId,
                                                                             singleMsgHeader.viewNum,
-                                                                            spanContext);
+                                                                            spanContext,
+                                                                            singleMsgHeader.result,
+                                                                            singleMsgHeader.keySeqNum);
     preProcessReqMsgsList_.push_back(move(preProcessReqMsg));
     dataPosition += sizeof(PreProcessRequestMsg::Header) + singleMsgHeader.spanContextSize +
                     singleMsgHeader.requestLength + singleMsgHeader.cidLength + singleMsgHeader.reqSignatureLength;
@@ -13,6 +13,10 @@
 #include "ReplicaConfig.hpp"
 #include "assertUtils.hpp"
 #include "SigManager.hpp"
+#include "CryptoManager.hpp"
+#include "bftengine/ClientRequestBatchSignature.hpp"
+
+#include <algorithm>
 
 namespace preprocessor {
 
@@ -34,13 +38,16 @@ PreProcessReplyMsg::PreProcessReplyMsg(NodeIdType senderId,
                                        const std::string& reqCid,
                                        ReplyStatus status,
                                        OperationResult preProcessResult,
-                                       ViewNum viewNum)
+                                       ViewNum viewNum,
+                                       SeqNum keySeqNum,
+                                       bool signResultHash)
     : MessageBase(senderId, MsgCode::PreProcessReply, 0, maxReplyMsgSize_) {
-  setParams(senderId, clientId, reqOffsetInBatch, reqSeqNum, reqRetryId, status, preProcessResult, viewNum);
-  setupMsgBody(preProcessResultBuf, preProcessResultBufLen, reqCid);
+  setParams(senderId, clientId, reqOffsetInBatch, reqSeqNum, reqRetryId, status, preProcessResult, viewNum, keySeqNum);
+  setupMsgBody(preProcessResultBuf, preProcessResultBufLen, reqCid, signResultHash);
 }
 
-// Used by PreProcessBatchReplyMsg while retrieving PreProcessReplyMsgs from the batch
+// Used by PreProcessBatchReplyMsg while retrieving PreProcessReplyMsgs from the batch, and by signBatch(). A batched
+// signature is longer than a plain one, so the message is allocated to fit.
 PreProcessReplyMsg::PreProcessReplyMsg(NodeIdType senderId,
                                        uint16_t clientId,
                                        uint16_t reqOffsetInBatch,
@@ -48,13 +55,18 @@ PreProcessReplyMsg::PreProcessReplyMsg(NodeIdType senderId,
                                        uint64_t reqRetryId,
                                        const uint8_t* resultsHash,
                                        const char* signature,
+                                       uint32_t signatureLength,
                                        const std::string& reqCid,
                                        ReplyStatus status,
                                        OperationResult preProcessResult,
-                                       ViewNum viewNum)
-    : MessageBase(senderId, MsgCode::PreProcessReply, 0, maxReplyMsgSize_) {
-  setParams(senderId, clientId, reqOffsetInBatch, reqSeqNum, reqRetryId, status, preProcessResult, viewNum);
-  setupMsgBody(resultsHash, signature, reqCid);
+                                       ViewNum viewNum,
+                                       SeqNum keySeqNum)
+    : MessageBase(senderId,
+                  MsgCode::PreProcessReply,
+                  0,
+                  std::max<uint32_t>(maxReplyMsgSize_, sizeof(Header) + signatureLength + reqCid.size())) {
+  setParams(senderId, clientId, reqOffsetInBatch, reqSeqNum, reqRetryId, status, preProcessResult, viewNum, keySeqNum);
+  setupMsgBody(resultsHash, signature, signatureLength, reqCid);
 }
 
 void PreProcessReplyMsg::validate(const ReplicasInfo& repInfo) const {
@@ -72,8 +84,7 @@ void PreProcessReplyMsg::validate(const ReplicasInfo& repInfo) const {
     throw std::runtime_error(__PRETTY_FUNCTION__);
   }
 
-  auto sigManager = SigManager::instance();
-  uint16_t sigLen = sigManager->getSigLength(msgHeader.senderId);
+  uint16_t sigLen = resultSigLength(msgHeader.senderId, msgHeader.keySeqNum);
   if (msgHeader.status == STATUS_GOOD) {
     if (size() < (sizeof(Header) + sigLen)) {
       LOG_WARN(logger(),
@@ -81,12 +92,26 @@ void PreProcessReplyMsg::validate(const ReplicasInfo& repInfo) const {
                    msgHeader.senderId, msgHeader.clientId, msgHeader.reqSeqNum, size(), sizeof(Header) + sigLen));
       throw runtime_error(__PRETTY_FUNCTION__ + string(": Message size is too small"));
     }
+    if (!resultSignaturesEnabled()) return;
+    // Like the shares of commit signatures, the shares are verified only if the signature the primary combines from
+    // them fails verification
+    if (ReplicaConfig::instance().preExecutionResultThresholdAuthEnabled) return;
     concord::diagnostics::TimeRecorder scoped_timer(*preProcessorHistograms_->verifyPreProcessReplySig);
-    if (!sigManager->verifySig(msgHeader.senderId,
-                               (char*)msgBody()->resultsHash,
-                               SHA3_256::SIZE_IN_BYTES,
-                               (char*)msgBody() + headerSize,
-                               sigLen))
+    if (batchedSignaturesEnabled()) {
+      // Verified batch roots are cached, so only the first reply of a batch costs a signature verification
+      if (!SigManager::instance()->verifyReplicaResultSig(msgHeader.senderId,
+                                                          (char*)msgBody()->resultsHash,
+                                                          SHA3_256::SIZE_IN_BYTES,
+                                                          (char*)msgBody() + headerSize,
+                                                          msgHeader.replyLength))
+        throw runtime_error(__PRETTY_FUNCTION__ + string(": verifyReplicaResultSig failed"));
+      return;
+    }
+    if (!SigManager::instance()->verifySig(msgHeader.senderId,
+                                           (char*)msgBody()->resultsHash,
+                                           SHA3_256::SIZE_IN_BYTES,
+                                           (char*)msgBody() + headerSize,
+                                           sigLen))
       throw runtime_error(__PRETTY_FUNCTION__ + string(": verifySig failed"));
   }
 }  // namespace preprocessor
@@ -94,12 +119,64 @@ void PreProcessReplyMsg::validate(const ReplicasInfo& repInfo) const {
 std::vector<char> PreProcessReplyMsg::getResultHashSignature() const {
   const uint64_t headerSize = sizeof(Header);
   const auto& msgHeader = *msgBody();
-  auto sigManager = SigManager::instance();
-  uint16_t sigLen = sigManager->getSigLength(msgHeader.senderId);
+  const uint32_t sigLen =
+      batchedSignaturesEnabled() ? msgHeader.replyLength : resultSigLength(msgHeader.senderId, msgHeader.keySeqNum);
 
   return std::vector<char>((char*)msgBody() + headerSize, (char*)msgBody() + headerSize + sigLen);
 }
 
+uint16_t PreProcessReplyMsg::resultSigLength(NodeIdType senderId, SeqNum keySeqNum) {
+  if (!resultSignaturesEnabled()) return 0;
+  // The threshold signature shares of all the replicas are of the same length
+  if (ReplicaConfig::instance().preExecutionResultThresholdAuthEnabled)
+    return CryptoManager::instance().thresholdSignerForPreExecution(keySeqNum)->requiredLengthForSignedData();
+  return SigManager::instance()->getSigLength(senderId);
+}
+
+bool PreProcessReplyMsg::resultSignaturesEnabled() {
+  const auto& config = ReplicaConfig::instance();
+  return config.preExecutionResultAuthEnabled || !config.enableReplicaMacAuthenticators;
+}
+
+bool PreProcessReplyMsg::batchedSignaturesEnabled() {
+  const auto& config = ReplicaConfig::instance();
+  return config.batchedPreProcessEnabled && config.preExecutionBatchResultSigningEnabled &&
+         !config.preExecutionResultThresholdAuthEnabled && resultSignaturesEnabled();
+}
+
+void PreProcessReplyMsg::signBatch(std::list<PreProcessReplyMsgSharedPtr>& replies) {
+  if (replies.empty()) return;
+  std::vector<batch_signature::Hash> leaves;
+  leaves.reserve(replies.size());
+  for (const auto& reply : replies)
+    leaves.push_back(batch_signature::leafHash((const char*)reply->resultsHash(), SHA3_256::SIZE_IN_BYTES));
+  const batch_signature::MerkleTree tree(std::move(leaves));
+  const auto digest = batch_signature::batchDigest(tree.size(), tree.root());
+  auto sigManager = SigManager::instance();
+  std::string rootSignature(sigManager->getMySigLength(), '\0');
+  {
+    concord::diagnostics::TimeRecorder scoped_timer(*preProcessorHistograms_->signPreProcessReplyHash);
+    sigManager->sign((const char*)digest.data(), digest.size(), rootSignature.data(), rootSignature.size());
+  }
+  uint32_t index = 0;
+  for (auto& reply : replies) {
+    const auto signature = batch_signature::serialize(rootSignature, index++, tree);
+    reply = std::make_shared<PreProcessReplyMsg>(reply->senderId(),
+                                                 reply->clientId(),
+                                                 reply->reqOffsetInBatch(),
+                                                 reply->reqSeqNum(),
+                                                 reply->reqRetryId(),
+                                                 reply->resultsHash(),
+                                                 signature.data(),
+                                                 signature.size(),
+                                                 reply->getCid(),
+                                                 reply->status(),
+                                                 reply->preProcessResult(),
+                                                 reply->viewNum(),
+                                                 reply->keySeqNum());
+  }
+}
+
 void PreProcessReplyMsg::setParams(NodeIdType senderId,
                                    uint16_t clientId,
                                    uint16_t reqOffsetInBatch,
@@ -107,7 +184,8 @@ void PreProcessReplyMsg::setParams(NodeIdType senderId,
                                    uint64_t reqRetryId,
                                    ReplyStatus status,
                                    OperationResult preProcessResult,
-                                   ViewNum viewNum) {
+                                   ViewNum viewNum,
+                                   SeqNum keySeqNum) {
   msgBody()->senderId = senderId;
   msgBody()->reqSeqNum = reqSeqNum;
   msgBody()->clientId = clientId;
@@ -116,11 +194,13 @@ void PreProcessReplyMsg::setParams(NodeIdType senderId,
   msgBody()->status = status;
   msgBody()->preProcessResult = preProcessResult;
   msgBody()->viewNum = viewNum;
-  LOG_DEBUG(logger(),
-            KVLOG(senderId, clientId, reqSeqNum, reqRetryId, status, static_cast<uint32_t>(preProcessResult)));
+  msgBody()->keySeqNum = keySeqNum;
+  LOG_DEBUG(
+      logger(),
+      KVLOG(senderId, clientId, reqSeqNum, reqRetryId, status, static_cast<uint32_t>(preProcessResult), keySeqNum));
 }
 
-void PreProcessReplyMsg::setLeftMsgParams(const string& reqCid, uint16_t sigSize) {
+void PreProcessReplyMsg::setLeftMsgParams(const string& reqCid, uint32_t sigSize) {
   const uint16_t headerSize = sizeof(Header);
   msgBody()->cidLength = reqCid.size();
   memcpy(body() + headerSize + sigSize, reqCid.c_str(), reqCid.size());
@@ -141,10 +221,10 @@ void PreProcessReplyMsg::setLeftMsgParams(const string& reqCid, uint16_t sigSize
 
 void PreProcessReplyMsg::setupMsgBody(const char* preProcessResultBuf,
                                       uint32_t preProcessResultBufLen,
-                                      const string& reqCid) {
-  uint16_t sigSize = 0;
-  auto sigManager = SigManager::instance();
-  sigSize = sigManager->getMySigLength();
+                                      const string& reqCid,
+                                      bool signResultHash) {
+  signResultHash = signResultHash && resultSignaturesEnabled();
+  const uint16_t sigSize = signResultHash ? resultSigLength(msgBody()->senderId, msgBody()->keySeqNum) : 0;
   // Calculate pre-process result hash
   auto hash = PreProcessResultHashCreator::create(preProcessResultBuf,
                                                   preProcessResultBufLen,
@@ -152,19 +232,27 @@ void PreProcessReplyMsg::setupMsgBody(const char* preProcessResultBuf,
                                                   msgBody()->clientId,
                                                   msgBody()->reqSeqNum);
   memcpy(msgBody()->resultsHash, hash.data(), SHA3_256::SIZE_IN_BYTES);
-  {
+  if (signResultHash) {
     concord::diagnostics::TimeRecorder scoped_timer(*preProcessorHistograms_->signPreProcessReplyHash);
-    sigManager->sign((char*)hash.data(), SHA3_256::SIZE_IN_BYTES, body() + sizeof(Header), sigSize);
+    if (ReplicaConfig::instance().preExecutionResultThresholdAuthEnabled) {
+      CryptoManager::instance()
+          .thresholdSignerForPreExecution(msgBody()->keySeqNum)
+          ->signData((char*)hash.data(), SHA3_256::SIZE_IN_BYTES, body() + sizeof(Header), sigSize);
+    } else {
+      SigManager::instance()->sign((char*)hash.data(), SHA3_256::SIZE_IN_BYTES, body() + sizeof(Header), sigSize);
+    }
   }
   setLeftMsgParams(reqCid, sigSize);
 }
 
 // Used by PreProcessBatchReplyMsg while retrieving PreProcessReplyMsgs from the batch
-void PreProcessReplyMsg::setupMsgBody(const uint8_t* resultsHash, const char* signature, const string& reqCid) {
+void PreProcessReplyMsg::setupMsgBody(const uint8_t* resultsHash,
+                                      const char* signature,
+                                      uint32_t signatureLength,
+                                      const string& reqCid) {
   memcpy(msgBody()->resultsHash, resultsHash, SHA3_256::SIZE_IN_BYTES);
-  const uint16_t sigLen = SigManager::instance()->getMySigLength();
-  memcpy(body() + sizeof(Header), signature, sigLen);
-  setLeftMsgParams(reqCid, sigLen);
+  memcpy(body() + sizeof(Header), signature, signatureLength);
+  setLeftMsgParams(reqCid, signatureLength);
 }
 
 std::string PreProcessReplyMsg::getCid() const {
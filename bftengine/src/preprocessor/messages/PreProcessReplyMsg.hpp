@@ -14,6 +14,7 @@
 #include "messages/MessageBase.hpp"
 #include "../PreProcessorRecorder.hpp"
 #include "PreProcessResultHashCreator.hpp"
+#include <list>
 #include <memory>
 
 namespace preprocessor {
@@ -32,7 +33,9 @@ class PreProcessReplyMsg : public MessageBase {
                      const std::string& reqCid,
                      ReplyStatus status,
                      bftEngine::OperationResult preProcessResult,
-                     ViewNum viewNum);
+                     ViewNum viewNum,
+                     SeqNum keySeqNum = 0,
+                     bool signResultHash = true);
 
   PreProcessReplyMsg(NodeIdType senderId,
                      uint16_t clientId,
@@ -41,10 +44,12 @@ class PreProcessReplyMsg : public MessageBase {
                      uint64_t reqRetryId,
                      const uint8_t* resultsHash,
                      const char* signature,
+                     uint32_t signatureLength,
                      const std::string& reqCid,
                      ReplyStatus status,
                      bftEngine::OperationResult preProcessResult,
-                     ViewNum viewNum);
+                     ViewNum viewNum,
+                     SeqNum keySeqNum = 0);
 
   BFTENGINE_GEN_CONSTRUCT_FROM_BASE_MESSAGE(PreProcessReplyMsg)
 
@@ -58,9 +63,26 @@ class PreProcessReplyMsg : public MessageBase {
   const ReplyStatus status() const { return msgBody()->status; }
   const bftEngine::OperationResult preProcessResult() const { return msgBody()->preProcessResult; }
   const ViewNum viewNum() const { return msgBody()->viewNum; }
+  const SeqNum keySeqNum() const { return msgBody()->keySeqNum; }
   std::vector<char> getResultHashSignature() const;
   std::string getCid() const;
 
+  // The length of the signature on the result hash, or of the threshold signature share on it when
+  // preExecutionResultThresholdAuthEnabled, in the replies of senderId. 0 if the result hashes are not signed.
+  static uint16_t resultSigLength(NodeIdType senderId, SeqNum keySeqNum);
+
+  // The result hash is signed only if the primary forwards the signatures as a proof of the result
+  // (preExecutionResultAuthEnabled), or if the replies are not authenticated by the MAC authenticators of the messages
+  // between replicas. Otherwise, only the primary checks the reply, and the MAC of its sender suffices.
+  static bool resultSignaturesEnabled();
+
+  // If the replies of a PreProcessBatchReplyMsg carry merkle-batched signatures, see signBatch()
+  static bool batchedSignaturesEnabled();
+  // Signs one merkle root over the result hashes of the replies of a batch, and replaces each reply, created with
+  // signResultHash = false, by a copy that carries the root signature and its inclusion path, in the format of
+  // ClientRequestBatchSignature.hpp. The primary verifies the root signature once for all the replies of the batch.
+  static void signBatch(std::list<std::shared_ptr<PreProcessReplyMsg>>& replies);
+
   static void setPreProcessorHistograms(preprocessor::PreProcessorRecorder* histograms) {
     preProcessorHistograms_ = histograms;
   }
@@ -80,6 +102,7 @@ class PreProcessReplyMsg : public MessageBase {
     uint32_t cidLength = 0;
     uint64_t reqRetryId = 0;
     ViewNum viewNum;
+    SeqNum keySeqNum = 0;
   };
 // The pre-executed results' hash signature resides in the message body
 #pragma pack(pop)
@@ -100,10 +123,17 @@ class PreProcessReplyMsg : public MessageBase {
                  uint64_t reqRetryId,
                  ReplyStatus status,
                  bftEngine::OperationResult preProcessResult,
-                 ViewNum viewNum);
-  void setupMsgBody(const char* preProcessResultBuf, uint32_t preProcessResultBufLen, const std::string& reqCid);
-  void setupMsgBody(const uint8_t* resultsHash, const char* signature, const std::string& reqCid);
-  void setLeftMsgParams(const std::string& cid, uint16_t sigSize);
+                 ViewNum viewNum,
+                 SeqNum keySeqNum);
+  void setupMsgBody(const char* preProcessResultBuf,
+                    uint32_t preProcessResultBufLen,
+                    const std::string& reqCid,
+                    bool signResultHash);
+  void setupMsgBody(const uint8_t* resultsHash,
+                    const char* signature,
+                    uint32_t signatureLength,
+                    const std::string& reqCid);
+  void setLeftMsgParams(const std::string& cid, uint32_t sigSize);
 
   Header* msgBody() const { return ((Header*)msgBody_); }
 
@@ -31,7 +31,8 @@ PreProcessRequestMsg::PreProcessRequestMsg(RequestType reqType,
                                            uint64_t blockId,
                                            ViewNum viewNum,
                                            const concordUtils::SpanContext& span_context,
-                                           uint32_t result)
+                                           uint32_t result,
+                                           SeqNum keySeqNum)
     : MessageBase(senderId,
                   MsgCode::PreProcessRequest,
                   span_context.data().size(),
@@ -49,7 +50,8 @@ PreProcessRequestMsg::PreProcessRequestMsg(RequestType reqType,
             requestSignatureLength,
             blockId,
             result,
-            viewNum);
+            viewNum,
+            keySeqNum);
   auto position = body() + sizeof(Header);
   memcpy(position, span_context.data().data(), span_context.data().size());
   position += span_context.data().size();
@@ -75,7 +77,8 @@ PreProcessRequestMsg::PreProcessRequestMsg(RequestType reqType,
                   requestSignatureLength,
                   msgLength,
                   blockId,
-                  result));
+                  result,
+                  keySeqNum));
 }
 
 void PreProcessRequestMsg::validate(const ReplicasInfo& repInfo) const {
@@ -100,7 +103,7 @@ void PreProcessRequestMsg::validate(const ReplicasInfo& repInfo) const {
 
   if (requestSignature) {
     ConcordAssert(sigManager->isClientTransactionSigningEnabled());
-    if (!sigManager->verifySig(
+    if (!sigManager->verifyClientRequestSig(
             header->clientId, requestBuf(), header->requestLength, requestSignature, header->reqSignatureLength)) {
       std::stringstream msg;
       LOG_WARN(logger(),
@@ -125,7 +128,8 @@ void PreProcessRequestMsg::setParams(RequestType reqType,
                                      uint16_t reqSignatureLength,
                                      uint64_t blockId,
                                      uint32_t result,
-                                     ViewNum viewNum) {
+                                     ViewNum viewNum,
+                                     SeqNum keySeqNum) {
   auto* header = msgBody();
   header->reqType = reqType;
   header->senderId = senderId;
@@ -140,6 +144,7 @@ void PreProcessRequestMsg::setParams(RequestType reqType,
   header->primaryBlockId = blockId;
   header->result = result;
   header->viewNum = viewNum;
+  header->keySeqNum = keySeqNum;
 }
 
 std::string PreProcessRequestMsg::getCid() const {
@@ -36,7 +36,8 @@ class PreProcessRequestMsg : public MessageBase {
                        uint64_t blockid,
                        ViewNum viewNum,
                        const concordUtils::SpanContext& span_context = concordUtils::SpanContext{},
-                       uint32_t result = 1);  // UNKNOWN
+                       uint32_t result = 1,  // UNKNOWN
+                       SeqNum keySeqNum = 0);
 
   BFTENGINE_GEN_CONSTRUCT_FROM_BASE_MESSAGE(PreProcessRequestMsg)
 
@@ -59,6 +60,8 @@ class PreProcessRequestMsg : public MessageBase {
     return nullptr;
   }
   const uint32_t result() const { return msgBody()->result; }
+  // The seq num whose threshold keys sign the pre-execution result, see preExecutionResultThresholdAuthEnabled
+  const SeqNum keySeqNum() const { return msgBody()->keySeqNum; }
 
  public:
 #pragma pack(push, 1)
@@ -77,6 +80,7 @@ class PreProcessRequestMsg : public MessageBase {
     uint64_t primaryBlockId;
     uint32_t result;
     ViewNum viewNum;
+    SeqNum keySeqNum;
   };
 #pragma pack(pop)
 
@@ -101,7 +105,8 @@ class PreProcessRequestMsg : public MessageBase {
                  uint16_t reqSignatureLength,
                  uint64_t blockId,
                  uint32_t result,
-                 ViewNum viewNum);
+                 ViewNum viewNum,
+                 SeqNum keySeqNum);
   Header* msgBody() const { return ((Header*)msgBody_); }
 };
 
@@ -12,6 +12,8 @@
 #include "PreProcessResultMsg.hpp"
 #include "Replica.hpp"  // for HAS_PRE_PROCESSED_FLAG
 #include "SigManager.hpp"
+#include "CryptoManager.hpp"
+#include "bftengine/ClientRequestBatchSignature.hpp"
 #include "PreProcessResultHashCreator.hpp"
 #include "endianness.hpp"
 
@@ -78,13 +80,23 @@ std::optional<std::string> PreProcessResultMsg::validatePreProcessResultSignatur
 
   for (const auto& sig : sigs) {
     bool verificationResult = false;
-    if (myReplicaId == sig.sender_replica) {
-      std::vector<char> mySignature(sigManager_->getMySigLength(), '\0');
+    const auto mySigLength = sigManager_->getMySigLength();
+    if (myReplicaId == sig.sender_replica && sig.signature.size() == mySigLength) {
+      std::vector<char> mySignature(mySigLength, '\0');
       sigManager_->sign(
           reinterpret_cast<const char*>(hash.data()), hash.size(), mySignature.data(), mySignature.size());
       verificationResult = mySignature == sig.signature;
+    } else if (myReplicaId == sig.sender_replica) {
+      // A merkle-batched signature of this replica: sign the batch digest again and compare the root signatures
+      const auto parsed = batch_signature::parse(sig.signature.data(), sig.signature.size(), mySigLength);
+      if (parsed) {
+        const auto digest = batch_signature::batchDigestFromPath((const char*)hash.data(), hash.size(), *parsed);
+        std::vector<char> mySignature(mySigLength, '\0');
+        sigManager_->sign((const char*)digest.data(), digest.size(), mySignature.data(), mySignature.size());
+        verificationResult = std::equal(mySignature.begin(), mySignature.end(), parsed->rootSignature);
+      }
     } else {
-      verificationResult = sigManager_->verifySig(
+      verificationResult = sigManager_->verifyReplicaResultSig(
           sig.sender_replica, (const char*)hash.data(), hash.size(), sig.signature.data(), sig.signature.size());
     }
 
@@ -98,6 +110,42 @@ std::optional<std::string> PreProcessResultMsg::validatePreProcessResultSignatur
   return {};
 }
 
+std::optional<std::string> PreProcessResultMsg::validatePreProcessResultCertificate(SeqNum seqNum) {
+  const auto [buf, buf_len] = getResultSignaturesBuf();
+  std::stringstream err;
+  PreProcessResultCertificate certificate;
+  try {
+    certificate = PreProcessResultCertificate::deserialize(buf, buf_len);
+  } catch (const std::exception& e) {
+    err << "PreProcessResult certificate validation failure - " << e.what()
+        << KVLOG(clientProxyId(), getCid(), requestSeqNum());
+    return err.str();
+  }
+
+  // The primary signs with the keys of a seq num that it executed before proposing this one, as replicas get the keys
+  // of a seq num at the same time for pre-execution results and for commits
+  if (certificate.key_seq_num > seqNum) {
+    err << "PreProcessResult certificate validation failure - keys of a later seq num"
+        << KVLOG(certificate.key_seq_num, seqNum, clientProxyId(), getCid(), requestSeqNum());
+    return err.str();
+  }
+
+  auto hash = PreProcessResultHashCreator::create(
+      requestBuf(), requestLength(), certificate.pre_process_result, clientProxyId(), requestSeqNum());
+  const auto verifier = CryptoManager::instance().thresholdVerifierForPreExecution(certificate.key_seq_num);
+  if (certificate.signature.size() != static_cast<size_t>(verifier->requiredLengthForSignedData()) ||
+      !verifier->verify(reinterpret_cast<const char*>(hash.data()),
+                        hash.size(),
+                        certificate.signature.data(),
+                        certificate.signature.size())) {
+    err << "PreProcessResult certificate validation failure - invalid threshold signature"
+        << KVLOG(certificate.key_seq_num, clientProxyId(), getCid(), requestSeqNum());
+    return err.str();
+  }
+
+  return {};
+}
+
 std::string PreProcessResultSignature::serializeResultSignatures(const std::set<PreProcessResultSignature>& signatures,
                                                                  const uint16_t numOfRequiredSignatures) {
   size_t buf_len = 0;
@@ -157,4 +205,35 @@ std::set<PreProcessResultSignature> PreProcessResultSignature::deserializeResult
   return ret;
 }
 
-}  // namespace preprocessor
\ No newline at end of file
+std::string PreProcessResultCertificate::serialize() const {
+  std::string output;
+  output.reserve(sizeof(key_seq_num) + sizeof(uint32_t) + sizeof(uint32_t) + signature.size());
+  output.append(concordUtils::toBigEndianStringBuffer(key_seq_num));
+  output.append(concordUtils::toBigEndianStringBuffer(static_cast<uint32_t>(pre_process_result)));
+  output.append(concordUtils::toBigEndianStringBuffer<uint32_t>(signature.size()));
+  output.append(signature.begin(), signature.end());
+  return output;
+}
+
+PreProcessResultCertificate PreProcessResultCertificate::deserialize(const char* buf, size_t len) {
+  size_t pos = 0;
+  if (sizeof(SeqNum) + sizeof(uint32_t) + sizeof(uint32_t) > len) {
+    throw std::runtime_error("Deserialization error - buffer length is less than fixed size values size");
+  }
+
+  const auto key_seq_num = concordUtils::fromBigEndianBuffer<SeqNum>(buf + pos);
+  pos += sizeof(SeqNum);
+  const auto pre_process_result = static_cast<OperationResult>(concordUtils::fromBigEndianBuffer<uint32_t>(buf + pos));
+  pos += sizeof(uint32_t);
+  const auto signature_size = concordUtils::fromBigEndianBuffer<uint32_t>(buf + pos);
+  pos += sizeof(uint32_t);
+
+  if (signature_size != len - pos) {
+    throw std::runtime_error("Deserialization error - remaining buffer length is not the signature size");
+  }
+
+  return PreProcessResultCertificate{
+      key_seq_num, pre_process_result, std::vector<char>(buf + pos, buf + pos + signature_size)};
+}
+
+}  // namespace preprocessor
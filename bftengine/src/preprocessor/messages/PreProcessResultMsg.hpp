@@ -56,6 +56,9 @@ class PreProcessResultMsg : public ClientRequestMsg {
 
   std::pair<char*, uint32_t> getResultSignaturesBuf();
   ErrorMessage validatePreProcessResultSignatures(ReplicaId myReplicaId, int16_t fVal);
+  // Validates the PreProcessResultCertificate that replaces the signatures when preExecutionResultThresholdAuthEnabled,
+  // for a PrePrepare of seqNum
+  ErrorMessage validatePreProcessResultCertificate(SeqNum seqNum);
 };
 
 struct PreProcessResultSignature {
@@ -82,4 +85,26 @@ struct PreProcessResultSignature {
   static std::set<PreProcessResultSignature> deserializeResultSignatures(const char* buf, size_t len);
 };
 
+// One threshold signature on the pre-execution result hash, which the primary combines from the signature shares of
+// fVal + 1 replicas with the threshold keys of key_seq_num. It is verified at the cost of one signature, regardless of
+// the number of replicas.
+struct PreProcessResultCertificate {
+  SeqNum key_seq_num = 0;
+  bftEngine::OperationResult pre_process_result = bftEngine::OperationResult::UNKNOWN;
+  std::vector<char> signature;
+
+  PreProcessResultCertificate() = default;
+
+  PreProcessResultCertificate(SeqNum keySeqNum, bftEngine::OperationResult result, std::vector<char>&& sig)
+      : key_seq_num{keySeqNum}, pre_process_result{result}, signature{std::move(sig)} {}
+
+  bool operator==(const PreProcessResultCertificate& rhs) const {
+    return key_seq_num == rhs.key_seq_num && pre_process_result == rhs.pre_process_result &&
+           signature == rhs.signature;
+  }
+
+  std::string serialize() const;
+  static PreProcessResultCertificate deserialize(const char* buf, size_t len);
+};
+
 }  // namespace preprocessor
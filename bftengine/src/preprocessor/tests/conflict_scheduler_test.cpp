@@ -0,0 +1,164 @@
+// Concord
+//
+// Copyright (c) 2022 VMware, Inc. All Rights Reserved.
+//
+// This product is licensed to you under the Apache 2.0 license (the "License"). You may not use this product except in
+// compliance with the Apache 2.0 License.
+//
+// This product may include a number of subcomponents with separate copyright notices and license terms. Your use of
+// these subcomponents is subject to the terms and conditions of the sub-component's license, as noted in the LICENSE
+// file.
+
+#include "gtest/gtest.h"
+
+#include "ConflictScheduler.hpp"
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace preprocessor;
+using KeySets = ConflictScheduler::KeySets;
+using RequestIds = std::vector<ConflictScheduler::RequestId>;
+
+// Request n of client 1
+ConflictScheduler::RequestId req(uint64_t n) { return ConflictScheduler::requestId(1, n); }
+
+class conflict_scheduler : public ::testing::Test {
+ protected:
+  // Records the requests in the order they are started, and the ones that are dropped
+  ConflictScheduler::Start startOf(ConflictScheduler::RequestId id) {
+    return [this, id](bool start) { (start ? started_ : dropped_).push_back(id); };
+  }
+
+  // Each request is a batch of its own, unless batchCid is given
+  bool schedule(uint64_t n, KeySets keySets, const std::string& batchCid = {}) {
+    return scheduler_.schedule(
+        req(n), batchCid.empty() ? std::to_string(n) : batchCid, std::move(keySets), startOf(req(n)));
+  }
+
+  ConflictScheduler scheduler_;
+  RequestIds started_;
+  RequestIds dropped_;
+};
+
+TEST_F(conflict_scheduler, readers_run_concurrently) {
+  ASSERT_TRUE(schedule(1, KeySets{{"a", "b"}, {"x"}}));
+  ASSERT_TRUE(schedule(2, KeySets{{"a"}, {"y"}}));
+  ASSERT_TRUE(schedule(3, KeySets{{"b"}, {}}));
+  ASSERT_EQ((RequestIds{req(1), req(2), req(3)}), started_);
+  ASSERT_EQ(0u, scheduler_.numOfWaiting());
+}
+
+TEST_F(conflict_scheduler, conflicting_requests_run_in_order) {
+  ASSERT_TRUE(schedule(1, KeySets{{}, {"a"}}));
+  // Reads a key that 1 writes
+  ASSERT_FALSE(schedule(2, KeySets{{"a"}, {"b"}}));
+  // Doesn't conflict with 1, but writes a key that 2, which arrived earlier, writes
+  ASSERT_FALSE(schedule(3, KeySets{{}, {"b"}}));
+  ASSERT_TRUE(schedule(4, KeySets{{"c"}, {"d"}}));
+  ASSERT_EQ((RequestIds{req(1), req(4)}), started_);
+  ASSERT_EQ(2u, scheduler_.numOfWaiting());
+
+  scheduler_.release(req(1));
+  ASSERT_EQ((RequestIds{req(1), req(4), req(2)}), started_);
+  scheduler_.release(req(2));
+  ASSERT_EQ((RequestIds{req(1), req(4), req(2), req(3)}), started_);
+  ASSERT_EQ(0u, scheduler_.numOfWaiting());
+  ASSERT_EQ(2u, scheduler_.numOfInFlight());
+  ASSERT_TRUE(dropped_.empty());
+}
+
+TEST_F(conflict_scheduler, released_waiting_request_is_dropped) {
+  ASSERT_TRUE(schedule(1, KeySets{{}, {"a"}}));
+  ASSERT_FALSE(schedule(2, KeySets{{}, {"a"}}));
+  ASSERT_FALSE(schedule(3, KeySets{{"a"}, {}}));
+  // 2 expires while waiting
+  scheduler_.release(req(2));
+  ASSERT_EQ((RequestIds{req(2)}), dropped_);
+  ASSERT_EQ(1u, scheduler_.numOfWaiting());
+  scheduler_.release(req(1));
+  ASSERT_EQ((RequestIds{req(1), req(3)}), started_);
+}
+
+TEST_F(conflict_scheduler, in_flight_request_is_started_again) {
+  ASSERT_TRUE(schedule(1, KeySets{{}, {"a"}}));
+  // A retry of the same request doesn't conflict with itself
+  ASSERT_TRUE(schedule(1, KeySets{{}, {"a"}}));
+  ASSERT_EQ((RequestIds{req(1), req(1)}), started_);
+  ASSERT_EQ(1u, scheduler_.numOfInFlight());
+}
+
+TEST_F(conflict_scheduler, duplicate_keys) {
+  ASSERT_TRUE(schedule(1, KeySets{{"b", "a", "b"}, {"c", "c"}}));
+  ASSERT_FALSE(schedule(2, KeySets{{"c"}, {}}));
+  ASSERT_TRUE(schedule(3, KeySets{{"a", "a"}, {}}));
+  scheduler_.release(req(1));
+  ASSERT_EQ((RequestIds{req(1), req(3), req(2)}), started_);
+}
+
+TEST_F(conflict_scheduler, keys_are_held_until_execution) {
+  ASSERT_TRUE(schedule(1, KeySets{{}, {"a"}}));
+  // 1 is pre-executed, but not executed yet: 2 would read the value of "a" from before 1
+  ASSERT_FALSE(schedule(2, KeySets{{"a"}, {"b"}}));
+  ASSERT_EQ(RequestIds{req(1)}, started_);
+  // The replica executes 1
+  scheduler_.release(req(1));
+  ASSERT_EQ((RequestIds{req(1), req(2)}), started_);
+  ASSERT_TRUE(dropped_.empty());
+}
+
+TEST_F(conflict_scheduler, requests_of_a_batch_wait_for_pre_execution_only) {
+  ASSERT_TRUE(schedule(1, KeySets{{}, {"a"}}, "batch"));
+  ASSERT_FALSE(schedule(2, KeySets{{"a"}, {"b"}}, "batch"));
+  ASSERT_FALSE(schedule(3, KeySets{{"b"}, {}}, "batch"));
+  // Of another batch
+  ASSERT_FALSE(schedule(4, KeySets{{"a"}, {}}));
+  ASSERT_EQ(RequestIds{req(1)}, started_);
+
+  // The batch is replied to once all of its requests are pre-executed, before 1 is executed
+  scheduler_.preExecuted(req(1));
+  ASSERT_EQ((RequestIds{req(1), req(2)}), started_);
+  scheduler_.preExecuted(req(2));
+  ASSERT_EQ((RequestIds{req(1), req(2), req(3)}), started_);
+  scheduler_.preExecuted(req(3));
+  ASSERT_EQ(1u, scheduler_.numOfWaiting());
+
+  // 4 still waits for the execution of 1
+  scheduler_.release(req(1));
+  ASSERT_EQ((RequestIds{req(1), req(2), req(3), req(4)}), started_);
+  ASSERT_TRUE(dropped_.empty());
+}
+
+TEST_F(conflict_scheduler, same_batch_cid_of_another_client_is_another_batch) {
+  ASSERT_TRUE(scheduler_.schedule(req(1), "batch", KeySets{{}, {"a"}}, startOf(req(1))));
+  const auto otherClientReq = ConflictScheduler::requestId(2, 1);
+  ASSERT_FALSE(scheduler_.schedule(otherClientReq, "batch", KeySets{{"a"}, {}}, startOf(otherClientReq)));
+  scheduler_.preExecuted(req(1));
+  ASSERT_EQ(RequestIds{req(1)}, started_);
+  scheduler_.release(req(1));
+  ASSERT_EQ((RequestIds{req(1), otherClientReq}), started_);
+}
+
+TEST_F(conflict_scheduler, requests_that_are_not_executed_expire) {
+  ASSERT_TRUE(schedule(1, KeySets{{}, {"a"}}));
+  ASSERT_FALSE(schedule(2, KeySets{{"a"}, {}}));
+  ASSERT_EQ(0u, scheduler_.releaseExpired(std::chrono::hours{1}));
+  ASSERT_EQ(RequestIds{req(1)}, started_);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds{2});
+  ASSERT_EQ(1u, scheduler_.releaseExpired(std::chrono::milliseconds{1}));
+  ASSERT_EQ((RequestIds{req(1), req(2)}), started_);
+  ASSERT_EQ(1u, scheduler_.numOfInFlight());
+  ASSERT_EQ(0u, scheduler_.numOfWaiting());
+}
+
+TEST(conflict_scheduler_request_id, unique_per_client_and_seq_num) {
+  ASSERT_NE(ConflictScheduler::requestId(1, 2), ConflictScheduler::requestId(2, 1));
+  ASSERT_NE(ConflictScheduler::requestId(1, 0), ConflictScheduler::requestId(1, 1));
+}
+
+}  // namespace
@@ -115,4 +115,81 @@ TEST_F(PreProcessReplyMsgTestFixture, getResultHashSignature) {
   clearDiagnosticsHandlers();
 }
 
+TEST_F(PreProcessReplyMsgTestFixture, signBatch) {
+  ASSERT_TRUE(sigManager);
+  config.batchedPreProcessEnabled = true;
+  config.preExecutionBatchResultSigningEnabled = true;
+  ASSERT_TRUE(PreProcessReplyMsg::batchedSignaturesEnabled());
+  const NodeIdType senderId = config.replicaId;
+  const uint16_t clientId = 1;
+  const uint16_t batchSize = 5;
+  ViewNum viewNum = 1;
+  std::list<PreProcessReplyMsgSharedPtr> replies;
+  for (uint16_t i = 0; i < batchSize; i++) {
+    const std::string result = "request body " + std::to_string(i);
+    replies.push_back(std::make_shared<PreProcessReplyMsg>(senderId,
+                                                           clientId,
+                                                           i,
+                                                           100 + i,
+                                                           0,
+                                                           result.c_str(),
+                                                           result.size(),
+                                                           "cid" + std::to_string(i),
+                                                           STATUS_GOOD,
+                                                           OperationResult::SUCCESS,
+                                                           viewNum,
+                                                           0,
+                                                           false));
+    EXPECT_TRUE(replies.back()->getResultHashSignature().empty());
+  }
+  PreProcessReplyMsg::signBatch(replies);
+  ASSERT_EQ(size_t{batchSize}, replies.size());
+  uint16_t i = 0;
+  for (const auto& reply : replies) {
+    EXPECT_EQ(i, reply->reqOffsetInBatch());
+    EXPECT_EQ("cid" + std::to_string(i++), reply->getCid());
+    const auto signature = reply->getResultHashSignature();
+    EXPECT_GT(signature.size(), sigManager->getMySigLength());
+    std::vector<char> hash(reply->resultsHash(), reply->resultsHash() + concord::util::SHA3_256::SIZE_IN_BYTES);
+    EXPECT_TRUE(sigManager->verifyReplicaResultSig(
+        senderId, hash.data(), hash.size(), signature.data(), signature.size()));
+    // The inclusion path doesn't hold for another result hash
+    hash[0] ^= 1;
+    EXPECT_FALSE(sigManager->verifyReplicaResultSig(
+        senderId, hash.data(), hash.size(), signature.data(), signature.size()));
+  }
+  config.batchedPreProcessEnabled = false;
+  config.preExecutionBatchResultSigningEnabled = false;
+  clearDiagnosticsHandlers();
+}
+
+TEST_F(PreProcessReplyMsgTestFixture, unsignedWithMacAuthenticators) {
+  ASSERT_TRUE(sigManager);
+  config.enableReplicaMacAuthenticators = true;
+  ASSERT_FALSE(PreProcessReplyMsg::resultSignaturesEnabled());
+  const NodeIdType senderId = 1;
+  const char preProcessResultBuf[] = "request body";
+  auto preProcessReplyMsg = PreProcessReplyMsg(senderId,
+                                               1,
+                                               0,
+                                               100,
+                                               0,
+                                               preProcessResultBuf,
+                                               sizeof(preProcessResultBuf),
+                                               "cid",
+                                               STATUS_GOOD,
+                                               OperationResult::SUCCESS,
+                                               1);
+  // Only the primary receives the reply, and the MAC of its sender authenticates it
+  EXPECT_TRUE(preProcessReplyMsg.getResultHashSignature().empty());
+  EXPECT_NO_THROW(preProcessReplyMsg.validate(replicaInfo));
+
+  // The signatures are still needed when the primary forwards them
+  config.preExecutionResultAuthEnabled = true;
+  EXPECT_TRUE(PreProcessReplyMsg::resultSignaturesEnabled());
+  config.preExecutionResultAuthEnabled = false;
+  config.enableReplicaMacAuthenticators = false;
+  clearDiagnosticsHandlers();
+}
+
 }  // namespace
@@ -229,6 +229,21 @@ TEST_F(PreProcessResultMsgTestFixture, ShrinkSignaturesToSize) {
   EXPECT_THAT(deserialized.size(), numRepliesNeeded);
 }
 
+TEST_F(PreProcessResultMsgTestFixture, CertificateDeserialization) {
+  std::vector<char> msgSig{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14};
+  const PreProcessResultCertificate certificate{301, OperationResult::EXEC_DATA_TOO_LARGE, std::vector<char>(msgSig)};
+  auto certificateBuf = certificate.serialize();
+  EXPECT_EQ(certificate, PreProcessResultCertificate::deserialize(certificateBuf.data(), certificateBuf.size()));
+
+  // Neither a truncated signature nor trailing bytes are accepted
+  EXPECT_THROW(PreProcessResultCertificate::deserialize(certificateBuf.data(), certificateBuf.size() - 1),
+               std::runtime_error);
+  certificateBuf.push_back(0);
+  EXPECT_THROW(PreProcessResultCertificate::deserialize(certificateBuf.data(), certificateBuf.size()),
+               std::runtime_error);
+  EXPECT_THROW(PreProcessResultCertificate::deserialize(certificateBuf.data(), sizeof(SeqNum)), std::runtime_error);
+}
+
 TEST_F(PreProcessResultMsgTestFixture, MsgDeserialisation) {
   MsgParams params;
   auto serialised = createMessage(params, replicaInfo.getNumberOfReplicas());
@@ -0,0 +1,213 @@
+// Concord
+//
+// Copyright (c) 2022 VMware, Inc. All Rights Reserved.
+//
+// This product is licensed to you under the Apache 2.0 license (the "License"). You may not use this product except in
+// compliance with the Apache 2.0 License.
+//
+// This product may include a number of subcomponents with separate copyright notices and license terms. Your use of
+// these subcomponents is subject to the terms and conditions of the sub-component's license, as noted in the LICENSE
+// file.
+
+// The certificate of a pre-execution result when preExecutionResultThresholdAuthEnabled: the primary combines it from
+// the threshold signature shares of fVal + 1 replicas, and the other replicas validate it in the PrePrepare. The tests
+// run as the primary, replica 0, with real BLS keys for all the replicas.
+
+#include "gtest/gtest.h"
+
+#include "RequestProcessingState.hpp"
+#include "messages/PreProcessResultMsg.hpp"
+#include "messages/PreProcessResultHashCreator.hpp"
+#include "CryptoManager.hpp"
+#include "ReplicaConfig.hpp"
+#include "threshsign/ThresholdSignaturesTypes.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace bftEngine;
+using namespace bftEngine::impl;
+using namespace preprocessor;
+
+constexpr uint16_t kNumOfReplicas = 4;
+constexpr uint16_t kFVal = 1;
+constexpr ReplicaId kPrimary = 0;
+constexpr uint16_t kClientId = 5;
+constexpr ReqId kReqSeqNum = 10;
+constexpr SeqNum kSeqNum = 7;
+const std::string kCid = "cid";
+const std::string kResult = "result of the pre-execution";
+
+// The threshold signers of all the replicas. The CryptoManager of this process holds the keys of the primary.
+class Replicas {
+ public:
+  static Replicas& instance() {
+    static Replicas replicas;
+    return replicas;
+  }
+
+  std::vector<char> sign(ReplicaId replica, const concord::util::SHA3_256::Digest& hash) const {
+    const auto& signer = signers_.at(replica);
+    std::vector<char> sigShare(signer->requiredLengthForSignedData());
+    signer->signData(reinterpret_cast<const char*>(hash.data()), hash.size(), sigShare.data(), sigShare.size());
+    return sigShare;
+  }
+
+ private:
+  Replicas() {
+    auto& config = ReplicaConfig::instance();
+    config.numReplicas = kNumOfReplicas;
+    config.fVal = kFVal;
+    config.cVal = 0;
+    config.replicaId = kPrimary;
+    config.maxExternalMessageSize = 2000000;
+    config.preExecutionResultAuthEnabled = true;
+    config.preExecutionResultThresholdAuthEnabled = true;
+
+    // As ReplicaLoader does
+    Cryptosystem cryptoSys(MULTISIG_BLS_SCHEME, "BN-P254", kNumOfReplicas, kNumOfReplicas);
+    cryptoSys.generateNewPseudorandomKeys();
+    const auto privateKeys = cryptoSys.getSystemPrivateKeys();
+    for (uint16_t i = 0; i < kNumOfReplicas; i++) {
+      cryptoSys.loadPrivateKey(i + 1, privateKeys[i + 1]);
+      signers_.emplace_back(cryptoSys.createThresholdSigner());
+    }
+    cryptoSys.loadPrivateKey(kPrimary + 1, privateKeys[kPrimary + 1]);
+    CryptoManager::instance(std::make_unique<Cryptosystem>(cryptoSys));
+    RequestProcessingState::init(kFVal + 1, nullptr);
+  }
+
+  std::vector<std::unique_ptr<IThresholdSigner>> signers_;
+};
+
+class ResultCertificateTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    Replicas::instance();
+    state_ = preProcessed(kResult);
+  }
+
+  // The state of the primary once it pre-executed the request into result
+  static std::unique_ptr<RequestProcessingState> preProcessed(const std::string& result) {
+    auto state = std::make_unique<RequestProcessingState>(
+        kPrimary, kNumOfReplicas, "", kClientId, 0, kCid, kReqSeqNum, nullptr, nullptr);
+    state->handlePrimaryPreProcessed(result.data(), result.size(), OperationResult::SUCCESS);
+    return state;
+  }
+
+  static void addReply(RequestProcessingState& state, ReplicaId sender, std::vector<char> sigShare) {
+    state.handlePreProcessReplyMsg(std::make_shared<PreProcessReplyMsg>(sender,
+                                                                        kClientId,
+                                                                        0,
+                                                                        kReqSeqNum,
+                                                                        0,
+                                                                        state.getResultHash().data(),
+                                                                        sigShare.data(),
+                                                                        sigShare.size(),
+                                                                        kCid,
+                                                                        STATUS_GOOD,
+                                                                        OperationResult::SUCCESS,
+                                                                        0));
+  }
+
+  void addReply(ReplicaId sender, std::vector<char> sigShare) { addReply(*state_, sender, std::move(sigShare)); }
+  void addReply(ReplicaId sender) { addReply(sender, Replicas::instance().sign(sender, state_->getResultHash())); }
+
+  // A share of sender on the result of another request
+  static std::vector<char> invalidShare(ReplicaId sender) {
+    auto otherHash = preProcessed(kResult + " of another request")->getResultHash();
+    return Replicas::instance().sign(sender, otherHash);
+  }
+
+  // The PreProcessResultMsg of the primary, as in the PrePrepare
+  static std::unique_ptr<PreProcessResultMsg> resultMsg(const PreProcessResultCertificate& certificate) {
+    return std::make_unique<PreProcessResultMsg>(kClientId,
+                                                 static_cast<uint32_t>(OperationResult::SUCCESS),
+                                                 kReqSeqNum,
+                                                 kResult.size(),
+                                                 kResult.data(),
+                                                 0,
+                                                 kCid,
+                                                 concordUtils::SpanContext{},
+                                                 nullptr,
+                                                 0,
+                                                 certificate.serialize());
+  }
+
+  std::unique_ptr<RequestProcessingState> state_;
+};
+
+TEST_F(ResultCertificateTest, f_plus_1_shares_combine_into_a_valid_certificate) {
+  ASSERT_EQ(state_->definePreProcessingConsensusResult(), CONTINUE);
+  addReply(2);
+  ASSERT_EQ(state_->definePreProcessingConsensusResult(), COMPLETE);
+
+  const auto& certificate = state_->getPreProcessResultCertificate();
+  EXPECT_EQ(certificate.key_seq_num, 0u);
+  EXPECT_EQ(certificate.pre_process_result, OperationResult::SUCCESS);
+  EXPECT_EQ(resultMsg(certificate)->validatePreProcessResultCertificate(kSeqNum), std::nullopt);
+}
+
+TEST_F(ResultCertificateTest, invalid_share_is_dropped_and_another_one_waited_for) {
+  addReply(1, invalidShare(1));
+  ASSERT_EQ(state_->definePreProcessingConsensusResult(), CONTINUE);
+  ASSERT_EQ(state_->getNumOfReceivedReplicas(), 1);
+
+  // Replica 1 was dropped along with its share, so that a share it sends again is accepted
+  addReply(1);
+  ASSERT_EQ(state_->getNumOfReceivedReplicas(), 2);
+  addReply(3);
+  ASSERT_EQ(state_->definePreProcessingConsensusResult(), COMPLETE);
+  EXPECT_EQ(resultMsg(state_->getPreProcessResultCertificate())->validatePreProcessResultCertificate(kSeqNum),
+            std::nullopt);
+}
+
+TEST_F(ResultCertificateTest, invalid_share_of_another_signer_is_dropped_with_its_sender) {
+  // Replica 3 sends an invalid share with the signer id of replica 2, which is not among the senders
+  addReply(3, invalidShare(2));
+  ASSERT_EQ(state_->definePreProcessingConsensusResult(), CONTINUE);
+  ASSERT_EQ(state_->getNumOfReceivedReplicas(), 1);
+
+  addReply(2);
+  ASSERT_EQ(state_->definePreProcessingConsensusResult(), COMPLETE);
+  EXPECT_EQ(resultMsg(state_->getPreProcessResultCertificate())->validatePreProcessResultCertificate(kSeqNum),
+            std::nullopt);
+}
+
+TEST_F(ResultCertificateTest, certificate_with_keys_of_a_later_seq_num_is_rejected) {
+  addReply(2);
+  ASSERT_EQ(state_->definePreProcessingConsensusResult(), COMPLETE);
+  auto certificate = state_->getPreProcessResultCertificate();
+  certificate.key_seq_num = kSeqNum + 1;
+  EXPECT_NE(resultMsg(certificate)->validatePreProcessResultCertificate(kSeqNum), std::nullopt);
+  certificate.key_seq_num = kSeqNum;
+  EXPECT_EQ(resultMsg(certificate)->validatePreProcessResultCertificate(kSeqNum), std::nullopt);
+}
+
+TEST_F(ResultCertificateTest, tampered_certificate_is_rejected) {
+  addReply(2);
+  ASSERT_EQ(state_->definePreProcessingConsensusResult(), COMPLETE);
+  const auto& certificate = state_->getPreProcessResultCertificate();
+
+  // The signature of another result
+  auto otherState = preProcessed(kResult + " of another request");
+  addReply(*otherState, 2, Replicas::instance().sign(2, otherState->getResultHash()));
+  ASSERT_EQ(otherState->definePreProcessingConsensusResult(), COMPLETE);
+  auto tampered = certificate;
+  tampered.signature = otherState->getPreProcessResultCertificate().signature;
+  EXPECT_NE(resultMsg(tampered)->validatePreProcessResultCertificate(kSeqNum), std::nullopt);
+
+  auto truncated = certificate;
+  truncated.signature.pop_back();
+  EXPECT_NE(resultMsg(truncated)->validatePreProcessResultCertificate(kSeqNum), std::nullopt);
+
+  // The certificate of an error result
+  auto otherResult = certificate;
+  otherResult.pre_process_result = OperationResult::INTERNAL_ERROR;
+  EXPECT_NE(resultMsg(otherResult)->validatePreProcessResultCertificate(kSeqNum), std::nullopt);
+}
+
+}  // namespace
@@ -0,0 +1,110 @@
+// Concord
+//
+// Copyright (c) 2022 VMware, Inc. All Rights Reserved.
+//
+// This product is licensed to you under the Apache 2.0 license (the "License"). You may not use this product except in
+// compliance with the Apache 2.0 License.
+//
+// This product may include a number of subcomponents with separate copyright notices and license terms.
+// Your use of these subcomponents is subject to the terms and conditions of the sub-component's license,
+// as noted in the LICENSE file.
+
+#include "gtest/gtest.h"
+
+#include "AdmissionControl.hpp"
+
+#include <thread>
+
+namespace {
+
+using namespace bftEngine::impl;
+using namespace std::chrono_literals;
+
+constexpr auto kMaxRetryAfter = 1000ms;
+
+class AdmissionControl_test : public ::testing::Test {
+ protected:
+  AdmissionControl_test()
+      : metrics_{"replica", std::make_shared<concordMetrics::Aggregator>()},
+        admissionControl_{AdmissionControl::Limits{100, 1000, 10, kMaxRetryAfter},
+                          [this]() { return requestsInQueue_; },
+                          [this]() { return pendingRequests_; },
+                          metrics_} {}
+
+  uint64_t requestsInQueue_ = 0;
+  uint64_t pendingRequests_ = 0;
+  concordMetrics::Component metrics_;
+  AdmissionControl admissionControl_;
+};
+
+TEST_F(AdmissionControl_test, admits_under_high_watermark) {
+  requestsInQueue_ = 89;
+  pendingRequests_ = 899;
+  ASSERT_FALSE(admissionControl_.admit());
+  ASSERT_FALSE(admissionControl_.overloaded());
+  ASSERT_DOUBLE_EQ(0.899, admissionControl_.load());
+}
+
+TEST_F(AdmissionControl_test, load_is_the_fullest_limit) {
+  requestsInQueue_ = 10;
+  pendingRequests_ = 100;
+  for (int i = 0; i < 9; ++i) admissionControl_.onPreProcessorRequestStarted();
+  ASSERT_DOUBLE_EQ(0.9, admissionControl_.load());
+  ASSERT_TRUE(admissionControl_.admit());
+  admissionControl_.onPreProcessorRequestReleased();
+  ASSERT_DOUBLE_EQ(0.8, admissionControl_.load());
+}
+
+TEST_F(AdmissionControl_test, turns_away_until_low_watermark) {
+  requestsInQueue_ = 90;
+  const auto retryAfter = admissionControl_.admit();
+  ASSERT_TRUE(retryAfter);
+  ASSERT_TRUE(admissionControl_.overloaded());
+
+  // Hysteresis: still overloaded between the watermarks
+  requestsInQueue_ = 75;
+  ASSERT_TRUE(admissionControl_.admit());
+  requestsInQueue_ = 69;
+  ASSERT_FALSE(admissionControl_.admit());
+  ASSERT_FALSE(admissionControl_.overloaded());
+  requestsInQueue_ = 75;
+  ASSERT_FALSE(admissionControl_.admit());
+}
+
+TEST_F(AdmissionControl_test, retry_after_grows_with_load) {
+  requestsInQueue_ = 90;
+  const auto atHighWatermark = admissionControl_.admit();
+  requestsInQueue_ = 100;
+  const auto full = admissionControl_.admit();
+  requestsInQueue_ = 200;
+  const auto overfull = admissionControl_.admit();
+  requestsInQueue_ = 70;
+  const auto atLowWatermark = admissionControl_.admit();
+
+  ASSERT_TRUE(atHighWatermark && full && overfull && atLowWatermark);
+  ASSERT_EQ(AdmissionControl::MIN_RETRY_AFTER, *atLowWatermark);
+  ASSERT_GT(*atHighWatermark, *atLowWatermark);
+  ASSERT_GT(*full, *atHighWatermark);
+  ASSERT_EQ(kMaxRetryAfter, *full);
+  ASSERT_EQ(kMaxRetryAfter, *overfull);
+}
+
+TEST_F(AdmissionControl_test, one_busy_reply_per_client_per_retry_time) {
+  ASSERT_TRUE(admissionControl_.shouldSendBusyReply(1, 50ms));
+  // Another request of the same client within its retry time, and a request of another client
+  ASSERT_FALSE(admissionControl_.shouldSendBusyReply(1, 50ms));
+  ASSERT_TRUE(admissionControl_.shouldSendBusyReply(2, 50ms));
+  std::this_thread::sleep_for(60ms);
+  ASSERT_TRUE(admissionControl_.shouldSendBusyReply(1, 50ms));
+  ASSERT_FALSE(admissionControl_.shouldSendBusyReply(1, 50ms));
+}
+
+TEST(AdmissionControl_limits_test, zero_limit_is_ignored) {
+  concordMetrics::Component metrics{"replica", std::make_shared<concordMetrics::Aggregator>()};
+  AdmissionControl admissionControl{
+      AdmissionControl::Limits{100, 0, 0, 0ms}, []() { return 10u; }, []() { return 1000000u; }, metrics};
+  ASSERT_DOUBLE_EQ(0.1, admissionControl.load());
+  ASSERT_FALSE(admissionControl.admit());
+}
+
+}  // namespace
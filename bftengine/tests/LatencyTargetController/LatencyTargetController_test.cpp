@@ -0,0 +1,106 @@
+// Concord
+//
+// Copyright (c) 2022 VMware, Inc. All Rights Reserved.
+//
+// This product is licensed to you under the Apache 2.0 license (the "License"). You may not use this product except in
+// compliance with the Apache 2.0 License.
+//
+// This product may include a number of subcomponents with separate copyright notices and license terms.
+// Your use of these subcomponents is subject to the terms and conditions of the sub-component's license,
+// as noted in the LICENSE file.
+
+#include "gtest/gtest.h"
+
+#include "LatencyTargetController.hpp"
+
+namespace {
+
+using namespace bftEngine::batchingLogic;
+using namespace std::chrono_literals;
+
+constexpr auto kTarget = 100ms;
+constexpr uint32_t kMaxBatchSize = 400;
+constexpr auto kMaxFlushPeriod = 1000ms;
+
+// Commits batches with this latency, with this queue depth before each one
+void commit(LatencyTargetController& controller,
+            size_t numBatches,
+            std::chrono::microseconds latency,
+            uint64_t requestsInQueue) {
+  for (size_t i = 0; i < numBatches; ++i) {
+    controller.onBatchClosed(requestsInQueue);
+    controller.onBatchCommitted(latency);
+  }
+}
+
+// Fills the window up to the first step, and runs it
+void warmUp(LatencyTargetController& controller, std::chrono::microseconds latency, uint64_t requestsInQueue) {
+  commit(controller, LatencyTargetController::WINDOW_SAMPLES, latency, requestsInQueue);
+}
+
+void commitStep(LatencyTargetController& controller, std::chrono::microseconds latency, uint64_t requestsInQueue) {
+  commit(controller, LatencyTargetController::STEP_SAMPLES, latency, requestsInQueue);
+}
+
+TEST(LatencyTargetController_test, starts_within_limits) {
+  LatencyTargetController controller{kTarget, 100, kMaxBatchSize, kMaxFlushPeriod};
+  ASSERT_EQ(100u, controller.batchSize());
+  ASSERT_EQ(kTarget, controller.flushPeriod());
+
+  LatencyTargetController bounded{kTarget, 1000, kMaxBatchSize, 10ms};
+  ASSERT_EQ(kMaxBatchSize, bounded.batchSize());
+  ASSERT_EQ(10ms, bounded.flushPeriod());
+}
+
+TEST(LatencyTargetController_test, waits_for_a_full_window) {
+  LatencyTargetController controller{kTarget, 100, kMaxBatchSize, kMaxFlushPeriod};
+  commit(controller, LatencyTargetController::WINDOW_SAMPLES - 1, 150ms, 1000);
+  ASSERT_EQ(100u, controller.batchSize());
+  ASSERT_EQ(kTarget, controller.flushPeriod());
+}
+
+TEST(LatencyTargetController_test, shrinks_batches_over_target) {
+  LatencyTargetController controller{kTarget, 100, kMaxBatchSize, kMaxFlushPeriod};
+  warmUp(controller, 150ms, 1000);
+  ASSERT_EQ(150ms, controller.p99Latency());
+  ASSERT_EQ(75u, controller.batchSize());
+  ASSERT_LT(controller.flushPeriod(), kTarget);
+
+  for (int i = 0; i < 50; ++i) commitStep(controller, 150ms, 1000);
+  ASSERT_EQ(1u, controller.batchSize());
+  ASSERT_EQ(LatencyTargetController::MIN_FLUSH_PERIOD, controller.flushPeriod());
+}
+
+TEST(LatencyTargetController_test, grows_batches_with_headroom_and_backlog) {
+  LatencyTargetController controller{kTarget, 100, kMaxBatchSize, kMaxFlushPeriod};
+  warmUp(controller, 20ms, 1000);
+  ASSERT_EQ(110u, controller.batchSize());
+
+  for (int i = 0; i < 50; ++i) commitStep(controller, 20ms, 1000);
+  ASSERT_EQ(kMaxBatchSize, controller.batchSize());
+}
+
+TEST(LatencyTargetController_test, keeps_batch_size_without_backlog) {
+  LatencyTargetController controller{kTarget, 100, kMaxBatchSize, kMaxFlushPeriod};
+  for (int i = 0; i < 20; ++i) commitStep(controller, 20ms, 10);
+  ASSERT_EQ(100u, controller.batchSize());
+  // The flush period converges to the budget left after the commit latency
+  ASSERT_NEAR(80, controller.flushPeriod().count(), 1);
+}
+
+TEST(LatencyTargetController_test, holds_in_the_headroom_band) {
+  LatencyTargetController controller{kTarget, 100, kMaxBatchSize, kMaxFlushPeriod};
+  for (int i = 0; i < 20; ++i) commitStep(controller, 90ms, 1000);
+  ASSERT_EQ(100u, controller.batchSize());
+}
+
+TEST(LatencyTargetController_test, p99_ignores_rare_outliers) {
+  LatencyTargetController controller{kTarget, 100, kMaxBatchSize, kMaxFlushPeriod};
+  // A single slow batch out of the 128 of the window is above the 99th percentile
+  commit(controller, 1, 1s, 1000);
+  commit(controller, LatencyTargetController::WINDOW_SAMPLES - 1, 20ms, 1000);
+  ASSERT_EQ(20ms, controller.p99Latency());
+  ASSERT_EQ(110u, controller.batchSize());
+}
+
+}  // namespace
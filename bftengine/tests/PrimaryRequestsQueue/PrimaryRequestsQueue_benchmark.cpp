@@ -0,0 +1,150 @@
+// Concord
+//
+// Copyright (c) 2022 VMware, Inc. All Rights Reserved.
+//
+// This product is licensed to you under the Apache 2.0 license (the "License").  You may not use this product except in
+// compliance with the Apache 2.0 License.
+//
+// This product may include a number of subcomponents with separate copyright notices and license terms. Your use of
+// these subcomponents is subject to the terms and conditions of the subcomponent's license, as noted in the LICENSE
+// file.
+
+// Throughput and fairness of the primary's requests queue under a skewed workload, against the FIFO queue it replaced.
+//
+// Requests of 100 clients arrive with Zipf-like skew: client i sends in proportion to 1 / (i + 1), so the first client
+// sends ~20% of the requests, and 10% of the requests are retries. Batches of 100 requests are taken as they arrive.
+// Counters:
+// - fairness: Jain's index of the requests each client gets in a batch, relative to its max-min fair share of the
+//   batch given the requests it has queued. 1 when every client gets its fair share.
+// - duplicates: the share of the queued requests that were duplicates of requests already in the queue.
+
+#include <benchmark/benchmark.h>
+
+#include "PrimaryRequestsQueue.hpp"
+
+#include <algorithm>
+#include <queue>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+using namespace bftEngine::impl;
+
+constexpr size_t kNumClients = 100;
+constexpr size_t kBatchSize = 100;
+constexpr size_t kArrivalsPerBatch = 120;
+constexpr double kRetryRate = 0.1;
+
+struct Request {
+  NodeIdType clientProxyId() const { return clientId; }
+  ReqId requestSeqNum() const { return reqSeqNum; }
+  NodeIdType clientId;
+  ReqId reqSeqNum;
+};
+
+// The same arrivals for both queues
+std::vector<Request> arrivals(size_t count) {
+  std::vector<double> weights;
+  for (size_t i = 0; i < kNumClients; ++i) weights.push_back(1.0 / static_cast<double>(i + 1));
+  std::mt19937 rng{1};
+  std::discrete_distribution<size_t> client(weights.begin(), weights.end());
+  std::bernoulli_distribution retry(kRetryRate);
+  std::vector<ReqId> lastSeqNum(kNumClients, 0);
+  std::vector<Request> requests;
+  for (size_t i = 0; i < count; ++i) {
+    const auto c = client(rng);
+    if (!retry(rng) || lastSeqNum[c] == 0) ++lastSeqNum[c];
+    requests.push_back({static_cast<NodeIdType>(c), lastSeqNum[c]});
+  }
+  return requests;
+}
+
+struct FifoQueue {
+  bool push(Request* r) {
+    q.push(r);
+    return true;
+  }
+  Request* front() const { return q.front(); }
+  void pop() { q.pop(); }
+  bool empty() const { return q.empty(); }
+  std::queue<Request*> q;
+};
+
+// Max-min fair shares of a batch among clients with these numbers of queued requests
+std::vector<double> fairShares(const std::vector<size_t>& queued) {
+  std::vector<size_t> order;
+  for (size_t c = 0; c < queued.size(); ++c) {
+    if (queued[c] > 0) order.push_back(c);
+  }
+  std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return queued[a] < queued[b]; });
+  std::vector<double> shares(queued.size(), 0);
+  double left = kBatchSize;
+  for (size_t i = 0; i < order.size(); ++i) {
+    const double share = std::min(static_cast<double>(queued[order[i]]), left / static_cast<double>(order.size() - i));
+    shares[order[i]] = share;
+    left -= share;
+  }
+  return shares;
+}
+
+double jainIndex(const std::vector<size_t>& served, const std::vector<double>& shares) {
+  double sum = 0, sumOfSquares = 0, n = 0;
+  for (size_t c = 0; c < served.size(); ++c) {
+    if (shares[c] == 0) continue;
+    const double x = static_cast<double>(served[c]) / shares[c];
+    sum += x;
+    sumOfSquares += x * x;
+    ++n;
+  }
+  return sumOfSquares > 0 ? sum * sum / (n * sumOfSquares) : 1;
+}
+
+template <typename Queue>
+void skewedClients(benchmark::State& state) {
+  const size_t numBatches = 1000;
+  auto requests = arrivals(numBatches * kArrivalsPerBatch);
+  double fairnessSum = 0;
+  size_t queuedRequests = 0;
+  size_t queuedDuplicates = 0;
+
+  for (auto _ : state) {
+    Queue queue;
+    // Of the requests in the queue, per client and per (client, sequence number)
+    std::vector<size_t> queued(kNumClients, 0);
+    std::unordered_map<uint64_t, size_t> copies;
+    size_t next = 0;
+    for (size_t b = 0; b < numBatches; ++b) {
+      for (size_t i = 0; i < kArrivalsPerBatch; ++i) {
+        auto* r = &requests[next++];
+        if (!queue.push(r)) continue;
+        ++queued[r->clientId];
+        ++queuedRequests;
+        if (copies[(static_cast<uint64_t>(r->clientId) << 48) | r->reqSeqNum]++ > 0) ++queuedDuplicates;
+      }
+
+      const auto shares = fairShares(queued);
+      std::vector<size_t> served(kNumClients, 0);
+      for (size_t i = 0; i < kBatchSize && !queue.empty(); ++i) {
+        auto* r = queue.front();
+        queue.pop();
+        ++served[r->clientId];
+        --queued[r->clientId];
+        --copies[(static_cast<uint64_t>(r->clientId) << 48) | r->reqSeqNum];
+      }
+      fairnessSum += jainIndex(served, shares);
+    }
+    benchmark::DoNotOptimize(queue);
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * numBatches * kArrivalsPerBatch));
+  state.counters["fairness"] = fairnessSum / static_cast<double>(state.iterations() * numBatches);
+  state.counters["duplicates"] = static_cast<double>(queuedDuplicates) / static_cast<double>(queuedRequests);
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(skewedClients, FifoQueue);
+BENCHMARK_TEMPLATE(skewedClients, PrimaryRequestsQueue<Request>);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,125 @@
+// Concord
+//
+// Copyright (c) 2022 VMware, Inc. All Rights Reserved.
+//
+// This product is licensed to you under the Apache 2.0 license (the "License").  You may not use this product except in
+// compliance with the Apache 2.0 License.
+//
+// This product may include a number of subcomponents with separate copyright notices and license terms. Your use of
+// these subcomponents is subject to the terms and conditions of the subcomponent's license, as noted in the LICENSE
+// file.
+
+#include "gtest/gtest.h"
+
+#include "PrimaryRequestsQueue.hpp"
+
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace {
+
+using namespace bftEngine::impl;
+
+struct Request {
+  NodeIdType clientProxyId() const { return clientId; }
+  ReqId requestSeqNum() const { return reqSeqNum; }
+  NodeIdType clientId;
+  ReqId reqSeqNum;
+};
+
+class PrimaryRequestsQueue_test : public ::testing::Test {
+ protected:
+  Request* newRequest(NodeIdType clientId, ReqId reqSeqNum) {
+    requests_.push_back(std::make_unique<Request>(Request{clientId, reqSeqNum}));
+    return requests_.back().get();
+  }
+  std::vector<std::pair<NodeIdType, ReqId>> popAll() {
+    std::vector<std::pair<NodeIdType, ReqId>> popped;
+    while (!queue_.empty()) {
+      popped.emplace_back(queue_.front()->clientId, queue_.front()->reqSeqNum);
+      queue_.pop();
+    }
+    return popped;
+  }
+
+  PrimaryRequestsQueue<Request> queue_;
+  std::vector<std::unique_ptr<Request>> requests_;
+};
+
+TEST_F(PrimaryRequestsQueue_test, clients_take_turns) {
+  for (ReqId i = 1; i <= 3; ++i) ASSERT_TRUE(queue_.push(newRequest(1, i)));
+  ASSERT_TRUE(queue_.push(newRequest(2, 1)));
+  ASSERT_TRUE(queue_.push(newRequest(3, 1)));
+  ASSERT_TRUE(queue_.push(newRequest(3, 2)));
+  ASSERT_EQ(6u, queue_.size());
+  ASSERT_EQ(3u, queue_.numClients());
+
+  const std::vector<std::pair<NodeIdType, ReqId>> expected = {{1, 1}, {2, 1}, {3, 1}, {1, 2}, {3, 2}, {1, 3}};
+  ASSERT_EQ(expected, popAll());
+  ASSERT_EQ(0u, queue_.numClients());
+}
+
+TEST_F(PrimaryRequestsQueue_test, client_that_comes_back_waits_for_its_turn) {
+  queue_.push(newRequest(1, 1));
+  queue_.push(newRequest(1, 2));
+  queue_.push(newRequest(2, 1));
+  queue_.pop();
+  queue_.pop();
+  // Client 2 had no more requests, it is now behind client 1
+  queue_.push(newRequest(2, 2));
+  const std::vector<std::pair<NodeIdType, ReqId>> expected = {{1, 2}, {2, 2}};
+  ASSERT_EQ(expected, popAll());
+}
+
+TEST_F(PrimaryRequestsQueue_test, duplicates_are_dropped_on_arrival) {
+  ASSERT_TRUE(queue_.push(newRequest(1, 5)));
+  ASSERT_TRUE(queue_.contains(1, 5));
+  ASSERT_FALSE(queue_.push(newRequest(1, 5)));
+  ASSERT_TRUE(queue_.push(newRequest(2, 5)));
+  ASSERT_EQ(2u, queue_.size());
+
+  popAll();
+  ASSERT_FALSE(queue_.contains(1, 5));
+  ASSERT_TRUE(queue_.push(newRequest(1, 5)));
+}
+
+TEST_F(PrimaryRequestsQueue_test, full_queue_evicts_from_the_largest_client) {
+  for (ReqId i = 1; i <= 5; ++i) queue_.push(newRequest(1, i));
+  queue_.push(newRequest(2, 1));
+
+  auto* evicted = queue_.evictForClient(3);
+  ASSERT_NE(nullptr, evicted);
+  ASSERT_EQ(1, evicted->clientId);
+  ASSERT_EQ(5u, evicted->reqSeqNum);
+  ASSERT_FALSE(queue_.contains(1, 5));
+  ASSERT_EQ(5u, queue_.size());
+
+  // A client doesn't evict its own requests, nor those of a client that would be left with no more than it has
+  ASSERT_EQ(nullptr, queue_.evictForClient(1));
+  PrimaryRequestsQueue<Request> balanced;
+  balanced.push(newRequest(1, 1));
+  balanced.push(newRequest(1, 2));
+  balanced.push(newRequest(2, 1));
+  ASSERT_EQ(nullptr, balanced.evictForClient(2));
+}
+
+// One client floods the queue before nine others send a few requests each. Every client gets its share of the first
+// batch, where a FIFO queue would fill it with requests of the flooding client only.
+TEST_F(PrimaryRequestsQueue_test, skewed_clients_share_batches) {
+  constexpr size_t kBatchSize = 50;
+  for (ReqId i = 1; i <= 900; ++i) queue_.push(newRequest(0, i));
+  for (NodeIdType client = 1; client < 10; ++client) {
+    for (ReqId i = 1; i <= 10; ++i) queue_.push(newRequest(client, i));
+  }
+
+  std::map<NodeIdType, size_t> perClient;
+  for (size_t i = 0; i < kBatchSize; ++i) {
+    ++perClient[queue_.front()->clientId];
+    queue_.pop();
+  }
+  ASSERT_EQ(10u, perClient.size());
+  for (const auto& [client, count] : perClient) ASSERT_EQ(kBatchSize / 10, count) << "client " << client;
+}
+
+}  // namespace
@@ -0,0 +1,203 @@
+// Concord
+//
+// Copyright (c) 2022 VMware, Inc. All Rights Reserved.
+//
+// This product is licensed to you under the Apache 2.0 license (the "License").  You may not use this product except in
+// compliance with the Apache 2.0 License.
+//
+// This product may include a number of subcomponents with separate copyright notices and license terms. Your use of
+// these subcomponents is subject to the terms and conditions of the subcomponent's license, as noted in the LICENSE
+// file.
+
+#include "ReplicaMacAuthenticator.hpp"
+#include "messages/MsgCode.hpp"
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace bftEngine::impl;
+
+namespace {
+
+constexpr uint16_t kNumReplicas = 4;
+
+std::vector<char> makeMessage(MsgType type, size_t size) {
+  std::vector<char> msg(size);
+  for (size_t i = 0; i < size; ++i) msg[i] = static_cast<char>(i);
+  std::memcpy(msg.data(), &type, sizeof(type));
+  return msg;
+}
+
+// Stands for the RSA signatures of the replicas: the signed data followed by the id of the signer
+ReplicaMacAuthenticator::Sign signerOf(ReplicaId id) {
+  return [id](const char* data, size_t dataLength) { return std::string(data, dataLength) + static_cast<char>(id); };
+}
+
+bool verifySignature(ReplicaId signer, const char* data, size_t dataLength, const char* sig, size_t sigLength) {
+  return std::string(sig, sigLength) == std::string(data, dataLength) + static_cast<char>(signer);
+}
+
+// Replicas connected by a network that delivers messages right away, and records the handshakes it delivers
+class Cluster {
+ public:
+  explicit Cluster(bool handshake) {
+    for (ReplicaId i = 0; i < kNumReplicas; ++i) start(i);
+    if (!handshake) return;
+    for (auto& replica : replicas_) replica->sendHandshakes();
+    for (ReplicaId i = 0; i < kNumReplicas; ++i) {
+      for (ReplicaId j = 0; j < kNumReplicas; ++j) EXPECT_EQ(replicas_[i]->hasSessionKey(j), i != j);
+    }
+  }
+
+  // (Re)starts a replica, with a new key and without the keys of its peers
+  void start(ReplicaId id) {
+    auto replica = std::make_unique<ReplicaMacAuthenticator>(id, kNumReplicas, signerOf(id), verifySignature);
+    replica->setSend([this, id](bft::communication::NodeNum dest, std::vector<uint8_t>&& message) {
+      handshakes_.push_back(message);
+      replicas_[dest]->verify(id, reinterpret_cast<const char*>(message.data()), message.size());
+    });
+    if (id < replicas_.size()) {
+      replicas_[id] = std::move(replica);
+    } else {
+      replicas_.push_back(std::move(replica));
+    }
+  }
+
+  ReplicaMacAuthenticator& operator[](ReplicaId id) { return *replicas_[id]; }
+  const std::vector<std::vector<uint8_t>>& handshakes() const { return handshakes_; }
+
+ private:
+  std::vector<std::unique_ptr<ReplicaMacAuthenticator>> replicas_;
+  std::vector<std::vector<uint8_t>> handshakes_;
+};
+
+std::optional<size_t> deliver(ReplicaMacAuthenticator& dest, ReplicaId sender, const std::vector<uint8_t>& message) {
+  return dest.verify(sender, reinterpret_cast<const char*>(message.data()), message.size());
+}
+
+TEST(ReplicaMacAuthenticator, messagesWithoutSessionKeysAreRejected) {
+  Cluster replicas(false);
+  const auto msg = makeMessage(MsgCode::PrePrepare, 100);
+  const auto out = replicas[0].authenticate(msg.data(), msg.size(), {1, 2, 3});
+  ASSERT_EQ(out.size(), msg.size() + sizeof(ReplicaMacAuthenticator::NumEntries));
+  for (ReplicaId i = 1; i < kNumReplicas; ++i) {
+    ASSERT_FALSE(deliver(replicas[i], 0, out).has_value());
+    ASSERT_EQ(replicas[i].stats().rejected, 1u);
+  }
+  // Client requests, which are signed, are still accepted
+  const auto request = makeMessage(MsgCode::ClientRequest, 100);
+  const auto length = deliver(replicas[1], 0, replicas[0].authenticate(request.data(), request.size(), {1}));
+  ASSERT_TRUE(length.has_value());
+  ASSERT_EQ(*length, request.size());
+  ASSERT_EQ(replicas[1].stats().selfAuthenticated, 1u);
+}
+
+TEST(ReplicaMacAuthenticator, handshakes) {
+  Cluster replicas(true);
+  for (ReplicaId i = 0; i < kNumReplicas; ++i) {
+    ASSERT_EQ(replicas[i].numOfSessionKeys(), kNumReplicas - 1);
+    ASSERT_EQ(replicas[i].stats().handshakes, kNumReplicas - 1u);
+  }
+  // Replica i asked all its peers with higher ids, which answered
+  ASSERT_EQ(replicas.handshakes().size(), size_t{kNumReplicas} * (kNumReplicas - 1));
+  // Nothing to do once all the session keys exist
+  replicas[0].sendHandshakes();
+  ASSERT_EQ(replicas.handshakes().size(), size_t{kNumReplicas} * (kNumReplicas - 1));
+}
+
+TEST(ReplicaMacAuthenticator, broadcast) {
+  Cluster replicas(true);
+  const auto msg = makeMessage(MsgCode::PrePrepare, 4096);
+  const auto out = replicas[0].authenticate(msg.data(), msg.size(), {1, 2, 3});
+  ASSERT_EQ(out.size(),
+            msg.size() + 3 * sizeof(ReplicaMacAuthenticator::Entry) + sizeof(ReplicaMacAuthenticator::NumEntries));
+  for (ReplicaId i = 1; i < kNumReplicas; ++i) {
+    const auto length = deliver(replicas[i], 0, out);
+    ASSERT_TRUE(length.has_value());
+    ASSERT_EQ(*length, msg.size());
+    ASSERT_EQ(std::memcmp(out.data(), msg.data(), msg.size()), 0);
+    ASSERT_EQ(replicas[i].stats().authenticated, 1u);
+  }
+  // The authenticator is bound to its sender
+  ASSERT_FALSE(deliver(replicas[2], 1, out).has_value());
+}
+
+TEST(ReplicaMacAuthenticator, tamperedMessagesAreRejected) {
+  Cluster replicas(true);
+  const auto msg = makeMessage(MsgCode::CommitPartial, 256);
+  const auto out = replicas[0].authenticate(msg.data(), msg.size(), {1});
+
+  auto tampered = out;
+  tampered[100] ^= 1;
+  ASSERT_FALSE(deliver(replicas[1], 0, tampered).has_value());
+
+  tampered = out;
+  tampered[msg.size() + sizeof(uint16_t)] ^= 1;  // the MAC of the entry
+  ASSERT_FALSE(deliver(replicas[1], 0, tampered).has_value());
+
+  tampered = out;
+  tampered.back() = 0x7f;  // number of entries larger than the message
+  ASSERT_FALSE(deliver(replicas[1], 0, tampered).has_value());
+
+  // Not a destination of the message
+  ASSERT_FALSE(deliver(replicas[2], 0, out).has_value());
+  ASSERT_EQ(replicas[1].stats().rejected, 3u);
+  ASSERT_EQ(replicas[1].stats().authenticated, 0u);
+}
+
+TEST(ReplicaMacAuthenticator, restartedReplicaRecovers) {
+  Cluster replicas(true);
+  replicas.start(3);
+
+  const auto prePrepare = makeMessage(MsgCode::PrePrepare, 128);
+  ASSERT_FALSE(deliver(replicas[0], 3, replicas[3].authenticate(prePrepare.data(), prePrepare.size(), {0})));
+
+  // Its peers replace its key and answer with theirs
+  replicas[3].sendHandshakes();
+  ASSERT_EQ(replicas[3].numOfSessionKeys(), kNumReplicas - 1);
+  ASSERT_TRUE(deliver(replicas[0], 3, replicas[3].authenticate(prePrepare.data(), prePrepare.size(), {0})));
+  ASSERT_TRUE(deliver(replicas[3], 0, replicas[0].authenticate(prePrepare.data(), prePrepare.size(), {3})));
+  ASSERT_EQ(replicas[0].stats().authenticated, 1u);
+}
+
+TEST(ReplicaMacAuthenticator, invalidHandshakesAreRejected) {
+  Cluster replicas(true);
+  // A handshake of the previous run of replica 3 to replica 0
+  const auto oldHandshake = replicas.handshakes()[4];
+  ReplicaMacAuthenticator::Handshake header;
+  std::memcpy(&header, oldHandshake.data(), sizeof(header));
+  ASSERT_EQ(header.senderId, 0);
+  ASSERT_EQ(header.destId, 3);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  replicas.start(0);
+  replicas[0].sendHandshakes();
+  const auto prePrepare = makeMessage(MsgCode::PrePrepare, 128);
+  ASSERT_TRUE(deliver(replicas[3], 0, replicas[0].authenticate(prePrepare.data(), prePrepare.size(), {3})));
+
+  // Replaying it doesn't bring back the old key
+  ASSERT_FALSE(deliver(replicas[3], 0, oldHandshake));
+  ASSERT_EQ(replicas[3].stats().rejected, 1u);
+  ASSERT_TRUE(deliver(replicas[3], 0, replicas[0].authenticate(prePrepare.data(), prePrepare.size(), {3})));
+
+  // Nor can it be sent by another replica, or to another replica
+  ASSERT_FALSE(deliver(replicas[3], 1, oldHandshake));
+  ASSERT_FALSE(deliver(replicas[2], 0, oldHandshake));
+  ASSERT_EQ(replicas[3].stats().rejected, 2u);
+  ASSERT_EQ(replicas[2].stats().rejected, 1u);
+
+  // A new key with an invalid signature
+  auto forged = oldHandshake;
+  header.keyCreationTime = std::numeric_limits<uint64_t>::max();
+  std::memcpy(forged.data(), &header, sizeof(header));
+  ASSERT_FALSE(deliver(replicas[3], 0, forged));
+  ASSERT_EQ(replicas[3].stats().rejected, 3u);
+  ASSERT_TRUE(deliver(replicas[3], 0, replicas[0].authenticate(prePrepare.data(), prePrepare.size(), {3})));
+}
+
+}  // namespace
@@ -0,0 +1,97 @@
+// Concord
+//
+// Copyright (c) 2022 VMware, Inc. All Rights Reserved.
+//
+// This product is licensed to you under the Apache 2.0 license (the "License").  You may not use this product except in
+// compliance with the Apache 2.0 License.
+//
+// This product may include a number of subcomponents with separate copyright notices and license terms. Your use of
+// these subcomponents is subject to the terms and conditions of the subcomponent's license, as noted in the LICENSE
+// file.
+
+// Throughput of SigManager lookups and signature verifications by many threads at once.
+//
+// Every thread verifies signatures of peer replicas, as the consensus and pre-processing threads do. The lookup-only
+// benchmark shows the cost of finding the verifier of a principal, without the cost of the verification itself.
+
+#include <benchmark/benchmark.h>
+
+#include "SigManager.hpp"
+#include "ReplicasInfo.hpp"
+#include "crypto_utils.hpp"
+#include "helper.hpp"
+
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using namespace bftEngine::impl;
+using concord::util::crypto::Crypto;
+using concord::util::crypto::KeyFormat;
+using concord::util::crypto::RSASigner;
+
+constexpr uint32_t kRsaSigLength = 2048;
+const auto kData = std::string(1024, 'x');
+
+struct Setup {
+  Setup() : replicasInfo{createReplicaConfig(1, 0), false, false} {
+    const auto numReplicas = ReplicaConfig::instance().numReplicas;
+    std::set<std::pair<PrincipalId, const std::string>> publicKeysOfReplicas;
+    std::string myPrivateKey;
+    for (PrincipalId id = 0; id < numReplicas; ++id) {
+      const auto [priv, pub] = Crypto::instance().generateRsaKeyPair(kRsaSigLength, KeyFormat::PemFormat);
+      if (id == 0) {
+        myPrivateKey = priv;
+        continue;
+      }
+      publicKeysOfReplicas.emplace(id, pub);
+      auto signer = RSASigner(priv, KeyFormat::PemFormat);
+      signatures.emplace_back(id, signer.sign(kData));
+    }
+    sigManager.reset(SigManager::init(
+        0, myPrivateKey, publicKeysOfReplicas, KeyFormat::PemFormat, nullptr, KeyFormat::PemFormat, replicasInfo));
+  }
+
+  ReplicasInfo replicasInfo;
+  std::unique_ptr<SigManager> sigManager;
+  std::vector<std::pair<PrincipalId, std::string>> signatures;
+};
+
+Setup& setup() {
+  static Setup s;
+  return s;
+}
+
+void verifierLookup(benchmark::State& state) {
+  auto& s = setup();
+  const auto& signatures = s.signatures;
+  auto i = size_t{0};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(s.sigManager->getSigLength(signatures[i++ % signatures.size()].first));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+void verifySignature(benchmark::State& state) {
+  auto& s = setup();
+  const auto& signatures = s.signatures;
+  auto i = size_t{0};
+  for (auto _ : state) {
+    const auto& [id, sig] = signatures[i++ % signatures.size()];
+    if (!s.sigManager->verifySig(id, kData.data(), kData.size(), sig.data(), sig.size())) {
+      state.SkipWithError("Verification failed");
+      break;
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+}  // namespace
+
+BENCHMARK(verifierLookup)->ThreadRange(1, 32)->UseRealTime();
+BENCHMARK(verifySignature)->ThreadRange(1, 32)->UseRealTime();
+BENCHMARK_MAIN();
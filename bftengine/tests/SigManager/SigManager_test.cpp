@@ -11,6 +11,7 @@
 
 #include "SigManager.hpp"
 #include "helper.hpp"
+#include "bftengine/ClientRequestBatchSignature.hpp"
 
 #include <cryptopp/dll.h>
 #include <cryptopp/rsa.h>
@@ -358,3 +359,156 @@ TEST(SigManagerTest, ReplicasAndClientsCheckVerify) {
     ASSERT_TRUE((expectFailure && !signatureValid) || (!expectFailure && signatureValid));
   }
 }
+
+TEST(SigManagerTest, ClientsMerkleBatchedSignatures) {
+  constexpr size_t numReplicas{4};
+  constexpr size_t numOfClientProxies{16};
+  constexpr PrincipalId myId{0};
+  constexpr PrincipalId clientId{numReplicas + numOfClientProxies};
+  constexpr uint32_t batchSize{7};
+  string myPrivKey, clientPrivKey, clientPubKey;
+  set<pair<PrincipalId, const string>> publicKeysOfReplicas;
+  set<pair<const string, set<uint16_t>>> publicKeysOfClients;
+
+  generateKeyPairs(2);
+  readFile(string(KEYS_BASE_PATH) + "/1/" + PRIV_KEY_NAME, myPrivKey);
+  readFile(string(KEYS_BASE_PATH) + "/2/" + PRIV_KEY_NAME, clientPrivKey);
+  readFile(string(KEYS_BASE_PATH) + "/2/" + PUB_KEY_NAME, clientPubKey);
+  publicKeysOfClients.insert(make_pair(clientPubKey, set<uint16_t>{clientId}));
+  concord::util::crypto::RSASigner clientSigner(clientPrivKey, concord::util::crypto::KeyFormat::PemFormat);
+
+  auto& config = createReplicaConfig(1, 0);
+  config.numReplicas = numReplicas;
+  config.numRoReplicas = 0;
+  config.numOfClientProxies = numOfClientProxies;
+  config.numOfExternalClients = 1;
+  ReplicasInfo replicaInfo(config, false, false);
+  unique_ptr<SigManager> sigManager(SigManager::init(myId,
+                                                     myPrivKey,
+                                                     publicKeysOfReplicas,
+                                                     concord::util::crypto::KeyFormat::PemFormat,
+                                                     &publicKeysOfClients,
+                                                     concord::util::crypto::KeyFormat::PemFormat,
+                                                     replicaInfo));
+
+  vector<string> requests;
+  vector<bftEngine::batch_signature::Hash> leaves;
+  for (uint32_t i = 0; i < batchSize; ++i) {
+    char data[RANDOM_DATA_SIZE]{0};
+    generateRandomData(data, RANDOM_DATA_SIZE);
+    requests.emplace_back(data, RANDOM_DATA_SIZE);
+    leaves.push_back(bftEngine::batch_signature::leafHash(requests.back().data(), requests.back().size()));
+  }
+  const auto tree = bftEngine::batch_signature::MerkleTree{leaves};
+  const auto digest = bftEngine::batch_signature::batchDigest(tree.size(), tree.root());
+  const auto rootSig = clientSigner.sign(string(digest.begin(), digest.end()));
+
+  for (uint32_t i = 0; i < batchSize; ++i) {
+    auto sig = bftEngine::batch_signature::serialize(rootSig, i, tree);
+    ASSERT_GT(sig.size(), rootSig.size());
+    ASSERT_EQ(sig.size(), sigManager->getClientRequestSigLength(clientId, sig.data(), sig.size()));
+    ASSERT_TRUE(
+        sigManager->verifyClientRequestSig(clientId, requests[i].data(), requests[i].size(), sig.data(), sig.size()));
+
+    // A request that is not part of the batch fails, even though the batch digest was already verified.
+    auto tampered = requests[i];
+    corrupt(tampered.data(), tampered.size());
+    ASSERT_FALSE(
+        sigManager->verifyClientRequestSig(clientId, tampered.data(), tampered.size(), sig.data(), sig.size()));
+
+    // A path of a different leaf fails.
+    const auto otherSig = bftEngine::batch_signature::serialize(rootSig, (i + 1) % batchSize, tree);
+    ASSERT_FALSE(sigManager->verifyClientRequestSig(
+        clientId, requests[i].data(), requests[i].size(), otherSig.data(), otherSig.size()));
+  }
+
+  // Malformed batched signatures are rejected by length.
+  auto truncated = bftEngine::batch_signature::serialize(rootSig, 0, tree);
+  truncated.pop_back();
+  ASSERT_EQ(0, sigManager->getClientRequestSigLength(clientId, truncated.data(), truncated.size()));
+
+  // Plain signatures are still supported.
+  const auto plainSig = clientSigner.sign(requests[0]);
+  ASSERT_EQ(plainSig.size(), sigManager->getClientRequestSigLength(clientId, plainSig.data(), plainSig.size()));
+  ASSERT_TRUE(sigManager->verifyClientRequestSig(
+      clientId, requests[0].data(), requests[0].size(), plainSig.data(), plainSig.size()));
+}
+
+TEST(SigManagerTest, VerifiedRequestsCache) {
+  VerifiedRequestsCache cache(2);
+  const auto d1 = VerifiedRequestsCache::digestOf("req1", 4, "sig1", 4);
+  const auto d2 = VerifiedRequestsCache::digestOf("req2", 4, "sig2", 4);
+  cache.insert(1, 10, d1);
+  ASSERT_TRUE(cache.contains(1, 10, d1));
+  // Same request sequence number with a different request or signature.
+  ASSERT_FALSE(cache.contains(1, 10, d2));
+  ASSERT_FALSE(cache.contains(17, 10, d1));
+
+  cache.erase(1, 10);
+  ASSERT_FALSE(cache.contains(1, 10, d1));
+
+  // Clients 1 and 17 share a shard, the oldest entry is evicted.
+  cache.insert(1, 11, d1);
+  cache.insert(17, 11, d1);
+  cache.insert(1, 12, d2);
+  ASSERT_FALSE(cache.contains(1, 11, d1));
+  ASSERT_TRUE(cache.contains(17, 11, d1));
+  ASSERT_TRUE(cache.contains(1, 12, d2));
+
+  cache.clear(1);
+  ASSERT_FALSE(cache.contains(1, 12, d2));
+  ASSERT_EQ(1, cache.size());
+}
+
+TEST(SigManagerTest, ClientsVerifiedRequestsAreCached) {
+  constexpr size_t numReplicas{4};
+  constexpr size_t numOfClientProxies{16};
+  constexpr PrincipalId myId{0};
+  constexpr PrincipalId clientId{numReplicas + numOfClientProxies};
+  constexpr ReqId reqSeqNum{100};
+  string myPrivKey, clientPrivKey, clientPubKey;
+  set<pair<PrincipalId, const string>> publicKeysOfReplicas;
+  set<pair<const string, set<uint16_t>>> publicKeysOfClients;
+
+  generateKeyPairs(2);
+  readFile(string(KEYS_BASE_PATH) + "/1/" + PRIV_KEY_NAME, myPrivKey);
+  readFile(string(KEYS_BASE_PATH) + "/2/" + PRIV_KEY_NAME, clientPrivKey);
+  readFile(string(KEYS_BASE_PATH) + "/2/" + PUB_KEY_NAME, clientPubKey);
+  publicKeysOfClients.insert(make_pair(clientPubKey, set<uint16_t>{clientId}));
+  concord::util::crypto::RSASigner clientSigner(clientPrivKey, concord::util::crypto::KeyFormat::PemFormat);
+
+  auto& config = createReplicaConfig(1, 0);
+  config.numReplicas = numReplicas;
+  config.numRoReplicas = 0;
+  config.numOfClientProxies = numOfClientProxies;
+  config.numOfExternalClients = 1;
+  ReplicasInfo replicaInfo(config, false, false);
+  unique_ptr<SigManager> sigManager(SigManager::init(myId,
+                                                     myPrivKey,
+                                                     publicKeysOfReplicas,
+                                                     concord::util::crypto::KeyFormat::PemFormat,
+                                                     &publicKeysOfClients,
+                                                     concord::util::crypto::KeyFormat::PemFormat,
+                                                     replicaInfo));
+
+  char data[RANDOM_DATA_SIZE]{0};
+  generateRandomData(data, RANDOM_DATA_SIZE);
+  const auto request = string(data, RANDOM_DATA_SIZE);
+  const auto sig = clientSigner.sign(request);
+
+  // Verified once, and then again from the cache.
+  for (int i = 0; i < 2; ++i) {
+    ASSERT_TRUE(sigManager->verifyClientRequestSig(
+        clientId, reqSeqNum, request.data(), request.size(), sig.data(), sig.size()));
+  }
+
+  // A different request with the same sequence number isn't taken from the cache.
+  auto tampered = request;
+  corrupt(tampered.data(), tampered.size());
+  ASSERT_FALSE(sigManager->verifyClientRequestSig(
+      clientId, reqSeqNum, tampered.data(), tampered.size(), sig.data(), sig.size()));
+
+  sigManager->onClientRequestCommitted(clientId, reqSeqNum);
+  ASSERT_TRUE(sigManager->verifyClientRequestSig(
+      clientId, reqSeqNum, request.data(), request.size(), sig.data(), sig.size()));
+}
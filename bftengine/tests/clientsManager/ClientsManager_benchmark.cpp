@@ -0,0 +1,110 @@
+// Concord
+//
+// Copyright (c) 2022 VMware, Inc. All Rights Reserved.
+//
+// This product is licensed to you under the Apache 2.0 license (the "License").  You may not use this product except in
+// compliance with the Apache 2.0 License.
+//
+// This product may include a number of subcomponents with separate copyright notices and license terms. Your use of
+// these subcomponents is subject to the terms and conditions of the subcomponent's license, as noted in the LICENSE
+// file.
+
+// Throughput of the clients table with 20000 external clients, accessed by several threads as the dispatcher, the
+// pre-processor and the request threads do.
+//
+// - requestLifecycle: each thread owns a disjoint range of clients, and takes a request of one of them through the
+//   checks of an incoming request (hasReply, isClientRequestInProcess, canBecomePending), makes it pending and removes
+//   it as executed. Threads only share the table and the count of pending requests.
+// - lookupsOfOtherClients: the checks only, on any client, as done for requests that are already replied or retried.
+// - earliestPendingRequest: the scan of the client monitor, with 1% of the clients holding a pending request.
+// Counters:
+// - clients: the number of clients in the table.
+
+#include <benchmark/benchmark.h>
+
+#include "ClientsManager.hpp"
+#include "ReservedPagesMock.hpp"
+#include "ReplicaConfig.hpp"
+#include "Metrics.hpp"
+
+#include <memory>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace bftEngine;
+using namespace bftEngine::impl;
+
+constexpr NodeIdType kFirstClientId = 100;
+constexpr NodeIdType kNumClients = 20000;
+
+bftEngine::test::ReservedPagesMock<ClientsManager> resPagesMock;
+concordMetrics::Component metrics{"replica", std::make_shared<concordMetrics::Aggregator>()};
+
+ClientsManager& clientsManager() {
+  static std::unique_ptr<ClientsManager> cm = [] {
+    ReservedPagesClientBase::setReservedPages(&resPagesMock);
+    std::set<NodeIdType> externalClients;
+    for (NodeIdType i = 0; i < kNumClients; ++i) externalClients.insert(kFirstClientId + i);
+    return std::unique_ptr<ClientsManager>(new ClientsManager({}, externalClients, {}, {}, metrics));
+  }();
+  return *cm;
+}
+
+void requestLifecycle(benchmark::State& state) {
+  auto& cm = clientsManager();
+  const NodeIdType clientsPerThread = kNumClients / static_cast<NodeIdType>(state.threads());
+  const NodeIdType firstClient = kFirstClientId + static_cast<NodeIdType>(state.thread_index()) * clientsPerThread;
+  const std::string cid = "cid";
+  std::vector<ReqId> lastSeqNum(clientsPerThread, 0);
+  NodeIdType next = 0;
+  for (auto _ : state) {
+    const NodeIdType clientId = firstClient + next;
+    const ReqId reqSeqNum = ++lastSeqNum[next];
+    if (++next == clientsPerThread) next = 0;
+
+    benchmark::DoNotOptimize(cm.hasReply(clientId, reqSeqNum));
+    benchmark::DoNotOptimize(cm.isClientRequestInProcess(clientId, reqSeqNum));
+    if (cm.canBecomePending(clientId, reqSeqNum)) cm.addPendingRequest(clientId, reqSeqNum, cid);
+    benchmark::DoNotOptimize(cm.isPending(clientId, reqSeqNum));
+    cm.removePendingForExecutionRequest(clientId, reqSeqNum);
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+  state.counters["clients"] = benchmark::Counter(kNumClients, benchmark::Counter::kAvgThreads);
+}
+
+void lookupsOfOtherClients(benchmark::State& state) {
+  auto& cm = clientsManager();
+  std::mt19937 rng{static_cast<uint32_t>(state.thread_index()) + 1};
+  std::uniform_int_distribution<NodeIdType> client(kFirstClientId, kFirstClientId + kNumClients - 1);
+  for (auto _ : state) {
+    const NodeIdType clientId = client(rng);
+    benchmark::DoNotOptimize(cm.isValidClient(clientId));
+    benchmark::DoNotOptimize(cm.hasReply(clientId, 1));
+    benchmark::DoNotOptimize(cm.isClientRequestInProcess(clientId, 1));
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+  state.counters["clients"] = benchmark::Counter(kNumClients, benchmark::Counter::kAvgThreads);
+}
+
+void earliestPendingRequest(benchmark::State& state) {
+  auto& cm = clientsManager();
+  for (NodeIdType i = 0; i < kNumClients; i += 100) cm.addPendingRequest(kFirstClientId + i, 1, "cid");
+  std::string cid;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(cm.infoOfEarliestPendingRequest(cid));
+  }
+  cm.clearAllPendingRequests();
+  state.counters["clients"] = benchmark::Counter(kNumClients, benchmark::Counter::kAvgThreads);
+}
+
+}  // namespace
+
+BENCHMARK(requestLifecycle)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(lookupsOfOtherClients)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(earliestPendingRequest);
+
+BENCHMARK_MAIN();
@@ -17,6 +17,9 @@
 #include "messages/ClientReplyMsg.hpp"
 #include "ReservedPagesMock.hpp"
 
+#include <atomic>
+#include <thread>
+
 using bftEngine::impl::ClientsManager;
 using bftEngine::impl::NodeIdType;
 using bftEngine::impl::ReplicasInfo;
@@ -29,6 +32,7 @@ using concord::util::crypto::KeyFormat;
 using concord::util::crypto::RSASigner;
 using concord::secretsmanager::ISecretsManagerImpl;
 using concordUtil::Timers;
+using std::atomic_bool;
 using std::chrono::milliseconds;
 using std::ifstream;
 using std::map;
@@ -39,6 +43,7 @@ using std::set;
 using std::shared_ptr;
 using std::string;
 using std::string_view;
+using std::thread;
 using std::this_thread::sleep_for;
 using std::unique_ptr;
 using std::vector;
@@ -1327,6 +1332,66 @@ TEST(ClientsManager, setClientPublicKey) {
          "than the one specified to it.";
 }
 
+TEST(ClientsManager, pendingRequestsOfOverlappingClientsFromSeveralThreads) {
+  // Every thread takes requests of all the clients through pending and executed, with its own sequence numbers, while
+  // the clients already have a reply to the request with sequence number 1.
+  constexpr NodeIdType kNumClients = 8;
+  constexpr int kNumThreads = 8;
+  constexpr ReqId kRequestsPerThread = 500;
+  constexpr ReqId kRepliedSeqNum = 1;
+  resetMockReservedPages();
+  set<NodeIdType> external_clients;
+  for (NodeIdType i = 1; i <= kNumClients; ++i) external_clients.insert(i);
+  unique_ptr<ClientsManager> cm(new ClientsManager({}, external_clients, {}, {}, metrics));
+  string reply_msg = "reply";
+  for (auto id : external_clients)
+    cm->allocateNewReplyMsgAndWriteToStorage(
+        id, kRepliedSeqNum, 0, reply_msg.data(), reply_msg.length(), kRSILengthForTesting);
+
+  atomic_bool done{false};
+  thread reader([&]() {
+    // A pending request is counted once and only while it is pending, so the count never goes past the requests that
+    // the threads hold at a time, nor wraps around below 0
+    while (!done) ASSERT_LE(cm->numOfPendingRequests(), uint64_t{kNumThreads} * kNumClients);
+  });
+
+  vector<thread> threads;
+  for (int t = 0; t < kNumThreads; ++t) {
+    threads.emplace_back([&, t]() {
+      for (ReqId i = 0; i < kRequestsPerThread; ++i) {
+        const ReqId reqSeqNum = kRepliedSeqNum + 1 + t * kRequestsPerThread + i;
+        for (auto id : external_clients) {
+          EXPECT_TRUE(cm->hasReply(id, kRepliedSeqNum));
+          EXPECT_FALSE(cm->hasReply(id, reqSeqNum));
+          cm->addPendingRequest(id, reqSeqNum, "cid");
+          EXPECT_TRUE(cm->isPending(id, reqSeqNum));
+        }
+        for (auto id : external_clients) {
+          cm->removePendingForExecutionRequest(id, reqSeqNum);
+          EXPECT_FALSE(cm->isPending(id, reqSeqNum));
+        }
+      }
+    });
+  }
+  for (auto& t : threads) t.join();
+  done = true;
+  reader.join();
+  EXPECT_EQ(cm->numOfPendingRequests(), 0u);
+
+  // The same, with requests that stay pending
+  threads.clear();
+  for (int t = 0; t < kNumThreads; ++t) {
+    threads.emplace_back([&, t]() {
+      for (ReqId i = 0; i < kRequestsPerThread; ++i)
+        for (auto id : external_clients) cm->addPendingRequest(id, kRepliedSeqNum + 1 + t * kRequestsPerThread + i, "");
+    });
+  }
+  for (auto& t : threads) t.join();
+  EXPECT_EQ(cm->numOfPendingRequests(), uint64_t{kNumThreads} * kRequestsPerThread * kNumClients);
+  cm->clearAllPendingRequests();
+  EXPECT_EQ(cm->numOfPendingRequests(), 0u);
+}
+
 int main(int argc, char** argv) {
   // Some functionalit(y/ies) of ClientsManager may require the global KeyExchangeManager::instance() to be
   // initialized.
@@ -23,6 +23,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <vector>
 
 namespace {
 
@@ -142,4 +143,39 @@ TEST_F(incoming_msgs_storage_test, push_external_raw_callback_not_called_before_
   ASSERT_FALSE(popped);
 }
 
+// Messages of each traffic class wait on their own queue. Consensus messages are handled first, and then the classes
+// take turns by their weights, so that state transfer isn't starved by client requests.
+TEST_F(incoming_msgs_storage_test, external_msgs_are_handled_by_traffic_class) {
+  auto handled = std::vector<std::uint16_t>{};
+  auto done = std::promise<void>{};
+  constexpr auto kNumClientRequests = 5;
+  constexpr auto kNumMsgs = kNumClientRequests + 2;
+  auto reg = std::make_shared<MsgHandlersRegistrator>();
+  for (auto type : {MsgCode::ClientRequest, MsgCode::StateTransfer, MsgCode::PrePrepare}) {
+    reg->registerMsgHandler(type, [&](MessageBase* msg) {
+      handled.push_back(msg->type());
+      delete msg;
+      if (handled.size() == kNumMsgs) done.set_value();
+    });
+  }
+  auto storage = IncomingMsgsStorageImp{reg, msg_wait_timeout_, replica_id_};
+  for (auto i = 0; i < kNumClientRequests; ++i) {
+    ASSERT_TRUE(storage.pushExternalMsg(newMsg(MsgCode::ClientRequest)));
+  }
+  ASSERT_TRUE(storage.pushExternalMsg(newMsg(MsgCode::StateTransfer)));
+  ASSERT_TRUE(storage.pushExternalMsg(newMsg(MsgCode::PrePrepare)));
+  storage.start();
+  ASSERT_EQ(std::future_status::ready, done.get_future().wait_for(10s));
+  storage.stop();
+
+  const auto expected = std::vector<std::uint16_t>{MsgCode::PrePrepare,
+                                                   MsgCode::ClientRequest,
+                                                   MsgCode::ClientRequest,
+                                                   MsgCode::ClientRequest,
+                                                   MsgCode::ClientRequest,
+                                                   MsgCode::StateTransfer,
+                                                   MsgCode::ClientRequest};
+  ASSERT_EQ(expected, handled);
+}
+
 }  // namespace
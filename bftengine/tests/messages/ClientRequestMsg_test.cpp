@@ -339,6 +339,41 @@ TEST_F(ClientRequestMsgTestFixture, validate_size) {
   EXPECT_THROW(msg.validate(replicaInfo), std::runtime_error);
 }
 
+TEST_F(ClientRequestMsgTestFixture, validate_truncated_signature) {
+  struct TestClientRequestMsg : ClientRequestMsg {
+    using ClientRequestMsg::ClientRequestMsg;
+    void setSize(uint32_t msgSize) { ClientRequestMsg::setMsgSize(msgSize); }
+  };
+
+  NodeIdType senderId = 1u;
+  uint64_t flags = 'F';
+  uint64_t reqSeqNum = 100u;
+  const char request[] = {"request body"};
+  const uint64_t requestTimeoutMilli = 0;
+  const std::string correlationId = "correlationId";
+  const char signature[] = {"request signature"};
+  TestClientRequestMsg msg(senderId,
+                           flags,
+                           reqSeqNum,
+                           sizeof(request),
+                           request,
+                           requestTimeoutMilli,
+                           correlationId,
+                           0,
+                           concordUtils::SpanContext{},
+                           signature,
+                           sizeof(signature));
+
+  // The signature now runs past the end of the message, so the size check has to reject it before it is parsed
+  msg.setSize(msg.size() - 1);
+  try {
+    msg.validate(replicaInfo);
+    FAIL() << "A truncated message passed validation";
+  } catch (const std::runtime_error& e) {
+    EXPECT_NE(std::string(e.what()).find("Invalid msgSize"), std::string::npos) << e.what();
+  }
+}
+
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
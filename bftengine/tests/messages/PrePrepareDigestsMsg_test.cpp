@@ -0,0 +1,155 @@
+// Concord
+//
+// Copyright (c) 2022 VMware, Inc. All Rights Reserved.
+//
+// This product is licensed to you under the Apache 2.0 license (the "License"). You may not use this product except in
+// compliance with the Apache 2.0 License.
+//
+// This product may include a number of subcomponents with separate copyright notices and license terms. Your use of
+// these subcomponents is subject to the terms and conditions of the subcomponent's license, as noted in the LICENSE
+// file.
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+#include "OpenTracing.hpp"
+#include "gtest/gtest.h"
+#include "messages/PrePrepareMsg.hpp"
+#include "messages/PrePrepareDigestsMsg.hpp"
+#include "messages/ClientRequestMsg.hpp"
+#include "bftengine/ClientMsgs.hpp"
+#include "bftengine/ReplicaConfig.hpp"
+#include "helper.hpp"
+#include "ReservedPagesMock.hpp"
+#include "EpochManager.hpp"
+
+using namespace bftEngine;
+using namespace bftEngine::impl;
+
+bftEngine::test::ReservedPagesMock<EpochManager> res_pages_mock_;
+
+namespace {
+
+std::vector<std::shared_ptr<ClientRequestMsg>> createClientRequests(size_t numMsgs) {
+  std::vector<std::shared_ptr<ClientRequestMsg>> requests;
+  const char rawSpanContext[] = {"span_\0context"};
+  const std::string spanContext{rawSpanContext, sizeof(rawSpanContext)};
+  for (size_t i = 0; i < numMsgs; i++) {
+    const std::string request(100 + i * 10, 'a' + i % 26);
+    requests.push_back(std::make_shared<ClientRequestMsg>(static_cast<NodeIdType>(10 + i),
+                                                          'F',
+                                                          100u + i,
+                                                          request.size(),
+                                                          request.c_str(),
+                                                          0,
+                                                          "correlationId" + std::to_string(i),
+                                                          0,
+                                                          concordUtils::SpanContext{spanContext}));
+  }
+  return requests;
+}
+
+class PrePrepareDigestsMsgTestFixture : public ::testing::Test {
+ public:
+  PrePrepareDigestsMsgTestFixture()
+      : config{createReplicaConfig()},
+        replicaInfo(config, false, false),
+        sigManager(createSigManager(config.replicaId,
+                                    config.replicaPrivateKey,
+                                    concord::util::crypto::KeyFormat::HexaDecimalStrippedFormat,
+                                    config.publicKeysOfReplicas,
+                                    replicaInfo)) {
+    bftEngine::ReservedPagesClientBase::setReservedPages(&res_pages_mock_);
+  }
+
+  // The primary of view 1
+  std::unique_ptr<PrePrepareMsg> createPrePrepare(const std::vector<std::shared_ptr<ClientRequestMsg>>& requests) {
+    const char rawSpanContext[] = {"span_\0context"};
+    const std::string spanContext{rawSpanContext, sizeof(rawSpanContext)};
+    size_t requestsSize = 0;
+    for (const auto& req : requests) requestsSize += req->size();
+    auto pp = std::make_unique<PrePrepareMsg>(
+        1u, 1u, 3u, CommitPath::OPTIMISTIC_FAST, concordUtils::SpanContext{spanContext}, requestsSize);
+    for (const auto& req : requests) pp->addRequest(req->body(), req->size());
+    pp->setTime(12345);
+    pp->finishAddingRequests();
+    return pp;
+  }
+
+  ReplicaConfig& config;
+  ReplicasInfo replicaInfo;
+  std::unique_ptr<SigManager> sigManager;
+};
+
+TEST_F(PrePrepareDigestsMsgTestFixture, create_and_rebuild) {
+  const auto requests = createClientRequests(20);
+  const auto pp = createPrePrepare(requests);
+
+  PrePrepareDigestsMsg msg(*pp);
+  EXPECT_NO_THROW(msg.validate(replicaInfo));
+  EXPECT_EQ(msg.viewNumber(), pp->viewNumber());
+  EXPECT_EQ(msg.seqNumber(), pp->seqNumber());
+  EXPECT_EQ(msg.numberOfRequests(), requests.size());
+  EXPECT_LT(msg.size(), pp->size());
+  for (uint16_t i = 0; i < msg.numberOfRequests(); i++) {
+    const auto ref = msg.requestRef(i);
+    EXPECT_EQ(ref.clientId, requests[i]->clientProxyId());
+    EXPECT_EQ(ref.reqSeqNum, requests[i]->requestSeqNum());
+    EXPECT_EQ(ref.requestSize, requests[i]->size());
+  }
+
+  std::vector<const ClientRequestMsg*> bodies;
+  for (const auto& req : requests) bodies.push_back(req.get());
+  std::unique_ptr<PrePrepareMsg> rebuilt{msg.rebuild(bodies)};
+  EXPECT_NO_THROW(rebuilt->validate(replicaInfo));
+  EXPECT_EQ(rebuilt->senderId(), pp->senderId());
+  EXPECT_EQ(rebuilt->firstPath(), pp->firstPath());
+  EXPECT_EQ(rebuilt->getTime(), pp->getTime());
+  EXPECT_EQ(rebuilt->getCid(), pp->getCid());
+  ASSERT_EQ(rebuilt->size(), pp->size());
+  EXPECT_EQ(0, std::memcmp(rebuilt->body(), pp->body(), pp->size()));
+}
+
+TEST_F(PrePrepareDigestsMsgTestFixture, rebuilt_with_other_requests_is_invalid) {
+  const auto requests = createClientRequests(5);
+  const auto pp = createPrePrepare(requests);
+  PrePrepareDigestsMsg msg(*pp);
+
+  // Same client, sequence number and size, but another body
+  const auto others = createClientRequests(5);
+  std::memset(others[2]->requestBuf(), 'z', others[2]->requestLength());
+  std::vector<const ClientRequestMsg*> bodies;
+  for (const auto& req : others) bodies.push_back(req.get());
+  std::unique_ptr<PrePrepareMsg> rebuilt{msg.rebuild(bodies)};
+  EXPECT_THROW(rebuilt->validate(replicaInfo), std::runtime_error);
+}
+
+TEST_F(PrePrepareDigestsMsgTestFixture, refers_to_its_requests_only) {
+  const auto requests = createClientRequests(5);
+  const auto pp = createPrePrepare(requests);
+  PrePrepareDigestsMsg msg(*pp);
+  for (uint16_t i = 0; i < msg.numberOfRequests(); i++)
+    EXPECT_TRUE(PrePrepareDigestsMsg::refersTo(msg.requestRef(i), *requests[i]));
+
+  // Same client, sequence number and size, but another body: the replica asks the primary for the PrePrepare
+  const auto others = createClientRequests(5);
+  std::memset(others[2]->requestBuf(), 'z', others[2]->requestLength());
+  EXPECT_FALSE(PrePrepareDigestsMsg::refersTo(msg.requestRef(2), *others[2]));
+  EXPECT_FALSE(PrePrepareDigestsMsg::refersTo(msg.requestRef(2), *requests[3]));
+}
+
+TEST_F(PrePrepareDigestsMsgTestFixture, sent_by_non_primary_is_invalid) {
+  const auto requests = createClientRequests(5);
+  const auto pp = createPrePrepare(requests);
+  pp->updateView(2u, pp->firstPath());
+  PrePrepareDigestsMsg msg(*pp);
+  EXPECT_THROW(msg.validate(replicaInfo), std::runtime_error);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,141 @@
+// Concord
+//
+// Copyright (c) 2022 VMware, Inc. All Rights Reserved.
+//
+// This product is licensed to you under the Apache 2.0 license (the "License").  You may not use this product except in
+// compliance with the Apache 2.0 License.
+//
+// This product may include a number of subcomponents with separate copyright notices and license terms. Your use of
+// these subcomponents is subject to the terms and conditions of the subcomponent's license, as noted in the LICENSE
+// file.
+
+// Allocation cost of the per sequence number state of the 4 signature collectors of SeqNumInfo, in a window of
+// kWorkWindowSize sequence numbers with as much history, as the replica keeps it.
+//
+// Each sequence number gets a partial signature from every replica in each collector, and the window advances by a
+// checkpoint window at once, resetting as many slots. The maps of the collectors are either heap allocated unordered
+// maps, as they were, or ordered maps in a monotonic arena of the slot that the reset releases at once.
+// Arg: the number of replicas.
+// Counters:
+// - allocations: heap allocations per sequence number.
+// - advance_p99_us, advance_max_us: the latency of advancing the window, which resets a checkpoint window of slots.
+
+#include <benchmark/benchmark.h>
+
+#include "SequenceWithActiveWindow.hpp"
+#include "SysConsts.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+std::atomic_uint64_t numOfAllocations{0};
+
+}  // namespace
+
+void* operator new(std::size_t size) {
+  numOfAllocations.fetch_add(1, std::memory_order_relaxed);
+  if (void* p = std::malloc(size == 0 ? 1 : size)) return p;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+using namespace bftEngine::impl;
+
+constexpr size_t kNumOfCollectors = 4;
+
+struct RepInfo {
+  void* partialSigMsg;
+  int state;
+};
+
+struct HeapSlot {
+  std::unordered_map<ReplicaId, RepInfo> collectors[kNumOfCollectors];
+
+  static void init(HeapSlot&, void*) {}
+  static void free(HeapSlot& i) { reset(i); }
+  static void reset(HeapSlot& i) {
+    for (auto& c : i.collectors) c.clear();
+  }
+};
+
+struct ArenaSlot {
+  std::unique_ptr<char[]> arenaBuffer;
+  std::unique_ptr<std::pmr::monotonic_buffer_resource> arena;
+  std::vector<std::pmr::map<ReplicaId, RepInfo>> collectors;
+
+  // As SeqNumInfo::init()
+  static void init(ArenaSlot& i, void* d) {
+    const size_t numOfReplicas = *static_cast<size_t*>(d);
+    const size_t arenaSize = kNumOfCollectors * numOfReplicas *
+                             (sizeof(std::pmr::map<ReplicaId, RepInfo>::value_type) + 4 * sizeof(void*));
+    i.arenaBuffer.reset(new char[arenaSize]);
+    i.arena.reset(new std::pmr::monotonic_buffer_resource(i.arenaBuffer.get(), arenaSize));
+    i.collectors.reserve(kNumOfCollectors);
+    for (size_t c = 0; c < kNumOfCollectors; ++c) i.collectors.emplace_back(i.arena.get());
+  }
+  static void free(ArenaSlot& i) { reset(i); }
+  static void reset(ArenaSlot& i) {
+    for (auto& c : i.collectors) c.clear();
+    i.arena->release();
+  }
+};
+
+template <typename Slot>
+void collectorsOfWindow(benchmark::State& state) {
+  using Window = SequenceWithActiveWindow<kWorkWindowSize, 1, SeqNum, Slot, Slot, 1>;
+  size_t numOfReplicas = static_cast<size_t>(state.range(0));
+  auto window = std::make_unique<Window>(0, &numOfReplicas);
+
+  const auto fill = [&](SeqNum first) {
+    for (SeqNum s = first; s < first + checkpointWindowSize; ++s) {
+      for (auto& c : window->get(s).collectors) {
+        for (ReplicaId r = 0; r < numOfReplicas; ++r) {
+          if (c.count(r) == 0) c[r] = RepInfo{nullptr, 0};
+        }
+      }
+    }
+  };
+
+  SeqNum lastStable = 0;
+  fill(lastStable);
+  std::vector<double> advanceLatencies;
+  const auto allocationsBefore = numOfAllocations.load();
+  for (auto _ : state) {
+    fill(lastStable + checkpointWindowSize);
+    const auto start = std::chrono::steady_clock::now();
+    lastStable += checkpointWindowSize;
+    window->advanceActiveWindow(lastStable);
+    const std::chrono::duration<double, std::micro> latency = std::chrono::steady_clock::now() - start;
+    advanceLatencies.push_back(latency.count());
+  }
+  const auto allocations = numOfAllocations.load() - allocationsBefore;
+
+  const auto seqNums = state.iterations() * checkpointWindowSize;
+  state.SetItemsProcessed(static_cast<int64_t>(seqNums));
+  state.counters["allocations"] = static_cast<double>(allocations) / static_cast<double>(seqNums);
+  std::sort(advanceLatencies.begin(), advanceLatencies.end());
+  state.counters["advance_p99_us"] = advanceLatencies[advanceLatencies.size() * 99 / 100];
+  state.counters["advance_max_us"] = advanceLatencies.back();
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(collectorsOfWindow, HeapSlot)->Arg(4)->Arg(31)->Arg(100);
+BENCHMARK_TEMPLATE(collectorsOfWindow, ArenaSlot)->Arg(4)->Arg(31)->Arg(100);
+
+BENCHMARK_MAIN();
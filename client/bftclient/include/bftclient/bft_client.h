@@ -11,9 +11,15 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <optional>
 #include <chrono>
+#include <functional>
+#include <future>
+#include <random>
+#include <thread>
+#include <unordered_set>
 
 #include "communication/ICommunication.hpp"
 #include "Logger.hpp"
@@ -27,12 +33,16 @@
 #include "diagnostics.h"
 #include "crypto_utils.hpp"
 #include "seq_num_generator.h"
+#include "timer_wheel.hpp"
 
 namespace bft::client {
 
 typedef std::unordered_map<uint64_t, Reply> SeqNumToReplyMap;
 typedef std::shared_ptr<bft::communication::ICommunication> SharedCommPtr;
 
+// Called once per asynchronous request with the matched reply, or with std::nullopt if the request timed out.
+typedef std::function<void(std::optional<Reply>&&)> ReplyCallback;
+
 class Client {
  public:
   Client(SharedCommPtr comm,
@@ -43,7 +53,11 @@ class Client {
     metrics_.setAggregator(aggregator);
   }
 
-  void stop() { communication_->stop(); }
+  ~Client();
+
+  void stop() {
+    if (!communication_stopped_.exchange(true)) communication_->stop();
+  }
 
   // Send a message where the reply gets allocated by the callee and returned in a vector.
   // The message to be sent is moved into the caller to prevent unnecessary copies.
@@ -64,17 +78,41 @@ class Client {
   Reply sendThreadSafe(const WriteConfig& config, Msg&& request);
   Reply sendThreadSafe(const ReadConfig& config, Msg&& request);
 
+  // Non-blocking send. Any number of requests, each with a unique sequence number, can be outstanding at once.
+  //
+  // Replies are matched on the communication thread, as soon as they arrive, and retransmissions and timeouts are
+  // driven by a single timer thread per client. The callback is called exactly once, from one of these threads, so it
+  // must not block. The future versions throw a TimeoutException from get() if the request timed out.
+  //
+  // This API is thread safe, but must not be used concurrently with the blocking send API of the same client.
+  //
+  // Throws a BftClientException if a request with the same sequence number is already outstanding.
+  void sendAsync(const WriteConfig& config, Msg&& request, ReplyCallback&& callback);
+  void sendAsync(const ReadConfig& config, Msg&& request, ReplyCallback&& callback);
+  std::future<Reply> sendAsync(const WriteConfig& config, Msg&& request);
+  std::future<Reply> sendAsync(const ReadConfig& config, Msg&& request);
+
+  // The number of outstanding asynchronous requests.
+  size_t numAsyncRequestsInFlight();
+
+  // The time until which retransmissions are held back, after a busy reply from an overloaded replica. In the past if
+  // the replicas are not known to be busy. Thread safe.
+  std::chrono::steady_clock::time_point busyUntil() const {
+    return std::chrono::steady_clock::time_point{std::chrono::steady_clock::duration{busy_until_.load()}};
+  }
+
  private:
   // Generic function for sending a read or write message.
   Reply send(const MatchConfig& match_config, const RequestConfig& request_config, Msg&& request, bool read_only);
 
-  // Wait for messages until we get a quorum or a retry timeout.
+  // Wait for messages until we get a quorum or a retry timeout. The retry timeout is extended while the replicas are
+  // busy, up to the deadline of the request.
   //
   // Inserts the Replies to the input queue.
-  void wait(std::unordered_map<uint64_t, Reply>& replies);
+  void wait(std::unordered_map<uint64_t, Reply>& replies, std::chrono::steady_clock::time_point deadline);
 
   // Return a Reply on quorum, or std::nullopt on timeout.
-  std::optional<Reply> wait();
+  std::optional<Reply> wait(std::chrono::steady_clock::time_point deadline);
 
   // Extract a matcher configurations from operational configurations
   //
@@ -88,7 +126,21 @@ class Client {
   // data, we construct them here, rather than relying on the type constructors embedded into the
   // bftEngine impl. This allows us to not have to link with the bftengine library, and also allows us
   // to return the messages as vectors with proper RAII based memory management.
-  Msg createClientMsg(const RequestConfig& req_config, Msg&& request, bool read_only, uint16_t client_id);
+  //
+  // If `signature` is given, it is used as the request signature instead of signing the request.
+  Msg createClientMsg(const RequestConfig& req_config,
+                      Msg&& request,
+                      bool read_only,
+                      uint16_t client_id,
+                      const std::string* signature = nullptr);
+
+  // Sign all the requests of a batch with a single signature of a merkle root over the requests. Returns the signature
+  // field of every request, see ClientRequestBatchSignature.hpp.
+  std::vector<std::string> batchSign(const std::deque<WriteRequest>& write_requests);
+
+  // Clear the DIGEST_REPLIES_REQ flag of a message created by createClientMsg, so that all replicas send full replies.
+  // The flag is not covered by the request signature. Return true if the flag was set.
+  static bool requestFullReplies(Msg& msg);
 
   // This function creates a ClientBatchRequestMsg.
   Msg createClientBatchMsg(const std::deque<Msg>& client_requests,
@@ -100,6 +152,33 @@ class Client {
                 const std::string& cid,
                 std::chrono::milliseconds& max_time_to_wait);
 
+  // Generic function for sending an asynchronous read or write message.
+  void sendAsync(const MatchConfig& match_config,
+                 const RequestConfig& request_config,
+                 Msg&& request,
+                 bool read_only,
+                 ReplyCallback&& callback);
+  std::future<Reply> sendAsyncWithFuture(const RequestConfig& request_config,
+                                         const std::function<void(ReplyCallback&&)>& send_func);
+
+  // Called from the communication thread for every received reply. Returns true if the reply belongs to an
+  // outstanding asynchronous request.
+  bool onAsyncReply(UnmatchedReply& reply);
+
+  // Called from the timer thread when the retry timer of an asynchronous request expires.
+  void onAsyncRetryTimeout(uint64_t seq_num);
+
+  // Called from the communication thread for every busy reply. Holds back retransmissions if the reply is verified.
+  void onBusyReply(const BusyReply& busy);
+  bool verifyBusyReply(const BusyReply& busy);
+  // Whether seq_num is of an outstanding request, so that busy replies to former requests are ignored.
+  bool isOutstanding(uint64_t seq_num);
+
+  void transmit(const Msg& msg,
+                const std::optional<ReplicaId>& primary,
+                const std::set<bft::communication::NodeNum>& destinations);
+  void startAsyncTimerThread();
+
   MsgReceiver receiver_;
 
   SharedCommPtr communication_;
@@ -125,6 +204,9 @@ class Client {
 
   // Transaction RSA signer
   std::unique_ptr<concord::util::crypto::ISigner> transaction_signer_;
+  // The signer is not thread safe. Requests are signed under this lock rather than async_lock_, so that replies are
+  // handled while a request is being signed.
+  std::mutex sign_lock_;
 
   static constexpr int64_t MAX_VALUE_NANOSECONDS = 1000 * 1000 * 1000;  // 1 second
   static constexpr int64_t MAX_TRANSACTION_SIZE = 100 * 1024 * 1024;    // 100MB
@@ -152,6 +234,45 @@ class Client {
   uint32_t snapshot_index_ = 0;
   std::unique_ptr<Recorders> histograms_;
   std::mutex lock_;
+
+  // An outstanding asynchronous request.
+  struct AsyncRequest {
+    Matcher matcher;
+    Msg msg;
+    std::set<bft::communication::NodeNum> destinations;
+    std::string correlation_id;
+    std::chrono::steady_clock::time_point start;
+    std::chrono::steady_clock::time_point deadline;
+    concord::util::TimerWheel::Handle retry_timer;
+    ReplyCallback callback;
+  };
+
+  static constexpr std::chrono::milliseconds ASYNC_TIMER_TICK = std::chrono::milliseconds{5};
+  static constexpr size_t ASYNC_TIMER_SLOTS = 1024;
+
+  // Protects the asynchronous request state, including async_primary_ and expected_commit_time_ms_ while
+  // asynchronous requests are used.
+  std::mutex async_lock_;
+  std::unordered_map<uint64_t, AsyncRequest> async_requests_;
+  std::optional<ReplicaId> async_primary_;
+  concord::util::TimerWheel async_timers_{ASYNC_TIMER_TICK, ASYNC_TIMER_SLOTS};
+  std::once_flag async_timer_thread_started_;
+  // Replies that don't belong to an asynchronous request are only queued while a blocking request is outstanding.
+  std::atomic_bool sync_request_in_progress_{false};
+  std::atomic_bool stop_async_timer_thread_{false};
+  std::atomic_bool communication_stopped_{false};
+  std::thread async_timer_thread_;
+
+  // See busyUntil(), as a steady_clock duration since the epoch
+  std::atomic<std::chrono::steady_clock::rep> busy_until_{0};
+  // The sequence numbers of the outstanding blocking requests. A copy of the keys of reply_certificates_, that the
+  // communication thread reads.
+  std::mutex sync_seq_nums_lock_;
+  std::unordered_set<uint64_t> sync_seq_nums_;
+  // The verifiers of the busy replies of the replicas. Loaded by the constructor, then only read by the communication
+  // thread.
+  std::unordered_map<uint16_t, std::unique_ptr<concord::util::crypto::IVerifier>> replica_verifiers_;
+  std::mt19937 busy_jitter_{std::random_device{}()};
 };
 
 }  // namespace bft::client
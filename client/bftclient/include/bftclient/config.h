@@ -69,6 +69,16 @@ struct ClientConfig {
   std::optional<std::string> transaction_signing_private_key_file_path = std::nullopt;
   std::optional<concord::secretsmanager::SecretData> secrets_manager_config = std::nullopt;
   std::optional<std::string> replicas_master_key_folder_path = "./replicas_rsa_keys";
+  // With transaction signing, sign the requests of a batch with a single signature of a merkle root over the requests,
+  // instead of signing every request.
+  bool merkle_batch_signing = true;
+  // An overloaded replica turns requests away with a busy reply that asks the client to retry after some time. The
+  // client holds back its retransmissions for that time, plus a random jitter of up to half of it, but never longer
+  // than this. Busy replies are verified with the public keys in replicas_master_key_folder_path.
+  std::chrono::milliseconds max_retry_after = 5s;
+  // Send write requests to all the replicas even when the primary is known, for replicas that reference the requests
+  // in their PrePrepares instead of sending them (prePrepareDigestsOnlyEnabled).
+  bool send_writes_to_all = false;
 };
 
 // Generic per-request configuration shared by reads and writes.
@@ -81,6 +91,10 @@ struct RequestConfig {
   std::string span_context = "";
   bool key_exchange = false;
   bool reconfiguration = false;
+  // Only the designated replica (sequence_number % number of replicas) sends the full reply, the others send a digest
+  // of it. Full replies are requested from all replicas when the first retry timeout expires. The designated replica
+  // must be part of the quorum destinations for this to be useful.
+  bool digest_replies = false;
 };
 
 // The configuration for a single write request.
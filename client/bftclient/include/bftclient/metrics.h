@@ -22,7 +22,8 @@ struct Metrics {
         retransmissions{component_.RegisterCounter("retransmissions")},
         transactionSigning{component_.RegisterCounter("transactionSigning")},
         retransmissionTimer{component_.RegisterGauge("retransmissionTimer", 0)},
-        repliesCleared{component_.RegisterCounter("repliesCleared", 0)} {
+        repliesCleared{component_.RegisterCounter("repliesCleared", 0)},
+        busyReplies{component_.RegisterAtomicCounter("busyReplies")} {
     component_.Register();
   }
 
@@ -40,6 +41,8 @@ struct Metrics {
   concordMetrics::CounterHandle transactionSigning;
   concordMetrics::GaugeHandle retransmissionTimer;
   concordMetrics::CounterHandle repliesCleared;
+  // Verified busy replies, received from the communication thread
+  concordMetrics::AtomicCounterHandle busyReplies;
 };
 
 }  // namespace bft::client
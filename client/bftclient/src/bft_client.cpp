@@ -11,11 +11,13 @@
 
 #include "bftclient/bft_client.h"
 #include "bftengine/ClientMsgs.hpp"
+#include "bftengine/ClientRequestBatchSignature.hpp"
 #include "assertUtils.hpp"
 #include "secrets_manager_impl.h"
 #include "secrets_manager_enc.h"
 #include "secrets_manager_plain.h"
 #include "communication/StateControl.hpp"
+#include "scope_exit.hpp"
 
 using namespace concord::diagnostics;
 using namespace concord::secretsmanager;
@@ -59,6 +61,23 @@ Client::Client(SharedCommPtr comm, const ClientConfig& config, std::shared_ptr<c
     transaction_signer_ = std::make_unique<concord::util::crypto::RSASigner>(
         key_plaintext.value().c_str(), concord::util::crypto::KeyFormat::PemFormat);
   }
+  if (config_.replicas_master_key_folder_path) {
+    // Busy replies are verified on the communication thread, so the keys of the replicas are loaded once, here
+    SecretsManagerPlain psm;
+    for (const auto& replica : config_.all_replicas) {
+      const auto key = psm.decryptFile(config_.replicas_master_key_folder_path.value() + "/" +
+                                       std::to_string(replica.val) + "/pub_key");
+      if (!key || key->empty()) {
+        LOG_WARN(logger_, "No public key, busy replies will be ignored" << KVLOG(replica.val));
+        continue;
+      }
+      replica_verifiers_.emplace(replica.val,
+                                 std::make_unique<concord::util::crypto::RSAVerifier>(
+                                     key.value(), concord::util::crypto::Crypto::instance().getFormat(key.value())));
+    }
+  }
+  receiver_.setReplyHandler([this](UnmatchedReply& reply) { return onAsyncReply(reply); });
+  receiver_.setBusyHandler([this](const BusyReply& busy) { onBusyReply(busy); });
   communication_->setReceiver(config_.id.val, &receiver_);
   communication_->start();
   if (config_.replicas_master_key_folder_path.has_value()) {
@@ -70,7 +89,24 @@ Client::Client(SharedCommPtr comm, const ClientConfig& config, std::shared_ptr<c
   }
 }
 
-Msg Client::createClientMsg(const RequestConfig& config, Msg&& request, bool read_only, uint16_t client_id) {
+Client::~Client() {
+  // No reply or busy reply reaches the asynchronous request state once it is destroyed
+  stop();
+  stop_async_timer_thread_ = true;
+  if (async_timer_thread_.joinable()) async_timer_thread_.join();
+  auto outstanding = decltype(async_requests_){};
+  {
+    std::lock_guard<std::mutex> lg(async_lock_);
+    outstanding.swap(async_requests_);
+  }
+  for (auto& [seq_num, request] : outstanding) {
+    (void)seq_num;
+    request.callback(std::nullopt);
+  }
+}
+
+Msg Client::createClientMsg(
+    const RequestConfig& config, Msg&& request, bool read_only, uint16_t client_id, const std::string* signature) {
   uint8_t flags = read_only ? READ_ONLY_REQ : EMPTY_FLAGS_REQ;
   size_t expected_sig_len = 0;
   bool write_req_with_pre_exec = !read_only && config.pre_execute;
@@ -85,9 +121,16 @@ Msg Client::createClientMsg(const RequestConfig& config, Msg&& request, bool rea
   if (config.reconfiguration) {
     flags |= RECONFIG_FLAG;
   }
+
+  if (config.digest_replies) {
+    flags |= DIGEST_REPLIES_REQ;
+  }
   auto header_size = sizeof(ClientRequestMsgHeader);
   auto msg_size = header_size + request.size() + config.correlation_id.size() + config.span_context.size();
-  if (transaction_signer_) {
+  if (signature) {
+    expected_sig_len = signature->size();
+    msg_size += expected_sig_len;
+  } else if (transaction_signer_) {
     expected_sig_len = transaction_signer_->signatureLength();
     msg_size += expected_sig_len;
   }
@@ -118,10 +161,15 @@ Msg Client::createClientMsg(const RequestConfig& config, Msg&& request, bool rea
   // Copy the correlation ID
   std::memcpy(position, config.correlation_id.data(), config.correlation_id.size());
 
-  if (transaction_signer_) {
+  if (signature) {
+    position += config.correlation_id.size();
+    std::memcpy(position, signature->data(), signature->size());
+    header->reqSignatureLength = signature->size();
+  } else if (transaction_signer_) {
     // Sign the request data, add the signature at the end of the request
     size_t actualSigSize = 0;
     position += config.correlation_id.size();
+    std::lock_guard<std::mutex> lg(sign_lock_);
     {
       std::string sig;
       std::string data(request.begin(), request.end());
@@ -151,6 +199,13 @@ Msg Client::createClientMsg(const RequestConfig& config, Msg&& request, bool rea
   return msg;
 }
 
+bool Client::requestFullReplies(Msg& msg) {
+  auto* header = reinterpret_cast<ClientRequestMsgHeader*>(msg.data());
+  if ((header->flags & DIGEST_REPLIES_REQ) == 0) return false;
+  header->flags &= ~static_cast<uint64_t>(DIGEST_REPLIES_REQ);
+  return true;
+}
+
 Msg Client::createClientBatchMsg(const std::deque<Msg>& client_requests,
                                  uint32_t batch_buf_size,
                                  const std::string& cid,
@@ -186,10 +241,17 @@ Msg Client::initBatch(std::deque<WriteRequest>& write_requests,
   Msg client_msg;
   MatchConfig match_config;
   uint32_t max_reply_size = 0;
-  for (auto& req : write_requests) {
+  std::vector<std::string> signatures;
+  if (transaction_signer_ && config_.merkle_batch_signing && write_requests.size() > 1) {
+    signatures = batchSign(write_requests);
+  }
+  for (size_t i = 0; i < write_requests.size(); ++i) {
+    auto& req = write_requests[i];
     match_config = writeConfigToMatchConfig(req.config);
     reply_certificates_.insert(std::make_pair(req.config.request.sequence_number, Matcher(match_config)));
-    pending_requests_.push_back(createClientMsg(req.config.request, std::move(req.request), false, config_.id.val));
+    const auto* signature = signatures.empty() ? nullptr : &signatures[i];
+    pending_requests_.push_back(
+        createClientMsg(req.config.request, std::move(req.request), false, config_.id.val, signature));
     if (req.config.request.timeout > max_time_to_wait) max_time_to_wait = req.config.request.timeout;
     if (req.config.request.max_reply_size > max_reply_size) max_reply_size = req.config.request.max_reply_size;
   }
@@ -199,6 +261,33 @@ Msg Client::initBatch(std::deque<WriteRequest>& write_requests,
   return createClientBatchMsg(pending_requests_, batch_buf_size, cid, config_.id.val);
 }
 
+std::vector<std::string> Client::batchSign(const std::deque<WriteRequest>& write_requests) {
+  std::vector<bftEngine::batch_signature::Hash> leaves;
+  leaves.reserve(write_requests.size());
+  for (const auto& req : write_requests) {
+    leaves.push_back(bftEngine::batch_signature::leafHash(reinterpret_cast<const char*>(req.request.data()),
+                                                          req.request.size()));
+  }
+  const auto tree = bftEngine::batch_signature::MerkleTree{std::move(leaves)};
+  const auto digest = bftEngine::batch_signature::batchDigest(tree.size(), tree.root());
+  std::string root_sig;
+  {
+    std::lock_guard<std::mutex> lg(sign_lock_);
+    TimeRecorder scoped_timer(*histograms_->sign_duration);
+    root_sig = transaction_signer_->sign(std::string(digest.begin(), digest.end()));
+  }
+  ConcordAssertEQ(root_sig.size(), transaction_signer_->signatureLength());
+  metrics_.transactionSigning++;
+
+  std::vector<std::string> signatures;
+  signatures.reserve(write_requests.size());
+  for (uint32_t i = 0; i < tree.size(); ++i) {
+    signatures.push_back(bftEngine::batch_signature::serialize(root_sig, i, tree));
+    histograms_->transaction_size->record(write_requests[i].request.size());
+  }
+  return signatures;
+}
+
 Reply Client::send(const WriteConfig& config, Msg&& request) {
   ConcordAssertEQ(reply_certificates_.size(), 0);
   auto match_config = writeConfigToMatchConfig(config);
@@ -219,14 +308,24 @@ Reply Client::send(const MatchConfig& match_config,
                    bool read_only) {
   metrics_.retransmissionTimer.Get().Set(expected_commit_time_ms_.upperLimit());
   metrics_.updateAggregator();
+  sync_request_in_progress_ = true;
+  auto sync_request_done = concord::util::ScopeExit{[this]() {
+    sync_request_in_progress_ = false;
+    std::lock_guard<std::mutex> lg(sync_seq_nums_lock_);
+    sync_seq_nums_.clear();
+  }};
   reply_certificates_.insert(std::make_pair(request_config.sequence_number, Matcher(match_config)));
+  {
+    std::lock_guard<std::mutex> lg(sync_seq_nums_lock_);
+    sync_seq_nums_.insert(request_config.sequence_number);
+  }
   receiver_.activate(request_config.max_reply_size);
   auto orig_msg = createClientMsg(request_config, std::move(request), read_only, config_.id.val);
   auto start = std::chrono::steady_clock::now();
   auto end = start + request_config.timeout;
   while (std::chrono::steady_clock::now() < end) {
     bft::client::Msg msg(orig_msg);  // create copy here due to the loop
-    if (primary_ && !read_only) {
+    if (primary_ && !read_only && !config_.send_writes_to_all) {
       communication_->send(primary_.value().val, std::move(msg), config_.id.val);
     } else {
       std::set<bft::communication::NodeNum> dests;
@@ -236,13 +335,15 @@ Reply Client::send(const MatchConfig& match_config,
       communication_->send(dests, std::move(msg), config_.id.val);
     }
 
-    if (auto reply = wait()) {
+    if (auto reply = wait(end)) {
       expected_commit_time_ms_.add(
           std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count());
       reply_certificates_.clear();
       return reply.value();
     }
     metrics_.retransmissions++;
+    // The designated replica may be faulty or slow - don't rely on it when retrying.
+    requestFullReplies(orig_msg);
   }
 
   expected_commit_time_ms_.add(request_config.timeout.count());
@@ -254,12 +355,25 @@ SeqNumToReplyMap Client::sendBatch(std::deque<WriteRequest>& write_requests, con
   SeqNumToReplyMap replies;
   std::chrono::milliseconds max_time_to_wait = 0s;
   MatchConfig match_config = writeConfigToMatchConfig(write_requests.front().config);
+  sync_request_in_progress_ = true;
+  auto sync_request_done = concord::util::ScopeExit{[this]() {
+    sync_request_in_progress_ = false;
+    std::lock_guard<std::mutex> lg(sync_seq_nums_lock_);
+    sync_seq_nums_.clear();
+  }};
   auto batch_msg = initBatch(write_requests, cid, max_time_to_wait);
+  {
+    std::lock_guard<std::mutex> lg(sync_seq_nums_lock_);
+    for (const auto& [seq_num, matcher] : reply_certificates_) {
+      (void)matcher;
+      sync_seq_nums_.insert(seq_num);
+    }
+  }
   auto start = std::chrono::steady_clock::now();
   auto end = start + max_time_to_wait;
   while (std::chrono::steady_clock::now() < end && replies.size() != pending_requests_.size()) {
     bft::client::Msg msg(batch_msg);  // create copy here due to the loop
-    if (primary_) {
+    if (primary_ && !config_.send_writes_to_all) {
       communication_->send(primary_.value().val, std::move(msg), config_.id.val);
     } else {
       std::set<bft::communication::NodeNum> dests;
@@ -269,8 +383,17 @@ SeqNumToReplyMap Client::sendBatch(std::deque<WriteRequest>& write_requests, con
       communication_->send(dests, std::move(msg), config_.id.val);
     }
 
-    wait(replies);
+    wait(replies, end);
     metrics_.retransmissions++;
+    bool full_replies_requested = false;
+    uint32_t batch_buf_size = 0;
+    for (auto& req : pending_requests_) {
+      full_replies_requested |= requestFullReplies(req);
+      batch_buf_size += req.size();
+    }
+    if (full_replies_requested) {
+      batch_msg = createClientBatchMsg(pending_requests_, batch_buf_size, cid, config_.id.val);
+    }
   }
   reply_certificates_.clear();
   if (replies.size() == pending_requests_.size()) {
@@ -284,9 +407,9 @@ SeqNumToReplyMap Client::sendBatch(std::deque<WriteRequest>& write_requests, con
   throw BatchTimeoutException(cid);
 }
 
-std::optional<Reply> Client::wait() {
+std::optional<Reply> Client::wait(std::chrono::steady_clock::time_point deadline) {
   SeqNumToReplyMap replies;
-  wait(replies);
+  wait(replies, deadline);
   if (replies.empty()) {
     static const size_t CLEAR_MATCHER_REPLIES_THRESHOLD = 2 * config_.f_val + config_.c_val + 1;
     // reply_certificates_ should hold just one request when using this wait method
@@ -302,13 +425,15 @@ std::optional<Reply> Client::wait() {
   return reply;
 }
 
-void Client::wait(SeqNumToReplyMap& replies) {
+void Client::wait(SeqNumToReplyMap& replies, std::chrono::steady_clock::time_point deadline) {
   auto now = std::chrono::steady_clock::now();
   auto retry_timeout = std::chrono::milliseconds(expected_commit_time_ms_.upperLimit());
-  auto end_wait = now + retry_timeout;
+  const auto retry_at = now + retry_timeout;
+  // A busy reply may arrive while waiting, so the end of the wait is recomputed every time
+  auto end_wait = [&]() { return std::max(retry_at, std::min(busyUntil(), deadline)); };
   // Keep trying to receive messages until we get quorum or a retry timeout.
-  while ((now = std::chrono::steady_clock::now()) < end_wait && !reply_certificates_.empty()) {
-    auto wait_time = std::chrono::duration_cast<std::chrono::milliseconds>(end_wait - now);
+  while ((now = std::chrono::steady_clock::now()) < end_wait() && !reply_certificates_.empty()) {
+    auto wait_time = std::chrono::duration_cast<std::chrono::milliseconds>(end_wait() - now);
     auto unmatched_requests = receiver_.wait(wait_time);
     for (auto&& reply : unmatched_requests) {
       auto request = reply_certificates_.find(reply.metadata.seq_num);
@@ -327,6 +452,7 @@ void Client::wait(SeqNumToReplyMap& replies) {
 MatchConfig Client::writeConfigToMatchConfig(const WriteConfig& write_config) {
   MatchConfig mc;
   mc.sequence_number = write_config.request.sequence_number;
+  mc.digest_replies = write_config.request.digest_replies;
 
   if (std::holds_alternative<LinearizableQuorum>(write_config.quorum)) {
     mc.quorum = quorum_converter_.toMofN(std::get<LinearizableQuorum>(write_config.quorum));
@@ -339,6 +465,7 @@ MatchConfig Client::writeConfigToMatchConfig(const WriteConfig& write_config) {
 MatchConfig Client::readConfigToMatchConfig(const ReadConfig& read_config) {
   MatchConfig mc;
   mc.sequence_number = read_config.request.sequence_number;
+  mc.digest_replies = read_config.request.digest_replies;
 
   if (std::holds_alternative<LinearizableQuorum>(read_config.quorum)) {
     mc.quorum = quorum_converter_.toMofN(std::get<LinearizableQuorum>(read_config.quorum));
@@ -387,4 +514,225 @@ Reply Client::sendThreadSafe(const ReadConfig& config, Msg&& request) {
   std::lock_guard<std::mutex> lg(lock_);
   return send(config, std::move(request));
 }
+
+void Client::sendAsync(const WriteConfig& config, Msg&& request, ReplyCallback&& callback) {
+  sendAsync(writeConfigToMatchConfig(config), config.request, std::move(request), false, std::move(callback));
+}
+
+void Client::sendAsync(const ReadConfig& config, Msg&& request, ReplyCallback&& callback) {
+  sendAsync(readConfigToMatchConfig(config), config.request, std::move(request), true, std::move(callback));
+}
+
+std::future<Reply> Client::sendAsync(const WriteConfig& config, Msg&& request) {
+  return sendAsyncWithFuture(config.request, [&](ReplyCallback&& callback) {
+    sendAsync(config, std::move(request), std::move(callback));
+  });
+}
+
+std::future<Reply> Client::sendAsync(const ReadConfig& config, Msg&& request) {
+  return sendAsyncWithFuture(config.request, [&](ReplyCallback&& callback) {
+    sendAsync(config, std::move(request), std::move(callback));
+  });
+}
+
+std::future<Reply> Client::sendAsyncWithFuture(const RequestConfig& request_config,
+                                               const std::function<void(ReplyCallback&&)>& send_func) {
+  auto promise = std::make_shared<std::promise<Reply>>();
+  auto future = promise->get_future();
+  send_func([promise, seq_num = request_config.sequence_number, cid = request_config.correlation_id](
+                std::optional<Reply>&& reply) {
+    if (reply) {
+      promise->set_value(std::move(*reply));
+    } else {
+      promise->set_exception(std::make_exception_ptr(TimeoutException(seq_num, cid)));
+    }
+  });
+  return future;
+}
+
+void Client::sendAsync(const MatchConfig& match_config,
+                       const RequestConfig& request_config,
+                       Msg&& request,
+                       bool read_only,
+                       ReplyCallback&& callback) {
+  startAsyncTimerThread();
+  const auto seq_num = request_config.sequence_number;
+  std::set<bft::communication::NodeNum> destinations;
+  for (const auto& d : match_config.quorum.destinations) {
+    destinations.emplace(d.val);
+  }
+
+  // Signed before taking async_lock_, which the communication thread takes for every reply
+  Msg msg = createClientMsg(request_config, std::move(request), read_only, config_.id.val);
+  std::optional<ReplicaId> primary;
+  {
+    std::lock_guard<std::mutex> lg(async_lock_);
+    if (async_requests_.find(seq_num) != async_requests_.end()) {
+      throw BftClientException("Request with sequence number: " + std::to_string(seq_num) + " is already outstanding");
+    }
+    receiver_.activate(std::max(receiver_.maxReplySize(), request_config.max_reply_size));
+    metrics_.retransmissionTimer.Get().Set(expected_commit_time_ms_.upperLimit());
+    const auto now = std::chrono::steady_clock::now();
+    const auto retry_timeout =
+        std::min(std::chrono::milliseconds(expected_commit_time_ms_.upperLimit()), request_config.timeout);
+    const auto timer = async_timers_.add(
+        retry_timeout, [this, seq_num]() { onAsyncRetryTimeout(seq_num); }, now);
+    async_requests_.emplace(seq_num,
+                            AsyncRequest{Matcher(match_config),
+                                         msg,
+                                         destinations,
+                                         request_config.correlation_id,
+                                         now,
+                                         now + request_config.timeout,
+                                         timer,
+                                         std::move(callback)});
+    // Reads always go to all destinations, writes go to the primary if it's known, unless sent to all.
+    if (!read_only && !config_.send_writes_to_all) primary = async_primary_;
+  }
+  transmit(msg, primary, destinations);
+}
+
+bool Client::onAsyncReply(UnmatchedReply& reply) {
+  ReplyCallback callback;
+  std::optional<Reply> matched;
+  {
+    std::lock_guard<std::mutex> lg(async_lock_);
+    auto request = async_requests_.find(reply.metadata.seq_num);
+    if (request == async_requests_.end()) {
+      // Not an asynchronous request. Drop it if nobody is going to wait for it.
+      return !sync_request_in_progress_;
+    }
+    if (auto match = request->second.matcher.onReply(std::move(reply))) {
+      async_primary_ = request->second.matcher.getPrimary();
+      async_timers_.cancel(request->second.retry_timer);
+      expected_commit_time_ms_.add(std::chrono::duration_cast<std::chrono::milliseconds>(
+                                       std::chrono::steady_clock::now() - request->second.start)
+                                       .count());
+      callback = std::move(request->second.callback);
+      matched = std::move(match->reply);
+      async_requests_.erase(request);
+    }
+  }
+  if (callback) callback(std::move(matched));
+  return true;
+}
+
+void Client::onAsyncRetryTimeout(uint64_t seq_num) {
+  ReplyCallback expired_callback;
+  Msg msg;
+  std::set<bft::communication::NodeNum> destinations;
+  {
+    std::lock_guard<std::mutex> lg(async_lock_);
+    auto it = async_requests_.find(seq_num);
+    if (it == async_requests_.end()) return;
+    auto& request = it->second;
+    const auto now = std::chrono::steady_clock::now();
+    if (now >= request.deadline) {
+      expected_commit_time_ms_.add(
+          std::chrono::duration_cast<std::chrono::milliseconds>(request.deadline - request.start).count());
+      LOG_DEBUG(logger_, "Asynchronous request timed out" << KVLOG(seq_num, request.correlation_id));
+      expired_callback = std::move(request.callback);
+      async_requests_.erase(it);
+    } else if (const auto busy_until = std::min(busyUntil(), request.deadline); busy_until > now) {
+      // Hold back the retransmission while the replicas are busy
+      request.retry_timer = async_timers_.add(
+          std::max(ASYNC_TIMER_TICK, std::chrono::duration_cast<std::chrono::milliseconds>(busy_until - now)),
+          [this, seq_num]() { onAsyncRetryTimeout(seq_num); },
+          now);
+      return;
+    } else {
+      const size_t clear_matcher_replies_threshold = 2 * config_.f_val + config_.c_val + 1;
+      if (request.matcher.numDifferentReplies() > clear_matcher_replies_threshold) {
+        request.matcher.clearReplies();
+        metrics_.repliesCleared++;
+      }
+      async_primary_ = std::nullopt;
+      metrics_.retransmissions++;
+      const auto retry_timeout =
+          std::min(std::chrono::milliseconds(expected_commit_time_ms_.upperLimit()),
+                   std::chrono::duration_cast<std::chrono::milliseconds>(request.deadline - now));
+      request.retry_timer = async_timers_.add(
+          retry_timeout, [this, seq_num]() { onAsyncRetryTimeout(seq_num); }, now);
+      requestFullReplies(request.msg);
+      msg = request.msg;
+      destinations = request.destinations;
+    }
+  }
+  if (expired_callback) {
+    expired_callback(std::nullopt);
+    return;
+  }
+  // The primary is unknown after a retry timeout, so retransmit to all destinations.
+  transmit(msg, std::nullopt, destinations);
+}
+
+void Client::onBusyReply(const BusyReply& busy) {
+  if (!isOutstanding(busy.seq_num)) {
+    LOG_DEBUG(logger_,
+              "Ignoring a busy reply to a request that is not outstanding" << KVLOG(busy.from.val, busy.seq_num));
+    return;
+  }
+  if (!verifyBusyReply(busy)) {
+    LOG_WARN(logger_, "Ignoring a busy reply that could not be verified" << KVLOG(busy.from.val, busy.seq_num));
+    return;
+  }
+  metrics_.busyReplies++;
+  auto jitter = std::uniform_int_distribution<std::chrono::milliseconds::rep>{0, busy.retry_after.count() / 2};
+  const auto retry_after = std::min(busy.retry_after + std::chrono::milliseconds{jitter(busy_jitter_)},
+                                    config_.max_retry_after);
+  LOG_DEBUG(logger_, "Replica is busy" << KVLOG(busy.from.val, busy.seq_num, retry_after.count()));
+  const auto busy_until = (std::chrono::steady_clock::now() + retry_after).time_since_epoch().count();
+  auto current = busy_until_.load();
+  while (current < busy_until && !busy_until_.compare_exchange_weak(current, busy_until)) {
+  }
+}
+
+bool Client::isOutstanding(uint64_t seq_num) {
+  {
+    std::lock_guard<std::mutex> lg(sync_seq_nums_lock_);
+    if (sync_seq_nums_.count(seq_num) > 0) return true;
+  }
+  std::lock_guard<std::mutex> lg(async_lock_);
+  return async_requests_.count(seq_num) > 0;
+}
+
+bool Client::verifyBusyReply(const BusyReply& busy) {
+  const auto verifier = replica_verifiers_.find(busy.from.val);
+  if (verifier == replica_verifiers_.end()) return false;
+  const auto signed_data = ClientBusyReplySignedData{REPLY_BUSY_MSG_TYPE,
+                                                     busy.from.val,
+                                                     config_.id.val,
+                                                     busy.seq_num,
+                                                     static_cast<uint32_t>(busy.retry_after.count())};
+  const auto data = std::string(reinterpret_cast<const char*>(&signed_data), sizeof(signed_data));
+  const auto signature = std::string(busy.signature.begin(), busy.signature.end());
+  return verifier->second->verify(data, signature);
+}
+
+void Client::transmit(const Msg& msg,
+                      const std::optional<ReplicaId>& primary,
+                      const std::set<bft::communication::NodeNum>& destinations) {
+  Msg copy(msg);
+  if (primary) {
+    communication_->send(primary.value().val, std::move(copy), config_.id.val);
+  } else {
+    communication_->send(destinations, std::move(copy), config_.id.val);
+  }
+}
+
+void Client::startAsyncTimerThread() {
+  std::call_once(async_timer_thread_started_, [this]() {
+    async_timer_thread_ = std::thread([this]() {
+      while (!stop_async_timer_thread_) {
+        std::this_thread::sleep_for(ASYNC_TIMER_TICK);
+        async_timers_.advance();
+      }
+    });
+  });
+}
+
+size_t Client::numAsyncRequestsInFlight() {
+  std::lock_guard<std::mutex> lg(async_lock_);
+  return async_requests_.size();
+}
 }  // namespace bft::client
@@ -10,13 +10,22 @@
 // file.
 
 #include "matcher.h"
+#include "sha_hash.hpp"
+#include "bftengine/ClientMsgs.hpp"
 
 namespace bft::client {
 
 std::optional<Match> Matcher::onReply(UnmatchedReply&& reply) {
   if (!valid(reply)) return std::nullopt;
   if (!config_.include_primary_) reply.metadata.primary = std::nullopt;
+  std::optional<Msg> full_data;
+  if (config_.digest_replies && !reply.digest_only) {
+    const auto digest = concord::util::SHA2_256{}.digest(reply.data.data(), reply.data.size());
+    full_data = std::move(reply.data);
+    reply.data = Msg(digest.begin(), digest.end());
+  }
   auto key = MatchKey{reply.metadata, std::move(reply.data)};
+  if (full_data) full_replies_.emplace(key, std::move(*full_data));
   if (matches_[key].count(reply.rsi.from)) {
     if (matches_[key][reply.rsi.from] != reply.rsi.data) {
       LOG_ERROR(logger_,
@@ -31,11 +40,16 @@ std::optional<Match> Matcher::onReply(UnmatchedReply&& reply) {
 
 std::optional<Match> Matcher::match() {
   auto result = std::find_if(matches_.begin(), matches_.end(), [this](const auto& match) {
+    // With digest replies, the quorum may be complete before any full reply arrives.
+    if (config_.digest_replies) {
+      return match.second.size() >= config_.quorum.wait_for && full_replies_.count(match.first) > 0;
+    }
     return match.second.size() == config_.quorum.wait_for;
   });
   if (result == matches_.end()) return std::nullopt;
   primary_ = result->first.metadata.primary;
-  return Match{Reply{result->first.metadata.result, result->first.data, std::move(result->second)},
+  auto data = config_.digest_replies ? std::move(full_replies_[result->first]) : result->first.data;
+  return Match{Reply{result->first.metadata.result, std::move(data), std::move(result->second)},
                result->first.metadata.primary};
 }
 
@@ -47,6 +61,11 @@ bool Matcher::valid(const UnmatchedReply& reply) const {
     return false;
   }
 
+  if (reply.digest_only && (!config_.digest_replies || reply.data.size() != REPLY_DIGEST_LENGTH)) {
+    LOG_WARN(logger_, "Received unexpected digest reply from: " << reply.rsi.from.val);
+    return false;
+  }
+
   if (!validSource(reply.rsi.from)) {
     LOG_WARN(logger_, "Received reply from invalid source: " << reply.rsi.from.val);
     return false;
@@ -27,6 +27,9 @@ struct MatchConfig {
   MofN quorum;
   uint64_t sequence_number;
   bool include_primary_ = true;  // by default part of the match is the current primary
+  // Replies are matched by the digest of their data, and a quorum also requires one full reply with that digest.
+  // Digest-only replies are only accepted in this mode.
+  bool digest_replies = false;
 };
 
 // The parts of data that must match in a reply for quorum to be reached
@@ -65,7 +68,10 @@ class Matcher {
   // go on for a long time.
   size_t numDifferentReplies() const { return matches_.size(); }
 
-  void clearReplies() { matches_.clear(); }
+  void clearReplies() {
+    matches_.clear();
+    full_replies_.clear();
+  }
 
   std::optional<ReplicaId> getPrimary() {
     if (!config_.include_primary_) return std::nullopt;
@@ -96,6 +102,9 @@ class Matcher {
   // replica. In the future we can keep track of this across future requests, but for now, we just log it and worry
   // about it for the current match.
   std::map<MatchKey, std::map<ReplicaId, Msg>> matches_;
+
+  // When matching by digest, the data of a full reply received for each MatchKey.
+  std::map<MatchKey, Msg> full_replies_;
 };
 
 }  // namespace bft::client
@@ -9,6 +9,8 @@
 // terms. Your use of these subcomponents is subject to the terms and conditions of the
 // subcomponent's license, as noted in the LICENSE file.
 
+#include <cstring>
+
 #include "kvstream.h"
 #include "assertUtils.hpp"
 #include "bftengine/ClientMsgs.hpp"
@@ -60,7 +62,11 @@ void MsgReceiver::onNewMessage(bft::communication::NodeNum source,
   }
 
   auto* header = reinterpret_cast<const bftEngine::ClientReplyMsgHeader*>(message);
-  if (header->msgType != REPLY_MSG_TYPE) {
+  if (header->msgType == REPLY_BUSY_MSG_TYPE) {
+    onBusyReply(source, header, msg_len);
+    return;
+  }
+  if (header->msgType != REPLY_MSG_TYPE && header->msgType != REPLY_DIGEST_MSG_TYPE) {
     LOG_WARN(logger_, "Invalid message received. Incorrect Header Type. " << KVLOG(header->msgType));
     return;
   }
@@ -83,10 +89,40 @@ void MsgReceiver::onNewMessage(bft::communication::NodeNum source,
   reply.metadata = metadata;
   reply.rsi = std::move(rsi);
   reply.data = Msg(start_of_body, start_of_rsi);
+  reply.digest_only = header->msgType == REPLY_DIGEST_MSG_TYPE;
 
+  if (reply_handler_ && reply_handler_(reply)) {
+    return;
+  }
   queue_.push(std::move(reply));
 }
 
+void MsgReceiver::onBusyReply(bft::communication::NodeNum source,
+                              const bftEngine::ClientReplyMsgHeader* header,
+                              size_t msg_len) {
+  const auto data_len = header->replyLength;
+  const auto sig_len = header->replicaSpecificInfoLength;
+  uint32_t retry_after_milli = 0;
+  if (msg_len < sizeof(bftEngine::ClientReplyMsgHeader) + header->spanContextSize + data_len ||
+      data_len != sizeof(retry_after_milli) + sig_len) {
+    LOG_WARN(logger_, "Invalid busy reply received. " << KVLOG(source, msg_len, data_len, sig_len));
+    return;
+  }
+  if (!busy_handler_) return;
+
+  const char* start_of_body =
+      reinterpret_cast<const char*>(header) + sizeof(bftEngine::ClientReplyMsgHeader) + header->spanContextSize;
+  memcpy(&retry_after_milli, start_of_body, sizeof(retry_after_milli));
+  const char* start_of_sig = start_of_body + sizeof(retry_after_milli);
+
+  auto busy = BusyReply{};
+  busy.from = ReplicaId{static_cast<uint16_t>(source)};
+  busy.seq_num = header->reqSeqNum;
+  busy.retry_after = std::chrono::milliseconds{retry_after_milli};
+  busy.signature = Msg(start_of_sig, start_of_sig + sig_len);
+  busy_handler_(busy);
+}
+
 void MsgReceiver::activate(uint32_t max_reply_size) {
   ConcordAssertNE(max_reply_size, 0);
   max_reply_size_ = max_reply_size;
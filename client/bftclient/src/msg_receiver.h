@@ -12,12 +12,15 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <functional>
 #include <queue>
 
 #include "communication/ICommunication.hpp"
 #include "Logger.hpp"
 #include "bftclient/config.h"
+#include "bftengine/ClientMsgs.hpp"
 
 namespace bft::client {
 
@@ -46,6 +49,17 @@ struct UnmatchedReply {
   ReplyMetadata metadata;
   Msg data;
   ReplicaSpecificInfo rsi;
+  // `data` holds only the digest of the reply data. See REPLY_DIGEST_MSG_TYPE.
+  bool digest_only = false;
+};
+
+// A REPLY_BUSY_MSG_TYPE reply: the replica is overloaded, and asks the client to retry after `retry_after`.
+struct BusyReply {
+  ReplicaId from;
+  uint64_t seq_num;
+  std::chrono::milliseconds retry_after;
+  // Of the replica, over bftEngine::ClientBusyReplySignedData
+  Msg signature;
 };
 
 // A thread-safe queue that allows the ASIO thread to push newly received messages and the client
@@ -105,9 +119,28 @@ class MsgReceiver : public bft::communication::IReceiver {
   // progress and we should drop everything. Activate should never be called with max_reply_size of 0.
   void activate(uint32_t max_reply_size);
   void deactivate();
+  uint32_t maxReplySize() const { return max_reply_size_; }
+
+  // Set a handler that is given every received reply before it is queued. If the handler returns true, it consumed
+  // (moved from) the reply and it is not queued for `wait`. This is how replies to asynchronous requests are dispatched
+  // without a waiting thread.
+  //
+  // The handler is called from the ASIO thread. It must be set before communication is started.
+  void setReplyHandler(std::function<bool(UnmatchedReply&)> handler) { reply_handler_ = std::move(handler); }
+
+  // Set a handler that is given every busy reply. Busy replies are not queued for `wait`.
+  //
+  // The handler is called from the ASIO thread. It must be set before communication is started.
+  void setBusyHandler(std::function<void(const BusyReply&)> handler) { busy_handler_ = std::move(handler); }
 
  private:
+  void onBusyReply(bft::communication::NodeNum source,
+                   const bftEngine::ClientReplyMsgHeader* header,
+                   size_t msg_len);
+
   std::atomic<uint32_t> max_reply_size_ = 0;
+  std::function<bool(UnmatchedReply&)> reply_handler_;
+  std::function<void(const BusyReply&)> busy_handler_;
   UnmatchedReplyQueue queue_;
   logging::Logger logger_ = logging::getLogger("bftclient.msgreceiver");
 };
@@ -17,6 +17,7 @@
 #include <vector>
 #include <iostream>
 #include <ctime>
+#include <future>
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wpedantic"
@@ -522,6 +523,62 @@ TEST_F(ClientApiTestFixture, write_f_plus_one_get_differnt_rsi) {
   client.stop();
 }
 
+TEST_F(ClientApiTestFixture, async_pipelined_writes) {
+  auto WriteBehavior = [&](const MsgFromClient& msg, IReceiver* client_receiver) {
+    auto reply = replyFromRequest(msg);
+    client_receiver->onNewMessage((NodeNum)msg.destination.val, (const char*)reply.data(), reply.size());
+  };
+
+  unique_ptr<FakeCommunication> comm(new FakeCommunication(WriteBehavior));
+  Client client(move(comm), test_config_);
+  vector<future<Reply>> futures;
+  for (uint64_t i = 1; i <= 100; i++) {
+    WriteConfig config{RequestConfig{false, i}, ByzantineSafeQuorum{}};
+    config.request.timeout = 1s;
+    futures.push_back(client.sendAsync(config, Msg({'h', 'e', 'l', 'l', 'o'})));
+  }
+  Msg expected{'w', 'o', 'r', 'l', 'd'};
+  for (auto& f : futures) {
+    auto reply = f.get();
+    ASSERT_EQ(expected, reply.matched_data);
+    ASSERT_EQ(reply.rsi.size(), 2);
+  }
+  ASSERT_EQ(client.numAsyncRequestsInFlight(), 0);
+  client.stop();
+}
+
+TEST_F(ClientApiTestFixture, async_receive_reply_after_retry_timeout) {
+  unique_ptr<FakeCommunication> comm(new FakeCommunication(RetryBehavior{test_config_.all_replicas}));
+  Client client(move(comm), test_config_);
+  ReadConfig read_config{RequestConfig{false, 1}, All{}};
+  read_config.request.timeout = 1s;
+  promise<optional<Reply>> result;
+  client.sendAsync(read_config, Msg({'h', 'e', 'l', 'l', 'o'}), [&](optional<Reply>&& reply) {
+    result.set_value(move(reply));
+  });
+  auto reply = result.get_future().get();
+  ASSERT_TRUE(reply.has_value());
+  Msg expected{'w', 'o', 'r', 'l', 'd'};
+  ASSERT_EQ(expected, reply->matched_data);
+  client.stop();
+}
+
+TEST_F(ClientApiTestFixture, async_timeout_and_duplicate_sequence_number) {
+  auto NoReplyBehavior = [&](const MsgFromClient& msg, IReceiver* client_receiver) { return; };
+
+  unique_ptr<FakeCommunication> comm(new FakeCommunication(NoReplyBehavior));
+  Client client(move(comm), test_config_);
+  WriteConfig config{RequestConfig{false, 1}, LinearizableQuorum{}};
+  config.request.timeout = 100ms;
+  auto start = chrono::steady_clock::now();
+  auto f = client.sendAsync(config, Msg({'h', 'e', 'l', 'l', 'o'}));
+  ASSERT_THROW(client.sendAsync(config, Msg({'h', 'e', 'l', 'l', 'o'})), BftClientException);
+  ASSERT_THROW(f.get(), TimeoutException);
+  ASSERT_GE(chrono::steady_clock::now() - start, config.request.timeout);
+  ASSERT_EQ(client.numAsyncRequestsInFlight(), 0);
+  client.stop();
+}
+
 int main(int argc, char* argv[]) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
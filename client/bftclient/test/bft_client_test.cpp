@@ -17,6 +17,7 @@
 
 #include "msg_receiver.h"
 #include "bftclient/bft_client.h"
+#include "sha_hash.hpp"
 
 using namespace bft::client;
 
@@ -114,6 +115,29 @@ TEST(msg_receiver_tests, no_replies_bad_msg_type) {
   ASSERT_EQ(0, replies.size());
 }
 
+TEST(msg_receiver_tests, digest_reply) {
+  MsgReceiver receiver;
+  receiver.activate(64 * 1024);
+  auto data_len = REPLY_DIGEST_LENGTH + 5u;
+  std::vector<char> reply(sizeof(bftEngine::ClientReplyMsgHeader) + data_len);
+
+  auto* header = reinterpret_cast<bftEngine::ClientReplyMsgHeader*>(reply.data());
+  header->msgType = REPLY_DIGEST_MSG_TYPE;
+  header->currentPrimaryId = 1;
+  header->reqSeqNum = 100;
+  header->replyLength = data_len;
+  header->replicaSpecificInfoLength = 5;
+
+  auto source = 2;
+  receiver.onNewMessage(source, reply.data(), reply.size());
+
+  auto replies = receiver.wait(1ms);
+  ASSERT_EQ(1, replies.size());
+  ASSERT_TRUE(replies[0].digest_only);
+  ASSERT_EQ(REPLY_DIGEST_LENGTH, replies[0].data.size());
+  ASSERT_EQ(5, replies[0].rsi.data.size());
+}
+
 std::set<ReplicaId> destinations(uint16_t n) {
   std::set<ReplicaId> replicas;
   for (uint16_t i = 0; i < n; i++) {
@@ -271,6 +295,79 @@ TEST(matcher_tests, wait_for_replies_with_ignoring_primary) {
   ASSERT_FALSE(match.value().primary.has_value());
 }
 
+Msg digest_of(const Msg& msg) {
+  auto digest = concord::util::SHA2_256{}.digest(msg.data(), msg.size());
+  return Msg(digest.begin(), digest.end());
+}
+
+TEST(matcher_tests, digest_quorum_completes_with_full_reply) {
+  uint64_t seq_num = 5;
+  MatchConfig config{MofN{3, destinations(4)}, seq_num};
+  config.digest_replies = true;
+  Matcher matcher(config);
+  ReplicaId primary{1};
+  Msg msg = {'h', 'e', 'l', 'l', 'o'};
+  auto unmatched = unmatched_replies(4, ReplyMetadata{primary, seq_num}, digest_of(msg), create_rsi(4));
+  for (auto& reply : unmatched) {
+    reply.digest_only = true;
+  }
+  // Replica 3 is the designated replier.
+  unmatched[3].data = msg;
+  unmatched[3].digest_only = false;
+
+  // A quorum of digests isn't enough without the full reply.
+  ASSERT_EQ(std::nullopt, matcher.onReply(std::move(unmatched[0])));
+  ASSERT_EQ(std::nullopt, matcher.onReply(std::move(unmatched[1])));
+  ASSERT_EQ(std::nullopt, matcher.onReply(std::move(unmatched[2])));
+
+  auto match = matcher.onReply(std::move(unmatched[3]));
+  ASSERT_TRUE(match.has_value());
+  ASSERT_EQ(match.value().reply.matched_data, msg);
+  ASSERT_EQ(match.value().primary.value(), primary);
+  ASSERT_EQ(4, match.value().reply.rsi.size());
+}
+
+TEST(matcher_tests, digest_replies_with_full_replies_and_mismatches) {
+  uint64_t seq_num = 5;
+  MatchConfig config{MofN{3, destinations(4)}, seq_num};
+  config.digest_replies = true;
+  Matcher matcher(config);
+  ReplicaId primary{1};
+  Msg msg = {'h', 'e', 'l', 'l', 'o'};
+  auto unmatched = unmatched_replies(4, ReplyMetadata{primary, seq_num}, msg, create_rsi(4));
+
+  // A digest of different data doesn't count.
+  auto bad_digest = unmatched[0];
+  bad_digest.data = digest_of(Msg{'x'});
+  bad_digest.digest_only = true;
+  ASSERT_EQ(std::nullopt, matcher.onReply(std::move(bad_digest)));
+
+  // A digest of a wrong length is rejected.
+  auto bad_length = unmatched[1];
+  bad_length.digest_only = true;
+  ASSERT_EQ(std::nullopt, matcher.onReply(std::move(bad_length)));
+
+  // Full replies, as sent after a retry, match digest replies.
+  ASSERT_EQ(std::nullopt, matcher.onReply(std::move(unmatched[0])));
+  unmatched[1].data = digest_of(msg);
+  unmatched[1].digest_only = true;
+  ASSERT_EQ(std::nullopt, matcher.onReply(std::move(unmatched[1])));
+  auto match = matcher.onReply(std::move(unmatched[2]));
+  ASSERT_TRUE(match.has_value());
+  ASSERT_EQ(match.value().reply.matched_data, msg);
+  ASSERT_EQ(3, match.value().reply.rsi.size());
+}
+
+TEST(matcher_tests, digest_replies_rejected_when_not_requested) {
+  uint64_t seq_num = 5;
+  MatchConfig config{MofN{1, destinations(4)}, seq_num};
+  Matcher matcher(config);
+  Msg msg = {'h', 'e', 'l', 'l', 'o'};
+  auto reply = UnmatchedReply{ReplyMetadata{ReplicaId{1}, seq_num}, digest_of(msg), create_rsi(1)[0]};
+  reply.digest_only = true;
+  ASSERT_EQ(std::nullopt, matcher.onReply(std::move(reply)));
+}
+
 TEST(quorum_tests, valid_quorums_without_destinations) {
   auto all_replicas = destinations(4);
   // Even that we have ro replicas, empty destinations should include only committers. To issue a request to ro replica
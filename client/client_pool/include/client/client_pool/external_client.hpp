@@ -84,6 +84,9 @@ class ConcordClient {
 
   bool isServing() const;
 
+  // True while retransmissions are held back after a busy reply from an overloaded replica
+  bool isBusy() const;
+
   void stopClientComm();
 
   bftEngine::OperationResult getRequestExecutionResult();
@@ -52,6 +52,7 @@ SubmitResult ConcordClientPool::SendRequest(std::vector<uint8_t> &&request,
   std::unique_lock<std::mutex> lock(clients_queue_lock_);
   metricsComponent_.UpdateAggregator();
   auto serving_candidates = clients_.size();
+  size_t busy_candidates = 0;
   int client_id = 0;
 
   while (!clients_.empty() && serving_candidates != 0) {
@@ -66,6 +67,14 @@ SubmitResult ConcordClientPool::SendRequest(std::vector<uint8_t> &&request,
       --serving_candidates;
       continue;
     }
+    // An overloaded replica asked this client to hold back for a while
+    if (client->isBusy()) {
+      clients_.pop_front();
+      clients_.push_back(client);
+      --serving_candidates;
+      ++busy_candidates;
+      continue;
+    }
     if (0 == seq_num) {
       seq_num = client->generateClientSeqNum();
       if (flags & ClientMsgFlag::RECONFIG_FLAG_REQ) {
@@ -153,7 +162,7 @@ SubmitResult ConcordClientPool::SendRequest(std::vector<uint8_t> &&request,
   is_overloaded_ = true;
   LOG_WARN(logger_, "Cannot allocate client for" << KVLOG(correlation_id));
   if (callback) {
-    if (serving_candidates == 0 && !clients_.empty()) {
+    if (serving_candidates == 0 && !clients_.empty() && busy_candidates == 0) {
       callback(bftEngine::SendResult{static_cast<uint32_t>(OperationResult::NOT_READY)});
     } else {
       callback(bftEngine::SendResult{static_cast<uint32_t>(OperationResult::OVERLOADED)});
@@ -386,6 +386,8 @@ std::chrono::steady_clock::time_point ConcordClient::getWaitingTime() const { re
 
 bool ConcordClient::isServing() const { return new_client_->isServing(num_of_replicas_, required_num_of_replicas_); }
 
+bool ConcordClient::isBusy() const { return new_client_->busyUntil() > std::chrono::steady_clock::now(); }
+
 void ConcordClient::setDelayFlagForTest(bool delay) { ConcordClient::delayed_behaviour_ = delay; }
 
 OperationResult ConcordClient::getRequestExecutionResult() { return clientRequestExecutionResult_; }
@@ -115,12 +115,16 @@ class PlainTcpConfig : public BaseCommConfig {
                  NodeMap nodes,
                  int32_t maxServerId,
                  NodeNum selfId,
-                 UPDATE_CONNECTIVITY_FN statusCallback = nullptr)
+                 UPDATE_CONNECTIVITY_FN statusCallback = nullptr,
+                 bool useIoUring = false)
       : BaseCommConfig(CommType::PlainTcp, host, port, bufLength, nodes, selfId, std::move(statusCallback)),
-        maxServerId_{maxServerId} {}
+        maxServerId_{maxServerId},
+        useIoUring_{useIoUring} {}
 
  public:
   int32_t maxServerId_;
+  // Use PlainTCPIoUringCommunication, if the kernel supports it
+  bool useIoUring_;
 };
 
 class TlsTcpConfig : public PlainTcpConfig {
@@ -231,6 +235,32 @@ class PlainTCPCommunication : public ICommunication {
   explicit PlainTCPCommunication(const PlainTcpConfig &config);
 };
 
+class IoUring;
+
+// Plain TCP on io_uring, compatible with PlainTCPCommunication on the wire.
+class PlainTCPIoUringCommunication : public ICommunication {
+ public:
+  // Returns nullptr if the kernel doesn't support the io_uring operations it needs.
+  static PlainTCPIoUringCommunication *create(const PlainTcpConfig &config);
+
+  int getMaxMessageSize() override;
+  int start() override;
+  int stop() override;
+  bool isRunning() const override;
+  ConnectionStatus getCurrentConnectionStatus(NodeNum node) override;
+  int send(NodeNum destNode, std::vector<uint8_t> &&msg, NodeNum endpointNum) override;
+  std::set<NodeNum> send(std::set<NodeNum> dests, std::vector<uint8_t> &&msg, NodeNum srcEndpointNum) override;
+  void setReceiver(NodeNum receiverNum, IReceiver *receiver) override;
+  void restartCommunication(NodeNum i) override {}
+  ~PlainTCPIoUringCommunication() override;
+
+ private:
+  class PlainTcpIoUringImpl;
+  PlainTcpIoUringImpl *ptrImpl_ = nullptr;
+
+  PlainTCPIoUringCommunication(const PlainTcpConfig &config, std::unique_ptr<IoUring> ring);
+};
+
 namespace tls {
 class Runner;
 }
@@ -247,6 +277,7 @@ class TlsTCPCommunication : public ICommunication {
   int send(NodeNum destNode, std::vector<uint8_t> &&msg, NodeNum endpointNum) override;
   std::set<NodeNum> send(std::set<NodeNum> dests, std::vector<uint8_t> &&msg, NodeNum srcEndpointNum) override;
   void setReceiver(NodeNum receiverNum, IReceiver *receiver) override;
+  void setTrafficClassifier(TrafficClassifier classifier) override;
   void restartCommunication(NodeNum i) override;
   ~TlsTCPCommunication() override;
 
@@ -254,6 +285,11 @@ class TlsTCPCommunication : public ICommunication {
   logging::Logger logger_;
   TlsTcpConfig *config_;
   std::unique_ptr<tls::Runner> runner_;
+  TrafficClassifier trafficClassifier_;
+
+  TrafficClass trafficClassOf(const std::vector<uint8_t> &msg) const {
+    return trafficClassifier_ ? trafficClassifier_(msg.data(), msg.size()) : TrafficClass::Consensus;
+  }
 
   explicit TlsTCPCommunication(const TlsTcpConfig &config);
 };
@@ -281,9 +317,16 @@ class TlsMultiplexCommunication : public TlsTCPCommunication {
                       const char *const message,
                       size_t messageLength,
                       NodeNum endpointNum) override;
+    void onNewPooledMessage(NodeNum sourceNode,
+                            ReceiveBuffer &&buffer,
+                            size_t messageLength,
+                            NodeNum endpointNum) override;
     void onConnectionStatusChanged(NodeNum node, ConnectionStatus newStatus) override;
 
    private:
+    // Returns the receiver of a message, and sets the source node of client messages.
+    IReceiver *findReceiver(NodeNum &sourceNode, NodeNum endpointNum);
+
     logging::Logger logger_;
     std::shared_ptr<TlsMultiplexConfig> multiplexConfig_;
     std::unordered_map<NodeNum, IReceiver *> receiversMap_;  // Source endpoint -> receiver object
@@ -21,6 +21,8 @@ class CommFactory {
  private:
   static logging::Logger _logger;
 
+  static ICommunication* createPlainTcp(const PlainTcpConfig& config);
+
  public:
   static ICommunication* create(const BaseCommConfig& config);
 };
@@ -16,6 +16,9 @@
 #include <set>
 #include <vector>
 
+#include "communication/ReceiveBufferPool.hpp"
+#include "communication/TrafficClass.hpp"
+
 namespace bft::communication {
 
 typedef uint64_t NodeNum;
@@ -33,6 +36,16 @@ class IReceiver {
                             size_t messageLength,
                             NodeNum endpointNum = MAX_ENDPOINT_NUM) = 0;
 
+  // Invoked instead of onNewMessage by transports that read messages into buffers of the ReceiveBufferPool. The
+  // receiver may take the buffer and keep it as the storage of the message. By default, the message is passed to
+  // onNewMessage and the buffer goes back to the pool.
+  virtual void onNewPooledMessage(NodeNum sourceNode,
+                                  ReceiveBuffer&& buffer,
+                                  size_t messageLength,
+                                  NodeNum endpointNum = MAX_ENDPOINT_NUM) {
+    onNewMessage(sourceNode, buffer.data(), messageLength, endpointNum);
+  }
+
   // Invoked when the known status of a connection is changed.
   // For each NodeNum, this method will never be concurrently
   // executed by two different threads.
@@ -73,6 +86,10 @@ class ICommunication {
 
   virtual void setReceiver(NodeNum receiverNum, IReceiver* receiver) = 0;
 
+  // Transports that queue outgoing messages by their traffic class use the classifier to tell it. Should be set before
+  // start().
+  virtual void setTrafficClassifier(TrafficClassifier classifier) {}
+
   virtual void restartCommunication(NodeNum i) = 0;
   virtual ~ICommunication() = default;
 };
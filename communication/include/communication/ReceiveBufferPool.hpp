@@ -0,0 +1,131 @@
+// Concord
+//
+// Copyright (c) 2022 VMware, Inc. All Rights Reserved.
+//
+// This product is licensed to you under the Apache 2.0 license (the "License").
+// You may not use this product except in compliance with the Apache 2.0 License.
+//
+// This product may include a number of subcomponents with separate copyright
+// notices and license terms. Your use of these subcomponents is subject to the
+// terms and conditions of the subcomponent's license, as noted in the
+// LICENSE file.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace bft::communication {
+
+class ReceiveBuffer;
+
+// A pool of recycled buffers for incoming messages.
+//
+// Buffers are grouped in power of two size classes, so a buffer of a class can hold any message of that class. A
+// transport reads a message directly into a buffer of the pool and hands it over to the receiver, which can keep the
+// buffer as the storage of the message, instead of copying it. Once the message is destroyed, the buffer goes back to
+// the pool by calling ReceiveBufferPool::free() on its data.
+//
+// Buffers larger than the largest size class are not pooled. Each size class keeps a bounded number of free buffers.
+class ReceiveBufferPool {
+ public:
+  static constexpr size_t kMinClassSizeLog = 9;   // 512B
+  static constexpr size_t kMaxClassSizeLog = 26;  // 64MB
+  static constexpr size_t kNumClasses = kMaxClassSizeLog - kMinClassSizeLog + 1;
+  // Total bytes of free buffers kept by each size class, but at least kMinFreeBuffersPerClass buffers.
+  static constexpr size_t kMaxFreeBytesPerClass = 16 * 1024 * 1024;
+  static constexpr size_t kMinFreeBuffersPerClass = 4;
+
+  struct Stats {
+    std::atomic_uint64_t allocated{0};  // new buffers
+    std::atomic_uint64_t reused{0};     // buffers taken from the pool
+    std::atomic_uint64_t released{0};   // buffers freed when their size class is full
+  };
+
+  static ReceiveBufferPool& instance();
+
+  // A buffer of at least `size` bytes.
+  ReceiveBuffer acquire(size_t size);
+
+  // Return the buffer that holds `data` to the pool. `data` must have been released from a ReceiveBuffer.
+  static void free(void* data);
+
+  const Stats& stats() const { return stats_; }
+
+  ReceiveBufferPool(const ReceiveBufferPool&) = delete;
+  ReceiveBufferPool& operator=(const ReceiveBufferPool&) = delete;
+
+ private:
+  // Stored right before the data of every buffer.
+  struct alignas(std::max_align_t) BufferHeader {
+    uint32_t sizeClass;
+    uint32_t capacity;
+  };
+  static constexpr uint32_t kUnpooled = kNumClasses;
+
+  struct SizeClass {
+    std::mutex lock;
+    std::vector<char*> free;
+  };
+
+  ReceiveBufferPool() = default;
+
+  static uint32_t sizeClassOf(size_t size);
+  static size_t maxFreeBuffers(uint32_t sizeClass);
+  void release(char* data);
+
+  std::array<SizeClass, kNumClasses> classes_;
+  Stats stats_;
+};
+
+// A buffer of the receive buffer pool. Goes back to the pool on destruction, unless released.
+class ReceiveBuffer {
+ public:
+  ReceiveBuffer() = default;
+  ReceiveBuffer(ReceiveBuffer&& other) noexcept : data_{other.data_}, capacity_{other.capacity_} {
+    other.data_ = nullptr;
+    other.capacity_ = 0;
+  }
+  ReceiveBuffer& operator=(ReceiveBuffer&& other) noexcept {
+    if (this != &other) {
+      reset();
+      data_ = other.data_;
+      capacity_ = other.capacity_;
+      other.data_ = nullptr;
+      other.capacity_ = 0;
+    }
+    return *this;
+  }
+  ReceiveBuffer(const ReceiveBuffer&) = delete;
+  ReceiveBuffer& operator=(const ReceiveBuffer&) = delete;
+  ~ReceiveBuffer() { reset(); }
+
+  char* data() const { return data_; }
+  size_t capacity() const { return capacity_; }
+  explicit operator bool() const { return data_ != nullptr; }
+
+  // The caller becomes responsible for returning the data to the pool with ReceiveBufferPool::free().
+  char* release() {
+    auto data = data_;
+    data_ = nullptr;
+    capacity_ = 0;
+    return data;
+  }
+
+  void reset() {
+    if (data_) ReceiveBufferPool::free(release());
+  }
+
+ private:
+  friend class ReceiveBufferPool;
+  ReceiveBuffer(char* data, size_t capacity) : data_{data}, capacity_{capacity} {}
+
+  char* data_ = nullptr;
+  size_t capacity_ = 0;
+};
+
+}  // namespace bft::communication
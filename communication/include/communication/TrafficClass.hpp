@@ -0,0 +1,65 @@
+// Concord
+//
+// Copyright (c) 2022 VMware, Inc. All Rights Reserved.
+//
+// This product is licensed to you under the Apache 2.0 license (the "License").
+// You may not use this product except in compliance with the Apache 2.0 License.
+//
+// This product may include a number of subcomponents with separate copyright
+// notices and license terms. Your use of these subcomponents is subject to the
+// terms and conditions of the subcomponent's license, as noted in the
+// LICENSE file.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+
+namespace bft::communication {
+
+// Classes of traffic, from the most urgent one. Messages of each class wait on their own queue, so that consensus
+// messages don't wait behind floods of client requests or state transfer chunks.
+enum class TrafficClass : uint8_t { Consensus = 0, Client, StateTransfer };
+static constexpr size_t NUM_TRAFFIC_CLASSES = 3;
+
+// Tells the class of a message from its content.
+using TrafficClassifier = std::function<TrafficClass(const uint8_t* msg, size_t size)>;
+
+// Weighted round robin among the traffic classes: a class is served up to its weight in a row while it has messages,
+// before its turn passes to the next class. A busy class delays the others by its weight at most, and doesn't starve
+// them. Once all are idle, the turn goes back to the most urgent class.
+class TrafficScheduler {
+ public:
+  static constexpr std::array<size_t, NUM_TRAFFIC_CLASSES> WEIGHTS = {16, 4, 1};
+
+  // The class to serve next, out of those that `hasMessages`, or std::nullopt if none has. Call served() once a
+  // message of it is taken.
+  template <typename HasMessages>
+  std::optional<TrafficClass> next(HasMessages&& hasMessages) {
+    if (served_ < WEIGHTS[current_] && hasMessages(static_cast<TrafficClass>(current_))) {
+      return static_cast<TrafficClass>(current_);
+    }
+    for (size_t i = 1; i <= NUM_TRAFFIC_CLASSES; ++i) {
+      const auto next = (current_ + i) % NUM_TRAFFIC_CLASSES;
+      if (hasMessages(static_cast<TrafficClass>(next))) {
+        current_ = next;
+        served_ = 0;
+        return static_cast<TrafficClass>(next);
+      }
+    }
+    current_ = 0;
+    served_ = 0;
+    return std::nullopt;
+  }
+
+  void served() { ++served_; }
+
+ private:
+  size_t current_ = 0;
+  size_t served_ = 0;
+};
+
+}  // namespace bft::communication
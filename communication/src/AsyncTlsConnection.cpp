@@ -98,6 +98,7 @@ void AsyncTlsConnection::readMsgSizeHeader() { readMsgSizeHeader(std::nullopt);
 
 void AsyncTlsConnection::readMsg() {
   auto msg_size = getReadMsgSize();
+  read_msg_ = ReceiveBufferPool::instance().acquire(msg_size);
   LOG_DEBUG(logger_, KVLOG(peer_id_.value(), msg_size, (void*)read_msg_.data()));
   auto self = shared_from_this();
   status_.msg_reads++;
@@ -131,7 +132,7 @@ void AsyncTlsConnection::readMsg() {
         {
           concord::diagnostics::TimeRecorder<true> scoped_timer(*histograms_.read_enqueue_time);
           NodeNum endpoint_num = getReadMsgEndpointNum();
-          receiver_->onNewMessage(peer_id_.value(), read_msg_.data(), bytes_transferred, endpoint_num);
+          receiver_->onNewPooledMessage(peer_id_.value(), std::move(read_msg_), bytes_transferred, endpoint_num);
         }
         readMsgSizeHeader();
       }));
@@ -232,23 +233,58 @@ void AsyncTlsConnection::write(std::shared_ptr<OutgoingMsg> msg) {
   expected = false;
   // Set the in-flight msg
   if (write_msg_used_.compare_exchange_weak(expected, true)) {
-    write_msg_ = std::move(msg);
+    write_msgs_.push_back(std::move(msg));
   } else {
     write_queue_.push(std::move(msg));
-    LOG_ERROR(logger_, "write_msg_ already in use by other thread, msg pushed to the write queue.");
+    LOG_ERROR(logger_, "write_msgs_ already in use by other thread, msg pushed to the write queue.");
     return;
   }
-  LOG_DEBUG(logger_, "Writing" << KVLOG(write_msg_->msg.size()));
+
+  // A small message that finds nothing queued behind it waits for the writes already posted to the strand, such as the
+  // rest of a burst, so they share its TLS record. This delays it by one turn of the strand at most.
+  if (write_msgs_.front()->msg.size() < MAX_COALESCED_WRITE_SIZE && write_queue_.size() == 0) {
+    auto self = shared_from_this();
+    asio::post(strand_, [this, self]() { flush(); });
+    return;
+  }
+  flush();
+}
+
+void AsyncTlsConnection::flush() {
+  if (disposed_) return;
+
+  // Small messages waiting on the queue are coalesced with the in-flight msg
+  size_t write_size = write_msgs_.front()->msg.size();
+  while (write_size < MAX_COALESCED_WRITE_SIZE) {
+    auto msg = write_queue_.popIfNotLargerThan(MAX_COALESCED_WRITE_SIZE - write_size);
+    if (!msg) break;
+    write_size += msg->msg.size();
+    write_msgs_.push_back(std::move(msg));
+  }
+  auto buffer = asio::buffer(write_msgs_.front()->msg);
+  if (write_msgs_.size() > 1) {
+    write_buf_.clear();
+    for (const auto& msg : write_msgs_) {
+      write_buf_.insert(write_buf_.end(), msg->msg.begin(), msg->msg.end());
+    }
+    buffer = asio::buffer(write_buf_);
+  }
+  LOG_DEBUG(logger_, "Writing" << KVLOG(write_msgs_.size(), write_size));
 
   // We don't want to include tcp transmission time.
-  histograms_.send_time_in_queue->recordAtomic(durationInMicros(write_msg_->send_time));
+  for (const auto& msg : write_msgs_) {
+    histograms_.send_time_in_queue->recordAtomic(durationInMicros(msg->send_time));
+  }
+  histograms_.msgs_per_write->recordAtomic(static_cast<int64_t>(write_msgs_.size()));
+  histograms_.bytes_per_write->recordAtomic(static_cast<int64_t>(write_size));
+  status_.total_writes++;
 
   auto self = shared_from_this();
   auto start = std::chrono::steady_clock::now();
   asio::async_write(
       *socket_,
-      asio::buffer(write_msg_->msg),
-      asio::bind_executor(strand_, [this, self, start](const asio::error_code& ec, auto /*bytes_written*/) {
+      buffer,
+      asio::bind_executor(strand_, [this, self, start, write_size](const asio::error_code& ec, auto /*bytes_written*/) {
         if (disposed_) return;
         if (ec) {
           if (ec == asio::error::operation_aborted) {
@@ -257,16 +293,18 @@ void AsyncTlsConnection::write(std::shared_ptr<OutgoingMsg> msg) {
             return;
           }
           LOG_WARN(logger_,
-                   "Write failed to node " << peer_id_.value() << " for message with size " << write_msg_->msg.size()
-                                           << ": " << ec.message());
+                   "Write failed to node " << peer_id_.value() << " for " << write_msgs_.size()
+                                           << " messages with size " << write_size << ": " << ec.message());
           return dispose();
         }
 
         // The write succeeded.
         histograms_.async_write->recordAtomic(durationInMicros(start));
         write_timer_.cancel();
-        histograms_.sent_msg_size->recordAtomic(static_cast<int64_t>(write_msg_->msg.size()));
-        write_msg_ = nullptr;
+        for (const auto& msg : write_msgs_) {
+          histograms_.sent_msg_size->recordAtomic(static_cast<int64_t>(msg->msg.size()));
+        }
+        write_msgs_.clear();
         write_msg_used_ = false;
         write(write_queue_.pop());
       }));
@@ -84,7 +84,6 @@ class AsyncTlsConnection : public std::enable_shared_from_this<AsyncTlsConnectio
         connection_manager_(conn_mgr),
         read_timer_(io_context_),
         write_timer_(io_context_),
-        read_msg_(config.bufferLength_),
         config_(config),
         status_(status),
         histograms_(histograms),
@@ -107,7 +106,6 @@ class AsyncTlsConnection : public std::enable_shared_from_this<AsyncTlsConnectio
         connection_manager_(conn_mgr),
         read_timer_(io_context_),
         write_timer_(io_context_),
-        read_msg_(config.bufferLength_),
         config_(config),
         status_(status),
         histograms_(histograms),
@@ -138,6 +136,9 @@ class AsyncTlsConnection : public std::enable_shared_from_this<AsyncTlsConnectio
   // Write this message in strand_ , or enqueue it if there is already a message being written.
   void write(std::shared_ptr<OutgoingMsg>);
 
+  // Write the messages in `write_msgs_`, together with the small messages that wait on the queue.
+  void flush();
+
   // Wrapper function to be called from the ConnMgr strand.
   void remoteDispose();
   // Clean up the connection
@@ -210,12 +211,14 @@ class AsyncTlsConnection : public std::enable_shared_from_this<AsyncTlsConnectio
   // On every read, we must read the size of the incoming message first. This buffer stores that size.
   std::array<char, MSG_HEADER_SIZE> read_size_buf_;
 
-  // Last read message
-  std::vector<char> read_msg_;
+  // The message being read. Taken from the receive buffer pool for every message, and handed over to the receiver.
+  ReceiveBuffer read_msg_;
 
-  // Message being currently written.
+  // Messages being currently written.
   std::atomic_bool write_msg_used_{false};
-  std::shared_ptr<OutgoingMsg> write_msg_;
+  std::vector<std::shared_ptr<OutgoingMsg>> write_msgs_;
+  // The messages being currently written, if there is more than one.
+  std::vector<uint8_t> write_buf_;
 
   TlsTcpConfig& config_;
   TlsStatus& status_;
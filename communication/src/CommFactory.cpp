@@ -21,6 +21,18 @@ namespace bft::communication {
 
 logging::Logger CommFactory::_logger = logging::getLogger("communication.factory");
 
+#ifdef USE_COMM_PLAIN_TCP
+ICommunication *CommFactory::createPlainTcp(const PlainTcpConfig &config) {
+  if (config.useIoUring_) {
+#ifdef USE_COMM_PLAIN_TCP_IO_URING
+    if (auto *res = PlainTCPIoUringCommunication::create(config)) return res;
+#endif
+    LOG_WARN(_logger, "io_uring TCP transport is not available, falling back to asio");
+  }
+  return PlainTCPCommunication::create(config);
+}
+#endif
+
 ICommunication *CommFactory::create(const BaseCommConfig &config) {
   ICommunication *res = nullptr;
 
@@ -32,7 +44,7 @@ ICommunication *CommFactory::create(const BaseCommConfig &config) {
       break;
     case CommType::PlainTcp:
 #ifdef USE_COMM_PLAIN_TCP
-      res = PlainTCPCommunication::create(dynamic_cast<const PlainTcpConfig &>(config));
+      res = createPlainTcp(dynamic_cast<const PlainTcpConfig &>(config));
 #endif
       break;
     case CommType::SimpleAuthTcp:
@@ -0,0 +1,246 @@
+// Concord
+//
+// Copyright (c) 2022 VMware, Inc. All Rights Reserved.
+//
+// This product is licensed to you under the Apache 2.0 license (the "License").
+// You may not use this product except in compliance with the Apache 2.0 License.
+//
+// This product may include a number of subcomponents with separate copyright
+// notices and license terms. Your use of these subcomponents is subject to the
+// terms and conditions of the subcomponent's license, as noted in the LICENSE
+// file.
+
+#pragma once
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+
+#ifndef __NR_io_uring_setup
+#define __NR_io_uring_setup 425
+#endif
+#ifndef __NR_io_uring_enter
+#define __NR_io_uring_enter 426
+#endif
+#ifndef __NR_io_uring_register
+#define __NR_io_uring_register 427
+#endif
+
+namespace bft::communication {
+
+// A minimal io_uring instance, on top of the raw system calls.
+//
+// Only the thread that owns the ring may call its methods. Besides submission and completion, it supports probing for
+// operations and a ring of provided buffers, from which the kernel picks the buffer of every receive.
+class IoUring {
+ public:
+  // Returns nullptr if the kernel doesn't support io_uring, errno tells why.
+  static std::unique_ptr<IoUring> create(unsigned entries) {
+    io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+    const int fd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+    if (fd < 0) return nullptr;
+    auto ring = std::unique_ptr<IoUring>(new IoUring(fd, params));
+    if (!ring->map()) return nullptr;
+    return ring;
+  }
+
+  ~IoUring() {
+    if (sqes_) munmap(sqes_, sqesSize_);
+    if (cqRing_ && cqRing_ != sqRing_) munmap(cqRing_, cqRingSize_);
+    if (sqRing_) munmap(sqRing_, sqRingSize_);
+    close(fd_);
+  }
+
+  IoUring(const IoUring&) = delete;
+  IoUring& operator=(const IoUring&) = delete;
+
+  // Whether the kernel supports all of the operations in `ops`.
+  template <size_t N>
+  bool supports(const uint8_t (&ops)[N]) const {
+    constexpr size_t kMaxOps = 256;
+    const auto size = sizeof(io_uring_probe) + kMaxOps * sizeof(io_uring_probe_op);
+    std::unique_ptr<io_uring_probe, decltype(&std::free)> probe{static_cast<io_uring_probe*>(std::calloc(1, size)),
+                                                                &std::free};
+    if (!probe || syscall(__NR_io_uring_register, fd_, IORING_REGISTER_PROBE, probe.get(), kMaxOps) < 0) return false;
+    for (auto op : ops) {
+      if (op > probe->last_op || !(probe->ops[op].flags & IO_URING_OP_SUPPORTED)) return false;
+    }
+    return true;
+  }
+
+  // The number of free submission queue entries.
+  unsigned sqSpaceLeft() const { return *sqEntries_ - (sqeTail_ - __atomic_load_n(sqHead_, __ATOMIC_ACQUIRE)); }
+
+  // A free submission queue entry, or nullptr if the submission queue is full.
+  io_uring_sqe* getSqe() {
+    const auto head = __atomic_load_n(sqHead_, __ATOMIC_ACQUIRE);
+    if (sqeTail_ - head >= *sqEntries_) return nullptr;
+    const auto index = sqeTail_ & *sqMask_;
+    auto* sqe = &sqes_[index];
+    std::memset(sqe, 0, sizeof(*sqe));
+    sqArray_[index] = index;
+    ++sqeTail_;
+    return sqe;
+  }
+
+  // Submit the queued entries and wait for at least `waitFor` completions. Returns the number of submitted entries, or
+  // -errno.
+  int submit(unsigned waitFor) {
+    const auto toSubmit = sqeTail_ - *sqTail_;
+    __atomic_store_n(sqTail_, sqeTail_, __ATOMIC_RELEASE);
+    const unsigned flags = waitFor ? IORING_ENTER_GETEVENTS : 0;
+    int res;
+    do {
+      res = static_cast<int>(syscall(__NR_io_uring_enter, fd_, toSubmit, waitFor, flags, nullptr, 0));
+    } while (res < 0 && errno == EINTR && waitFor == 0);
+    return res < 0 ? -errno : res;
+  }
+
+  // Call `f` on every available completion. Returns the number of completions.
+  template <typename F>
+  unsigned forEachCqe(F&& f) {
+    auto head = *cqHead_;
+    const auto tail = __atomic_load_n(cqTail_, __ATOMIC_ACQUIRE);
+    unsigned count = 0;
+    for (; head != tail; ++head, ++count) {
+      f(cqes_[head & *cqMask_]);
+    }
+    __atomic_store_n(cqHead_, head, __ATOMIC_RELEASE);
+    return count;
+  }
+
+  // A ring of `count` provided buffers of `bufferSize` bytes each, in group `groupId`. `count` must be a power of two.
+  class BufferRing {
+   public:
+    ~BufferRing() {
+      if (registered_) {
+        io_uring_buf_reg reg;
+        std::memset(&reg, 0, sizeof(reg));
+        reg.bgid = groupId_;
+        syscall(__NR_io_uring_register, fd_, IORING_UNREGISTER_PBUF_RING, &reg, 1);
+      }
+      if (ring_) munmap(ring_, ringSize_);
+      std::free(buffers_);
+    }
+
+    uint16_t groupId() const { return groupId_; }
+    uint32_t bufferSize() const { return bufferSize_; }
+    char* buffer(uint16_t id) const { return buffers_ + size_t{id} * bufferSize_; }
+
+    // Give the buffer back to the kernel.
+    void recycle(uint16_t id) {
+      // Not ring_->bufs, whose flexible array is not at offset 0 when compiled as C++
+      auto& buf = reinterpret_cast<io_uring_buf*>(ring_)[tail_ & (count_ - 1)];
+      buf.addr = reinterpret_cast<uint64_t>(buffer(id));
+      buf.len = bufferSize_;
+      buf.bid = id;
+      ++tail_;
+      __atomic_store_n(&ring_->tail, tail_, __ATOMIC_RELEASE);
+    }
+
+   private:
+    friend class IoUring;
+    BufferRing(int fd, uint16_t groupId, uint32_t bufferSize, uint16_t count)
+        : fd_{fd}, groupId_{groupId}, bufferSize_{bufferSize}, count_{count} {}
+
+    int fd_;
+    uint16_t groupId_;
+    uint32_t bufferSize_;
+    uint16_t count_;
+    uint16_t tail_ = 0;
+    bool registered_ = false;
+    io_uring_buf_ring* ring_ = nullptr;
+    size_t ringSize_ = 0;
+    char* buffers_ = nullptr;
+  };
+
+  // Returns nullptr if the kernel doesn't support provided buffer rings.
+  std::unique_ptr<BufferRing> registerBufferRing(uint16_t groupId, uint32_t bufferSize, uint16_t count) {
+    std::unique_ptr<BufferRing> bufferRing{new BufferRing(fd_, groupId, bufferSize, count)};
+    bufferRing->ringSize_ = count * sizeof(io_uring_buf);
+    void* ring = mmap(nullptr, bufferRing->ringSize_, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+    if (ring == MAP_FAILED) return nullptr;
+    bufferRing->ring_ = static_cast<io_uring_buf_ring*>(ring);
+    bufferRing->buffers_ = static_cast<char*>(std::malloc(size_t{count} * bufferSize));
+    if (!bufferRing->buffers_) return nullptr;
+
+    io_uring_buf_reg reg;
+    std::memset(&reg, 0, sizeof(reg));
+    reg.ring_addr = reinterpret_cast<uint64_t>(ring);
+    reg.ring_entries = count;
+    reg.bgid = groupId;
+    if (syscall(__NR_io_uring_register, fd_, IORING_REGISTER_PBUF_RING, &reg, 1) < 0) return nullptr;
+    bufferRing->registered_ = true;
+    for (uint16_t id = 0; id < count; ++id) bufferRing->recycle(id);
+    return bufferRing;
+  }
+
+ private:
+  IoUring(int fd, const io_uring_params& params) : fd_{fd}, params_{params} {}
+
+  bool map() {
+    sqRingSize_ = params_.sq_off.array + params_.sq_entries * sizeof(unsigned);
+    cqRingSize_ = params_.cq_off.cqes + params_.cq_entries * sizeof(io_uring_cqe);
+    const bool singleMmap = params_.features & IORING_FEAT_SINGLE_MMAP;
+    if (singleMmap) sqRingSize_ = cqRingSize_ = std::max(sqRingSize_, cqRingSize_);
+
+    void* sq = mmap(nullptr, sqRingSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQ_RING);
+    if (sq == MAP_FAILED) return false;
+    sqRing_ = static_cast<char*>(sq);
+    if (singleMmap) {
+      cqRing_ = sqRing_;
+    } else {
+      void* cq =
+          mmap(nullptr, cqRingSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_CQ_RING);
+      if (cq == MAP_FAILED) return false;
+      cqRing_ = static_cast<char*>(cq);
+    }
+    sqesSize_ = params_.sq_entries * sizeof(io_uring_sqe);
+    void* sqes = mmap(nullptr, sqesSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED) return false;
+    sqes_ = static_cast<io_uring_sqe*>(sqes);
+
+    sqHead_ = reinterpret_cast<unsigned*>(sqRing_ + params_.sq_off.head);
+    sqTail_ = reinterpret_cast<unsigned*>(sqRing_ + params_.sq_off.tail);
+    sqMask_ = reinterpret_cast<unsigned*>(sqRing_ + params_.sq_off.ring_mask);
+    sqEntries_ = reinterpret_cast<unsigned*>(sqRing_ + params_.sq_off.ring_entries);
+    sqArray_ = reinterpret_cast<unsigned*>(sqRing_ + params_.sq_off.array);
+    sqeTail_ = *sqTail_;
+    cqHead_ = reinterpret_cast<unsigned*>(cqRing_ + params_.cq_off.head);
+    cqTail_ = reinterpret_cast<unsigned*>(cqRing_ + params_.cq_off.tail);
+    cqMask_ = reinterpret_cast<unsigned*>(cqRing_ + params_.cq_off.ring_mask);
+    cqes_ = reinterpret_cast<io_uring_cqe*>(cqRing_ + params_.cq_off.cqes);
+    return true;
+  }
+
+  const int fd_;
+  const io_uring_params params_;
+  char* sqRing_ = nullptr;
+  char* cqRing_ = nullptr;
+  io_uring_sqe* sqes_ = nullptr;
+  size_t sqRingSize_ = 0;
+  size_t cqRingSize_ = 0;
+  size_t sqesSize_ = 0;
+
+  unsigned* sqHead_ = nullptr;
+  unsigned* sqTail_ = nullptr;
+  unsigned* sqMask_ = nullptr;
+  unsigned* sqEntries_ = nullptr;
+  unsigned* sqArray_ = nullptr;
+  unsigned sqeTail_ = 0;
+  unsigned* cqHead_ = nullptr;
+  unsigned* cqTail_ = nullptr;
+  unsigned* cqMask_ = nullptr;
+  io_uring_cqe* cqes_ = nullptr;
+};
+
+}  // namespace bft::communication
@@ -0,0 +1,796 @@
+// Concord
+//
+// Copyright (c) 2022 VMware, Inc. All Rights Reserved.
+//
+// This product is licensed to you under the Apache 2.0 license (the "License").
+// You may not use this product except in compliance with the Apache 2.0 License.
+//
+// This product may include a number of subcomponents with separate copyright
+// notices and license terms. Your use of these subcomponents is subject to the
+// terms and conditions of the subcomponent's license, as noted in the LICENSE file.
+
+// A plain TCP transport that runs all socket I/O of a node on a single io_uring.
+//
+// It speaks the wire protocol of PlainTCPCommunication, so nodes of both transports can be mixed in a cluster. Compared
+// to the asio transport:
+// - Messages sent to a peer while a previous send is in flight are gathered by a single sendmsg, and all the operations
+//   that an iteration of the event loop prepares are submitted by a single system call.
+// - Messages are received by multishot receives into a ring of provided buffers that is registered with the kernel,
+//   without a system call per read. Kernels without provided buffer rings or multishot receives get one receive per
+//   read into a buffer of the connection.
+// - Messages are reassembled into buffers of the ReceiveBufferPool and handed to the receiver without another copy.
+// - Payloads are sent from the buffers of the callers, a message sent to many nodes is not copied.
+
+#include "communication/CommDefs.hpp"
+#include "IoUring.h"
+#include "Logger.hpp"
+#include "assertUtils.hpp"
+
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace bft::communication {
+
+namespace {
+
+// First 4 bytes - message length, next 2 bytes - message type, as in PlainTcpCommunication.cpp
+constexpr uint8_t LENGTH_FIELD_SIZE = 4;
+constexpr uint8_t MSG_TYPE_FIELD_SIZE = 2;
+constexpr size_t HEADER_SIZE = LENGTH_FIELD_SIZE + MSG_TYPE_FIELD_SIZE;
+
+enum MessageType : uint16_t { Reserved = 0, Hello, Regular };
+
+constexpr unsigned kRingEntries = 1024;
+constexpr uint16_t kRecvBufferGroup = 0;
+constexpr uint16_t kNumRecvBuffers = 256;
+constexpr uint32_t kRecvBufferSize = 64 * 1024;
+// Messages gathered by a single sendmsg
+constexpr size_t kMaxMessagesPerSend = 64;
+constexpr uint32_t kMinReconnectTimeoutMilli = 256;
+constexpr uint32_t kMaxReconnectTimeoutMilli = 8192;
+
+const uint8_t kRequiredOps[] = {IORING_OP_ACCEPT,
+                                IORING_OP_CONNECT,
+                                IORING_OP_LINK_TIMEOUT,
+                                IORING_OP_RECV,
+                                IORING_OP_SENDMSG,
+                                IORING_OP_READ,
+                                IORING_OP_TIMEOUT,
+                                IORING_OP_ASYNC_CANCEL};
+
+bool resolve(const std::string &host, uint16_t port, sockaddr_in &address) {
+  addrinfo hints;
+  std::memset(&hints, 0, sizeof(hints));
+  hints.ai_family = AF_INET;
+  hints.ai_socktype = SOCK_STREAM;
+  addrinfo *results = nullptr;
+  if (getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints, &results) != 0 || !results) return false;
+  std::memcpy(&address, results->ai_addr, sizeof(address));
+  freeaddrinfo(results);
+  return true;
+}
+
+void setNoDelay(int fd) {
+  int one = 1;
+  setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+}
+
+}  // namespace
+
+class PlainTCPIoUringCommunication::PlainTcpIoUringImpl {
+ public:
+  using Payload = std::shared_ptr<const std::vector<uint8_t>>;
+
+  PlainTcpIoUringImpl(const PlainTcpConfig &config, std::unique_ptr<IoUring> ring)
+      : selfId_{config.selfId_},
+        nodes_{config.nodes_},
+        bufferLength_{config.bufferLength_},
+        statusCallback_{config.statusCallback_},
+        ring_{std::move(ring)} {
+    bufferRing_ = ring_->registerBufferRing(kRecvBufferGroup, kRecvBufferSize, kNumRecvBuffers);
+    if (!bufferRing_) LOG_INFO(logger_, "Provided buffer rings are not supported, receiving into connection buffers");
+
+    wakeupFd_ = eventfd(0, EFD_CLOEXEC);
+    ConcordAssertGE(wakeupFd_, 0);
+
+    // all replicas are in listen mode
+    if (selfId_ <= static_cast<NodeNum>(config.maxServerId_)) {
+      sockaddr_in address;
+      // This is the *listen* port, we should expect to be able to resolve our own name
+      ConcordAssert(resolve(config.listenHost_, config.listenPort_, address));
+      listenFd_ = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+      ConcordAssertGE(listenFd_, 0);
+      int one = 1;
+      setsockopt(listenFd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+      ConcordAssertEQ(bind(listenFd_, reinterpret_cast<sockaddr *>(&address), sizeof(address)), 0);
+      ConcordAssertEQ(listen(listenFd_, SOMAXCONN), 0);
+      LOG_INFO(logger_, "Listening on " << config.listenHost_ << ":" << config.listenPort_);
+    }
+
+    // this node should connect only to nodes with lower ID, and all nodes with higher ID will connect to this node
+    for (const auto &[id, node] : nodes_) {
+      if (id < selfId_ && id <= static_cast<NodeNum>(config.maxServerId_)) {
+        auto conn = std::make_shared<Connection>(id, true);
+        conn->host = node.host;
+        conn->port = node.port;
+        peers_.emplace(id, conn);
+        connections_.insert(conn);
+      }
+      if (node.isReplica && statusCallback_) {
+        PeerConnectivityStatus pcs{};
+        pcs.peerId = id;
+        pcs.peerHost = node.host;
+        pcs.peerPort = node.port;
+        pcs.statusType = StatusType::Started;
+        statusCallback_(pcs);
+      }
+    }
+  }
+
+  ~PlainTcpIoUringImpl() {
+    stop();
+    for (const auto &conn : connections_) closeSocket(*conn);
+    if (listenFd_ >= 0) close(listenFd_);
+    close(wakeupFd_);
+  }
+
+  int start() {
+    if (thread_.joinable()) return 0;  // running
+    stopping_ = false;
+    running_ = true;
+    thread_ = std::thread([this] { run(); });
+    return 0;
+  }
+
+  int stop() {
+    if (!thread_.joinable()) return 0;  // stopped
+    stopping_ = true;
+    wakeup();
+    thread_.join();
+    closeConnections();
+    running_ = false;
+    return 0;
+  }
+
+  bool isRunning() const { return running_; }
+
+  ConnectionStatus getCurrentConnectionStatus(NodeNum node) {
+    if (!isRunning()) return ConnectionStatus::Disconnected;
+    std::lock_guard<std::mutex> lock(lock_);
+    const auto it = peers_.find(node);
+    if (it != peers_.end() && it->second->connected) return ConnectionStatus::Connected;
+    return ConnectionStatus::Disconnected;
+  }
+
+  int send(NodeNum destNode, const Payload &payload) {
+    {
+      std::lock_guard<std::mutex> lock(lock_);
+      const auto it = peers_.find(destNode);
+      if (it == peers_.end() || !it->second->connected) return 0;
+      outbox_.emplace_back(it->second, makeFrame(MessageType::Regular, payload));
+      if (!wakeupPending_) {
+        wakeupPending_ = true;
+        wakeup();
+      }
+    }
+    if (statusCallback_ && isReplica(selfId_)) {
+      PeerConnectivityStatus pcs{};
+      pcs.peerId = selfId_;
+      pcs.statusType = StatusType::MessageSent;
+      statusCallback_(pcs);
+    }
+    return 0;
+  }
+
+  void setReceiver(IReceiver *receiver) { receiver_ = receiver; }
+
+ private:
+  struct Frame {
+    std::array<char, HEADER_SIZE> header;
+    Payload payload;
+  };
+
+  struct Connection {
+    Connection(NodeNum peer, bool outgoing) : peer{peer}, outgoing{outgoing} {}
+
+    // Of incoming connections, known once the Hello message is received
+    NodeNum peer;
+    const bool outgoing;
+    int fd = -1;
+    // Incremented whenever the socket is closed, completions of operations on older sockets are ignored
+    uint32_t generation = 0;
+    std::atomic_bool connected{false};
+    bool helloReceived = false;
+
+    // Outgoing connections
+    std::string host;
+    uint16_t port = 0;
+    sockaddr_in address;
+    uint32_t reconnectTimeoutMilli = kMinReconnectTimeoutMilli;
+    __kernel_timespec connectTimeout;
+    __kernel_timespec reconnectTimeout;
+
+    // Receive state
+    std::array<char, HEADER_SIZE> header;
+    size_t headerFilled = 0;
+    uint16_t type = MessageType::Reserved;
+    ReceiveBuffer body;
+    uint32_t bodyLength = 0;
+    uint32_t bodyFilled = 0;
+    std::vector<char> recvBuffer;  // without a provided buffer ring
+
+    // Send state
+    std::deque<Frame> pending;
+    bool sending = false;
+  };
+
+  enum class OpType : uint8_t { Accept, Connect, Recv, Send, Reconnect, Wakeup };
+
+  struct Op {
+    OpType type;
+    std::shared_ptr<Connection> conn;
+    uint32_t generation = 0;
+    // Send
+    std::vector<Frame> frames;
+    std::vector<iovec> iovecs;
+    msghdr msg;
+    size_t sent = 0;
+    size_t total = 0;
+  };
+
+  static Frame makeFrame(MessageType type, Payload payload) {
+    Frame frame;
+    const uint32_t size = MSG_TYPE_FIELD_SIZE + payload->size();
+    std::memcpy(frame.header.data(), &size, LENGTH_FIELD_SIZE);
+    std::memcpy(frame.header.data() + LENGTH_FIELD_SIZE, &type, MSG_TYPE_FIELD_SIZE);
+    frame.payload = std::move(payload);
+    return frame;
+  }
+
+  bool isReplica(NodeNum node) const {
+    const auto it = nodes_.find(node);
+    return it != nodes_.end() && it->second.isReplica;
+  }
+
+  void wakeup() {
+    const uint64_t one = 1;
+    [[maybe_unused]] auto res = write(wakeupFd_, &one, sizeof(one));
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  // Event loop
+
+  void run() {
+    if (listenFd_ >= 0) prepAccept(newOp(OpType::Accept, nullptr));
+    prepWakeup(newOp(OpType::Wakeup, nullptr));
+    for (const auto &conn : connections_) {
+      if (conn->outgoing) connect(conn);
+    }
+
+    while (!stopping_) {
+      const auto res = ring_->submit(1);
+      if (res < 0 && res != -EINTR && res != -EBUSY) LOG_ERROR(logger_, "io_uring_enter failed: " << strerror(-res));
+      ring_->forEachCqe([this](const io_uring_cqe &cqe) { onCompletion(cqe); });
+      flushOutbox();
+    }
+    drain();
+  }
+
+  // Cancel all operations and wait for their completions, as they refer to the memory of the operations.
+  void drain() {
+    for (const auto &conn : connections_) {
+      if (conn->fd >= 0) shutdown(conn->fd, SHUT_RDWR);
+    }
+    for (const auto &[id, op] : ops_) {
+      auto *sqe = prep(IORING_OP_ASYNC_CANCEL, -1, 0);
+      sqe->addr = id;
+    }
+    while (!ops_.empty()) {
+      ring_->submit(1);
+      ring_->forEachCqe([this](const io_uring_cqe &cqe) {
+        if (cqe.flags & IORING_CQE_F_BUFFER) bufferRing_->recycle(cqe.flags >> IORING_CQE_BUFFER_SHIFT);
+        if (!cqe.user_data) return;
+        const auto it = ops_.find(cqe.user_data);
+        if (it == ops_.end()) return;
+        // Otherwise the peer wouldn't see the connection close
+        if (it->second->type == OpType::Accept && cqe.res >= 0) close(cqe.res);
+        if (!(cqe.flags & IORING_CQE_F_MORE)) ops_.erase(it);
+      });
+    }
+  }
+
+  // Closes the sockets left by a drained event loop, so that the next run reconnects to the peers and accepts their
+  // connections again.
+  void closeConnections() {
+    std::lock_guard<std::mutex> lock(lock_);
+    for (auto it = connections_.begin(); it != connections_.end();) {
+      const auto conn = *it;
+      closeSocket(*conn);
+      if (conn->outgoing) {
+        conn->reconnectTimeoutMilli = kMinReconnectTimeoutMilli;
+        ++it;
+        continue;
+      }
+      const auto peer = peers_.find(conn->peer);
+      if (conn->helloReceived && peer != peers_.end() && peer->second == conn) peers_.erase(peer);
+      it = connections_.erase(it);
+    }
+  }
+
+  // Submits the queued entries if fewer than `count` entries are free, so that the next `count` preps don't submit.
+  void reserveSqes(unsigned count) {
+    if (ring_->sqSpaceLeft() < count) ring_->submit(0);
+    ConcordAssertGE(ring_->sqSpaceLeft(), count);
+  }
+
+  io_uring_sqe *prep(uint8_t opcode, int fd, uint64_t opId) {
+    auto *sqe = ring_->getSqe();
+    if (!sqe) {
+      // The submission queue is full
+      ring_->submit(0);
+      sqe = ring_->getSqe();
+      ConcordAssertNE(sqe, nullptr);
+    }
+    sqe->opcode = opcode;
+    sqe->fd = fd;
+    sqe->user_data = opId;
+    return sqe;
+  }
+
+  uint64_t newOp(OpType type, const std::shared_ptr<Connection> &conn) {
+    const auto id = nextOpId_++;
+    auto &op = ops_[id];
+    op = std::make_unique<Op>();
+    op->type = type;
+    op->conn = conn;
+    if (conn) op->generation = conn->generation;
+    return id;
+  }
+
+  void onCompletion(const io_uring_cqe &cqe) {
+    if (cqe.user_data == 0) return;  // connect timeouts and cancellations
+    const auto it = ops_.find(cqe.user_data);
+    ConcordAssert(it != ops_.end());
+    auto &op = *it->second;
+    const bool stale = op.conn && op.generation != op.conn->generation;
+    bool resubmitted = false;
+    switch (op.type) {
+      case OpType::Accept:
+        resubmitted = onAccept(cqe.user_data, cqe.res);
+        break;
+      case OpType::Connect:
+        if (!stale) onConnect(op.conn, cqe.res);
+        break;
+      case OpType::Recv:
+        resubmitted = onRecv(cqe.user_data, op, cqe, stale);
+        break;
+      case OpType::Send:
+        if (!stale) resubmitted = onSend(cqe.user_data, op, cqe.res);
+        break;
+      case OpType::Reconnect:
+        if (!stale && !stopping_) connect(op.conn);
+        break;
+      case OpType::Wakeup:
+        prepWakeup(cqe.user_data);
+        resubmitted = true;
+        break;
+    }
+    // Not `it`, handlers may add operations
+    if (!resubmitted && !(cqe.flags & IORING_CQE_F_MORE)) ops_.erase(cqe.user_data);
+  }
+
+  void prepWakeup(uint64_t opId) {
+    auto *sqe = prep(IORING_OP_READ, wakeupFd_, opId);
+    sqe->addr = reinterpret_cast<uint64_t>(&wakeupValue_);
+    sqe->len = sizeof(wakeupValue_);
+    sqe->off = static_cast<uint64_t>(-1);
+  }
+
+  void flushOutbox() {
+    decltype(outbox_) outbox;
+    {
+      std::lock_guard<std::mutex> lock(lock_);
+      outbox.swap(outbox_);
+      wakeupPending_ = false;
+    }
+    for (auto &[conn, frame] : outbox) {
+      if (conn->connected) conn->pending.push_back(std::move(frame));
+    }
+    for (auto &[conn, frame] : outbox) {
+      if (!conn->sending && !conn->pending.empty()) prepSend(conn);
+    }
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  // Connections
+
+  void prepAccept(uint64_t opId) {
+    auto *sqe = prep(IORING_OP_ACCEPT, listenFd_, opId);
+    sqe->accept_flags = SOCK_CLOEXEC;
+  }
+
+  bool onAccept(uint64_t opId, int res) {
+    if (stopping_) {
+      if (res >= 0) close(res);
+      return false;
+    }
+    if (res < 0) {
+      LOG_WARN(logger_, "Accept failed: " << strerror(-res));
+    } else {
+      auto conn = std::make_shared<Connection>(0, false);
+      conn->fd = res;
+      setNoDelay(conn->fd);
+      connections_.insert(conn);
+      prepRecv(newOp(OpType::Recv, conn), *conn);
+    }
+    prepAccept(opId);
+    return true;
+  }
+
+  void connect(const std::shared_ptr<Connection> &conn) {
+    if (!resolve(conn->host, conn->port, conn->address)) {
+      LOG_INFO(logger_, "Unable to resolve " << conn->host << ":" << conn->port);
+      scheduleReconnect(conn);
+      return;
+    }
+    conn->fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    ConcordAssertGE(conn->fd, 0);
+    LOG_DEBUG(logger_,
+              "connecting from: " << selfId_ << " ,to: " << conn->peer << ", timeout: " << conn->reconnectTimeoutMilli);
+    // A submission between the linked entries would submit the connect without its timeout
+    reserveSqes(2);
+    auto *sqe = prep(IORING_OP_CONNECT, conn->fd, newOp(OpType::Connect, conn));
+    sqe->addr = reinterpret_cast<uint64_t>(&conn->address);
+    sqe->off = sizeof(conn->address);
+    sqe->flags |= IOSQE_IO_LINK;
+    // Cancels the connect, which fails with ECANCELED
+    setTimespec(conn->connectTimeout, conn->reconnectTimeoutMilli);
+    auto *timeoutSqe = prep(IORING_OP_LINK_TIMEOUT, -1, 0);
+    timeoutSqe->addr = reinterpret_cast<uint64_t>(&conn->connectTimeout);
+    timeoutSqe->len = 1;
+  }
+
+  static void setTimespec(__kernel_timespec &ts, uint32_t milli) {
+    ts.tv_sec = milli / 1000;
+    ts.tv_nsec = (milli % 1000) * 1000000;
+  }
+
+  void onConnect(const std::shared_ptr<Connection> &conn, int res) {
+    if (res < 0) {
+      LOG_DEBUG(logger_, "connect from: " << selfId_ << " ,to: " << conn->peer << " failed: " << strerror(-res));
+      closeSocket(*conn);
+      scheduleReconnect(conn);
+      return;
+    }
+    LOG_DEBUG(logger_, "connected, node " << selfId_ << ", dest: " << conn->peer);
+    setNoDelay(conn->fd);
+    conn->reconnectTimeoutMilli = kMinReconnectTimeoutMilli;
+    conn->connected = true;
+    conn->pending.push_front(
+        makeFrame(MessageType::Hello,
+                  std::make_shared<std::vector<uint8_t>>(reinterpret_cast<const uint8_t *>(&selfId_),
+                                                         reinterpret_cast<const uint8_t *>(&selfId_ + 1))));
+    prepRecv(newOp(OpType::Recv, conn), *conn);
+    prepSend(conn);
+  }
+
+  void scheduleReconnect(const std::shared_ptr<Connection> &conn) {
+    const auto timeout = conn->reconnectTimeoutMilli;
+    conn->reconnectTimeoutMilli = std::min(timeout * 2, kMaxReconnectTimeoutMilli);
+    setTimespec(conn->reconnectTimeout, timeout);
+    auto *sqe = prep(IORING_OP_TIMEOUT, -1, newOp(OpType::Reconnect, conn));
+    sqe->addr = reinterpret_cast<uint64_t>(&conn->reconnectTimeout);
+    sqe->len = 1;
+  }
+
+  // Completions of operations on the closed socket are ignored from now on.
+  void closeSocket(Connection &conn) {
+    if (conn.fd >= 0) {
+      shutdown(conn.fd, SHUT_RDWR);
+      close(conn.fd);
+      conn.fd = -1;
+    }
+    conn.generation++;
+    conn.connected = false;
+    conn.headerFilled = 0;
+    conn.body.reset();
+    conn.pending.clear();
+    conn.sending = false;
+  }
+
+  void onConnectionError(const std::shared_ptr<Connection> &conn) {
+    LOG_DEBUG(logger_, "connection error, node " << selfId_ << ", dest: " << conn->peer);
+    closeSocket(*conn);
+    if (stopping_) return;
+    if (conn->outgoing) {
+      scheduleReconnect(conn);
+      if (statusCallback_ && isReplica(selfId_)) {
+        PeerConnectivityStatus pcs{};
+        pcs.peerId = selfId_;
+        pcs.statusType = StatusType::Broken;
+        statusCallback_(pcs);
+      }
+      return;
+    }
+    connections_.erase(conn);
+    if (conn->helloReceived) {
+      std::lock_guard<std::mutex> lock(lock_);
+      const auto it = peers_.find(conn->peer);
+      if (it != peers_.end() && it->second == conn) peers_.erase(it);
+    }
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  // Receive
+
+  void prepRecv(uint64_t opId, Connection &conn) {
+    auto *sqe = prep(IORING_OP_RECV, conn.fd, opId);
+    if (bufferRing_) {
+      sqe->flags |= IOSQE_BUFFER_SELECT;
+      sqe->buf_group = bufferRing_->groupId();
+      if (multishotRecv_) sqe->ioprio |= IORING_RECV_MULTISHOT;
+      return;
+    }
+    conn.recvBuffer.resize(kRecvBufferSize);
+    sqe->addr = reinterpret_cast<uint64_t>(conn.recvBuffer.data());
+    sqe->len = conn.recvBuffer.size();
+  }
+
+  // Returns whether the operation was resubmitted.
+  bool onRecv(uint64_t opId, Op &op, const io_uring_cqe &cqe, bool stale) {
+    const bool more = cqe.flags & IORING_CQE_F_MORE;
+    const char *data = nullptr;
+    std::optional<uint16_t> bufferId;
+    if (cqe.flags & IORING_CQE_F_BUFFER) {
+      bufferId = cqe.flags >> IORING_CQE_BUFFER_SHIFT;
+      data = bufferRing_->buffer(*bufferId);
+    } else {
+      data = op.conn->recvBuffer.data();
+    }
+
+    bool ok = !stale && !stopping_;
+    if (ok && cqe.res == -EINVAL && multishotRecv_) {
+      LOG_INFO(logger_, "Multishot receives are not supported, receiving once per operation");
+      multishotRecv_ = false;
+    } else if (ok && cqe.res == -ENOBUFS) {
+      // All provided buffers are taken, they are returned below
+      LOG_DEBUG(logger_, "Out of receive buffers, node " << selfId_);
+    } else if (ok && cqe.res > 0) {
+      ok = onData(op.conn, data, static_cast<size_t>(cqe.res));
+      if (!ok) onConnectionError(op.conn);
+    } else if (ok) {
+      // The peer closed the connection, or it failed
+      ok = false;
+      onConnectionError(op.conn);
+    }
+    if (bufferId) bufferRing_->recycle(*bufferId);
+    if (!ok || more) return false;
+    prepRecv(opId, *op.conn);
+    return true;
+  }
+
+  // Returns false on protocol errors.
+  bool onData(const std::shared_ptr<Connection> &conn, const char *data, size_t length) {
+    auto &c = *conn;
+    while (length > 0) {
+      if (c.headerFilled < HEADER_SIZE) {
+        const auto n = std::min(length, HEADER_SIZE - c.headerFilled);
+        std::memcpy(c.header.data() + c.headerFilled, data, n);
+        c.headerFilled += n;
+        data += n;
+        length -= n;
+        if (c.headerFilled < HEADER_SIZE) break;
+
+        uint32_t msgLength;
+        std::memcpy(&msgLength, c.header.data(), LENGTH_FIELD_SIZE);
+        std::memcpy(&c.type, c.header.data() + LENGTH_FIELD_SIZE, MSG_TYPE_FIELD_SIZE);
+        if (msgLength < MSG_TYPE_FIELD_SIZE || msgLength - MSG_TYPE_FIELD_SIZE > bufferLength_) {
+          LOG_ERROR(logger_, "Invalid message length, node " << selfId_ << ", dest: " << c.peer << KVLOG(msgLength));
+          return false;
+        }
+        c.bodyLength = msgLength - MSG_TYPE_FIELD_SIZE;
+        c.bodyFilled = 0;
+        c.body = ReceiveBufferPool::instance().acquire(std::max<size_t>(c.bodyLength, 1));
+      }
+      const auto n = std::min<size_t>(length, c.bodyLength - c.bodyFilled);
+      std::memcpy(c.body.data() + c.bodyFilled, data, n);
+      c.bodyFilled += n;
+      data += n;
+      length -= n;
+      if (c.bodyFilled < c.bodyLength) break;
+      c.headerFilled = 0;
+      if (!onMessage(conn)) return false;
+    }
+    return true;
+  }
+
+  bool onMessage(const std::shared_ptr<Connection> &conn) {
+    auto &c = *conn;
+    if (c.type == MessageType::Hello) {
+      if (c.bodyLength != sizeof(NodeNum)) return false;
+      if (c.outgoing) return true;
+      std::memcpy(&c.peer, c.body.data(), sizeof(NodeNum));
+      LOG_DEBUG(logger_, "node: " << selfId_ << " got hello from:" << c.peer);
+      c.helloReceived = true;
+      c.connected = true;
+      std::lock_guard<std::mutex> lock(lock_);
+      peers_[c.peer] = conn;
+      return true;
+    }
+    if (c.type != MessageType::Regular) return true;
+    if (!c.outgoing && !c.helloReceived) {
+      LOG_WARN(logger_, "Message before hello, node " << selfId_);
+      return true;
+    }
+    if (receiver_) receiver_->onNewPooledMessage(c.peer, std::move(c.body), c.bodyLength);
+    c.body.reset();
+    if (statusCallback_ && isReplica(c.peer)) {
+      PeerConnectivityStatus pcs{};
+      pcs.peerId = c.peer;
+      pcs.peerHost = c.host;
+      pcs.peerPort = c.port;
+      pcs.statusType = StatusType::MessageReceived;
+      statusCallback_(pcs);
+    }
+    return true;
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  // Send
+
+  void prepSend(const std::shared_ptr<Connection> &conn) {
+    const auto opId = newOp(OpType::Send, conn);
+    auto &op = *ops_[opId];
+    const auto count = std::min(conn->pending.size(), kMaxMessagesPerSend);
+    op.frames.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+      op.total += HEADER_SIZE + conn->pending.front().payload->size();
+      op.frames.push_back(std::move(conn->pending.front()));
+      conn->pending.pop_front();
+    }
+    conn->sending = true;
+    prepSendMsg(opId, op);
+  }
+
+  // Gather the bytes of the frames of the operation that were not sent yet.
+  void prepSendMsg(uint64_t opId, Op &op) {
+    op.iovecs.clear();
+    auto skip = op.sent;
+    const auto add = [&](const void *base, size_t length) {
+      if (skip >= length) {
+        skip -= length;
+        return;
+      }
+      op.iovecs.push_back(iovec{const_cast<char *>(static_cast<const char *>(base)) + skip, length - skip});
+      skip = 0;
+    };
+    for (const auto &frame : op.frames) {
+      add(frame.header.data(), frame.header.size());
+      if (!frame.payload->empty()) add(frame.payload->data(), frame.payload->size());
+    }
+    std::memset(&op.msg, 0, sizeof(op.msg));
+    op.msg.msg_iov = op.iovecs.data();
+    op.msg.msg_iovlen = op.iovecs.size();
+    auto *sqe = prep(IORING_OP_SENDMSG, op.conn->fd, opId);
+    sqe->addr = reinterpret_cast<uint64_t>(&op.msg);
+    sqe->len = 1;
+    sqe->msg_flags = MSG_NOSIGNAL;
+  }
+
+  // Returns whether the operation was resubmitted.
+  bool onSend(uint64_t opId, Op &op, int res) {
+    if (stopping_) return false;
+    if (res < 0) {
+      LOG_DEBUG(logger_, "send failed, node " << selfId_ << ", dest: " << op.conn->peer << ": " << strerror(-res));
+      onConnectionError(op.conn);
+      return false;
+    }
+    op.sent += static_cast<size_t>(res);
+    if (op.sent < op.total) {
+      prepSendMsg(opId, op);
+      return true;
+    }
+    op.conn->sending = false;
+    if (!op.conn->pending.empty()) prepSend(op.conn);
+    return false;
+  }
+
+  logging::Logger logger_ = logging::getLogger("concord-bft.tcp");
+  const NodeNum selfId_;
+  const NodeMap nodes_;
+  const uint32_t bufferLength_;
+  const UPDATE_CONNECTIVITY_FN statusCallback_;
+  IReceiver *receiver_ = nullptr;
+
+  std::unique_ptr<IoUring> ring_;
+  std::unique_ptr<IoUring::BufferRing> bufferRing_;
+  bool multishotRecv_ = true;
+  int listenFd_ = -1;
+  int wakeupFd_ = -1;
+  uint64_t wakeupValue_ = 0;
+
+  std::thread thread_;
+  std::atomic_bool running_{false};
+  std::atomic_bool stopping_{false};
+
+  // Owned by the event loop thread
+  std::unordered_map<uint64_t, std::unique_ptr<Op>> ops_;
+  uint64_t nextOpId_ = 1;
+  std::unordered_set<std::shared_ptr<Connection>> connections_;
+
+  // Guards the connections to peers and the messages to send
+  std::mutex lock_;
+  std::unordered_map<NodeNum, std::shared_ptr<Connection>> peers_;
+  std::vector<std::pair<std::shared_ptr<Connection>, Frame>> outbox_;
+  bool wakeupPending_ = false;
+};
+
+PlainTCPIoUringCommunication *PlainTCPIoUringCommunication::create(const PlainTcpConfig &config) {
+  auto ring = IoUring::create(kRingEntries);
+  if (!ring) {
+    LOG_WARN(logging::getLogger("concord-bft.tcp"), "io_uring is not supported: " << strerror(errno));
+    return nullptr;
+  }
+  if (!ring->supports(kRequiredOps)) {
+    LOG_WARN(logging::getLogger("concord-bft.tcp"), "io_uring doesn't support the operations of the TCP transport");
+    return nullptr;
+  }
+  return new PlainTCPIoUringCommunication(config, std::move(ring));
+}
+
+PlainTCPIoUringCommunication::PlainTCPIoUringCommunication(const PlainTcpConfig &config,
+                                                           std::unique_ptr<IoUring> ring)
+    : ptrImpl_{new PlainTcpIoUringImpl(config, std::move(ring))} {}
+
+PlainTCPIoUringCommunication::~PlainTCPIoUringCommunication() { delete ptrImpl_; }
+
+int PlainTCPIoUringCommunication::getMaxMessageSize() { return -1; }
+
+int PlainTCPIoUringCommunication::start() { return ptrImpl_->start(); }
+
+int PlainTCPIoUringCommunication::stop() { return ptrImpl_->stop(); }
+
+bool PlainTCPIoUringCommunication::isRunning() const { return ptrImpl_->isRunning(); }
+
+ConnectionStatus PlainTCPIoUringCommunication::getCurrentConnectionStatus(NodeNum node) {
+  return ptrImpl_->getCurrentConnectionStatus(node);
+}
+
+int PlainTCPIoUringCommunication::send(NodeNum destNode, std::vector<uint8_t> &&msg, NodeNum endpointNum) {
+  return ptrImpl_->send(destNode, std::make_shared<const std::vector<uint8_t>>(std::move(msg)));
+}
+
+std::set<NodeNum> PlainTCPIoUringCommunication::send(std::set<NodeNum> dests,
+                                                     std::vector<uint8_t> &&msg,
+                                                     NodeNum endpointNum) {
+  // Shared by the frames to all destinations
+  const auto payload = std::make_shared<const std::vector<uint8_t>>(std::move(msg));
+  std::set<NodeNum> failed_nodes;
+  for (auto &d : dests) {
+    if (ptrImpl_->send(d, payload) != 0) failed_nodes.insert(d);
+  }
+  return failed_nodes;
+}
+
+void PlainTCPIoUringCommunication::setReceiver(NodeNum receiverNum, IReceiver *receiver) {
+  ptrImpl_->setReceiver(receiver);
+}
+
+}  // namespace bft::communication
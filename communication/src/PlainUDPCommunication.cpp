@@ -16,6 +16,8 @@
 
 #include "errnoString.hpp"
 
+#include <algorithm>
+#include <array>
 #include <iostream>
 #include <cstddef>
 #include <cassert>
@@ -26,6 +28,7 @@
 #include <thread>
 #include <functional>
 #include <poll.h>
+#include <sys/socket.h>
 
 using namespace std;
 
@@ -38,6 +41,11 @@ struct NodeAddressResolveResult {
 };
 
 class PlainUDPCommunication::PlainUdpImpl {
+  struct OutgoingDatagram {
+    const Addr *to;
+    std::shared_ptr<std::vector<uint8_t>> msg;
+  };
+
  public:
   // Initializes a new UDPCommunication layer that will listen on the given listenPort.
   PlainUdpImpl(const PlainUdpConfig &config)
@@ -92,8 +100,6 @@ class PlainUDPCommunication::PlainUdpImpl {
       return -1;
     }
 
-    bufferForIncomingMessages_ = (char *)std::malloc(maxMsgSize_);
-
     // Initialize socket.
     udpSockFd_ = socket(AF_INET, SOCK_DGRAM, 0);
     if (udpSockFd_ < 0) {
@@ -128,8 +134,6 @@ class PlainUDPCommunication::PlainUdpImpl {
     running_ = false;
     // Stopping the receiving thread happens as the last step because it relies on the 'running' flag.
     stopRecvThread();
-    std::free(bufferForIncomingMessages_);
-    bufferForIncomingMessages_ = nullptr;
     return 0;
   }
 
@@ -142,40 +146,92 @@ class PlainUDPCommunication::PlainUdpImpl {
     return ConnectionStatus::Disconnected;
   }
 
-  int sendAsyncMessage(const NodeNum &destNode, std::shared_ptr<std::vector<uint8_t>> msg) {
-    ssize_t error = 0;
+  // Queues the message to every destination. The thread that finds no flush in progress sends the queued datagrams of
+  // all threads, with as few sendmmsg calls as possible, while the others return right away. Returns the destinations
+  // that are unknown.
+  std::set<NodeNum> sendAsyncMessage(const std::set<NodeNum> &dests, std::shared_ptr<std::vector<uint8_t>> msg) {
     if (msg->size() > MAX_UDP_PAYLOAD_SIZE) {
       LOG_ERROR(logger_, "Error, exceeded UDP payload size limit, message length: " << std::to_string(msg->size()));
-      return -1;
+      return dests;
     }
 
     if (!running_) throw std::runtime_error("The communication layer is not running!");
-    const Addr *to = &nodes2addresses_[destNode];
-    ConcordAssert((to != NULL) && "The destination endpoint does not exist!");
     ConcordAssert((msg->size() > 0) && "The message length must be positive!");
-    LOG_DEBUG(logger_,
-              " Sending " << msg->size() << " bytes to " << destNode << " (" << inet_ntoa(to->sin_addr) << ":"
-                          << ntohs(to->sin_port));
-    error = sendto(udpSockFd_, msg->data(), msg->size(), 0, (struct sockaddr *)to, sizeof(Addr));
-    if (error < 0) {
-      // -1 return value means underlying socket error.
-      LOG_INFO(logger_, "Error while sending: " << concordUtils::errnoString(errno));
-    } else if (error < (ssize_t)msg->size()) {
-      // Message was partially sent. Unclear why this would happen, perhaps due to oversized messages (?).
-      LOG_INFO(logger_, "Sent %d out of %d bytes!");
+    std::set<NodeNum> failed;
+    {
+      std::lock_guard<std::mutex> guard(sendLock_);
+      for (auto dest : dests) {
+        const auto to = nodes2addresses_.find(dest);
+        if (to == nodes2addresses_.end()) {
+          LOG_ERROR(logger_, "The destination endpoint does not exist: " << dest);
+          failed.insert(dest);
+          continue;
+        }
+        LOG_DEBUG(logger_,
+                  " Sending " << msg->size() << " bytes to " << dest << " (" << inet_ntoa(to->second.sin_addr) << ":"
+                              << ntohs(to->second.sin_port));
+        sendQueue_.push_back(OutgoingDatagram{&to->second, msg});
+      }
+      if (flushing_) return failed;
+      flushing_ = true;
     }
+    flushSendQueue();
+    return failed;
+  }
 
-    if (error == (ssize_t)msg->size()) {
-      if (statusCallback_) {
-        PeerConnectivityStatus pcs{};
-        pcs.peerId = selfId_;
-        pcs.statusType = StatusType::MessageSent;
-        // pcs.statusTime = we don't set it since it is set by the aggregator
-        // in the upcoming version timestamps should be reviewed
-        statusCallback_(pcs);
+  void flushSendQueue() {
+    std::vector<OutgoingDatagram> batch;
+    while (true) {
+      {
+        std::lock_guard<std::mutex> guard(sendLock_);
+        batch.clear();
+        batch.swap(sendQueue_);
+        if (batch.empty()) {
+          flushing_ = false;
+          return;
+        }
+      }
+      for (size_t i = 0; i < batch.size(); i += MAX_DATAGRAMS_PER_CALL) {
+        sendBatch(batch.data() + i, std::min(batch.size() - i, MAX_DATAGRAMS_PER_CALL));
       }
     }
-    return 0;
+  }
+
+  void sendBatch(const OutgoingDatagram *datagrams, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+      sendIovecs_[i].iov_base = datagrams[i].msg->data();
+      sendIovecs_[i].iov_len = datagrams[i].msg->size();
+      auto &hdr = sendHeaders_[i].msg_hdr;
+      memset(&hdr, 0, sizeof(hdr));
+      hdr.msg_name = const_cast<Addr *>(datagrams[i].to);
+      hdr.msg_namelen = sizeof(Addr);
+      hdr.msg_iov = &sendIovecs_[i];
+      hdr.msg_iovlen = 1;
+    }
+    size_t sent = 0;
+    while (sent < count) {
+      const auto res = sendmmsg(udpSockFd_, &sendHeaders_[sent], count - sent, 0);
+      if (res < 0) {
+        if (errno == EINTR) continue;
+        // The datagram that failed is skipped, as by sendto() before.
+        LOG_INFO(logger_, "Error while sending: " << concordUtils::errnoString(errno));
+        ++sent;
+        continue;
+      }
+      for (auto i = sent; i < sent + res; ++i) {
+        if (sendHeaders_[i].msg_len < datagrams[i].msg->size()) {
+          LOG_INFO(logger_, "Sent " << sendHeaders_[i].msg_len << " out of " << datagrams[i].msg->size() << " bytes!");
+        } else if (statusCallback_) {
+          PeerConnectivityStatus pcs{};
+          pcs.peerId = selfId_;
+          pcs.statusType = StatusType::MessageSent;
+          // pcs.statusTime = we don't set it since it is set by the aggregator
+          // in the upcoming version timestamps should be reviewed
+          statusCallback_(pcs);
+        }
+      }
+      sent += res;
+    }
   }
 
   void startRecvThread() {
@@ -198,14 +254,76 @@ class PlainUDPCommunication::PlainUdpImpl {
 
   void stopRecvThread() { recvThreadRef_->join(); }
 
+  // Small datagrams are copied to a buffer of their size, and the large buffer stays in the ring. Large datagrams are
+  // handed over with their buffer, which is replaced.
+  void onDatagram(ReceiveBuffer &buffer, size_t mLen, const Addr &fromAddress) {
+    if (!mLen) {
+      // Maybe we received an actual zero-length UDP datagram, but we never send those.
+      LOG_DEBUG(logger_, "Node " << selfId_ << ": Received empty message");
+      return;
+    }
+
+    auto resolveNode = addrToNodeId(fromAddress);
+    if (!resolveNode.wasFound) {
+      LOG_DEBUG(logger_, "Sender not found, address: " << resolveNode.key);
+      return;
+    }
+
+    auto sendingNode = resolveNode.nodeId;
+    if (receiverRef_ != NULL) {
+      LOG_DEBUG(logger_, "Node " << selfId_ << ": Calling onNewMessage, msg from: " << sendingNode);
+      if (mLen <= buffer.capacity() / 2) {
+        auto copy = ReceiveBufferPool::instance().acquire(mLen);
+        memcpy(copy.data(), buffer.data(), mLen);
+        receiverRef_->onNewPooledMessage(sendingNode, std::move(copy), mLen);
+      } else {
+        receiverRef_->onNewPooledMessage(sendingNode, std::move(buffer), mLen);
+      }
+    } else {
+      LOG_ERROR(logger_, "Node " << selfId_ << ": receiver is NULL");
+    }
+
+    bool isReplica = check_replica(sendingNode);
+    if (statusCallback_ && isReplica) {
+      PeerConnectivityStatus pcs{};
+      pcs.peerId = sendingNode;
+
+      char str[INET_ADDRSTRLEN];
+      inet_ntop(AF_INET, &(fromAddress.sin_addr), str, INET_ADDRSTRLEN);
+      pcs.peerHost = string(str);
+
+      pcs.peerPort = ntohs(fromAddress.sin_port);
+      pcs.statusType = StatusType::MessageReceived;
+
+      // pcs.statusTime = we dont set it since it is set by the aggregator
+      // in the upcoming version timestamps should be reviewed
+      statusCallback_(pcs);
+    }
+  }
+
   void recvThreadRoutine() {
     ConcordAssert((udpSockFd_ != 0) && "Unable to start receiving: socket not define!");
     ConcordAssert((receiverRef_ != 0) && "Unable to start receiving: receiver not defined!");
 
     // The main receive loop.
-    Addr fromAddress;
-    socklen_t fromAddressLength = sizeof(fromAddress);
-    int mLen = 0;
+    // The ring of buffers that recvmmsg() receives into, one datagram per buffer.
+    std::array<ReceiveBuffer, MAX_DATAGRAMS_PER_CALL> buffers;
+    std::array<Addr, MAX_DATAGRAMS_PER_CALL> fromAddresses;
+    std::array<iovec, MAX_DATAGRAMS_PER_CALL> iovecs;
+    std::array<mmsghdr, MAX_DATAGRAMS_PER_CALL> headers;
+    const auto prepare = [&](size_t i) {
+      if (!buffers[i]) buffers[i] = ReceiveBufferPool::instance().acquire(maxMsgSize_);
+      iovecs[i].iov_base = buffers[i].data();
+      iovecs[i].iov_len = maxMsgSize_;
+      auto &hdr = headers[i].msg_hdr;
+      memset(&hdr, 0, sizeof(hdr));
+      hdr.msg_name = &fromAddresses[i];
+      hdr.msg_namelen = sizeof(Addr);
+      hdr.msg_iov = &iovecs[i];
+      hdr.msg_iovlen = 1;
+    };
+    for (size_t i = 0; i < MAX_DATAGRAMS_PER_CALL; ++i) prepare(i);
+
     int timeout = 5000;  // In milliseconds.
     int iRes = 0;
 
@@ -214,61 +332,31 @@ class PlainUDPCommunication::PlainUdpImpl {
     fds.events = POLLIN;  // Register for data read.
 
     do {
-      mLen = 0;
       iRes = poll(&fds, 1, timeout);
-      if (0 < iRes) {  // Event(s) reported.
-        mLen = recvfrom(
-            udpSockFd_, bufferForIncomingMessages_, maxMsgSize_, 0, (sockaddr *)&fromAddress, &fromAddressLength);
-      } else if (0 > iRes) {  // Error.
+      if (0 > iRes) {  // Error.
         LOG_ERROR(logger_, "Poll failed. " << std::strerror(errno));
         continue;
-      } else {  // Timeout
+      } else if (0 == iRes) {  // Timeout
         LOG_DEBUG(logger_, "Poll timeout occurred. timeout = " << timeout << " milli seconds.");
         continue;
       }
-      if (!running_) break;
-      LOG_DEBUG(logger_, "Node " << selfId_ << ": recvfrom returned " << mLen << " bytes");
-
-      if (mLen < 0) {
-        LOG_DEBUG(logger_, "Node " << selfId_ << ": Error in recvfrom(): " << mLen);
-        continue;
-      } else if (!mLen) {
-        // Probably, Stop() set 'running' to false and shut down the socket. Or, maybe, we received an actual
-        // zero-length UDP datagram, but we never send those.)
-        LOG_DEBUG(logger_, "Node " << selfId_ << ": Received empty message (shutting down?)");
-        continue;
-      }
-
-      auto resolveNode = addrToNodeId(fromAddress);
-      if (!resolveNode.wasFound) {
-        LOG_DEBUG(logger_, "Sender not found, address: " << resolveNode.key);
-        continue;
-      }
-
-      auto sendingNode = resolveNode.nodeId;
-      if (receiverRef_ != NULL) {
-        LOG_DEBUG(logger_, "Node " << selfId_ << ": Calling onNewMessage, msg from: " << sendingNode);
-        receiverRef_->onNewMessage(sendingNode, bufferForIncomingMessages_, mLen);
-      } else {
-        LOG_ERROR(logger_, "Node " << selfId_ << ": receiver is NULL");
-      }
-
-      bool isReplica = check_replica(sendingNode);
-      if (statusCallback_ && isReplica) {
-        PeerConnectivityStatus pcs{};
-        pcs.peerId = sendingNode;
-
-        char str[INET_ADDRSTRLEN];
-        inet_ntop(AF_INET, &(fromAddress.sin_addr), str, INET_ADDRSTRLEN);
-        pcs.peerHost = string(str);
-
-        pcs.peerPort = ntohs(fromAddress.sin_port);
-        pcs.statusType = StatusType::MessageReceived;
-
-        // pcs.statusTime = we dont set it since it is set by the aggregator
-        // in the upcoming version timestamps should be reviewed
-        statusCallback_(pcs);
-      }
+      // Drain the socket, as long as whole batches are received
+      int received = 0;
+      do {
+        received = recvmmsg(udpSockFd_, headers.data(), headers.size(), MSG_DONTWAIT, nullptr);
+        if (!running_) break;
+        if (received < 0) {
+          if (errno != EAGAIN && errno != EWOULDBLOCK) {
+            LOG_DEBUG(logger_, "Node " << selfId_ << ": Error in recvmmsg(): " << std::strerror(errno));
+          }
+          break;
+        }
+        LOG_DEBUG(logger_, "Node " << selfId_ << ": recvmmsg returned " << received << " datagrams");
+        for (int i = 0; i < received; ++i) {
+          onDatagram(buffers[i], headers[i].msg_len, fromAddresses[i]);
+          prepare(i);
+        }
+      } while (received == static_cast<int>(headers.size()));
     } while (running_);
 
     // Since neither WinSock nor Linux sockets manual doesn't specify explicitly that there is no need to call shutdown
@@ -322,8 +410,6 @@ class PlainUDPCommunication::PlainUdpImpl {
   // Reference to an IReceiver where we dispatch any received messages.
   IReceiver *receiverRef_ = nullptr;
 
-  char *bufferForIncomingMessages_ = nullptr;
-
   UPDATE_CONNECTIVITY_FN statusCallback_ = nullptr;
 
   NodeNum selfId_;
@@ -331,6 +417,17 @@ class PlainUDPCommunication::PlainUdpImpl {
   // Max UDP packet bytes can be sent, without headers.
   static constexpr uint16_t MAX_UDP_PAYLOAD_SIZE = 65535 - 20 - 8;
 
+  // Max datagrams sent by a sendmmsg() call or received by a recvmmsg() call.
+  static constexpr size_t MAX_DATAGRAMS_PER_CALL = 64;
+
+  // Guards the send queue, and whether a thread is sending it.
+  std::mutex sendLock_;
+  std::vector<OutgoingDatagram> sendQueue_;
+  bool flushing_ = false;
+  // Used by the flushing thread only.
+  std::array<iovec, MAX_DATAGRAMS_PER_CALL> sendIovecs_;
+  std::array<mmsghdr, MAX_DATAGRAMS_PER_CALL> sendHeaders_;
+
   // Flag to indicate whether the current communication layer still runs.
   std::atomic<bool> running_{false};
 
@@ -366,20 +463,15 @@ ConnectionStatus PlainUDPCommunication::getCurrentConnectionStatus(NodeNum node)
 
 int PlainUDPCommunication::send(NodeNum destNode, std::vector<uint8_t> &&msg, NodeNum endpointNum) {
   auto m = std::make_shared<std::vector<uint8_t>>(std::move(msg));
-  return ptrImpl_->sendAsyncMessage(destNode, m);
+  return ptrImpl_->sendAsyncMessage({destNode}, m).empty() ? 0 : -1;
 }
 
 std::set<NodeNum> PlainUDPCommunication::send(std::set<NodeNum> dests,
                                               std::vector<uint8_t> &&msg,
                                               NodeNum endpointNum) {
-  std::set<NodeNum> failed_nodes;
+  // All the datagrams of a broadcast are sent together
   auto m = std::make_shared<std::vector<uint8_t>>(std::move(msg));
-  for (auto &d : dests) {
-    if (ptrImpl_->sendAsyncMessage(d, m) != 0) {
-      failed_nodes.insert(d);
-    }
-  }
-  return failed_nodes;
+  return ptrImpl_->sendAsyncMessage(dests, m);
 }
 
 void PlainUDPCommunication::setReceiver(NodeNum receiverNum, IReceiver *receiver) {
@@ -0,0 +1,78 @@
+// Concord
+//
+// Copyright (c) 2022 VMware, Inc. All Rights Reserved.
+//
+// This product is licensed to you under the Apache 2.0 license (the "License").
+// You may not use this product except in compliance with the Apache 2.0 License.
+//
+// This product may include a number of subcomponents with separate copyright
+// notices and license terms. Your use of these subcomponents is subject to the
+// terms and conditions of the subcomponent's license, as noted in the
+// LICENSE file.
+
+#include "communication/ReceiveBufferPool.hpp"
+#include "assertUtils.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+namespace bft::communication {
+
+ReceiveBufferPool& ReceiveBufferPool::instance() {
+  // Never destroyed, as messages that hold pool buffers might outlive static objects.
+  static auto* pool = new ReceiveBufferPool();
+  return *pool;
+}
+
+uint32_t ReceiveBufferPool::sizeClassOf(size_t size) {
+  uint32_t sizeClass = 0;
+  while (sizeClass < kNumClasses && (size_t{1} << (kMinClassSizeLog + sizeClass)) < size) ++sizeClass;
+  return sizeClass;
+}
+
+size_t ReceiveBufferPool::maxFreeBuffers(uint32_t sizeClass) {
+  return std::max(kMinFreeBuffersPerClass, kMaxFreeBytesPerClass >> (kMinClassSizeLog + sizeClass));
+}
+
+ReceiveBuffer ReceiveBufferPool::acquire(size_t size) {
+  const auto sizeClass = sizeClassOf(size);
+  if (sizeClass != kUnpooled) {
+    auto& cls = classes_[sizeClass];
+    std::lock_guard<std::mutex> lock(cls.lock);
+    if (!cls.free.empty()) {
+      auto* data = cls.free.back();
+      cls.free.pop_back();
+      stats_.reused++;
+      return ReceiveBuffer{data, reinterpret_cast<BufferHeader*>(data - sizeof(BufferHeader))->capacity};
+    }
+  }
+  const auto capacity = (sizeClass == kUnpooled) ? size : (size_t{1} << (kMinClassSizeLog + sizeClass));
+  ConcordAssertLE(capacity, UINT32_MAX);
+  auto* raw = static_cast<char*>(std::malloc(sizeof(BufferHeader) + capacity));
+  if (raw == nullptr) throw std::bad_alloc();
+  new (raw) BufferHeader{sizeClass, static_cast<uint32_t>(capacity)};
+  stats_.allocated++;
+  return ReceiveBuffer{raw + sizeof(BufferHeader), capacity};
+}
+
+void ReceiveBufferPool::free(void* data) {
+  if (data) instance().release(static_cast<char*>(data));
+}
+
+void ReceiveBufferPool::release(char* data) {
+  auto* raw = data - sizeof(BufferHeader);
+  const auto sizeClass = reinterpret_cast<BufferHeader*>(raw)->sizeClass;
+  if (sizeClass != kUnpooled) {
+    auto& cls = classes_[sizeClass];
+    std::lock_guard<std::mutex> lock(cls.lock);
+    if (cls.free.size() < maxFreeBuffers(sizeClass)) {
+      cls.free.push_back(data);
+      return;
+    }
+  }
+  stats_.released++;
+  std::free(raw);
+}
+
+}  // namespace bft::communication
@@ -16,6 +16,7 @@
 #include <chrono>
 #include <sstream>
 
+#include "communication/TrafficClass.hpp"
 #include "kvstream.h"
 #include "diagnostics.h"
 
@@ -49,6 +50,7 @@ struct TlsStatus {
     num_connections = 0;
     total_messages_sent = 0;
     total_messages_dropped = 0;
+    total_writes = 0;
     msg_size_header_read_attempts = 0;
     msg_reads = 0;
     read_timer_started = 0;
@@ -70,6 +72,7 @@ struct TlsStatus {
     oss << KVLOG(num_connections) << std::endl;
     oss << KVLOG(total_messages_sent) << std::endl;
     oss << KVLOG(total_messages_dropped) << std::endl;
+    oss << KVLOG(total_writes) << std::endl;
     oss << KVLOG(msg_size_header_read_attempts) << std::endl;
     oss << KVLOG(msg_reads) << std::endl;
     oss << KVLOG(read_timer_started) << std::endl;
@@ -90,6 +93,8 @@ struct TlsStatus {
   std::atomic<size_t> num_connections;
   std::atomic<size_t> total_messages_sent;
   std::atomic<size_t> total_messages_dropped;
+  // Every write carries one or more messages, see `Recorders::msgs_per_write`.
+  std::atomic<size_t> total_writes;
   std::atomic<size_t> msg_size_header_read_attempts;
   std::atomic<size_t> msg_reads;
   std::atomic<size_t> read_timer_started;
@@ -113,12 +118,18 @@ struct Recorders {
       : write_queue_size_in_bytes(
             MAKE_SHARED_RECORDER("write_queue_size_in_bytes", 1, max_queue_size_in_bytes, 3, Unit::BYTES)),
         sent_msg_size(MAKE_SHARED_RECORDER("sent_msg_size", 1, max_msg_size, 3, Unit::BYTES)),
+        bytes_per_write(MAKE_SHARED_RECORDER("bytes_per_write", 1, max_msg_size, 3, Unit::BYTES)),
         received_msg_size(MAKE_SHARED_RECORDER("received_msg_size", 1, max_msg_size, 3, Unit::BYTES)) {
     auto& registrar = concord::diagnostics::RegistrarSingleton::getInstance();
     registrar.perf.registerComponent("tls" + selfId,
                                      {write_queue_len,
+                                      write_queue_len_by_class[0],
+                                      write_queue_len_by_class[1],
+                                      write_queue_len_by_class[2],
                                       write_queue_size_in_bytes,
                                       sent_msg_size,
+                                      bytes_per_write,
+                                      msgs_per_write,
                                       received_msg_size,
                                       send_time_in_queue,
                                       read_enqueue_time,
@@ -133,8 +144,16 @@ struct Recorders {
 
   std::shared_ptr<Recorder> write_queue_size_in_bytes;
   std::shared_ptr<Recorder> sent_msg_size;
+  std::shared_ptr<Recorder> bytes_per_write;
   std::shared_ptr<Recorder> received_msg_size;
   DEFINE_SHARED_RECORDER(write_queue_len, 1, MAX_QUEUE_LENGTH, 3, Unit::COUNT);
+  // Indexed by TrafficClass
+  std::array<std::shared_ptr<Recorder>, NUM_TRAFFIC_CLASSES> write_queue_len_by_class = {
+      MAKE_SHARED_RECORDER("write_queue_len_consensus", 1, MAX_QUEUE_LENGTH, 3, Unit::COUNT),
+      MAKE_SHARED_RECORDER("write_queue_len_client", 1, MAX_QUEUE_LENGTH, 3, Unit::COUNT),
+      MAKE_SHARED_RECORDER("write_queue_len_state_transfer", 1, MAX_QUEUE_LENGTH, 3, Unit::COUNT)};
+  // Small messages are coalesced into one write and one TLS record.
+  DEFINE_SHARED_RECORDER(msgs_per_write, 1, MAX_QUEUE_LENGTH, 3, Unit::COUNT);
   DEFINE_SHARED_RECORDER(send_time_in_queue, 1, MAX_US, 3, Unit::MICROSECONDS);
   DEFINE_SHARED_RECORDER(read_enqueue_time, 1, MAX_US, 3, Unit::MICROSECONDS);
   DEFINE_SHARED_RECORDER(send_post_to_mgr, 1, MAX_US, 3, Unit::MICROSECONDS);
@@ -23,10 +23,7 @@ void TlsMultiplexCommunication::TlsMultiplexReceiver::setReceiver(NodeNum receiv
   receiversMap_.insert_or_assign(receiverNum, receiver);
 }
 
-void TlsMultiplexCommunication::TlsMultiplexReceiver::onNewMessage(NodeNum sourceNode,
-                                                                   const char *const message,
-                                                                   size_t messageLength,
-                                                                   NodeNum endpointNum) {
+IReceiver *TlsMultiplexCommunication::TlsMultiplexReceiver::findReceiver(NodeNum &sourceNode, NodeNum endpointNum) {
   // client -> replica: endpointNum = clientId
   // replica -> client: endpointNum = clientId
   // replica1 -> replica2: endpointNum = destNode = replica2
@@ -44,11 +41,29 @@ void TlsMultiplexCommunication::TlsMultiplexReceiver::onNewMessage(NodeNum sourc
 
   const auto &receiver = receiversMap_.find(receiverId);
   if (receiver != receiversMap_.end()) {
-    receiver->second->onNewMessage(sourceNode, message, messageLength);
     LOG_DEBUG(logger_, "Receiver found for" << KVLOG(receiverId, endpointNum, sourceNode));
-    return;
+    return receiver->second;
   }
   LOG_ERROR(logger_, "Receiver not found for" << KVLOG(receiverId, endpointNum, sourceNode));
+  return nullptr;
+}
+
+void TlsMultiplexCommunication::TlsMultiplexReceiver::onNewMessage(NodeNum sourceNode,
+                                                                   const char *const message,
+                                                                   size_t messageLength,
+                                                                   NodeNum endpointNum) {
+  if (auto *receiver = findReceiver(sourceNode, endpointNum)) {
+    receiver->onNewMessage(sourceNode, message, messageLength);
+  }
+}
+
+void TlsMultiplexCommunication::TlsMultiplexReceiver::onNewPooledMessage(NodeNum sourceNode,
+                                                                         ReceiveBuffer &&buffer,
+                                                                         size_t messageLength,
+                                                                         NodeNum endpointNum) {
+  if (auto *receiver = findReceiver(sourceNode, endpointNum)) {
+    receiver->onNewPooledMessage(sourceNode, std::move(buffer), messageLength);
+  }
 }
 
 void TlsMultiplexCommunication::TlsMultiplexReceiver::onConnectionStatusChanged(NodeNum node,
@@ -52,7 +52,8 @@ ConnectionStatus TlsTCPCommunication::getCurrentConnectionStatus(const NodeNum n
 }
 
 int TlsTCPCommunication::send(NodeNum destNode, std::vector<uint8_t> &&msg, NodeNum endpointNum) {
-  auto outgoingMsg = std::make_shared<tls::OutgoingMsg>(std::move(msg), endpointNum);
+  const auto trafficClass = trafficClassOf(msg);
+  auto outgoingMsg = std::make_shared<tls::OutgoingMsg>(std::move(msg), endpointNum, trafficClass);
   runner_->send(destNode, outgoingMsg);
   return 0;
 }
@@ -61,13 +62,18 @@ std::set<NodeNum> TlsTCPCommunication::send(std::set<NodeNum> dests,
                                             std::vector<uint8_t> &&msg,
                                             NodeNum srcEndpointNum) {
   std::set<NodeNum> failed_nodes;
-  auto outgoingMsg = std::make_shared<tls::OutgoingMsg>(std::move(msg), srcEndpointNum);
+  const auto trafficClass = trafficClassOf(msg);
+  auto outgoingMsg = std::make_shared<tls::OutgoingMsg>(std::move(msg), srcEndpointNum, trafficClass);
   runner_->send(dests, outgoingMsg);
   return failed_nodes;
 }
 
 void TlsTCPCommunication::setReceiver(NodeNum id, IReceiver *receiver) { runner_->setReceiver(id, receiver); }
 
+void TlsTCPCommunication::setTrafficClassifier(TrafficClassifier classifier) {
+  trafficClassifier_ = std::move(classifier);
+}
+
 void TlsTCPCommunication::restartCommunication(NodeNum i) {
   if (i == config_->selfId_) {
     runner_->stop();
@@ -14,6 +14,7 @@
 
 #include <arpa/inet.h>
 #include <bits/stdint-uintn.h>
+#include <array>
 #include <atomic>
 #include <cstddef>
 #include <cstring>
@@ -33,9 +34,16 @@ namespace bft::communication::tls {
 // The number is very large right now so as not to affect current setups. In the future we will
 // have better admission control.
 static constexpr size_t MAX_QUEUE_SIZE_IN_BYTES = 1024 * 1024 * 1024;  // 1 GB
+// Small messages waiting on the queue are written together, in a single TLS record, as long as their total size
+// doesn't exceed the largest plaintext of a TLS record.
+static constexpr size_t MAX_COALESCED_WRITE_SIZE = 16 * 1024;
 struct OutgoingMsg {
-  OutgoingMsg(std::vector<uint8_t>&& raw_msg, NodeNum endpointNum)
-      : msg(raw_msg.size() + MSG_HEADER_SIZE), send_time(std::chrono::steady_clock::now()) {
+  OutgoingMsg(std::vector<uint8_t>&& raw_msg,
+              NodeNum endpointNum,
+              TrafficClass traffic_class = TrafficClass::Consensus)
+      : msg(raw_msg.size() + MSG_HEADER_SIZE),
+        send_time(std::chrono::steady_clock::now()),
+        traffic_class(traffic_class) {
     uint32_t msg_size = htonl(static_cast<uint32_t>(raw_msg.size()));
     auto const endpoint = concordUtils::hostToNet<NodeNum>(endpointNum);
     const Header header{msg_size, endpoint};
@@ -44,10 +52,12 @@ struct OutgoingMsg {
   }
   std::vector<uint8_t> msg;
   std::chrono::steady_clock::time_point send_time;
+  TrafficClass traffic_class;
 
   size_t payload_size() { return msg.size() - MSG_HEADER_SIZE; }
 };
 
+// Messages of each traffic class wait on their own queue. Within a class, messages are written in order.
 class WriteQueue {
  public:
   WriteQueue(Recorders& recorders) : logger_(logging::getLogger("concord-bft.tls.conn")), recorders_(recorders) {}
@@ -61,29 +71,47 @@ class WriteQueue {
       return std::nullopt;
     }
     queued_size_in_bytes_ += msg->msg.size();
-    msgs_.push_back(std::move(msg));
-    return msgs_.size();
+    lanes_[static_cast<size_t>(msg->traffic_class)].push_back(std::move(msg));
+    return ++size_;
   }
 
-  std::shared_ptr<OutgoingMsg> pop() {
-    recorders_.write_queue_len->recordAtomic(msgs_.size());
+  // Pop the next message, of the traffic class whose turn it is.
+  std::shared_ptr<OutgoingMsg> pop() { return popIfNotLargerThan(MAX_QUEUE_SIZE_IN_BYTES); }
+
+  // Pop the next message only if its size doesn't exceed `max_bytes`.
+  std::shared_ptr<OutgoingMsg> popIfNotLargerThan(size_t max_bytes) {
+    recorders_.write_queue_len->recordAtomic(size_);
     recorders_.write_queue_size_in_bytes->recordAtomic(queued_size_in_bytes_);
-    if (msgs_.empty()) {
+    for (size_t i = 0; i < NUM_TRAFFIC_CLASSES; ++i) {
+      recorders_.write_queue_len_by_class[i]->recordAtomic(lanes_[i].size());
+    }
+    const auto traffic_class =
+        scheduler_.next([this](TrafficClass c) { return !lanes_[static_cast<size_t>(c)].empty(); });
+    if (!traffic_class) {
       return nullptr;
     }
-    auto msg = std::move(msgs_.front());
-    msgs_.pop_front();
+    auto& lane = lanes_[static_cast<size_t>(*traffic_class)];
+    if (lane.front()->msg.size() > max_bytes) {
+      return nullptr;
+    }
+    scheduler_.served();
+    auto msg = std::move(lane.front());
+    lane.pop_front();
+    --size_;
     queued_size_in_bytes_ -= msg->msg.size();
     return msg;
   }
 
   void clear() {
-    msgs_.clear();
+    for (auto& lane : lanes_) {
+      lane.clear();
+    }
+    size_ = 0;
     queued_size_in_bytes_ = 0;
   }
 
   void setDestination(NodeNum id) { destination_ = id; }
-  size_t size() const { return msgs_.size(); }
+  size_t size() const { return size_; }
 
   size_t sizeInBytes() const { return queued_size_in_bytes_; }
 
@@ -91,7 +119,9 @@ class WriteQueue {
   WriteQueue& operator=(const WriteQueue&) = delete;
 
  private:
-  std::deque<std::shared_ptr<OutgoingMsg>> msgs_;
+  std::array<std::deque<std::shared_ptr<OutgoingMsg>>, NUM_TRAFFIC_CLASSES> lanes_;
+  TrafficScheduler scheduler_;
+  size_t size_ = 0;
   size_t queued_size_in_bytes_ = 0;
 
   std::optional<NodeNum> destination_ = std::nullopt;
@@ -0,0 +1,123 @@
+// Concord
+//
+// Copyright (c) 2022 VMware, Inc. All Rights Reserved.
+//
+// This product is licensed to you under the Apache 2.0 license (the "License").
+// You may not use this product except in compliance with the Apache 2.0 License.
+//
+// This product may include a number of subcomponents with separate copyright
+// notices and license terms. Your use of these subcomponents is subject to the
+// terms and conditions of the subcomponent's license, as noted in the
+// LICENSE file.
+
+// Throughput of the plain TCP transports over loopback: PlainTCPCommunication (asio) and PlainTCPIoUringCommunication.
+//
+// A client sends batches of messages to a replica, as a primary sends to its peers, and every iteration waits until the
+// replica received the whole batch.
+
+#include <benchmark/benchmark.h>
+
+#include "communication/CommDefs.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+using namespace bft::communication;
+using namespace std::chrono_literals;
+
+constexpr uint32_t kBufferLength = 4 * 1024 * 1024;
+constexpr size_t kBatchSize = 1000;
+
+enum Transport : int64_t { kAsio = 0, kIoUring = 1 };
+
+class CountingReceiver : public IReceiver {
+ public:
+  void onNewMessage(NodeNum, const char* const, size_t, NodeNum) override {
+    std::lock_guard<std::mutex> lock(lock_);
+    if (++received_ == expected_) cv_.notify_one();
+  }
+  void onConnectionStatusChanged(NodeNum, ConnectionStatus) override {}
+
+  void expect(size_t count) {
+    std::lock_guard<std::mutex> lock(lock_);
+    received_ = 0;
+    expected_ = count;
+  }
+  bool wait() {
+    std::unique_lock<std::mutex> lock(lock_);
+    return cv_.wait_for(lock, 30s, [this] { return received_ >= expected_; });
+  }
+
+ private:
+  std::mutex lock_;
+  std::condition_variable cv_;
+  size_t received_ = 0;
+  size_t expected_ = 0;
+};
+
+std::unique_ptr<ICommunication> makeNode(Transport transport, NodeNum id, const NodeMap& nodes, IReceiver* receiver) {
+  PlainTcpConfig config{"127.0.0.1", nodes.at(id).port, kBufferLength, nodes, 0, id, nullptr, transport == kIoUring};
+  std::unique_ptr<ICommunication> comm;
+  if (transport == kIoUring) {
+    comm.reset(PlainTCPIoUringCommunication::create(config));
+  } else {
+    comm.reset(PlainTCPCommunication::create(config));
+  }
+  if (!comm) return nullptr;
+  comm->setReceiver(id, receiver);
+  comm->start();
+  return comm;
+}
+
+void loopback(benchmark::State& state) {
+  const auto transport = static_cast<Transport>(state.range(0));
+  const auto messageSize = static_cast<size_t>(state.range(1));
+  // Ports of each run are distinct, as sockets of previous runs may linger
+  static uint16_t port = 37000;
+  port += 2;
+  NodeMap nodes;
+  nodes.emplace(0, NodeInfo{"127.0.0.1", port, true});
+  nodes.emplace(1, NodeInfo{"127.0.0.1", static_cast<uint16_t>(port + 1), false});
+
+  CountingReceiver receiver;
+  auto replica = makeNode(transport, 0, nodes, &receiver);
+  auto client = makeNode(transport, 1, nodes, nullptr);
+  if (!replica || !client) {
+    state.SkipWithError("Transport is not supported");
+    return;
+  }
+  for (int i = 0; i < 1000 && client->getCurrentConnectionStatus(0) != ConnectionStatus::Connected; ++i) {
+    std::this_thread::sleep_for(10ms);
+  }
+  // The replica knows the client once its hello message arrived
+  std::this_thread::sleep_for(100ms);
+
+  for (auto _ : state) {
+    receiver.expect(kBatchSize);
+    for (size_t i = 0; i < kBatchSize; ++i) {
+      client->send(0, std::vector<uint8_t>(messageSize, 'x'), MAX_ENDPOINT_NUM);
+    }
+    if (!receiver.wait()) {
+      state.SkipWithError("Messages were lost");
+      break;
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kBatchSize);
+  state.SetBytesProcessed(state.iterations() * kBatchSize * messageSize);
+  client->stop();
+  replica->stop();
+}
+
+}  // namespace
+
+BENCHMARK(loopback)
+    ->ArgNames({"io_uring", "size"})
+    ->ArgsProduct({{kAsio, kIoUring}, {64, 1024, 16 * 1024, 256 * 1024}})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_MAIN();
@@ -0,0 +1,210 @@
+// Concord
+//
+// Copyright (c) 2022 VMware, Inc. All Rights Reserved.
+//
+// This product is licensed to you under the Apache 2.0 license (the "License").
+// You may not use this product except in compliance with the Apache 2.0 License.
+//
+// This product may include a number of subcomponents with separate copyright
+// notices and license terms. Your use of these subcomponents is subject to the
+// terms and conditions of the subcomponent's license, as noted in the
+// LICENSE file.
+
+#include "communication/CommDefs.hpp"
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace bft::communication;
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr uint16_t kBasePort = 36100;
+constexpr uint32_t kBufferLength = 1024 * 1024;
+
+class Receiver : public IReceiver {
+ public:
+  void onNewMessage(NodeNum sourceNode, const char* const message, size_t messageLength, NodeNum) override {
+    std::lock_guard<std::mutex> lock(lock_);
+    messages_.emplace_back(sourceNode, std::vector<uint8_t>(message, message + messageLength));
+    cv_.notify_all();
+  }
+  void onConnectionStatusChanged(NodeNum, ConnectionStatus) override {}
+
+  std::vector<std::pair<NodeNum, std::vector<uint8_t>>> waitFor(size_t count) {
+    std::unique_lock<std::mutex> lock(lock_);
+    cv_.wait_for(lock, 10s, [&] { return messages_.size() >= count; });
+    return messages_;
+  }
+
+ private:
+  std::mutex lock_;
+  std::condition_variable cv_;
+  std::vector<std::pair<NodeNum, std::vector<uint8_t>>> messages_;
+};
+
+NodeMap makeNodes(uint16_t numNodes, uint16_t numReplicas) {
+  NodeMap nodes;
+  for (NodeNum i = 0; i < numNodes; ++i) {
+    nodes.emplace(i, NodeInfo{"127.0.0.1", static_cast<uint16_t>(kBasePort + i), i < numReplicas});
+  }
+  return nodes;
+}
+
+std::unique_ptr<ICommunication> makeNode(NodeNum id, const NodeMap& nodes, uint16_t numReplicas, Receiver& receiver) {
+  PlainTcpConfig config{"127.0.0.1", nodes.at(id).port, kBufferLength, nodes, numReplicas - 1, id, nullptr, true};
+  auto comm = std::unique_ptr<ICommunication>(PlainTCPIoUringCommunication::create(config));
+  if (!comm) return nullptr;
+  comm->setReceiver(id, &receiver);
+  comm->start();
+  return comm;
+}
+
+bool waitForConnection(ICommunication& comm, NodeNum node) {
+  for (int i = 0; i < 1000; ++i) {
+    if (comm.getCurrentConnectionStatus(node) == ConnectionStatus::Connected) return true;
+    std::this_thread::sleep_for(10ms);
+  }
+  return false;
+}
+
+std::vector<uint8_t> makeMessage(size_t size, uint8_t seed) {
+  std::vector<uint8_t> msg(size);
+  for (size_t i = 0; i < size; ++i) msg[i] = static_cast<uint8_t>(seed + i);
+  return msg;
+}
+
+TEST(plain_tcp_io_uring, messages_are_delivered_in_order) {
+  const auto nodes = makeNodes(2, 2);
+  Receiver receiver0, receiver1;
+  auto node0 = makeNode(0, nodes, 2, receiver0);
+  if (!node0) GTEST_SKIP() << "io_uring is not supported";
+  auto node1 = makeNode(1, nodes, 2, receiver1);
+  ASSERT_NE(node1, nullptr);
+  ASSERT_TRUE(waitForConnection(*node1, 0));
+  ASSERT_TRUE(waitForConnection(*node0, 1));
+
+  // Empty messages, and messages larger than a receive buffer
+  const std::vector<size_t> sizes{1, 0, 100, 4096, 200 * 1024, 17, 1024 * 1024};
+  std::vector<std::vector<uint8_t>> sent;
+  for (size_t i = 0; i < sizes.size(); ++i) {
+    sent.push_back(makeMessage(sizes[i], static_cast<uint8_t>(i)));
+    auto copy = sent.back();
+    ASSERT_EQ(node1->send(0, std::move(copy), MAX_ENDPOINT_NUM), 0);
+  }
+  const auto received = receiver0.waitFor(sent.size());
+  ASSERT_EQ(received.size(), sent.size());
+  for (size_t i = 0; i < sent.size(); ++i) {
+    ASSERT_EQ(received[i].first, 1u);
+    ASSERT_EQ(received[i].second, sent[i]);
+  }
+
+  // Replies go over the incoming connection
+  ASSERT_EQ(node0->send(1, makeMessage(10, 7), MAX_ENDPOINT_NUM), 0);
+  const auto replies = receiver1.waitFor(1);
+  ASSERT_EQ(replies.size(), 1u);
+  ASSERT_EQ(replies[0].first, 0u);
+  ASSERT_EQ(replies[0].second, makeMessage(10, 7));
+
+  node1->stop();
+  node0->stop();
+}
+
+TEST(plain_tcp_io_uring, broadcast_from_many_threads) {
+  constexpr uint16_t kNumNodes = 4;
+  constexpr size_t kThreads = 4;
+  constexpr size_t kMessagesPerThread = 500;
+  const auto nodes = makeNodes(kNumNodes, kNumNodes);
+  std::vector<Receiver> receivers(kNumNodes);
+  std::vector<std::unique_ptr<ICommunication>> comms;
+  for (NodeNum i = 0; i < kNumNodes; ++i) {
+    comms.push_back(makeNode(i, nodes, kNumNodes, receivers[i]));
+    if (!comms.back()) GTEST_SKIP() << "io_uring is not supported";
+  }
+  for (NodeNum i = 1; i < kNumNodes; ++i) {
+    ASSERT_TRUE(waitForConnection(*comms[0], i));
+  }
+
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&, t] {
+      for (size_t i = 0; i < kMessagesPerThread; ++i) {
+        auto msg = makeMessage(64 + i, static_cast<uint8_t>(t));
+        // The first byte of a message tells its thread, the rest is verified by its length
+        msg[0] = static_cast<uint8_t>(t);
+        comms[0]->send({1, 2, 3}, std::move(msg), MAX_ENDPOINT_NUM);
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+
+  for (NodeNum i = 1; i < kNumNodes; ++i) {
+    const auto received = receivers[i].waitFor(kThreads * kMessagesPerThread);
+    ASSERT_EQ(received.size(), kThreads * kMessagesPerThread);
+    // Messages of every thread arrive in the order they were sent
+    std::vector<size_t> next(kThreads, 0);
+    for (const auto& [source, msg] : received) {
+      ASSERT_EQ(source, 0u);
+      const auto t = msg[0];
+      ASSERT_LT(t, kThreads);
+      ASSERT_EQ(msg.size(), 64 + next[t]++);
+    }
+  }
+  for (auto& comm : comms) comm->stop();
+}
+
+TEST(plain_tcp_io_uring, reconnects_to_restarted_node) {
+  const auto nodes = makeNodes(2, 2);
+  Receiver receiver0, receiver1, receiver0Restarted;
+  auto node0 = makeNode(0, nodes, 2, receiver0);
+  if (!node0) GTEST_SKIP() << "io_uring is not supported";
+  auto node1 = makeNode(1, nodes, 2, receiver1);
+  ASSERT_TRUE(waitForConnection(*node1, 0));
+
+  node0->stop();
+  node0.reset();
+  node0 = makeNode(0, nodes, 2, receiver0Restarted);
+  // Node 1 reconnects and says hello
+  ASSERT_TRUE(waitForConnection(*node0, 1));
+  ASSERT_EQ(node1->send(0, makeMessage(32, 1), MAX_ENDPOINT_NUM), 0);
+  const auto received = receiver0Restarted.waitFor(1);
+  ASSERT_EQ(received.size(), 1u);
+  ASSERT_EQ(received[0].second, makeMessage(32, 1));
+
+  node1->stop();
+  node0->stop();
+}
+
+TEST(plain_tcp_io_uring, restarts_after_stop) {
+  const auto nodes = makeNodes(2, 2);
+  Receiver receiver0, receiver1;
+  auto node0 = makeNode(0, nodes, 2, receiver0);
+  if (!node0) GTEST_SKIP() << "io_uring is not supported";
+  auto node1 = makeNode(1, nodes, 2, receiver1);
+  ASSERT_TRUE(waitForConnection(*node1, 0));
+
+  // Both the connecting node and the accepting node are restarted
+  for (auto* node : {node1.get(), node0.get()}) {
+    node->stop();
+    ASSERT_FALSE(node->isRunning());
+    node->start();
+    ASSERT_TRUE(node->isRunning());
+    ASSERT_TRUE(waitForConnection(*node1, 0));
+    ASSERT_TRUE(waitForConnection(*node0, 1));
+  }
+  ASSERT_EQ(node1->send(0, makeMessage(32, 2), MAX_ENDPOINT_NUM), 0);
+  const auto received = receiver0.waitFor(1);
+  ASSERT_EQ(received.size(), 1u);
+  ASSERT_EQ(received[0].second, makeMessage(32, 2));
+
+  node1->stop();
+  node0->stop();
+}
+
+}  // namespace
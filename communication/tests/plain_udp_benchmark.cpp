@@ -0,0 +1,134 @@
+// Concord
+//
+// Copyright (c) 2022 VMware, Inc. All Rights Reserved.
+//
+// This product is licensed to you under the Apache 2.0 license (the "License").
+// You may not use this product except in compliance with the Apache 2.0 License.
+//
+// This product may include a number of subcomponents with separate copyright
+// notices and license terms. Your use of these subcomponents is subject to the
+// terms and conditions of the subcomponent's license, as noted in the
+// LICENSE file.
+
+// Datagram rate of PlainUDPCommunication over loopback.
+//
+// A primary broadcasts batches of messages to its peers, from one or more threads, and every iteration waits until the
+// peers received the whole batch. UDP may drop datagrams, so an iteration stops waiting once no more datagrams arrive,
+// its time is until the last datagram arrived, and the lost datagrams are counted.
+
+#include <benchmark/benchmark.h>
+
+#include "communication/CommDefs.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace bft::communication;
+using namespace std::chrono_literals;
+
+constexpr uint32_t kBufferLength = 64 * 1024;
+// Small enough for the default socket receive buffer
+constexpr size_t kBatchSize = 100;
+
+class CountingReceiver : public IReceiver {
+ public:
+  void onNewMessage(NodeNum, const char* const, size_t, NodeNum) override {
+    std::lock_guard<std::mutex> lock(lock_);
+    last_ = std::chrono::steady_clock::now();
+    if (++received_ == expected_) cv_.notify_one();
+  }
+  void onConnectionStatusChanged(NodeNum, ConnectionStatus) override {}
+
+  void expect(size_t count) {
+    std::lock_guard<std::mutex> lock(lock_);
+    received_ = 0;
+    expected_ = count;
+  }
+  // Returns the number of received messages, and when the last one arrived
+  std::pair<size_t, std::chrono::steady_clock::time_point> wait() {
+    std::unique_lock<std::mutex> lock(lock_);
+    auto received = received_;
+    while (!cv_.wait_for(lock, 20ms, [this] { return received_ >= expected_; }) && received_ != received) {
+      received = received_;
+    }
+    return {received_, last_};
+  }
+
+ private:
+  std::mutex lock_;
+  std::condition_variable cv_;
+  size_t received_ = 0;
+  size_t expected_ = 0;
+  std::chrono::steady_clock::time_point last_;
+};
+
+std::unique_ptr<ICommunication> makeNode(NodeNum id, const NodeMap& nodes, IReceiver* receiver) {
+  PlainUdpConfig config{"127.0.0.1", nodes.at(id).port, kBufferLength, nodes, id};
+  std::unique_ptr<ICommunication> comm{PlainUDPCommunication::create(config)};
+  comm->setReceiver(id, receiver);
+  comm->start();
+  return comm;
+}
+
+// Arguments: the number of peers, the number of sending threads and the message size.
+void broadcast(benchmark::State& state) {
+  const auto numPeers = static_cast<NodeNum>(state.range(0));
+  const auto numThreads = static_cast<size_t>(state.range(1));
+  const auto messageSize = static_cast<size_t>(state.range(2));
+  // Ports of each run are distinct, as sockets of previous runs may linger
+  static uint16_t port = 38000;
+  port += 8;
+  NodeMap nodes;
+  std::set<NodeNum> peers;
+  for (NodeNum i = 0; i <= numPeers; ++i) {
+    nodes.emplace(i, NodeInfo{"127.0.0.1", static_cast<uint16_t>(port + i), true});
+    if (i > 0) peers.insert(i);
+  }
+
+  std::vector<CountingReceiver> receivers(numPeers + 1);
+  std::vector<std::unique_ptr<ICommunication>> comms;
+  for (NodeNum i = 0; i <= numPeers; ++i) comms.push_back(makeNode(i, nodes, &receivers[i]));
+
+  size_t received = 0;
+  size_t lost = 0;
+  for (auto _ : state) {
+    for (auto peer : peers) receivers[peer].expect(kBatchSize);
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < numThreads; ++t) {
+      threads.emplace_back([&, t] {
+        for (auto i = t; i < kBatchSize; i += numThreads) {
+          comms[0]->send(peers, std::vector<uint8_t>(messageSize, 'x'), MAX_ENDPOINT_NUM);
+        }
+      });
+    }
+    for (auto& thread : threads) thread.join();
+    auto end = start;
+    for (auto peer : peers) {
+      const auto [count, last] = receivers[peer].wait();
+      received += count;
+      lost += kBatchSize - count;
+      end = std::max(end, last);
+    }
+    state.SetIterationTime(std::chrono::duration<double>(end - start).count());
+  }
+  state.SetItemsProcessed(received);
+  state.counters["lost"] = benchmark::Counter(lost, benchmark::Counter::kAvgIterations);
+  for (auto& comm : comms) comm->stop();
+}
+
+}  // namespace
+
+BENCHMARK(broadcast)
+    ->ArgNames({"peers", "threads", "size"})
+    ->ArgsProduct({{1, 3, 6}, {1, 4}, {64, 1024}})
+    ->Iterations(200)
+    ->UseManualTime()
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_MAIN();
@@ -0,0 +1,68 @@
+// Concord
+//
+// Copyright (c) 2022 VMware, Inc. All Rights Reserved.
+//
+// This product is licensed to you under the Apache 2.0 license (the "License"). You may not use this product except in
+// compliance with the Apache 2.0 License.
+//
+// This product may include a number of subcomponents with separate copyright notices and license terms. Your use of
+// these subcomponents is subject to the terms and conditions of the sub-component's license, as noted in the LICENSE
+// file.
+
+#include "communication/ICommunication.hpp"
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <string>
+
+using namespace bft::communication;
+using namespace std;
+
+namespace {
+
+class CopyingReceiver : public IReceiver {
+ public:
+  void onNewMessage(NodeNum, const char* const message, size_t messageLength, NodeNum) override {
+    received.assign(message, messageLength);
+  }
+  void onConnectionStatusChanged(NodeNum, ConnectionStatus) override {}
+
+  string received;
+};
+
+TEST(receive_buffer_pool, buffers_are_size_classed_and_reused) {
+  auto& pool = ReceiveBufferPool::instance();
+  auto buffer = pool.acquire(1000);
+  ASSERT_TRUE(buffer);
+  ASSERT_EQ(buffer.capacity(), 1024);
+  auto* data = buffer.data();
+  buffer.reset();
+  ASSERT_FALSE(buffer);
+
+  // A buffer of the same size class is taken from the pool.
+  const auto reused = pool.stats().reused.load();
+  buffer = pool.acquire(600);
+  ASSERT_EQ(buffer.data(), data);
+  ASSERT_EQ(buffer.capacity(), 1024);
+  ASSERT_EQ(pool.stats().reused.load(), reused + 1);
+
+  // Released buffers are returned explicitly.
+  auto* released = buffer.release();
+  ASSERT_FALSE(buffer);
+  ReceiveBufferPool::free(released);
+  ASSERT_EQ(pool.acquire(1024).data(), data);
+
+  // Buffers larger than the largest size class are not pooled.
+  const auto largest = size_t{1} << ReceiveBufferPool::kMaxClassSizeLog;
+  ASSERT_EQ(pool.acquire(largest + 1).capacity(), largest + 1);
+}
+
+TEST(receive_buffer_pool, default_receiver_gets_the_message) {
+  CopyingReceiver receiver;
+  auto buffer = ReceiveBufferPool::instance().acquire(5);
+  memcpy(buffer.data(), "hello", 5);
+  receiver.onNewPooledMessage(1, std::move(buffer), 5);
+  ASSERT_EQ(receiver.received, "hello");
+}
+
+}  // namespace
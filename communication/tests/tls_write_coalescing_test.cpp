@@ -0,0 +1,190 @@
+// Concord
+//
+// Copyright (c) 2022 VMware, Inc. All Rights Reserved.
+//
+// This product is licensed to you under the Apache 2.0 license (the "License").
+// You may not use this product except in compliance with the Apache 2.0 License.
+//
+// This product may include a number of subcomponents with separate copyright
+// notices and license terms. Your use of these subcomponents is subject to the
+// terms and conditions of the subcomponent's license, as noted in the
+// LICENSE file.
+
+// Small messages queued on a TLS connection are written together, up to MAX_COALESCED_WRITE_SIZE. These tests check
+// that messages on both sides of that limit arrive whole and in order. The certificates of nodes 0 and 1 are expected
+// under the directory given as the first argument, as created by scripts/linux/create_tls_certs.sh.
+
+#include "communication/CommDefs.hpp"
+#include "diagnostics.h"
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace bft::communication;
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr uint16_t kBasePort = 36200;
+// Each test listens on ports of its own, so that it doesn't wait for the ones of the previous test to be released
+uint16_t nextPort = kBasePort;
+constexpr uint32_t kBufferLength = 1024 * 1024;
+// Of a TLS record, as MAX_COALESCED_WRITE_SIZE
+constexpr size_t kMaxCoalescedWriteSize = 16 * 1024;
+const std::string kCipherSuite = "ECDHE-ECDSA-AES256-GCM-SHA384";
+std::string certificatesRootPath = "certs";
+
+class Receiver : public IReceiver {
+ public:
+  void onNewMessage(NodeNum sourceNode, const char* const message, size_t messageLength, NodeNum) override {
+    std::lock_guard<std::mutex> lock(lock_);
+    messages_.emplace_back(sourceNode, std::vector<uint8_t>(message, message + messageLength));
+    cv_.notify_all();
+  }
+  void onConnectionStatusChanged(NodeNum, ConnectionStatus) override {}
+
+  std::vector<std::pair<NodeNum, std::vector<uint8_t>>> waitFor(size_t count) {
+    std::unique_lock<std::mutex> lock(lock_);
+    cv_.wait_for(lock, 30s, [&] { return messages_.size() >= count; });
+    return messages_;
+  }
+
+ private:
+  std::mutex lock_;
+  std::condition_variable cv_;
+  std::vector<std::pair<NodeNum, std::vector<uint8_t>>> messages_;
+};
+
+class tls_write_coalescing : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    for (NodeNum i = 0; i < 2; ++i) nodes_.emplace(i, NodeInfo{"127.0.0.1", nextPort++, true});
+    for (NodeNum i = 0; i < 2; ++i) {
+      TlsTcpConfig config{
+          "127.0.0.1", nodes_.at(i).port, kBufferLength, nodes_, 1, i, certificatesRootPath, kCipherSuite, false};
+      comms_[i].reset(TlsTCPCommunication::create(config));
+      comms_[i]->setReceiver(i, &receivers_[i]);
+      comms_[i]->start();
+    }
+    ASSERT_TRUE(waitForConnection(*comms_[1], 0));
+    ASSERT_TRUE(waitForConnection(*comms_[0], 1));
+  }
+
+  void TearDown() override {
+    for (auto& comm : comms_) {
+      if (comm) comm->stop();
+    }
+    // The next test registers the diagnostics of the same nodes
+    auto& registrar = concord::diagnostics::RegistrarSingleton::getInstance();
+    registrar.perf.clear();
+    registrar.status.clear();
+  }
+
+  static bool waitForConnection(ICommunication& comm, NodeNum node) {
+    for (int i = 0; i < 3000; ++i) {
+      if (comm.getCurrentConnectionStatus(node) == ConnectionStatus::Connected) return true;
+      std::this_thread::sleep_for(10ms);
+    }
+    return false;
+  }
+
+  // Sends messages of these sizes from node 1 to node 0, and checks that they arrive whole and in order
+  void sendAndCheck(const std::vector<size_t>& sizes) {
+    std::vector<std::vector<uint8_t>> sent;
+    for (size_t i = 0; i < sizes.size(); ++i) {
+      sent.push_back(makeMessage(sizes[i], static_cast<uint8_t>(i)));
+      auto copy = sent.back();
+      ASSERT_EQ(comms_[1]->send(0, std::move(copy), MAX_ENDPOINT_NUM), 0);
+    }
+    const auto received = receivers_[0].waitFor(sent.size());
+    ASSERT_EQ(received.size(), sent.size());
+    for (size_t i = 0; i < sent.size(); ++i) {
+      ASSERT_EQ(received[i].first, 1u);
+      ASSERT_EQ(received[i].second, sent[i]) << "message " << i << " of size " << sizes[i];
+    }
+  }
+
+  static std::vector<uint8_t> makeMessage(size_t size, uint8_t seed) {
+    std::vector<uint8_t> msg(size);
+    for (size_t i = 0; i < size; ++i) msg[i] = static_cast<uint8_t>(seed + i * 7);
+    return msg;
+  }
+
+  NodeMap nodes_;
+  Receiver receivers_[2];
+  std::unique_ptr<ICommunication> comms_[2];
+};
+
+TEST_F(tls_write_coalescing, burst_of_small_messages) {
+  std::vector<size_t> sizes;
+  for (size_t i = 0; i < 5000; ++i) sizes.push_back(1 + i % 300);
+  sendAndCheck(sizes);
+}
+
+TEST_F(tls_write_coalescing, messages_around_the_limit) {
+  // With the header of each message, the written sizes are just under, at and just over the limit
+  const size_t header = MSG_HEADER_SIZE;
+  std::vector<size_t> sizes;
+  for (size_t i = 0; i < 50; ++i) {
+    sizes.push_back(kMaxCoalescedWriteSize - header - 1);
+    sizes.push_back(10);
+    sizes.push_back(kMaxCoalescedWriteSize - header);
+    sizes.push_back(kMaxCoalescedWriteSize - header + 1);
+    sizes.push_back(1);
+    sizes.push_back(kMaxCoalescedWriteSize + 1);
+    sizes.push_back(kMaxCoalescedWriteSize / 2);
+    sizes.push_back(kMaxCoalescedWriteSize / 2 - header);
+  }
+  sendAndCheck(sizes);
+}
+
+TEST_F(tls_write_coalescing, small_messages_from_many_threads) {
+  constexpr size_t kThreads = 4;
+  constexpr size_t kMessagesPerThread = 2000;
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&, t] {
+      for (size_t i = 0; i < kMessagesPerThread; ++i) {
+        // Every 100th message is over the limit on its own
+        auto msg = makeMessage(i % 100 == 0 ? kMaxCoalescedWriteSize + 1 : 16 + i % 200, static_cast<uint8_t>(i));
+        // The first byte tells the thread, the next two the index of the message in the thread
+        msg[0] = static_cast<uint8_t>(t);
+        msg[1] = static_cast<uint8_t>(i >> 8);
+        msg[2] = static_cast<uint8_t>(i);
+        comms_[1]->send(0, std::move(msg), MAX_ENDPOINT_NUM);
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+
+  const auto received = receivers_[0].waitFor(kThreads * kMessagesPerThread);
+  ASSERT_EQ(received.size(), kThreads * kMessagesPerThread);
+  // Messages of every thread arrive in the order they were sent
+  std::vector<size_t> next(kThreads, 0);
+  for (const auto& [source, msg] : received) {
+    ASSERT_EQ(source, 1u);
+    const size_t t = msg[0];
+    ASSERT_LT(t, kThreads);
+    const size_t i = (static_cast<size_t>(msg[1]) << 8) | msg[2];
+    ASSERT_EQ(i, next[t]++);
+    auto expected = makeMessage(i % 100 == 0 ? kMaxCoalescedWriteSize + 1 : 16 + i % 200, static_cast<uint8_t>(i));
+    expected[0] = msg[0];
+    expected[1] = msg[1];
+    expected[2] = msg[2];
+    ASSERT_EQ(msg, expected);
+  }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  if (argc > 1) certificatesRootPath = argv[1];
+  return RUN_ALL_TESTS();
+}
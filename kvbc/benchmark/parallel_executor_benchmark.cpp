@@ -0,0 +1,134 @@
+// Concord
+//
+// Copyright (c) 2022 VMware, Inc. All Rights Reserved.
+//
+// This product is licensed to you under the Apache 2.0 license (the
+// "License").  You may not use this product except in compliance with the
+// Apache 2.0 License.
+//
+// This product may include a number of subcomponents with separate copyright
+// notices and license terms. Your use of these subcomponents is subject to the
+// terms and conditions of the subcomponent's license, as noted in the LICENSE
+// file.
+
+// Throughput of ParallelExecutor for a batch of requests with tunable contention.
+//
+// Arguments:
+//  - number of threads (1 means sequential execution)
+//  - contention in percent - the probability that a request reads and writes a single hot key
+//
+// Every request reads a few keys, does some CPU work (hashing) and writes its own key.
+
+#include <benchmark/benchmark.h>
+
+#include "categorization/parallel_executor.h"
+#include "db_interfaces.h"
+#include "sha_hash.hpp"
+
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace concord::kvbc;
+using namespace concord::kvbc::categorization;
+
+const auto kCategory = std::string{"versioned"};
+constexpr auto kBatchSize = 512u;
+constexpr auto kKeyCount = 100000u;
+constexpr auto kReadsPerRequest = 4u;
+constexpr auto kHashRounds = 200u;
+
+class StaticReader : public IReader {
+ public:
+  std::optional<categorization::Value> get(const std::string &, const std::string &, BlockId) const override {
+    return std::nullopt;
+  }
+  std::optional<categorization::Value> getLatest(const std::string &, const std::string &key) const override {
+    return VersionedValue{{1, key}};
+  }
+  void multiGet(const std::string &,
+                const std::vector<std::string> &,
+                const std::vector<BlockId> &,
+                std::vector<std::optional<categorization::Value>> &) const override {}
+  void multiGetLatest(const std::string &,
+                      const std::vector<std::string> &,
+                      std::vector<std::optional<categorization::Value>> &) const override {}
+  std::optional<TaggedVersion> getLatestVersion(const std::string &, const std::string &) const override {
+    return std::nullopt;
+  }
+  void multiGetLatestVersion(const std::string &,
+                             const std::vector<std::string> &,
+                             std::vector<std::optional<TaggedVersion>> &) const override {}
+  std::optional<Updates> getBlockUpdates(BlockId) const override { return std::nullopt; }
+  BlockId getGenesisBlockId() const override { return 1; }
+  BlockId getLastBlockId() const override { return 1; }
+};
+
+struct RequestPlan {
+  std::vector<std::string> reads;
+  std::string write;
+};
+
+std::vector<RequestPlan> makePlan(std::uint32_t contention_percent) {
+  auto gen = std::mt19937{42};
+  auto key_dist = std::uniform_int_distribution<std::uint32_t>{0, kKeyCount - 1};
+  auto percent_dist = std::uniform_int_distribution<std::uint32_t>{0, 99};
+  auto plan = std::vector<RequestPlan>{};
+  for (auto i = 0u; i < kBatchSize; ++i) {
+    auto req = RequestPlan{};
+    for (auto r = 0u; r < kReadsPerRequest; ++r) {
+      req.reads.push_back("k" + std::to_string(key_dist(gen)));
+    }
+    if (percent_dist(gen) < contention_percent) {
+      req.reads.push_back("hot");
+      req.write = "hot";
+    } else {
+      req.write = "w" + std::to_string(i);
+    }
+    plan.push_back(std::move(req));
+  }
+  return plan;
+}
+
+void parallelExecution(benchmark::State &state) {
+  const auto threads = static_cast<std::uint32_t>(state.range(0));
+  const auto plan = makePlan(static_cast<std::uint32_t>(state.range(1)));
+  auto reader = StaticReader{};
+  auto executor = ParallelExecutor{reader, {{kCategory, CATEGORY_TYPE::versioned_kv}}, threads};
+  const auto func = [&plan](std::size_t index, ParallelExecutor::Transaction &txn) {
+    auto acc = std::string{};
+    for (const auto &key : plan[index].reads) {
+      acc += txn.get(kCategory, key).value_or("");
+    }
+    auto digest = concord::util::SHA3_256{}.digest(acc.data(), acc.size());
+    for (auto i = 1u; i < kHashRounds; ++i) {
+      digest = concord::util::SHA3_256{}.digest(digest.data(), digest.size());
+    }
+    txn.put(kCategory, plan[index].write, std::string{digest.cbegin(), digest.cend()});
+  };
+
+  auto reexecutions = 0ull;
+  for (auto _ : state) {
+    auto updates = executor.execute(kBatchSize, func);
+    benchmark::DoNotOptimize(updates);
+    reexecutions += executor.lastStats().reexecutions;
+  }
+  state.SetItemsProcessed(state.iterations() * kBatchSize);
+  state.counters["reexecutions_per_batch"] =
+      benchmark::Counter(static_cast<double>(reexecutions) / static_cast<double>(state.iterations()));
+}
+
+}  // namespace
+
+BENCHMARK(parallelExecution)
+    ->ArgsProduct({{1, 2, 4, 8, 16}, {0, 1, 10, 50, 100}})
+    ->ArgNames({"threads", "contention%"})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,158 @@
+// Concord
+//
+// Copyright (c) 2022 VMware, Inc. All Rights Reserved.
+//
+// This product is licensed to you under the Apache 2.0 license (the
+// "License").  You may not use this product except in compliance with the
+// Apache 2.0 License.
+//
+// This product may include a number of subcomponents with separate copyright
+// notices and license terms. Your use of these subcomponents is subject to the
+// terms and conditions of the subcomponent's license, as noted in the LICENSE
+// file.
+
+#pragma once
+
+#include "base_types.h"
+#include "db_interfaces.h"
+#include "thread_pool.hpp"
+#include "updates.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace concord::kvbc::categorization {
+
+// Optimistic (Block-STM style) parallel execution of a batch of requests.
+//
+// Requests are executed speculatively on a thread pool against a multi-version in-memory overlay on top of an
+// IReader. Every request records the versions it read (either the reader or the write of a lower-index request at a
+// given incarnation). After the speculative round, requests are validated in their original order. A request whose
+// read set no longer matches the state produced by the requests before it is re-executed against that state. Since
+// validation happens in order, a re-executed request always observes the final state of its prefix and is therefore
+// committed immediately.
+//
+// The resulting Updates are identical to executing the requests sequentially, in order, against the same overlay,
+// provided the execute function is deterministic given the values it reads and only accesses state through the
+// passed Transaction.
+//
+// Supported category types are block merkle, versioned and immutable (without tags). Deletes are not supported for
+// immutable categories.
+class ParallelExecutor {
+ private:
+  using Key = std::pair<std::string, std::string>;  // category ID and key
+
+  struct KeyHash {
+    std::size_t operator()(const Key& k) const noexcept {
+      const auto h = std::hash<std::string>{}(k.first);
+      return h ^ (std::hash<std::string>{}(k.second) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2));
+    }
+  };
+
+  // A write of the request at `index` when executing as its `incarnation`.
+  struct Version {
+    std::size_t index{0};
+    std::uint32_t incarnation{0};
+  };
+
+  // A read observed either a specific version or, if std::nullopt, the underlying reader.
+  struct Read {
+    Key key;
+    std::optional<Version> version;
+  };
+
+  // std::nullopt means a delete.
+  using WriteSet = std::map<Key, std::optional<std::string>>;
+
+ public:
+  // A request's view of the state. Reads observe the request's own writes, then writes of lower-index requests and,
+  // finally, the underlying reader.
+  class Transaction {
+   public:
+    std::optional<std::string> get(const std::string& category_id, const std::string& key);
+    void put(const std::string& category_id, const std::string& key, std::string value);
+    void del(const std::string& category_id, const std::string& key);
+
+   private:
+    Transaction(ParallelExecutor& executor, std::size_t index) : executor_{executor}, index_{index} {}
+
+    ParallelExecutor& executor_;
+    const std::size_t index_;
+    std::vector<Read> reads_;
+    WriteSet writes_;
+    friend class ParallelExecutor;
+  };
+
+  // Executes the request at the given index. Can be called more than once for the same index and concurrently for
+  // different indexes.
+  using ExecuteFunction = std::function<void(std::size_t index, Transaction&)>;
+
+  struct Stats {
+    std::size_t executions{0};
+    std::size_t reexecutions{0};
+  };
+
+ public:
+  // Passing thread_count = 1 executes requests sequentially, in order, on the calling thread.
+  ParallelExecutor(const IReader& reader,
+                   std::map<std::string, CATEGORY_TYPE> category_types,
+                   std::uint32_t thread_count);
+
+  // Executes `request_count` requests and returns the updates for the resulting block.
+  // If a request throws after observing a consistent state, the exception is propagated to the caller.
+  Updates execute(std::size_t request_count, const ExecuteFunction& func);
+
+  // Statistics about the last execute() call.
+  const Stats& lastStats() const { return stats_; }
+
+ private:
+  struct TxnState {
+    std::uint32_t incarnation{0};
+    std::vector<Read> reads;
+    WriteSet writes;
+    std::exception_ptr error;
+  };
+
+  // Versions of a key, ordered by request index.
+  struct VersionChain {
+    std::map<std::size_t, std::pair<std::uint32_t, std::optional<std::string>>> versions;
+  };
+
+  struct Shard {
+    std::mutex mutex;
+    std::unordered_map<Key, VersionChain, KeyHash> chains;
+  };
+
+  static constexpr std::size_t kShards = 64;
+
+  Shard& shardFor(const Key& key) { return shards_[KeyHash{}(key) % kShards]; }
+  void executeIncarnation(std::size_t index, const ExecuteFunction& func);
+  bool validate(std::size_t index);
+  void publish(std::size_t index, std::uint32_t incarnation, const WriteSet& old_writes, const WriteSet& new_writes);
+  std::pair<std::optional<Version>, std::optional<std::string>> readVersioned(const Key& key, std::size_t index);
+  std::optional<std::string> readStorage(const Key& key) const;
+  void checkCategory(const std::string& category_id, bool is_delete) const;
+  Updates buildUpdates();
+  void reset(std::size_t request_count);
+
+ private:
+  const IReader& reader_;
+  const std::map<std::string, CATEGORY_TYPE> category_types_;
+  std::unique_ptr<concord::util::ThreadPool> pool_;
+  std::array<Shard, kShards> shards_;
+  std::vector<TxnState> txns_;
+  Stats stats_;
+};
+
+}  // namespace concord::kvbc::categorization
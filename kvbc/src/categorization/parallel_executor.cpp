@@ -0,0 +1,245 @@
+// Concord
+//
+// Copyright (c) 2022 VMware, Inc. All Rights Reserved.
+//
+// This product is licensed to you under the Apache 2.0 license (the
+// "License").  You may not use this product except in compliance with the
+// Apache 2.0 License.
+//
+// This product may include a number of subcomponents with separate copyright
+// notices and license terms. Your use of these subcomponents is subject to the
+// terms and conditions of the subcomponent's license, as noted in the LICENSE
+// file.
+
+#include "categorization/parallel_executor.h"
+
+#include "assertUtils.hpp"
+
+#include <future>
+#include <set>
+#include <stdexcept>
+#include <variant>
+
+namespace concord::kvbc::categorization {
+
+std::optional<std::string> ParallelExecutor::Transaction::get(const std::string& category_id, const std::string& key) {
+  auto k = Key{category_id, key};
+  if (auto it = writes_.find(k); it != writes_.cend()) {
+    return it->second;
+  }
+  auto [version, value] = executor_.readVersioned(k, index_);
+  reads_.push_back(Read{std::move(k), version});
+  return std::move(value);
+}
+
+void ParallelExecutor::Transaction::put(const std::string& category_id, const std::string& key, std::string value) {
+  executor_.checkCategory(category_id, false);
+  writes_[Key{category_id, key}] = std::move(value);
+}
+
+void ParallelExecutor::Transaction::del(const std::string& category_id, const std::string& key) {
+  executor_.checkCategory(category_id, true);
+  writes_[Key{category_id, key}] = std::nullopt;
+}
+
+ParallelExecutor::ParallelExecutor(const IReader& reader,
+                                   std::map<std::string, CATEGORY_TYPE> category_types,
+                                   std::uint32_t thread_count)
+    : reader_{reader}, category_types_{std::move(category_types)} {
+  ConcordAssertGT(thread_count, 0);
+  if (thread_count > 1) {
+    pool_ = std::make_unique<concord::util::ThreadPool>(thread_count);
+  }
+}
+
+Updates ParallelExecutor::execute(std::size_t request_count, const ExecuteFunction& func) {
+  reset(request_count);
+
+  // Speculative round - all requests run concurrently against the overlay.
+  if (pool_) {
+    auto futures = std::vector<std::future<void>>{};
+    futures.reserve(request_count);
+    for (auto i = 0u; i < request_count; ++i) {
+      futures.push_back(pool_->async([this, i, &func]() { executeIncarnation(i, func); }));
+    }
+    for (auto& f : futures) {
+      f.get();
+    }
+  } else {
+    for (auto i = 0u; i < request_count; ++i) {
+      executeIncarnation(i, func);
+    }
+  }
+
+  // Validate and commit in order. All requests before `i` are final at this point, so a re-execution of `i` observes
+  // exactly the state sequential execution would have.
+  for (auto i = 0u; i < request_count; ++i) {
+    if (!validate(i)) {
+      executeIncarnation(i, func);
+      ++stats_.reexecutions;
+    }
+    if (txns_[i].error) {
+      std::rethrow_exception(txns_[i].error);
+    }
+  }
+  stats_.executions = request_count + stats_.reexecutions;
+
+  return buildUpdates();
+}
+
+void ParallelExecutor::executeIncarnation(std::size_t index, const ExecuteFunction& func) {
+  auto& txn = txns_[index];
+  auto t = Transaction{*this, index};
+  auto error = std::exception_ptr{};
+  try {
+    func(index, t);
+  } catch (...) {
+    // Could be a result of an inconsistent speculative read. Only propagated if the request is found valid.
+    error = std::current_exception();
+  }
+  const auto incarnation = ++txn.incarnation;
+  publish(index, incarnation, txn.writes, t.writes_);
+  txn.reads = std::move(t.reads_);
+  txn.writes = std::move(t.writes_);
+  txn.error = error;
+}
+
+std::pair<std::optional<ParallelExecutor::Version>, std::optional<std::string>> ParallelExecutor::readVersioned(
+    const Key& key, std::size_t index) {
+  {
+    auto& shard = shardFor(key);
+    auto lock = std::lock_guard{shard.mutex};
+    if (auto chain = shard.chains.find(key); chain != shard.chains.cend()) {
+      auto it = chain->second.versions.lower_bound(index);
+      if (it != chain->second.versions.cbegin()) {
+        --it;
+        return {Version{it->first, it->second.first}, it->second.second};
+      }
+    }
+  }
+  return {std::nullopt, readStorage(key)};
+}
+
+bool ParallelExecutor::validate(std::size_t index) {
+  for (const auto& read : txns_[index].reads) {
+    auto& shard = shardFor(read.key);
+    auto lock = std::lock_guard{shard.mutex};
+    auto current = std::optional<Version>{};
+    if (auto chain = shard.chains.find(read.key); chain != shard.chains.cend()) {
+      auto it = chain->second.versions.lower_bound(index);
+      if (it != chain->second.versions.cbegin()) {
+        --it;
+        current = Version{it->first, it->second.first};
+      }
+    }
+    if (current.has_value() != read.version.has_value()) {
+      return false;
+    }
+    if (current && (current->index != read.version->index || current->incarnation != read.version->incarnation)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void ParallelExecutor::publish(std::size_t index,
+                               std::uint32_t incarnation,
+                               const WriteSet& old_writes,
+                               const WriteSet& new_writes) {
+  for (const auto& [key, value] : old_writes) {
+    if (new_writes.find(key) == new_writes.cend()) {
+      auto& shard = shardFor(key);
+      auto lock = std::lock_guard{shard.mutex};
+      shard.chains[key].versions.erase(index);
+    }
+  }
+  for (const auto& [key, value] : new_writes) {
+    auto& shard = shardFor(key);
+    auto lock = std::lock_guard{shard.mutex};
+    shard.chains[key].versions[index] = std::make_pair(incarnation, value);
+  }
+}
+
+std::optional<std::string> ParallelExecutor::readStorage(const Key& key) const {
+  const auto value = reader_.getLatest(key.first, key.second);
+  if (!value) {
+    return std::nullopt;
+  }
+  return std::visit([](const auto& v) { return v.data; }, *value);
+}
+
+void ParallelExecutor::checkCategory(const std::string& category_id, bool is_delete) const {
+  const auto it = category_types_.find(category_id);
+  if (it == category_types_.cend()) {
+    throw std::invalid_argument{"ParallelExecutor: unknown category: " + category_id};
+  }
+  if (is_delete && it->second == CATEGORY_TYPE::immutable) {
+    throw std::invalid_argument{"ParallelExecutor: deletes are not supported in immutable category: " + category_id};
+  }
+}
+
+Updates ParallelExecutor::buildUpdates() {
+  // Apply the final write sets in order so that later requests overwrite earlier ones.
+  auto merged = std::map<std::string, std::map<std::string, std::optional<std::string>>>{};
+  for (auto& txn : txns_) {
+    for (auto& [key, value] : txn.writes) {
+      merged[key.first][key.second] = std::move(value);
+    }
+  }
+
+  auto updates = Updates{};
+  for (auto& [category_id, kvs] : merged) {
+    switch (category_types_.at(category_id)) {
+      case CATEGORY_TYPE::block_merkle: {
+        auto merkle = BlockMerkleUpdates{};
+        for (auto& [key, value] : kvs) {
+          auto k = key;
+          if (value) {
+            merkle.addUpdate(std::move(k), std::move(*value));
+          } else {
+            merkle.addDelete(std::move(k));
+          }
+        }
+        updates.add(category_id, std::move(merkle));
+        break;
+      }
+      case CATEGORY_TYPE::versioned_kv: {
+        auto versioned = VersionedUpdates{};
+        for (auto& [key, value] : kvs) {
+          auto k = key;
+          if (value) {
+            versioned.addUpdate(std::move(k), std::move(*value));
+          } else {
+            versioned.addDelete(std::move(k));
+          }
+        }
+        updates.add(category_id, std::move(versioned));
+        break;
+      }
+      case CATEGORY_TYPE::immutable: {
+        auto immutable = ImmutableUpdates{};
+        for (auto& [key, value] : kvs) {
+          auto k = key;
+          immutable.addUpdate(std::move(k),
+                              ImmutableUpdates::ImmutableValue{std::move(*value), std::set<std::string>{}});
+        }
+        updates.add(category_id, std::move(immutable));
+        break;
+      }
+      default:
+        ConcordAssert(false);
+    }
+  }
+  return updates;
+}
+
+void ParallelExecutor::reset(std::size_t request_count) {
+  txns_.clear();
+  txns_.resize(request_count);
+  for (auto& shard : shards_) {
+    shard.chains.clear();
+  }
+  stats_ = Stats{};
+}
+
+}  // namespace concord::kvbc::categorization
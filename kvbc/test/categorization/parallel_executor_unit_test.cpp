@@ -0,0 +1,189 @@
+// Concord
+//
+// Copyright (c) 2022 VMware, Inc. All Rights Reserved.
+//
+// This product is licensed to you under the Apache 2.0 license (the
+// "License").  You may not use this product except in compliance with the
+// Apache 2.0 License.
+//
+// This product may include a number of subcomponents with separate copyright
+// notices and license terms. Your use of these subcomponents is subject to the
+// terms and conditions of the subcomponent's license, as noted in the LICENSE
+// file.
+
+#include "gtest/gtest.h"
+
+#include "categorization/parallel_executor.h"
+#include "db_interfaces.h"
+
+#include <map>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using namespace ::testing;
+using namespace concord::kvbc;
+using namespace concord::kvbc::categorization;
+
+const auto kMerkle = std::string{"merkle"};
+const auto kVersioned = std::string{"versioned"};
+const auto kImmutable = std::string{"immutable"};
+
+class InMemoryReader : public IReader {
+ public:
+  std::map<std::pair<std::string, std::string>, std::string> data;
+
+  std::optional<categorization::Value> get(const std::string &, const std::string &, BlockId) const override {
+    return std::nullopt;
+  }
+
+  std::optional<categorization::Value> getLatest(const std::string &category_id,
+                                                 const std::string &key) const override {
+    auto it = data.find({category_id, key});
+    if (it == data.cend()) {
+      return std::nullopt;
+    }
+    return VersionedValue{{1, it->second}};
+  }
+
+  void multiGet(const std::string &,
+                const std::vector<std::string> &,
+                const std::vector<BlockId> &,
+                std::vector<std::optional<categorization::Value>> &) const override {}
+
+  void multiGetLatest(const std::string &,
+                      const std::vector<std::string> &,
+                      std::vector<std::optional<categorization::Value>> &) const override {}
+
+  std::optional<TaggedVersion> getLatestVersion(const std::string &, const std::string &) const override {
+    return std::nullopt;
+  }
+
+  void multiGetLatestVersion(const std::string &,
+                             const std::vector<std::string> &,
+                             std::vector<std::optional<TaggedVersion>> &) const override {}
+
+  std::optional<Updates> getBlockUpdates(BlockId) const override { return std::nullopt; }
+
+  BlockId getGenesisBlockId() const override { return 1; }
+
+  BlockId getLastBlockId() const override { return 1; }
+};
+
+const auto kCategories = std::map<std::string, CATEGORY_TYPE>{{kMerkle, CATEGORY_TYPE::block_merkle},
+                                                               {kVersioned, CATEGORY_TYPE::versioned_kv},
+                                                               {kImmutable, CATEGORY_TYPE::immutable}};
+
+std::uint64_t toInt(const std::optional<std::string> &v) { return v ? std::stoull(*v) : 0; }
+
+// Every request increments a shared counter and a per-group counter, then records what it saw in its own key.
+void counterRequest(std::size_t index, ParallelExecutor::Transaction &txn) {
+  const auto counter = toInt(txn.get(kVersioned, "counter")) + 1;
+  txn.put(kVersioned, "counter", std::to_string(counter));
+
+  const auto group_key = "group" + std::to_string(index % 4);
+  const auto group = toInt(txn.get(kMerkle, group_key)) + index;
+  txn.put(kMerkle, group_key, std::to_string(group));
+
+  txn.put(kImmutable, "req" + std::to_string(index), std::to_string(counter) + ":" + std::to_string(group));
+}
+
+TEST(parallel_executor, parallel_matches_sequential) {
+  auto reader = InMemoryReader{};
+  reader.data[{kVersioned, "counter"}] = "100";
+  reader.data[{kMerkle, "group1"}] = "7";
+
+  auto sequential = ParallelExecutor{reader, kCategories, 1};
+  const auto expected = sequential.execute(200, counterRequest);
+  ASSERT_EQ(sequential.lastStats().executions, 200u);
+  ASSERT_EQ(sequential.lastStats().reexecutions, 0u);
+
+  const auto expected_counter = std::get<VersionedInput>(expected.categoryUpdates(kVersioned)->get()).kv.at("counter");
+  ASSERT_EQ(expected_counter.data, "300");
+
+  for (auto threads : {2u, 4u, 8u}) {
+    auto parallel = ParallelExecutor{reader, kCategories, threads};
+    for (auto i = 0; i < 5; ++i) {
+      ASSERT_EQ(parallel.execute(200, counterRequest), expected);
+      ASSERT_EQ(parallel.lastStats().executions, 200u + parallel.lastStats().reexecutions);
+    }
+  }
+}
+
+TEST(parallel_executor, independent_requests_are_not_reexecuted) {
+  auto reader = InMemoryReader{};
+  auto executor = ParallelExecutor{reader, kCategories, 4};
+  const auto updates = executor.execute(100, [](std::size_t index, ParallelExecutor::Transaction &txn) {
+    const auto key = "k" + std::to_string(index);
+    txn.put(kVersioned, key, txn.get(kVersioned, key).value_or("v"));
+  });
+  ASSERT_EQ(executor.lastStats().reexecutions, 0u);
+  ASSERT_EQ(updates.size(), 100u);
+}
+
+TEST(parallel_executor, later_requests_overwrite_and_delete) {
+  auto reader = InMemoryReader{};
+  reader.data[{kMerkle, "a"}] = "storage";
+  auto executor = ParallelExecutor{reader, kCategories, 4};
+  const auto updates = executor.execute(3, [](std::size_t index, ParallelExecutor::Transaction &txn) {
+    switch (index) {
+      case 0:
+        txn.put(kMerkle, "a", "first");
+        txn.put(kMerkle, "b", "first");
+        break;
+      case 1:
+        txn.del(kMerkle, "a");
+        break;
+      case 2:
+        // Assertions are not used here as speculative executions can observe inconsistent state.
+        txn.put(kMerkle, "c", txn.get(kMerkle, "a").value_or("deleted"));
+        txn.put(kMerkle, "b", txn.get(kMerkle, "b").value_or("") + "+third");
+        break;
+    }
+  });
+  const auto &merkle = std::get<BlockMerkleInput>(updates.categoryUpdates(kMerkle)->get());
+  ASSERT_EQ(merkle.kv.size(), 2u);
+  ASSERT_EQ(merkle.kv.at("b"), "first+third");
+  ASSERT_EQ(merkle.kv.at("c"), "deleted");
+  ASSERT_EQ(merkle.deletes, std::vector<std::string>{"a"});
+}
+
+TEST(parallel_executor, errors_are_propagated) {
+  auto reader = InMemoryReader{};
+  auto executor = ParallelExecutor{reader, kCategories, 4};
+  ASSERT_THROW(executor.execute(10,
+                                [](std::size_t index, ParallelExecutor::Transaction &) {
+                                  if (index == 5) throw std::runtime_error{"failure"};
+                                }),
+               std::runtime_error);
+  ASSERT_THROW(executor.execute(
+                   1, [](std::size_t, ParallelExecutor::Transaction &txn) { txn.put("unknown", "k", "v"); }),
+               std::invalid_argument);
+  ASSERT_THROW(
+      executor.execute(1, [](std::size_t, ParallelExecutor::Transaction &txn) { txn.del(kImmutable, "k"); }),
+      std::invalid_argument);
+}
+
+// A request that throws on a speculative, inconsistent read must not fail the batch.
+TEST(parallel_executor, speculative_errors_are_retried) {
+  auto reader = InMemoryReader{};
+  auto executor = ParallelExecutor{reader, kCategories, 8};
+  for (auto i = 0; i < 10; ++i) {
+    ASSERT_NO_THROW(executor.execute(50, [](std::size_t index, ParallelExecutor::Transaction &txn) {
+      const auto seen = toInt(txn.get(kVersioned, "chain"));
+      if (seen != index) throw std::logic_error{"out of order"};
+      txn.put(kVersioned, "chain", std::to_string(index + 1));
+    }));
+  }
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  ::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,84 @@
+# Concord
+#
+# Copyright (c) 2022 VMware, Inc. All Rights Reserved.
+#
+# This product is licensed to you under the Apache 2.0 license (the "License").
+# You may not use this product except in compliance with the Apache 2.0 License.
+#
+# This product may include a number of subcomponents with separate copyright
+# notices and license terms. Your use of these subcomponents is subject to the
+# terms and conditions of the subcomponent's license, as noted in the LICENSE
+# file.
+
+import os.path
+import time
+import unittest
+
+import trio
+
+from util.test_base import ApolloTest
+from util.bft import with_trio, with_bft_network, KEY_FILE_PREFIX
+from util.skvbc_history_tracker import verify_linearizability
+from util import skvbc as kvbc
+
+NUM_OF_ROUNDS = 10
+MAX_CONCURRENCY = 30
+# Small enough for a burst of MAX_CONCURRENCY requests to overload the primary
+MAX_PENDING_REQUESTS = "4"
+MAX_PREPROCESSOR_REQUESTS = "4"
+# Well under the request timeout of the clients: overloaded replicas turn requests away instead of queueing them
+MAX_WRITE_LATENCY_SECONDS = 4
+
+def start_replica_cmd(builddir, replica_id):
+    """
+    Return a command that starts an skvbc replica when passed to
+    subprocess. Popen.
+
+    Note each arguments is an element in a list.
+    """
+    statusTimerMilli = "500"
+    path = os.path.join(builddir, "tests", "simpleKVBC", "TesterReplica", "skvbc_replica")
+    return [path,
+            "-k", KEY_FILE_PREFIX,
+            "-i", str(replica_id),
+            "-s", statusTimerMilli,
+            "--admission-control-max-pending-requests", MAX_PENDING_REQUESTS,
+            "--admission-control-max-preprocessor-requests", MAX_PREPROCESSOR_REQUESTS
+            ]
+
+class SkvbcAdmissionControlTest(ApolloTest):
+
+    @with_trio
+    @with_bft_network(start_replica_cmd, selected_configs=lambda n, f, c: n == 4)
+    @verify_linearizability(pre_exec_enabled=True, no_conflicts=True)
+    async def test_overloaded_primary_sends_busy_replies(self, bft_network, tracker):
+        """
+        Overload the primary with bursts of concurrent writes, and check that:
+        1. It turns some of them away with busy replies.
+        2. The clients back off and retry, so that all of the writes complete, with a bounded latency.
+        """
+        bft_network.start_all_replicas()
+        skvbc = kvbc.SimpleKVBCProtocol(bft_network, tracker)
+        clients = bft_network.random_clients(MAX_CONCURRENCY)
+        latencies = []
+
+        async def timed_write(client):
+            start = time.monotonic()
+            await skvbc.send_write_kv_set(client=client, max_set_size=2)
+            latencies.append(time.monotonic() - start)
+
+        for _ in range(NUM_OF_ROUNDS):
+            async with trio.open_nursery() as nursery:
+                for client in clients:
+                    nursery.start_soon(timed_write, client)
+
+        self.assertEqual(len(latencies), NUM_OF_ROUNDS * len(clients))
+        self.assertLess(max(latencies), MAX_WRITE_LATENCY_SECONDS)
+
+        primary = await bft_network.get_current_primary()
+        rejected = await bft_network.get_metric(primary, bft_network, "Counters", "admissionControlRejectedRequests")
+        self.assertGreater(rejected, 0)
+        self.assertGreater(sum(client.busy_replies for client in clients), 0)
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,79 @@
+# Concord
+#
+# Copyright (c) 2022 VMware, Inc. All Rights Reserved.
+#
+# This product is licensed to you under the Apache 2.0 license (the "License").
+# You may not use this product except in compliance with the Apache 2.0 License.
+#
+# This product may include a number of subcomponents with separate copyright
+# notices and license terms. Your use of these subcomponents is subject to the
+# terms and conditions of the subcomponent's license, as noted in the LICENSE
+# file.
+
+import os.path
+import unittest
+
+from util.test_base import ApolloTest
+from util.bft import with_trio, with_bft_network, KEY_FILE_PREFIX
+from util.skvbc_history_tracker import verify_linearizability
+from util import skvbc as kvbc
+
+NUM_OF_OPS = 100
+# The share of the PrePrepareDigestsMsgs that a replica may fail to rebuild, because a request reached the primary
+# before it reached the replica
+MAX_MISSING_REQUESTS_RATIO = 0.2
+
+def start_replica_cmd(builddir, replica_id):
+    """
+    Return a command that starts an skvbc replica when passed to
+    subprocess.Popen.
+
+    Note each arguments is an element in a list.
+    """
+    statusTimerMilli = "500"
+    viewChangeTimeoutMilli = "10000"
+    path = os.path.join(builddir, "tests", "simpleKVBC", "TesterReplica", "skvbc_replica")
+    return [path,
+            "-k", KEY_FILE_PREFIX,
+            "-i", str(replica_id),
+            "-s", statusTimerMilli,
+            "-v", viewChangeTimeoutMilli,
+            "--pre-prepare-digests-only"
+            ]
+
+class SkvbcPrePrepareDigestsTest(ApolloTest):
+
+    @with_trio
+    @with_bft_network(start_replica_cmd, selected_configs=lambda n, f, c: n == 4)
+    @verify_linearizability()
+    async def test_preprepares_are_rebuilt_from_client_requests(self, bft_network, tracker):
+        """
+        Run replicas whose primary references the client requests of its PrePrepares, with clients that send their
+        writes to all the replicas, and check that:
+        1. The primary sends PrePrepareDigestsMsgs.
+        2. The other replicas rebuild most of the PrePrepares from the requests they got from the clients, rather than
+           asking the primary for them.
+        """
+        bft_network.start_all_replicas()
+        for client in bft_network.clients.values():
+            client.send_writes_to_all = True
+        skvbc = kvbc.SimpleKVBCProtocol(bft_network, tracker)
+
+        await skvbc.run_concurrent_ops(NUM_OF_OPS, write_weight=1)
+        await skvbc.read_your_writes()
+
+        primary = await bft_network.get_current_primary()
+        sent = await bft_network.get_metric(primary, bft_network, "Counters", "sentPrePrepareDigestsMsgs")
+        self.assertGreater(sent, 0)
+
+        for replica_id in bft_network.all_replicas(without={primary}):
+            received = await bft_network.get_metric(
+                replica_id, bft_network, "Counters", "receivedPrePrepareDigestsMsgs")
+            missing = await bft_network.get_metric(
+                replica_id, bft_network, "Counters", "prePrepareDigestsWithMissingRequests")
+            self.assertGreater(received, 0)
+            self.assertLessEqual(missing, received * MAX_MISSING_REQUESTS_RATIO,
+                                 f"Replica {replica_id} missed the requests of {missing} of {received} PrePrepares")
+
+if __name__ == '__main__':
+    unittest.main()
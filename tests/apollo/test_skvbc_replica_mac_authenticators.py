@@ -0,0 +1,88 @@
+# Concord
+#
+# Copyright (c) 2022 VMware, Inc. All Rights Reserved.
+#
+# This product is licensed to you under the Apache 2.0 license (the "License").
+# You may not use this product except in compliance with the Apache 2.0 License.
+#
+# This product may include a number of subcomponents with separate copyright
+# notices and license terms. Your use of these subcomponents is subject to the
+# terms and conditions of the subcomponent's license, as noted in the LICENSE
+# file.
+
+import os.path
+import random
+import unittest
+
+import trio
+
+from util.test_base import ApolloTest
+from util.bft import with_trio, with_bft_network, KEY_FILE_PREFIX
+from util.skvbc_history_tracker import verify_linearizability
+from util import skvbc as kvbc
+
+def start_replica_cmd(builddir, replica_id):
+    """
+    Return a command that starts an skvbc replica when passed to
+    subprocess.Popen.
+
+    Note each arguments is an element in a list.
+    """
+    statusTimerMilli = "500"
+    viewChangeTimeoutMilli = "10000"
+    path = os.path.join(builddir, "tests", "simpleKVBC", "TesterReplica", "skvbc_replica")
+    return [path,
+            "-k", KEY_FILE_PREFIX,
+            "-i", str(replica_id),
+            "-s", statusTimerMilli,
+            "-v", viewChangeTimeoutMilli,
+            "--replica-mac-authenticators"
+            ]
+
+class SkvbcReplicaMacAuthenticatorsTest(ApolloTest):
+
+    @with_trio
+    @with_bft_network(start_replica_cmd, selected_configs=lambda n, f, c: n == 4)
+    @verify_linearizability()
+    async def test_view_change_with_mac_authenticators(self, bft_network, tracker):
+        """
+        Run replicas that authenticate the messages between them with MACs, and check that:
+        1. Every replica establishes a session key with each of its peers through handshakes, without which the
+           messages between them would be dropped.
+        2. Writes complete before and after a view change, which relies on the MACs of the view change messages.
+        """
+        bft_network.start_all_replicas()
+        skvbc = kvbc.SimpleKVBCProtocol(bft_network, tracker)
+        await skvbc.run_concurrent_ops(10)
+
+        for replica_id in bft_network.all_replicas():
+            await self._wait_for_session_keys(bft_network, replica_id)
+
+        initial_primary = await bft_network.get_current_primary()
+        initial_view = await bft_network.get_current_view()
+        bft_network.stop_replica(initial_primary)
+
+        try:
+            with trio.move_on_after(seconds=5):
+                await skvbc.send_indefinite_write_requests()
+        finally:
+            await bft_network.wait_for_view(
+                replica_id=random.choice(bft_network.all_replicas(without={initial_primary})),
+                expected=lambda v: v == initial_view + 1,
+                err_msg="Make sure view change has been triggered."
+            )
+
+        await skvbc.run_concurrent_ops(10)
+        await skvbc.read_your_writes()
+
+    async def _wait_for_session_keys(self, bft_network, replica_id):
+        peers = bft_network.config.n - 1
+
+        async def session_keys():
+            keys = await bft_network.get_metric(replica_id, bft_network, "Gauges", "macSessionKeys")
+            return keys if keys >= peers else None
+
+        await bft_network.wait_for(session_keys, timeout=30, interval=1)
+
+if __name__ == '__main__':
+    unittest.main()
@@ -301,6 +301,24 @@ void InternalCommandsHandler::writeAccumulatedBlock(ExecutionRequestsQueue &bloc
   addBlock(verUpdates, merkleUpdates, sn);
 }
 
+std::optional<IRequestsHandler::KeySets> InternalCommandsHandler::preExecutionKeySets(uint16_t clientId,
+                                                                                   const char *request,
+                                                                                   uint32_t requestSize) {
+  const uint8_t *request_buffer_as_uint8 = reinterpret_cast<const uint8_t *>(request);
+  SKVBCRequest deserialized_request;
+  try {
+    deserialize(request_buffer_as_uint8, request_buffer_as_uint8 + requestSize, deserialized_request);
+  } catch (const runtime_error &e) {
+    return std::nullopt;
+  }
+  const auto *write_req = std::get_if<SKVBCWriteRequest>(&deserialized_request.request);
+  if (!write_req) return std::nullopt;
+  KeySets keySets;
+  for (const auto &key : write_req->readset) keySets.readKeys.emplace_back(key.begin(), key.end());
+  for (const auto &[key, value] : write_req->writeset) keySets.writeKeys.emplace_back(key.begin(), key.end());
+  return keySets;
+}
+
 OperationResult InternalCommandsHandler::verifyWriteCommand(uint32_t requestSize,
                                                             const uint8_t *request,
                                                             size_t maxReplySize,
@@ -481,6 +499,9 @@ OperationResult InternalCommandsHandler::executeWriteCommand(uint32_t requestSiz
     LOG_INFO(m_logger,
              "ConditionalWrite message handled; writesCounter=" << m_writesCounter
                                                                 << " currBlock=" << write_rep.latest_block);
+  // The request was pre-executed against a state that changed since, so the replica counts it as aborted. The reply
+  // still tells the client that the write failed.
+  if (hasConflict && (flags & MsgFlag::HAS_PRE_PROCESSED_FLAG)) return OperationResult::CONFLICT_DETECTED;
   return OperationResult::SUCCESS;
 }
 
@@ -60,6 +60,9 @@ class InternalCommandsHandler : public concord::kvbc::ICommandsHandler {
                   const std::string &batchCid,
                   concordUtils::SpanWrapper &parent_span) override;
 
+  // The read and write sets of a write request
+  std::optional<KeySets> preExecutionKeySets(uint16_t clientId, const char *request, uint32_t requestSize) override;
+
   void setPerformanceManager(std::shared_ptr<concord::performance::PerformanceManager> perfManager) override;
 
  private:
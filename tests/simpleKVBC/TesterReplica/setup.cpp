@@ -101,6 +101,12 @@ std::unique_ptr<TestSetup> TestSetup::ParseArgs(int argc, char** argv) {
     std::string byzantineStrategies;
     bool is_separate_communication_mode = false;
     int addAllKeysAsPublic = 0;
+    int replicaMacAuthenticators = 0;
+    int preExecResultThresholdAuth = 0;
+    int preExecBatchResultSigning = 0;
+    int preExecConflictAwareScheduling = 0;
+    int prePrepareDigestsOnly = 0;
+    int tcpIoUring = 0;
     int stateTransferMsgDelayMs = 0;
     std::unordered_set<ReplicaId> byzantineReplicaIds{};
 
@@ -112,6 +118,9 @@ std::unique_ptr<TestSetup> TestSetup::ParseArgs(int argc, char** argv) {
         {"delay-state-transfer-messages-millisec", required_argument, 0, 2},
         {"corrupt-checkpoint-messages-from-replica-ids", required_argument, 0, 2},
         {"diagnostics-port", required_argument, 0, 2},
+        {"consensus-batching-latency-target", required_argument, 0, 2},
+        {"admission-control-max-pending-requests", required_argument, 0, 2},
+        {"admission-control-max-preprocessor-requests", required_argument, 0, 2},
 
         // long/short format options
         {"replica-id", required_argument, 0, 'i'},
@@ -145,6 +154,12 @@ std::unique_ptr<TestSetup> TestSetup::ParseArgs(int argc, char** argv) {
         // direct options - assign directly ro a non-null flag
         {"publish-master-key-on-startup", no_argument, (int*)&replicaConfig.publishReplicasMasterKeyOnStartup, 1},
         {"add-all-keys-as-public", no_argument, &addAllKeysAsPublic, 1},
+        {"replica-mac-authenticators", no_argument, &replicaMacAuthenticators, 1},
+        {"pre-exec-result-threshold-auth", no_argument, &preExecResultThresholdAuth, 1},
+        {"pre-exec-batch-result-signing", no_argument, &preExecBatchResultSigning, 1},
+        {"pre-exec-conflict-aware-scheduling", no_argument, &preExecConflictAwareScheduling, 1},
+        {"pre-prepare-digests-only", no_argument, &prePrepareDigestsOnly, 1},
+        {"tcp-io-uring", no_argument, &tcpIoUring, 1},
         {0, 0, 0, 0}};
     int o = 0;
     int optionIndex = 0;
@@ -205,6 +220,29 @@ std::unique_ptr<TestSetup> TestSetup::ParseArgs(int argc, char** argv) {
                     "a valid available port number"};
               }
             } break;
+            case 3: {
+              const auto latencyTargetMs = concord::util::to<std::uint32_t>(std::string(optarg));
+              if (!latencyTargetMs) {
+                throw std::runtime_error{"invalid argument for --consensus-batching-latency-target"};
+              }
+              replicaConfig.batchingLatencyTargetMs = latencyTargetMs;
+            } break;
+            case 4: {
+              const auto maxPendingRequests = concord::util::to<std::uint32_t>(std::string(optarg));
+              if (!maxPendingRequests) {
+                throw std::runtime_error{"invalid argument for --admission-control-max-pending-requests"};
+              }
+              replicaConfig.admissionControlEnabled = true;
+              replicaConfig.admissionControlMaxPendingRequests = maxPendingRequests;
+            } break;
+            case 5: {
+              const auto maxPreProcessorRequests = concord::util::to<std::uint32_t>(std::string(optarg));
+              if (!maxPreProcessorRequests) {
+                throw std::runtime_error{"invalid argument for --admission-control-max-preprocessor-requests"};
+              }
+              replicaConfig.admissionControlEnabled = true;
+              replicaConfig.admissionControlMaxPreProcessorRequests = maxPreProcessorRequests;
+            } break;
             default: {
               std::ostringstream ss;
               ss << "invalid option:" << KVLOG(o, optionIndex);
@@ -278,7 +316,7 @@ std::unique_ptr<TestSetup> TestSetup::ParseArgs(int argc, char** argv) {
         }
         case 'b': {
           auto policy = concord::util::to<std::uint32_t>(std::string(optarg));
-          if (policy < bftEngine::BATCH_SELF_ADJUSTED || policy > bftEngine::BATCH_ADAPTIVE)
+          if (policy < bftEngine::BATCH_SELF_ADJUSTED || policy > bftEngine::BATCH_LATENCY_TARGET)
             throw std::runtime_error{"invalid argument for --consensus-batching-policy"};
           replicaConfig.batchingPolicy = policy;
           break;
@@ -355,6 +393,15 @@ std::unique_ptr<TestSetup> TestSetup::ParseArgs(int argc, char** argv) {
     }
 
     if (keysFilePrefix.empty()) throw std::runtime_error("missing --key-file-prefix");
+    replicaConfig.enableReplicaMacAuthenticators = replicaMacAuthenticators != 0;
+    if (preExecResultThresholdAuth) {
+      if (!replicaConfig.preExecutionResultAuthEnabled)
+        throw std::runtime_error("--pre-exec-result-threshold-auth requires --pre-exec-result-auth");
+      replicaConfig.preExecutionResultThresholdAuthEnabled = true;
+    }
+    replicaConfig.preExecutionBatchResultSigningEnabled = preExecBatchResultSigning != 0;
+    replicaConfig.preExecConflictAwareSchedulingEnabled = preExecConflictAwareScheduling != 0;
+    replicaConfig.prePrepareDigestsOnlyEnabled = prePrepareDigestsOnly != 0;
 
     // If -p and -t are set, enable clientTransactionSigningEnabled. If only one of them is set, throw an error
     if (!principalsMapping.empty() && !txnSigningKeysPath.empty()) {
@@ -375,6 +422,7 @@ std::unique_ptr<TestSetup> TestSetup::ParseArgs(int argc, char** argv) {
 #ifdef USE_COMM_PLAIN_TCP
     bft::communication::PlainTcpConfig conf =
         testCommConfig.GetTCPConfig(true, replicaConfig.replicaId, numOfClients, numOfReplicas, commConfigFile);
+    conf.useIoUring_ = tcpIoUring != 0;
 #elif USE_COMM_TLS_TCP
     bft::communication::TlsTcpConfig conf = testCommConfig.GetTlsTCPConfig(
         true, replicaConfig.replicaId, numOfClients, numOfReplicas, commConfigFile, certRootPath);
@@ -0,0 +1,111 @@
+// Concord
+//
+// Copyright (c) 2022 VMware, Inc. All Rights Reserved.
+//
+// This product is licensed to you under the Apache 2.0 license (the "License").
+// You may not use this product except in compliance with the Apache 2.0 License.
+//
+// This product may include a number of subcomponents with separate copyright
+// notices and license terms. Your use of these subcomponents is subject to the
+// terms and conditions of the subcomponent's license, as noted in the
+// LICENSE file.
+
+// Latency of combining 2f+1 out of n = 3f+1 signature shares into a threshold signature: computing the Lagrange
+// coefficients of the signers and raising the shares to them, with and without the coefficients cache and Pippenger's
+// multiexponentiation.
+
+#include <stdexcept>
+#include <vector>
+
+#include "Logger.hpp"
+#include "Timer.h"
+#include "XAssert.h"
+
+#include "threshsign/bls/relic/Library.h"
+#include "threshsign/bls/relic/FastMultExp.h"
+#include "threshsign/VectorOfShares.h"
+#include "bls/relic/LagrangeInterpolation.h"
+#include "app/RelicMain.h"
+
+using namespace BLS::Relic;
+
+void benchCombine(int numIters, int n) {
+  const int f = (n - 1) / 3;
+  const int k = 2 * f + 1;
+  const BNT& fieldOrder = Library::Get().getG2Order();
+  const int maxBits = Library::Get().getG2OrderNumBits();
+
+  VectorOfShares signers;
+  VectorOfShares::randomSubset(signers, n, k);
+
+  std::vector<G1T> shares(static_cast<size_t>(n + 1));
+  for (ShareID i = signers.first(); signers.isEnd(i) == false; i = signers.next(i)) {
+    shares[static_cast<size_t>(i)].Random();
+  }
+
+  std::vector<BNT> coeffs(static_cast<size_t>(n + 1));
+  LagrangeCoeffsCache cache(fieldOrder);
+  // Steady state: the same signers combined before
+  cache.get(signers, coeffs);
+
+  G1T r1, r2, r3, r4;
+  AveragingTimer t1("Lagrange + fastMultExp:         ");
+  AveragingTimer t2("cached Lagrange + fastMultExp:  ");
+  AveragingTimer t3("Lagrange + Pippenger:           ");
+  AveragingTimer t4("cached Lagrange + Pippenger:    ");
+  for (int i = 0; i < numIters; i++) {
+    t1.startLap();
+    lagrangeCoeffAccumReduced(signers, coeffs, fieldOrder);
+    r1 = fastMultExp<G1T>(signers, shares, coeffs, maxBits);
+    t1.endLap();
+
+    t2.startLap();
+    cache.get(signers, coeffs);
+    r2 = fastMultExp<G1T>(signers, shares, coeffs, maxBits);
+    t2.endLap();
+
+    t3.startLap();
+    lagrangeCoeffAccumReduced(signers, coeffs, fieldOrder);
+    r3 = fastMultExpPippenger<G1T>(signers, shares, coeffs, maxBits);
+    t3.endLap();
+
+    t4.startLap();
+    cache.get(signers, coeffs);
+    r4 = fastMultExpPippenger<G1T>(signers, shares, coeffs, maxBits);
+    t4.endLap();
+  }
+
+  LOG_INFO(THRESHSIGN_LOG, "k = " << k << " out of n = " << n << ", " << numIters << " iterations");
+  LOG_INFO(THRESHSIGN_LOG, t1);
+  LOG_INFO(THRESHSIGN_LOG, t2);
+  LOG_INFO(THRESHSIGN_LOG, t3);
+  LOG_INFO(THRESHSIGN_LOG, t4);
+
+  if (r1 != r2 || r1 != r3 || r1 != r4) {
+    throw std::runtime_error("Incorrect results returned by one of the implementations.");
+  }
+}
+
+int RelicAppMain(const Library& lib, const std::vector<std::string>& args) {
+  (void)args;
+
+  unsigned int seed = static_cast<unsigned int>(time(NULL));
+  LOG_INFO(THRESHSIGN_LOG, "Randomness seed passed to srand(): " << seed);
+  // NOTE: srand is not and should not be used for any cryptographic randomness.
+  srand(seed);
+
+#ifdef NDEBUG
+  const int numIters = 100;
+#else
+  const int numIters = 10;
+#endif
+
+  // Precomputes inverses of i for all signers i
+  lib.getPrecomputedInverses();
+
+  for (int n : {7, 31, 61, 100, 151, 202, 301}) {
+    benchCombine(numIters, n);
+  }
+
+  return 0;
+}
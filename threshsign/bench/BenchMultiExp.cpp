@@ -57,7 +57,7 @@ int RelicAppMain(const Library& lib, const std::vector<std::string>& args) {
 
 template <class GT>
 void benchFastMultExp(int numIters, int numSigners, int reqSigners) {
-  GT r1, r2, r3;
+  GT r1, r2, r3, r4;
   int n = numSigners + (rand() % 2);
   int k = reqSigners + (rand() % 2);
   assertLessThanOrEqual(reqSigners, numSigners);
@@ -115,13 +115,21 @@ void benchFastMultExp(int numIters, int numSigners, int reqSigners) {
     t3.endLap();
   }
 
+  AveragingTimer t4("Pippenger:      ");
+  for (int i = 0; i < numIters; i++) {
+    t4.startLap();
+    r4 = fastMultExpPippenger<GT>(s, a, e, maxBits);
+    t4.endLap();
+  }
+
   LOG_INFO(THRESHSIGN_LOG, "Ran for " << numIters << " iterations");
   LOG_INFO(THRESHSIGN_LOG, t1);
   LOG_INFO(THRESHSIGN_LOG, t2);
   LOG_INFO(THRESHSIGN_LOG, t3);
+  LOG_INFO(THRESHSIGN_LOG, t4);
 
   // Same way?
-  if (r1 != r2 || r1 != r3) {
+  if (r1 != r2 || r1 != r3 || r1 != r4) {
     throw std::runtime_error("Incorrect results returned by one of the implementations.");
   }
 }
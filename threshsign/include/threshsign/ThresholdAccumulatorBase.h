@@ -108,8 +108,10 @@ class ThresholdAccumulatorBase : public IThresholdAccumulator {
   /**
    * Verifies all the pendingShares and moves the valid ones into validShares for accumulation later.
    * After it returns, the 'signers' bit vector will be for the validShares, not pendingShares.
+   *
+   * NOTE: Verifies shares one by one with verifyShare(). Subclasses can override it to verify them in batches.
    */
-  void verifyPendingShares();
+  virtual void verifyPendingShares();
 
   /**
    * Returns true if setExpectedDigest() has been called with a valid digest.
@@ -26,6 +26,8 @@
 namespace BLS {
 namespace Relic {
 
+class BlsThresholdVerifier;
+
 class BlsSigshareParser {
  public:
   std::pair<ShareID, G1T> operator()(const char* sigShare, int len);
@@ -41,11 +43,15 @@ class BlsAccumulatorBase : public ThresholdAccumulatorBase<BlsPublicKey, G1T, Bl
   // True if share verification is enabled
   bool shareVerificationEnabled;
 
+  // If set, pending shares are verified in batches with a BlsBatchVerifier on this verifier (see verifyPendingShares())
+  const BlsThresholdVerifier* batchVerifier;
+
  public:
   BlsAccumulatorBase(const std::vector<BlsPublicKey>& vks,
                      NumSharesType reqSigners,
                      NumSharesType totalSigners,
-                     bool withShareVerification);
+                     bool withShareVerification,
+                     const BlsThresholdVerifier* batchVerifier = nullptr);
   virtual ~BlsAccumulatorBase() {}
 
   // IThresholdAccumulator overloads.
@@ -93,6 +99,13 @@ class BlsAccumulatorBase : public ThresholdAccumulatorBase<BlsPublicKey, G1T, Bl
    */
   virtual void onExpectedDigestSet();
 
+  /**
+   * With a batchVerifier, checks the aggregate of all the pending shares at once, and only when it fails, splits
+   * them in halves recursively to pinpoint the bad ones. A few bad shares out of n then cost O(log n) pairings each
+   * rather than all the shares being paired one by one, so a Byzantine signer can't make combining much slower.
+   */
+  void verifyPendingShares() override;
+
   // Used internally or for testing
  public:
   /**
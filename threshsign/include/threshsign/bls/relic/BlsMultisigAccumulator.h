@@ -31,7 +31,8 @@ class BlsMultisigAccumulator : public BlsAccumulatorBase {
   BlsMultisigAccumulator(const std::vector<BlsPublicKey>& vks,
                          NumSharesType reqSigners,
                          NumSharesType totalSigners,
-                         bool withShareVerification);
+                         bool withShareVerification,
+                         const BlsThresholdVerifier* batchVerifier = nullptr);
   virtual ~BlsMultisigAccumulator() {}
 
   // IThresholdAccumulator overloads.
@@ -22,11 +22,14 @@
 #include "BlsAccumulatorBase.h"
 #include "BlsPublicKey.h"
 
+#include <memory>
 #include <vector>
 
 namespace BLS {
 namespace Relic {
 
+class LagrangeCoeffsCache;
+
 class BlsThresholdAccumulator : public BlsAccumulatorBase {
  protected:
   /**
@@ -34,12 +37,18 @@ class BlsThresholdAccumulator : public BlsAccumulatorBase {
    * ThresholdAccumulatorBase::validSharesBits
    */
   std::vector<BNT> coeffs;
+  /**
+   * Coefficients of recent sets of signers, shared with the other accumulators of the verifier (nullptr: no caching)
+   */
+  std::shared_ptr<LagrangeCoeffsCache> coeffsCache;
 
  public:
   BlsThresholdAccumulator(const std::vector<BlsPublicKey>& vks,
                           NumSharesType reqSigners,
                           NumSharesType totalSigners,
-                          bool withShareVerification);
+                          bool withShareVerification,
+                          std::shared_ptr<LagrangeCoeffsCache> coeffsCache = nullptr,
+                          const BlsThresholdVerifier* batchVerifier = nullptr);
   virtual ~BlsThresholdAccumulator() {}
 
   // IThresholdAccumulator overloads.
@@ -24,6 +24,8 @@
 
 namespace BLS::Relic {
 
+class LagrangeCoeffsCache;
+
 class BlsThresholdVerifier : public IThresholdVerifier {
  protected:
   BlsPublicParameters params_;
@@ -33,6 +35,8 @@ class BlsThresholdVerifier : public IThresholdVerifier {
   G2T generator2_;
   NumSharesType reqSigners_;
   const NumSharesType numSigners_;
+  // Lagrange coefficients of the recent sets of signers, for the accumulators created by this verifier
+  std::shared_ptr<LagrangeCoeffsCache> lagrangeCoeffsCache_;
 
  public:
   BlsThresholdVerifier(const BlsPublicParameters &params,
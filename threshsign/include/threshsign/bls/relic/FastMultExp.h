@@ -36,6 +36,17 @@ GT fastMultExp(const VectorOfShares& s,
                const std::vector<BNT>& e,
                int maxBits);
 
+/**
+ * Computes r = \prod_{i \in s} { a[i]^e[i] } with Pippenger's bucket method: the exponents are cut in windows of c
+ * bits, and in each window the bases are first added to the bucket of their c-bit digit, so every base costs one
+ * addition per window rather than one per set bit. The windows are independent, so they are split among threads.
+ *
+ * NOTE: Faster than fastMultExp above from a few dozens of shares on (see PIPPENGER_MIN_SHARES).
+ */
+static constexpr int PIPPENGER_MIN_SHARES = 32;
+template <class GT>
+GT fastMultExpPippenger(const VectorOfShares& s, const std::vector<GT>& a, const std::vector<BNT>& e, int maxBits);
+
 /**
  * Computes r = \prod_{i \in s} { a[i]^e[i] } faster than naive method by recursing on
  * a fast way to compute a1^e1 * a2^e2.
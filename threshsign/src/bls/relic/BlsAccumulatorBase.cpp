@@ -19,6 +19,7 @@
 #include "threshsign/bls/relic/FastMultExp.h"
 
 #include "BlsAlmostMultisigCoefficients.h"
+#include "BlsBatchVerifier.h"
 #include "LagrangeInterpolation.h"
 
 #include <vector>
@@ -45,8 +46,11 @@ std::pair<ShareID, G1T> BlsSigshareParser::operator()(const char* sigShare, int
 BlsAccumulatorBase::BlsAccumulatorBase(const std::vector<BlsPublicKey>& verifKeys,
                                        NumSharesType reqSigners,
                                        NumSharesType totalSigners,
-                                       bool withShareVerification)
-    : ThresholdAccumulatorBase(verifKeys, reqSigners, totalSigners), shareVerificationEnabled(withShareVerification) {
+                                       bool withShareVerification,
+                                       const BlsThresholdVerifier* batchVerifier)
+    : ThresholdAccumulatorBase(verifKeys, reqSigners, totalSigners),
+      shareVerificationEnabled(withShareVerification),
+      batchVerifier(batchVerifier) {
   assertEqual(vks.size(), static_cast<std::vector<BlsPublicKey>::size_type>(totalSigners + 1));
 
   g2_get_gen(gen2);  // NOTE: requires BLS::Relic::Library::Get() call above to be made
@@ -59,6 +63,44 @@ void BlsAccumulatorBase::onExpectedDigestSet() {
   g1_map(hash, static_cast<const uint8_t*>(expectedDigest.get()), expectedDigestLen);
 }
 
+void BlsAccumulatorBase::verifyPendingShares() {
+  // A single share is checked as fast alone
+  if (batchVerifier == nullptr || pendingSharesBits.count() < 2) {
+    ThresholdAccumulatorBase::verifyPendingShares();
+    return;
+  }
+
+  assertTrue(hasShareVerificationEnabled());
+  assertTrue(hasExpectedDigest());
+  assertEqual(validSharesBits.count(), 0);
+
+  BlsBatchVerifier batch(*batchVerifier, pendingSharesBits.count());
+  for (ShareID id = pendingSharesBits.first(); pendingSharesBits.isEnd(id) == false; id = pendingSharesBits.next(id)) {
+    batch.addShare(id, pendingShares[static_cast<size_t>(id)]);
+  }
+
+  std::vector<ShareID> badShares;
+  batch.batchVerify(hash, true, badShares, true);
+  for (ShareID id : badShares) {
+    invalidShares.insert(id);
+    LOG_WARN(THRESHSIGN_LOG, "Invalid share by signer " << id << " detected (batch verification)");
+  }
+
+  for (ShareID id = pendingSharesBits.first(); pendingSharesBits.isEnd(id) == false; id = pendingSharesBits.next(id)) {
+    // We have to stop if we reach required threshold number of signers
+    if (validSharesBits.count() == reqSigners) break;
+    if (invalidShares.count(id) > 0) continue;
+
+    size_t idx = static_cast<size_t>(id);
+    validShares[idx] = pendingShares[idx];
+    validSharesBits.add(id);
+  }
+  pendingShares.clear();
+
+  LOG_DEBUG(THRESHSIGN_LOG,
+            "Batch verified " << pendingSharesBits.count() << " pending shares, " << badShares.size() << " invalid");
+}
+
 bool BlsAccumulatorBase::verifyShare(ShareID id, const G1T& sigShare) {
   assertTrue(hasExpectedDigest());
   assertInclusiveRange(1, id, totalSigners);
@@ -32,11 +32,18 @@ BlsBatchVerifier::~BlsBatchVerifier() {}
 void BlsBatchVerifier::addShare(ShareID id, const G1T& sigShare) {
   const G2T& vk = checked_ref_cast<const BlsPublicKey&>(ver.getShareVerificationKey(id)).getPoint();
 
+  // Each share is scaled by a random exponent of its own, along with its VK. Otherwise, the errors of two bad shares
+  // (e.g., sig1 + d and sig2 - d) cancel out in their aggregate, which verifies although neither share does.
+  BNT r;
+  do {
+    r.Random(RANDOM_EXPONENT_BITS);
+  } while (r == BNT::Zero());
+
   // MAYDO: We could start aggregating incrementally after a leaf is appended
   // (powers of two + finish it off in batchVerify()). Make sure aggregate() still works incrementally.
 
   // We just insert in the tree directly as a leaf
-  aggTree.appendLeaf(Share(id, sigShare, vk));
+  aggTree.appendLeaf(Share(id, G1T::Times(sigShare, r), G2T::Times(vk, r)));
 }
 
 void BlsBatchVerifier::aggregateSigsAndVerifKeys() { aggTree.aggregate(); }
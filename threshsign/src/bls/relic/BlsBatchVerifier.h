@@ -245,9 +245,14 @@ class AlmostCompleteBinaryTree {
  * "They found that Simple Binary Search is more efficient than naively testing
  * each signature individually if there are fewer than N/8 invalid signatures
  * in the batch."
+ *
+ * Shares are batched with random small exponents (see addShare()), so that bad shares can't cancel each other out.
  */
 class BlsBatchVerifier {
  protected:
+  // A forged aggregate verifies with probability 2^-RANDOM_EXPONENT_BITS
+  static constexpr int RANDOM_EXPONENT_BITS = 64;
+
   class Share {
    public:
     Share() : isAggregated(false), id(0) {}
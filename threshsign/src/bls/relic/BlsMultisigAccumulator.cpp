@@ -24,8 +24,9 @@ namespace Relic {
 BlsMultisigAccumulator::BlsMultisigAccumulator(const std::vector<BlsPublicKey>& verifKeys,
                                                NumSharesType reqSigners,
                                                NumSharesType totalSigners,
-                                               bool withShareVerification)
-    : BlsAccumulatorBase(verifKeys, reqSigners, totalSigners, withShareVerification) {}
+                                               bool withShareVerification,
+                                               const BlsThresholdVerifier* batchVerifier)
+    : BlsAccumulatorBase(verifKeys, reqSigners, totalSigners, withShareVerification, batchVerifier) {}
 
 void BlsMultisigAccumulator::getFullSignedData(char* outThreshSig, int threshSigLen) {
   aggregateShares();
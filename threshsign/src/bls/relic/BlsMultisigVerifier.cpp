@@ -53,7 +53,7 @@ IThresholdAccumulator *BlsMultisigVerifier::newAccumulator(bool withShareVerific
              "BLS n-out-of-n multisig typically has share verification "
              "disabled in Concord. Are you sure you need this?");
   }
-  return new BlsMultisigAccumulator(publicKeysVector_, reqSigners_, numSigners_, withShareVerification);
+  return new BlsMultisigAccumulator(publicKeysVector_, reqSigners_, numSigners_, withShareVerification, this);
 }
 
 /**
@@ -33,13 +33,20 @@ namespace Relic {
 BlsThresholdAccumulator::BlsThresholdAccumulator(const std::vector<BlsPublicKey>& vks,
                                                  NumSharesType reqSigners,
                                                  NumSharesType totalSigners,
-                                                 bool withShareVerification)
-    : BlsAccumulatorBase(vks, reqSigners, totalSigners, withShareVerification) {
+                                                 bool withShareVerification,
+                                                 std::shared_ptr<LagrangeCoeffsCache> coeffsCache,
+                                                 const BlsThresholdVerifier* batchVerifier)
+    : BlsAccumulatorBase(vks, reqSigners, totalSigners, withShareVerification, batchVerifier),
+      coeffsCache(std::move(coeffsCache)) {
   coeffs.resize(static_cast<size_t>(totalSigners + 1));
   assertEqual(threshSig, G1T::Identity());
 }
 
 void BlsThresholdAccumulator::computeLagrangeCoeff() {
+  if (coeffsCache) {
+    coeffsCache->get(validSharesBits, coeffs);
+    return;
+  }
   lagrangeCoeffAccumReduced(validSharesBits, coeffs, BLS::Relic::Library::Get().getG2Order());
 }
 
@@ -51,7 +58,11 @@ void BlsThresholdAccumulator::exponentiateLagrangeCoeff() {
   //}
 
   int maxBits = Library::Get().getG2OrderNumBits();
-  threshSig = fastMultExp<G1T>(validSharesBits, validShares, coeffs, maxBits);
+  if (validSharesBits.count() >= PIPPENGER_MIN_SHARES) {
+    threshSig = fastMultExpPippenger<G1T>(validSharesBits, validShares, coeffs, maxBits);
+  } else {
+    threshSig = fastMultExp<G1T>(validSharesBits, validShares, coeffs, maxBits);
+  }
 }
 
 } /* namespace Relic */
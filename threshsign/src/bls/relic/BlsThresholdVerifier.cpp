@@ -18,8 +18,10 @@
 #include "threshsign/bls/relic/BlsThresholdAccumulator.h"
 #include "threshsign/bls/relic/BlsPublicKey.h"
 #include "threshsign/bls/relic/BlsPublicParameters.h"
+#include "threshsign/bls/relic/Library.h"
 
 #include "BlsAlmostMultisigAccumulator.h"
+#include "LagrangeInterpolation.h"
 
 #include <algorithm>
 #include <iterator>
@@ -43,7 +45,8 @@ BlsThresholdVerifier::BlsThresholdVerifier(const BlsPublicParameters &params,
       publicKeysVector_(verificationKeys.begin(), verificationKeys.end()),
       generator2_(params.getGenerator2()),
       reqSigners_(reqSigners),
-      numSigners_(numSigners) {
+      numSigners_(numSigners),
+      lagrangeCoeffsCache_(std::make_shared<LagrangeCoeffsCache>(Library::Get().getG2Order())) {
   assertEqual(verificationKeys.size(), static_cast<vector<BlsPublicKey>::size_type>(numSigners + 1));
   // verifKeys[0] was copied as well, but it's set to a dummy PK so it does not matter
   assertEqual(publicKeysVector_.size(), static_cast<vector<BlsPublicKey>::size_type>(numSigners + 1));
@@ -62,7 +65,8 @@ IThresholdAccumulator *BlsThresholdVerifier::newAccumulator(bool withShareVerifi
   if (reqSigners_ == numSigners_ - 1) {
     return new BlsAlmostMultisigAccumulator(publicKeysVector_, numSigners_);
   } else {
-    return new BlsThresholdAccumulator(publicKeysVector_, reqSigners_, numSigners_, withShareVerification);
+    return new BlsThresholdAccumulator(
+        publicKeysVector_, reqSigners_, numSigners_, withShareVerification, lagrangeCoeffsCache_, this);
   }
 }
 
@@ -13,10 +13,16 @@
 #include "threshsign/VectorOfShares.h"
 #include "threshsign/bls/relic/Library.h"
 
+#include <algorithm>
+#include <exception>
+#include <future>
+#include <limits>
+#include <thread>
 #include <vector>
 
 #include "XAssert.h"
 #include "Logger.hpp"
+#include "thread_pool.hpp"
 
 using std::endl;
 
@@ -58,6 +64,139 @@ GT fastMultExp(const VectorOfShares& s,
   return r;
 }
 
+namespace {
+
+// Windows are computed in parallel from this number of shares on. Below it, a window is only a few dozens of additions
+// and handing it to another thread doesn't pay off.
+constexpr int PIPPENGER_PARALLEL_MIN_SHARES = 64;
+
+// Picks the window size c with the fewest additions: each of the maxBits/c windows adds every base to a bucket, and
+// then sums its 2^c - 1 buckets with two additions per bucket.
+int pippengerWindowBits(int count, int maxBits) {
+  int best = 1;
+  long bestCost = std::numeric_limits<long>::max();
+  for (int c = 1; c <= 16; c++) {
+    long cost = static_cast<long>((maxBits + c - 1) / c) * (count + (2L << c));
+    if (cost < bestCost) {
+      bestCost = cost;
+      best = c;
+    }
+  }
+  return best;
+}
+
+unsigned int pippengerNumThreads() {
+  static const unsigned int numThreads = std::max(std::thread::hardware_concurrency(), 1u);
+  return numThreads;
+}
+
+// The calling thread computes windows too, so the pool has one thread less than the machine.
+concord::util::ThreadPool& pippengerThreadPool() {
+  static concord::util::ThreadPool pool{std::max(pippengerNumThreads() - 1, 1u)};
+  return pool;
+}
+
+// When RELIC is built with multithreading support, its context (e.g., the curve parameters) is per thread, so pool
+// threads have to set up their own before doing any group operation. Otherwise, the context is the global one that
+// Library set up, and initializing it again would reset it under the other threads.
+void initRelicInThisThread() {
+#if defined(MULTI) && MULTI != SINGLE
+  thread_local bool initialized = false;
+  if (initialized) return;
+  if (core_init() != STS_OK || pc_param_set_any() != STS_OK) {
+    throw std::runtime_error("Could not initialize RELIC elliptic curve library in a multiexponentiation thread");
+  }
+  initialized = true;
+#endif
+}
+
+// The numBits bits of e from firstBit on
+size_t windowDigit(const BNT& e, int firstBit, int numBits) {
+  size_t digit = 0;
+  for (int b = numBits - 1; b >= 0; b--) {
+    digit = (digit << 1) | (e.getBit(firstBit + b) ? 1u : 0u);
+  }
+  return digit;
+}
+
+// Computes \sum_i digit_i * a[i], where digit_i is the window of e[i], by adding each a[i] to the bucket of its digit
+template <class GT>
+GT pippengerWindow(
+    const std::vector<size_t>& ids, const std::vector<GT>& a, const std::vector<BNT>& e, int firstBit, int numBits) {
+  std::vector<GT> buckets((size_t{1} << numBits) - 1);
+  for (size_t idx : ids) {
+    size_t digit = windowDigit(e[idx], firstBit, numBits);
+    if (digit != 0) buckets[digit - 1].Add(a[idx]);
+  }
+
+  // \sum_d d * buckets[d], as the sum of the running sums of the buckets from the highest digit down
+  GT running, sum;
+  for (auto bucket = buckets.rbegin(); bucket != buckets.rend(); ++bucket) {
+    running.Add(*bucket);
+    sum.Add(running);
+  }
+  return sum;
+}
+
+}  // namespace
+
+template <class GT>
+GT fastMultExpPippenger(const VectorOfShares& s, const std::vector<GT>& a, const std::vector<BNT>& e, int maxBits) {
+  std::vector<size_t> ids;
+  ids.reserve(static_cast<size_t>(s.count()));
+  for (ShareID i = s.first(); s.isEnd(i) == false; i = s.next(i)) {
+    size_t idx = static_cast<size_t>(i);
+    assertLessThanOrEqual(e[idx].getBits(), maxBits);
+    ids.push_back(idx);
+  }
+
+  const int c = pippengerWindowBits(s.count(), maxBits);
+  const int numWindows = (maxBits + c - 1) / c;
+  std::vector<GT> windows(static_cast<size_t>(numWindows));
+  auto computeWindows = [&](int first, int last) {
+    for (int w = first; w < last; w++) {
+      windows[static_cast<size_t>(w)] = pippengerWindow(ids, a, e, w * c, std::min(c, maxBits - w * c));
+    }
+  };
+
+  // Split the windows among threads, the calling one taking the first share
+  int numTasks = 1;
+  if (s.count() >= PIPPENGER_PARALLEL_MIN_SHARES) {
+    numTasks = std::min(numWindows, static_cast<int>(pippengerNumThreads()));
+  }
+  // The tasks refer to this frame, so all of them are waited for before it unwinds, even on an error
+  std::vector<std::future<void>> tasks;
+  std::exception_ptr error;
+  try {
+    for (int t = 1; t < numTasks; t++) {
+      tasks.push_back(pippengerThreadPool().async([&computeWindows, t, numTasks, numWindows]() {
+        initRelicInThisThread();
+        computeWindows(t * numWindows / numTasks, (t + 1) * numWindows / numTasks);
+      }));
+    }
+    computeWindows(0, numWindows / numTasks);
+  } catch (...) {
+    error = std::current_exception();
+  }
+  for (auto& task : tasks) {
+    try {
+      task.get();
+    } catch (...) {
+      if (!error) error = std::current_exception();
+    }
+  }
+  if (error) std::rethrow_exception(error);
+
+  // r = \sum_w windows[w] * 2^{c * w}
+  GT r;
+  for (int w = numWindows - 1; w >= 0; w--) {
+    for (int j = 0; j < c; j++) r.Double();
+    r.Add(windows[static_cast<size_t>(w)]);
+  }
+
+  return r;
+}
+
 template <class GT>
 GT fastMultExpTwo(const VectorOfShares& s, const std::vector<GT>& a, const std::vector<BNT>& e) {
   GT r;
@@ -104,6 +243,15 @@ template G2T fastMultExp<G2T>(const VectorOfShares& s,
                               const std::vector<BNT>& e,
                               int maxBits);
 
+template G1T fastMultExpPippenger<G1T>(const VectorOfShares& s,
+                                       const std::vector<G1T>& a,
+                                       const std::vector<BNT>& e,
+                                       int maxBits);
+template G2T fastMultExpPippenger<G2T>(const VectorOfShares& s,
+                                       const std::vector<G2T>& a,
+                                       const std::vector<BNT>& e,
+                                       int maxBits);
+
 template G1T fastMultExpTwo<G1T>(const VectorOfShares& s, const std::vector<G1T>& a, const std::vector<BNT>& e);
 template G2T fastMultExpTwo<G2T>(const VectorOfShares& s, const std::vector<G2T>& a, const std::vector<BNT>& e);
 
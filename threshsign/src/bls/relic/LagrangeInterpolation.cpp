@@ -22,6 +22,7 @@
 #include "Timer.h"
 
 #include <algorithm>
+#include <optional>
 
 using std::endl;
 
@@ -195,6 +196,44 @@ void LagrangeIncrementalCoeffs::finalize(std::vector<BNT>& coeffsOut) {
   }
 }
 
+LagrangeCoeffsCache::LagrangeCoeffsCache(const BNT& fieldOrder, size_t capacity)
+    : fieldOrder_(fieldOrder), cache_(capacity) {}
+
+void LagrangeCoeffsCache::get(const VectorOfShares& signers, std::vector<BNT>& coeffs) {
+  std::string key(static_cast<size_t>(VectorOfShares::getByteCount()), '\0');
+  signers.toBytes(reinterpret_cast<unsigned char*>(key.data()), VectorOfShares::getByteCount());
+
+  std::optional<std::vector<BNT>> cached;
+  {
+    std::lock_guard<std::mutex> lock(lock_);
+    cached = cache_.get(key);
+  }
+
+  if (cached) {
+    auto coeff = cached->begin();
+    for (ShareID i = signers.first(); signers.isEnd(i) == false; i = signers.next(i)) {
+      coeffs[static_cast<size_t>(i)] = *coeff++;
+    }
+    return;
+  }
+
+  // Computed outside of the lock, as it takes much longer than a lookup
+  lagrangeCoeffAccumReduced(signers, coeffs, fieldOrder_);
+
+  std::vector<BNT> computed;
+  computed.reserve(static_cast<size_t>(signers.count()));
+  for (ShareID i = signers.first(); signers.isEnd(i) == false; i = signers.next(i)) {
+    computed.push_back(coeffs[static_cast<size_t>(i)]);
+  }
+  std::lock_guard<std::mutex> lock(lock_);
+  cache_.put(std::move(key), std::move(computed));
+}
+
+concord::util::LruCache<std::string, std::vector<BNT>>::Stats LagrangeCoeffsCache::getStats() {
+  std::lock_guard<std::mutex> lock(lock_);
+  return cache_.getStats();
+}
+
 /**
  * Functions to compute all n Lagrange coefficients in one go.
  */
@@ -12,7 +12,9 @@
 
 #pragma once
 
+#include <mutex>
 #include <set>
+#include <string>
 #include <vector>
 
 #include "threshsign/bls/relic/BlsNumTypes.h"
@@ -20,6 +22,8 @@
 #include "threshsign/ThresholdSignaturesTypes.h"
 #include "threshsign/VectorOfShares.h"
 
+#include "lru_cache.hpp"
+
 /**
  * These methods take the set of signers and compute the vector of Lagrange
  * coefficients (i.e., l_i^S(0) for each signer i).
@@ -165,5 +169,36 @@ void lagrangeCoeffNaiveReduced(const VectorOfShares& signers, std::vector<BNT>&
  */
 void lagrangeCoeffAccumReduced(const VectorOfShares& signers, std::vector<BNT>& lagrangeCoeffs, const BNT& fieldOrder);
 
+/**
+ * A bounded cache of the Lagrange coefficients of the recent sets of signers.
+ *
+ * Once replicas are up, the same few sets of signers (e.g., the fastest 2f+1 replicas) combine signatures over and
+ * over, so their coefficients are computed once rather than on every combine. Shared by the accumulators of a verifier.
+ */
+class LagrangeCoeffsCache {
+ public:
+  static constexpr size_t DEFAULT_CAPACITY = 64;
+
+  LagrangeCoeffsCache(const BNT& fieldOrder, size_t capacity = DEFAULT_CAPACITY);
+
+  /**
+   * Sets coeffs[i] to the Lagrange coefficient of signer i, for all i in signers, as lagrangeCoeffAccumReduced() does.
+   *
+   * NOTE: Thread-safe.
+   */
+  void get(const VectorOfShares& signers, std::vector<BNT>& coeffs);
+
+  /**
+   * The sets of signers found in the cache (hits) and computed (misses) by get() so far.
+   */
+  concord::util::LruCache<std::string, std::vector<BNT>>::Stats getStats();
+
+ private:
+  const BNT fieldOrder_;
+  std::mutex lock_;
+  // The serialized signers, to their coefficients in the order of the signers
+  concord::util::LruCache<std::string, std::vector<BNT>> cache_;
+};
+
 }  // namespace Relic
 }  // namespace BLS
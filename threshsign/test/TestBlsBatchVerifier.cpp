@@ -148,6 +148,120 @@ void batchVerifyHelper(BlsBatchVerifier& ver,
 #endif
 }
 
+/**
+ * Combines 2f+1 out of n shares, numBadShares of which are bad, as a replica does once the combined signature failed
+ * to verify: the accumulators of the verifier check the shares in batches. Checks they pinpoint the bad shares, and
+ * compares the recovery time with verifying the shares one by one.
+ */
+void runBadSharesRecoveryTest(int n, int numBadShares) {
+  int k = 2 * ((n - 1) / 3) + 1;
+  testAssertLessThanOrEqual(numBadShares, k);
+
+  BlsPublicParameters params = PublicParametersFactory::getWhatever();
+  BlsThresholdFactory factory(params);
+  std::vector<IThresholdSigner*> signers(static_cast<size_t>(n + 1));
+  IThresholdVerifier* verifierTemp;
+
+  std::tie(signers, verifierTemp) = factory.newRandomSigners(k, n);
+  BlsThresholdVerifier* verifier = dynamic_cast<BlsThresholdVerifier*>(verifierTemp);
+  std::vector<BlsPublicKey> vks = verifier->getPublicKeysVector();
+
+  const char* msg = "some message";
+  int msgLen = static_cast<int>(strlen(msg));
+  const unsigned char* buf = reinterpret_cast<const unsigned char*>(msg);
+
+  VectorOfShares badSubset;
+  VectorOfShares::randomSubset(badSubset, k, numBadShares);
+
+  std::vector<G1T> sigShares(static_cast<size_t>(k + 1));
+  for (ShareID id = 1; id <= k; id++) {
+    BlsThresholdSigner* signer = dynamic_cast<BlsThresholdSigner*>(signers[static_cast<size_t>(id)]);
+    G1T& sig = sigShares[static_cast<size_t>(id)];
+    sig = signer->signData(buf, msgLen);
+    // Change the signature to sig=sig*2, making it invalid...
+    if (badSubset.contains(id)) sig.Double();
+  }
+
+  auto recover = [&](BlsAccumulatorBase& acc, AveragingTimer& t) {
+    for (ShareID id = 1; id <= k; id++) {
+      acc.addNumById(id, sigShares[static_cast<size_t>(id)]);
+    }
+
+    // Shares are verified once the digest is known
+    t.startLap();
+    acc.setExpectedDigest(buf, msgLen);
+    t.endLap();
+
+    std::set<ShareID> invalidShares = acc.getInvalidShareIds();
+    testAssertEqual(invalidShares.size(), static_cast<std::set<ShareID>::size_type>(numBadShares));
+    for (ShareID id : invalidShares) {
+      testAssertTrue(badSubset.contains(id));
+    }
+    testAssertEqual(acc.getNumValidShares(), k - numBadShares);
+  };
+
+  AveragingTimer batched("batched:   ");
+  std::unique_ptr<IThresholdAccumulator> acc(verifier->newAccumulator(true));
+  recover(dynamic_cast<BlsAccumulatorBase&>(*acc), batched);
+
+  AveragingTimer oneByOne("one by one:");
+  BlsThresholdAccumulator accOneByOne(vks, k, n, true);
+  recover(accOneByOne, oneByOne);
+
+  LOG_INFO(THRESHSIGN_LOG,
+           "Found " << numBadShares << " bad shares out of k = " << k << ", n = " << n << ": " << batched
+                    << ", " << oneByOne);
+
+  for (IThresholdSigner* signer : signers) delete signer;
+  delete verifierTemp;
+}
+
+/**
+ * Two bad shares whose errors cancel out: their sum is the sum of the valid shares, so it verifies without random
+ * exponents. Checks both are reported as bad.
+ */
+void runCancellingErrorsTest(int n) {
+  int k = 2 * ((n - 1) / 3) + 1;
+
+  BlsPublicParameters params = PublicParametersFactory::getWhatever();
+  BlsThresholdFactory factory(params);
+  std::vector<IThresholdSigner*> signers(static_cast<size_t>(n + 1));
+  IThresholdVerifier* verifierTemp;
+
+  std::tie(signers, verifierTemp) = factory.newRandomSigners(k, n);
+  BlsThresholdVerifier* verifier = dynamic_cast<BlsThresholdVerifier*>(verifierTemp);
+
+  const char* msg = "some message";
+  int msgLen = static_cast<int>(strlen(msg));
+  const unsigned char* buf = reinterpret_cast<const unsigned char*>(msg);
+
+  // Shares 1 and 2 get +d and -d
+  G1T d, minusD;
+  d.Random();
+  BNT minusOne = params.getGroupOrder();
+  minusOne.Subtract(BNT::One());
+  minusD = G1T::Times(d, minusOne);
+
+  std::unique_ptr<IThresholdAccumulator> acc(verifier->newAccumulator(true));
+  for (ShareID id = 1; id <= k; id++) {
+    BlsThresholdSigner* signer = dynamic_cast<BlsThresholdSigner*>(signers[static_cast<size_t>(id)]);
+    G1T sig = signer->signData(buf, msgLen);
+    if (id == 1) sig.Add(d);
+    if (id == 2) sig.Add(minusD);
+    dynamic_cast<BlsAccumulatorBase&>(*acc).addNumById(id, sig);
+  }
+  acc->setExpectedDigest(buf, msgLen);
+
+  std::set<ShareID> invalidShares = acc->getInvalidShareIds();
+  testAssertEqual(invalidShares.size(), 2u);
+  testAssertTrue(invalidShares.count(1) > 0);
+  testAssertTrue(invalidShares.count(2) > 0);
+  testAssertEqual(dynamic_cast<BlsAccumulatorBase&>(*acc).getNumValidShares(), k - 2);
+
+  for (IThresholdSigner* signer : signers) delete signer;
+  delete verifierTemp;
+}
+
 int RelicAppMain(const Library& lib, const std::vector<std::string>& args) {
   (void)args;
   (void)lib;
@@ -163,5 +277,13 @@ int RelicAppMain(const Library& lib, const std::vector<std::string>& args) {
     }
   }
 
+  for (int n : {7, 31, 100}) {
+    int f = (n - 1) / 3;
+    for (int bad : {0, 1, 2, f}) {
+      runBadSharesRecoveryTest(n, bad);
+    }
+    runCancellingErrorsTest(n);
+  }
+
   return 0;
 }
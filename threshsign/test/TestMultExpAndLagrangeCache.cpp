@@ -0,0 +1,167 @@
+// Concord
+//
+// Copyright (c) 2022 VMware, Inc. All Rights Reserved.
+//
+// This product is licensed to you under the Apache 2.0 license (the "License").
+// You may not use this product except in compliance with the Apache 2.0 License.
+//
+// This product may include a number of subcomponents with separate copyright
+// notices and license terms. Your use of these subcomponents is subject to the
+// terms and conditions of the subcomponent's license, as noted in the
+// LICENSE file.
+
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "threshsign/VectorOfShares.h"
+#include "threshsign/bls/relic/Library.h"
+#include "threshsign/bls/relic/FastMultExp.h"
+
+#include "bls/relic/LagrangeInterpolation.h"
+
+using namespace BLS::Relic;
+
+namespace {
+
+// Random bases and exponents of a random subset of reqSigners out of numSigners, as combined by the accumulators
+template <class GT>
+struct MultExpInput {
+  MultExpInput(int numSigners, int reqSigners)
+      : a(static_cast<size_t>(numSigners) + 1), e(static_cast<size_t>(numSigners) + 1) {
+    VectorOfShares::randomSubset(signers, numSigners, reqSigners);
+    for (ShareID i = signers.first(); signers.isEnd(i) == false; i = signers.next(i)) {
+      a[static_cast<size_t>(i)].Random();
+      e[static_cast<size_t>(i)].RandomMod(Library::Get().getG2Order());
+    }
+  }
+
+  VectorOfShares signers;
+  std::vector<GT> a;
+  std::vector<BNT> e;
+};
+
+template <class GT>
+void checkPippengerMatchesFastMultExp(int numSigners, int reqSigners) {
+  const int maxBits = Library::Get().getG2OrderNumBits();
+  for (int iter = 0; iter < 3; iter++) {
+    MultExpInput<GT> in(numSigners, reqSigners);
+    GT expected = fastMultExp<GT>(in.signers, in.a, in.e, maxBits);
+    GT actual = fastMultExpPippenger<GT>(in.signers, in.a, in.e, maxBits);
+    ASSERT_TRUE(expected == actual) << "n = " << numSigners << ", k = " << reqSigners << ", signers " << in.signers;
+  }
+}
+
+// Below, at and above PIPPENGER_MIN_SHARES, and above the number of shares from which windows are computed in parallel
+const std::vector<std::pair<int, int>> kSizes = {{1, 1}, {4, 3}, {10, 7}, {31, 21}, {50, 32}, {100, 67}, {301, 201}};
+
+TEST(FastMultExpPippenger, matches_fastMultExp_in_G1) {
+  for (const auto& [n, k] : kSizes) checkPippengerMatchesFastMultExp<G1T>(n, k);
+}
+
+TEST(FastMultExpPippenger, matches_fastMultExp_in_G2) {
+  for (const auto& [n, k] : kSizes) checkPippengerMatchesFastMultExp<G2T>(n, k);
+}
+
+TEST(FastMultExpPippenger, zero_exponents) {
+  const int maxBits = Library::Get().getG2OrderNumBits();
+  MultExpInput<G1T> in(64, 64);
+  for (ShareID i = in.signers.first(); in.signers.isEnd(i) == false; i = in.signers.next(i)) {
+    if (i % 2 == 0) in.e[static_cast<size_t>(i)] = BNT::Zero();
+  }
+  ASSERT_TRUE(fastMultExp<G1T>(in.signers, in.a, in.e, maxBits) ==
+              fastMultExpPippenger<G1T>(in.signers, in.a, in.e, maxBits));
+}
+
+void checkCoeffs(const VectorOfShares& signers, const std::vector<BNT>& coeffs) {
+  std::vector<BNT> expected(coeffs.size());
+  lagrangeCoeffAccumReduced(signers, expected, Library::Get().getG2Order());
+  for (ShareID i = signers.first(); signers.isEnd(i) == false; i = signers.next(i)) {
+    ASSERT_TRUE(coeffs[static_cast<size_t>(i)] == expected[static_cast<size_t>(i)]) << "signer " << i;
+  }
+}
+
+TEST(LagrangeCoeffsCache, same_signers_hit_and_other_signers_miss) {
+  constexpr int n = 31;
+  LagrangeCoeffsCache cache(Library::Get().getG2Order());
+  VectorOfShares signers;
+  VectorOfShares::randomSubset(signers, n, 21);
+  std::vector<BNT> coeffs(static_cast<size_t>(n) + 1);
+
+  cache.get(signers, coeffs);
+  checkCoeffs(signers, coeffs);
+  ASSERT_EQ(cache.getStats().hits, 0u);
+  ASSERT_EQ(cache.getStats().misses, 1u);
+
+  // The same set of signers, in an accumulator of its own
+  std::vector<BNT> cachedCoeffs(static_cast<size_t>(n) + 1);
+  VectorOfShares sameSigners;
+  for (ShareID i = signers.first(); signers.isEnd(i) == false; i = signers.next(i)) sameSigners.add(i);
+  cache.get(sameSigners, cachedCoeffs);
+  checkCoeffs(signers, cachedCoeffs);
+  ASSERT_EQ(cache.getStats().hits, 1u);
+  ASSERT_EQ(cache.getStats().misses, 1u);
+
+  // One signer replaced by another
+  VectorOfShares otherSigners = sameSigners;
+  ShareID replaced = otherSigners.first();
+  otherSigners.remove(replaced);
+  for (ShareID i = 1; i <= n; i++) {
+    if (i != replaced && !otherSigners.contains(i)) {
+      otherSigners.add(i);
+      break;
+    }
+  }
+  std::vector<BNT> otherCoeffs(static_cast<size_t>(n) + 1);
+  cache.get(otherSigners, otherCoeffs);
+  checkCoeffs(otherSigners, otherCoeffs);
+  ASSERT_EQ(cache.getStats().hits, 1u);
+  ASSERT_EQ(cache.getStats().misses, 2u);
+
+  // Both sets are cached now
+  cache.get(signers, coeffs);
+  cache.get(otherSigners, otherCoeffs);
+  checkCoeffs(signers, coeffs);
+  checkCoeffs(otherSigners, otherCoeffs);
+  ASSERT_EQ(cache.getStats().hits, 3u);
+  ASSERT_EQ(cache.getStats().misses, 2u);
+}
+
+TEST(LagrangeCoeffsCache, least_recently_used_signers_are_evicted) {
+  constexpr int n = 7;
+  LagrangeCoeffsCache cache(Library::Get().getG2Order(), 2);
+  std::vector<VectorOfShares> sets(3);
+  // {1..5}, {2..6} and {3..7}
+  for (ShareID first = 1; first <= 3; first++) {
+    for (ShareID i = first; i < first + 5; i++) sets[static_cast<size_t>(first - 1)].add(i);
+  }
+  std::vector<BNT> coeffs(static_cast<size_t>(n) + 1);
+
+  for (const auto& signers : sets) cache.get(signers, coeffs);
+  ASSERT_EQ(cache.getStats().misses, 3u);
+
+  // The first set was evicted by the third one
+  cache.get(sets[2], coeffs);
+  cache.get(sets[1], coeffs);
+  ASSERT_EQ(cache.getStats().hits, 2u);
+  cache.get(sets[0], coeffs);
+  checkCoeffs(sets[0], coeffs);
+  ASSERT_EQ(cache.getStats().hits, 2u);
+  ASSERT_EQ(cache.getStats().misses, 4u);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  // NOTE: srand is not and should not be used for any cryptographic randomness, only for picking random signers.
+  unsigned int seed = static_cast<unsigned int>(time(nullptr));
+  std::cout << "Randomness seed passed to srand(): " << seed << std::endl;
+  srand(seed);
+  // Initializes RELIC
+  Library::Get();
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,99 @@
+// Concord
+//
+// Copyright (c) 2022 VMware, Inc. All Rights Reserved.
+//
+// This product is licensed to you under the Apache 2.0 license (the "License").
+// You may not use this product except in compliance with the Apache 2.0
+// License.
+//
+// This product may include a number of subcomponents with separate copyright
+// notices and license terms. Your use of these subcomponents is subject to the
+// terms and conditions of the subcomponent's license, as noted in the
+// LICENSE file.
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+#include "Metrics.hpp"
+
+namespace concord::util {
+
+// The share of the CPUs of the machine that the process used since the previous call, in [0, 1].
+class ProcessCpuUtilization {
+ public:
+  ProcessCpuUtilization();
+  double operator()();
+
+ private:
+  std::chrono::nanoseconds lastCpuTime_;
+  std::chrono::steady_clock::time_point lastWallTime_;
+};
+
+// Tunes the number of threads of a thread pool at runtime, within bounds. Every tick() samples the time that jobs
+// waited in the pool's queue and the CPU utilization of the process, and:
+// - shrinks the pool by a quarter, and at least a thread, if the CPU utilization is over its maximum, as more threads
+//   would only add contention,
+// - or else grows it by a quarter, and at least a thread, if jobs waited longer than the target,
+// - or else shrinks it by a thread if it was idle for IDLE_TICKS_TO_SHRINK ticks in a row: no queued jobs, and jobs
+//   waited under a quarter of the target.
+// The decisions are exported as metrics whose names start with the name of the pool.
+class ConcurrencyController {
+ public:
+  static constexpr size_t IDLE_TICKS_TO_SHRINK = 3;
+
+  enum class Decision { HOLD, GROW, SHRINK };
+
+  // minThreads is raised to 1, and lowered to maxThreads, if needed
+  struct Config {
+    size_t minThreads;
+    size_t maxThreads;
+    std::chrono::microseconds targetQueueWait;
+    // In [0, 1]
+    double maxCpuUtilization;
+  };
+
+  // The controlled pool
+  struct Pool {
+    std::function<size_t()> numOfThreads;
+    std::function<size_t()> numOfJobs;
+    std::function<std::chrono::microseconds()> takeAverageQueueWait;
+    std::function<void(size_t)> resize;
+  };
+
+  // The Pool of a SimpleThreadPool or a ThreadPool
+  template <typename ThreadPoolType>
+  static Pool poolOf(ThreadPoolType& pool) {
+    return Pool{[&pool]() { return pool.getNumOfThreads(); },
+                [&pool]() { return pool.getNumOfJobs(); },
+                [&pool]() { return pool.takeAverageQueueWait(); },
+                [&pool](size_t numOfThreads) { pool.resize(numOfThreads); }};
+  }
+
+  ConcurrencyController(const std::string& name,
+                        const Config& config,
+                        Pool pool,
+                        concordMetrics::Component& metrics,
+                        std::function<double()> cpuUtilization = ProcessCpuUtilization{});
+
+  // Should be called periodically, from one thread at a time
+  Decision tick();
+
+ private:
+  const std::string name_;
+  const Config config_;
+  const Pool pool_;
+  std::function<double()> cpuUtilization_;
+  size_t idleTicks_ = 0;
+
+  concordMetrics::GaugeHandle metric_threads_;
+  concordMetrics::GaugeHandle metric_queue_wait_micros_;
+  concordMetrics::GaugeHandle metric_cpu_utilization_percent_;
+  concordMetrics::CounterHandle metric_grown_;
+  concordMetrics::CounterHandle metric_shrunk_;
+};
+
+}  // namespace concord::util
@@ -112,6 +112,8 @@ class DigestUtil {
  public:
   static size_t digestLength();
   static bool compute(const char* input, size_t inputLength, char* outBufferForDigest, size_t lengthOfBufferForDigest);
+  // outDigests[i] = digest of inputs[i], for all i < count. Several inputs may be hashed at once, see Sha256.hpp.
+  static void computeBatch(const char* const* inputs, const size_t* inputLengths, size_t count, Digest* outDigests);
 
   class Context {
    public:
@@ -0,0 +1,66 @@
+// Concord
+//
+// Copyright (c) 2022 VMware, Inc. All Rights Reserved.
+//
+// This product is licensed to you under the Apache 2.0 license (the "License").  You may not use this product except in
+// compliance with the Apache 2.0 License.
+//
+// This product may include a number of subcomponents with separate copyright notices and license terms. Your use of
+// these subcomponents is subject to the terms and conditions of the subcomponent's license, as noted in the LICENSE
+// file.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace concord::util::digest {
+
+// SHA-256, with the implementation chosen at runtime by the features of the CPU:
+// - Inputs are hashed with the SHA extensions (SHA-NI) when available.
+// - Otherwise, many independent inputs (e.g., the requests of a batch) are hashed 8 at a time, one in each 32-bit lane
+//   of the AVX2 registers, which is several times faster than hashing them one by one.
+// All implementations give the same output as the portable one, which is used when neither is available.
+class Sha256 {
+ public:
+  static constexpr size_t DIGEST_LENGTH = 32;
+  static constexpr size_t BLOCK_LENGTH = 64;
+  // Inputs hashed at a time by the AVX2 implementation
+  static constexpr size_t LANES = 8;
+
+  enum class Implementation : uint8_t { Portable, ShaNi, Avx2 };
+
+  // The fastest implementations on this CPU, for single inputs and for many inputs
+  static Implementation singleBuffer();
+  static Implementation multiBuffer();
+  static bool isSupported(Implementation impl);
+
+  static void compute(const uint8_t* input, size_t length, uint8_t* digest) {
+    compute(singleBuffer(), input, length, digest);
+  }
+  // digests[i] = SHA-256(inputs[i]), for all i < count
+  static void computeMany(const uint8_t* const* inputs, const size_t* lengths, size_t count, uint8_t* const* digests) {
+    computeMany(multiBuffer(), inputs, lengths, count, digests);
+  }
+
+  // With a given implementation, that must be supported by this CPU (for tests and benchmarks). Multi-buffer
+  // computation with a single-buffer implementation hashes the inputs one by one.
+  static void compute(Implementation impl, const uint8_t* input, size_t length, uint8_t* digest);
+  static void computeMany(
+      Implementation impl, const uint8_t* const* inputs, const size_t* lengths, size_t count, uint8_t* const* digests);
+
+  // Incremental hashing, with the single-buffer implementation
+  Sha256();
+  void update(const uint8_t* data, size_t length);
+  // Writes the digest of the data so far. The object must not be used afterwards.
+  void writeDigest(uint8_t* digest);
+
+ private:
+  std::array<uint32_t, 8> state_;
+  std::array<uint8_t, BLOCK_LENGTH> buffer_;
+  size_t buffered_ = 0;
+  uint64_t length_ = 0;
+};
+
+}  // namespace concord::util::digest
@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <queue>
 #include <vector>
 #include <thread>
@@ -49,12 +50,17 @@ class SimpleThreadPool {
    * @param j - subclass of Job for execution
    */
   void add(Job* j);
+  /**
+   * grows or shrinks a started pool to the desired number of threads. Threads beyond it retire once they finish their
+   * current job. Should not be called concurrently with start() or stop()
+   */
+  void resize(size_t num_of_threads);
   /**
    * get the number of currently allocated threads in pool
    */
   size_t getNumOfThreads() {
     guard g(queue_lock_);
-    return threads_.size();
+    return threads_.size() - num_of_retiring_threads_ - retired_threads_.size();
   }
   /**
    * get the number of jobs in queue
@@ -63,13 +69,25 @@ class SimpleThreadPool {
     guard g(queue_lock_);
     return job_queue_.size();
   }
+  /**
+   * get the average time that the jobs taken for execution since the previous call waited in queue, or that the oldest
+   * job in queue has waited, whichever is longer
+   */
+  std::chrono::microseconds takeAverageQueueWait();
 
  protected:
+  struct QueuedJob {
+    Job* job;
+    std::chrono::steady_clock::time_point enqueued;
+  };
+
+  void startThread();
+  void joinRetiredThreads();
   bool load(Job*& outJob);
   void execute(Job*);
 
  protected:
-  std::queue<SimpleThreadPool::Job*> job_queue_;
+  std::queue<QueuedJob> job_queue_;
   std::mutex queue_lock_;
   std::condition_variable queue_cond_;
   bool stopped_;
@@ -77,6 +95,11 @@ class SimpleThreadPool {
   std::mutex threads_startup_lock_;
   std::condition_variable threads_startup_cond_;
   std::vector<std::thread> threads_;
+  // Threads that should exit instead of taking another job, and the ones that did and are waiting to be joined
+  size_t num_of_retiring_threads_ = 0;
+  std::vector<std::thread::id> retired_threads_;
+  std::chrono::microseconds queue_wait_{0};
+  size_t num_of_dequeued_jobs_ = 0;
 };
 
 }  // namespace concord::util
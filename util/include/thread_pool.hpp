@@ -18,6 +18,8 @@
 
 #include <assertUtils.hpp>
 
+#include <algorithm>
+#include <chrono>
 #include <condition_variable>
 #include <future>
 #include <mutex>
@@ -56,6 +58,65 @@ class ThreadPool {
     }
   }
 
+ public:
+  // Grows or shrinks the pool to thread_count > 0 threads. Threads beyond it retire once they finish their current
+  // task. Not thread safe with respect to other resize() calls.
+  void resize(unsigned int thread_count) {
+    ConcordAssert(thread_count > 0);
+    auto retired = std::vector<std::thread>{};
+    {
+      auto lock = std::lock_guard{task_queue_.mutex};
+      for (const auto& id : task_queue_.retired) {
+        auto it = std::find_if(threads_.begin(), threads_.end(), [&id](const auto& t) { return t.get_id() == id; });
+        retired.push_back(std::move(*it));
+        threads_.erase(it);
+      }
+      task_queue_.retired.clear();
+      const auto current = threads_.size() - task_queue_.retiring;
+      if (thread_count > current) {
+        // Threads that didn't retire yet keep working instead of new ones starting
+        const auto kept = std::min<size_t>(thread_count - current, task_queue_.retiring);
+        task_queue_.retiring -= kept;
+        for (auto i = current + kept; i < thread_count; ++i) {
+          threads_.emplace_back([this]() { loop(); });
+        }
+      } else {
+        task_queue_.retiring += current - thread_count;
+      }
+    }
+    task_queue_.cv.notify_all();
+    for (auto& t : retired) {
+      t.join();
+    }
+  }
+
+  // The number of threads, not counting the ones that retire.
+  size_t getNumOfThreads() {
+    auto lock = std::lock_guard{task_queue_.mutex};
+    return threads_.size() - task_queue_.retiring - task_queue_.retired.size();
+  }
+
+  // The number of tasks that wait for a thread.
+  size_t getNumOfJobs() {
+    auto lock = std::lock_guard{task_queue_.mutex};
+    return task_queue_.tasks.size();
+  }
+
+  // The average time that the tasks taken since the previous call waited in queue, or that the oldest task that still
+  // waits did, whichever is longer.
+  std::chrono::microseconds takeAverageQueueWait() {
+    using namespace std::chrono;
+    auto lock = std::lock_guard{task_queue_.mutex};
+    auto average =
+        microseconds{task_queue_.dequeued ? task_queue_.wait.count() / static_cast<int64_t>(task_queue_.dequeued) : 0};
+    if (!task_queue_.tasks.empty()) {
+      average = std::max(average, duration_cast<microseconds>(steady_clock::now() - task_queue_.tasks.front().second));
+    }
+    task_queue_.wait = microseconds{0};
+    task_queue_.dequeued = 0;
+    return average;
+  }
+
  public:
   // Executes the passed function (or any callable) in a pool thread. Returns a future to the result.
   // Arguments are always copied or moved. Reference arguments are not supported on purpose. Main reason is safety.
@@ -74,7 +135,7 @@ class ThreadPool {
     }};
     {
       auto lock = std::lock_guard{task_queue_.mutex};
-      task_queue_.tasks.push(std::move(task));
+      task_queue_.tasks.emplace(std::move(task), std::chrono::steady_clock::now());
     }
     task_queue_.cv.notify_one();
     return future;
@@ -86,12 +147,20 @@ class ThreadPool {
   void loop() noexcept {
     while (true) {
       auto lock = std::unique_lock{task_queue_.mutex};
-      while (task_queue_.tasks.empty() && !task_queue_.stop) {
+      while (task_queue_.tasks.empty() && !task_queue_.stop && !task_queue_.retiring) {
         task_queue_.cv.wait(lock);
       }
       if (task_queue_.stop) break;
+      if (task_queue_.retiring) {
+        --task_queue_.retiring;
+        task_queue_.retired.push_back(std::this_thread::get_id());
+        break;
+      }
       ConcordAssert(!task_queue_.tasks.empty());
-      auto task = std::move(task_queue_.tasks.front());
+      auto task = std::move(task_queue_.tasks.front().first);
+      task_queue_.wait += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() -
+                                                                               task_queue_.tasks.front().second);
+      ++task_queue_.dequeued;
       task_queue_.tasks.pop();
       lock.unlock();
       try {
@@ -104,8 +173,8 @@ class ThreadPool {
 
  private:
   struct TaskQueue {
-    // A queue of tasks for execution.
-    std::queue<GenericTask> tasks;
+    // A queue of tasks for execution, with the time each was queued at.
+    std::queue<std::pair<GenericTask, std::chrono::steady_clock::time_point>> tasks;
 
     // A mutex for the queue.
     std::mutex mutex;
@@ -115,6 +184,14 @@ class ThreadPool {
 
     // A task queue stop flag.
     bool stop{false};
+
+    // The number of threads that should exit instead of taking another task, and the ones that did.
+    size_t retiring{0};
+    std::vector<std::thread::id> retired;
+
+    // The total time that the tasks taken since the last takeAverageQueueWait() waited in queue, and their number.
+    std::chrono::microseconds wait{0};
+    size_t dequeued{0};
   };
 
   // A task queue that is shared between pool threads.
@@ -0,0 +1,134 @@
+// Concord
+//
+// Copyright (c) 2022 VMware, Inc. All Rights Reserved.
+//
+// This product is licensed to you under the Apache 2.0 license (the "License").
+// You may not use this product except in compliance with the Apache 2.0 License.
+//
+// This product may include a number of subcomponents with separate copyright
+// notices and license terms. Your use of these subcomponents is subject to the
+// terms and conditions of the subcomponent's license, as noted in the LICENSE
+// file.
+
+#pragma once
+
+#include "assertUtils.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace concord::util {
+
+// A hashed timer wheel for a large number of one-shot timers.
+//
+// Time is divided into ticks and every timer is placed in the slot of the tick it expires at (modulo the number of
+// slots). Adding and cancelling a timer is O(1). Advancing the wheel only visits the slots of the ticks that passed.
+// Timers never fire early, but can fire up to one tick late.
+//
+// All methods are thread safe. Callbacks are called from the thread that calls advance() without holding the internal
+// lock, so they can add or cancel timers.
+class TimerWheel {
+ public:
+  using Clock = std::chrono::steady_clock;
+  using Handle = std::uint64_t;
+  using Callback = std::function<void()>;
+
+  TimerWheel(std::chrono::milliseconds tick, std::size_t slots, Clock::time_point now = Clock::now())
+      : tick_{tick}, start_{now}, slots_(slots) {
+    ConcordAssertGT(tick_.count(), 0);
+    ConcordAssertGT(slots, 0);
+  }
+
+  TimerWheel(const TimerWheel&) = delete;
+  TimerWheel& operator=(const TimerWheel&) = delete;
+
+  // Add a timer that fires after `timeout`. Returns a handle that can be used to cancel it.
+  Handle add(std::chrono::milliseconds timeout, Callback cb, Clock::time_point now = Clock::now()) {
+    auto lock = std::lock_guard{mutex_};
+    const auto ticks = (timeout.count() + tick_.count() - 1) / tick_.count();
+    const auto expiry = std::max(tickAt(now) + static_cast<std::uint64_t>(ticks), last_tick_ + 1);
+    const auto handle = ++last_handle_;
+    timers_.emplace(handle, Timer{expiry, std::move(cb)});
+    slots_[expiry % slots_.size()].push_back(handle);
+    return handle;
+  }
+
+  // Cancel a timer. Returns true if the timer was pending.
+  bool cancel(Handle handle) {
+    auto lock = std::lock_guard{mutex_};
+    // The handle is removed from its slot lazily, when the slot is visited.
+    return timers_.erase(handle) > 0;
+  }
+
+  // Fire all timers that expired until `now`. Returns the number of fired timers.
+  std::size_t advance(Clock::time_point now = Clock::now()) {
+    auto expired = std::vector<Callback>{};
+    {
+      auto lock = std::lock_guard{mutex_};
+      const auto current = tickAt(now);
+      if (current <= last_tick_) {
+        return 0;
+      }
+      // Visiting every slot once is enough, no matter how many ticks passed.
+      const auto to_visit = std::min<std::uint64_t>(current - last_tick_, slots_.size());
+      for (auto tick = current - to_visit + 1; tick <= current; ++tick) {
+        auto& slot = slots_[tick % slots_.size()];
+        auto remaining = std::vector<Handle>{};
+        for (auto handle : slot) {
+          auto it = timers_.find(handle);
+          if (it == timers_.end()) {
+            continue;
+          }
+          if (it->second.expiry <= current) {
+            expired.push_back(std::move(it->second.cb));
+            timers_.erase(it);
+          } else {
+            remaining.push_back(handle);
+          }
+        }
+        slot.swap(remaining);
+      }
+      last_tick_ = current;
+    }
+    for (auto& cb : expired) {
+      cb();
+    }
+    return expired.size();
+  }
+
+  // The number of pending timers.
+  std::size_t size() const {
+    auto lock = std::lock_guard{mutex_};
+    return timers_.size();
+  }
+
+  std::chrono::milliseconds tick() const { return tick_; }
+
+ private:
+  struct Timer {
+    std::uint64_t expiry;
+    Callback cb;
+  };
+
+  std::uint64_t tickAt(Clock::time_point t) const {
+    if (t <= start_) return 0;
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(t - start_) / tick_);
+  }
+
+ private:
+  const std::chrono::milliseconds tick_;
+  const Clock::time_point start_;
+  std::vector<std::vector<Handle>> slots_;
+  std::unordered_map<Handle, Timer> timers_;
+  std::uint64_t last_tick_{0};
+  Handle last_handle_{0};
+  mutable std::mutex mutex_;
+};
+
+}  // namespace concord::util
@@ -91,6 +91,12 @@ class BftClient(ABC):
         self.rsi_replies = dict()
         self.comm_prepared = False
         self.ro_replicas = ro_replicas
+        # Retransmissions are held back until this time.monotonic() value, after a busy reply from an overloaded replica
+        self.busy_until = 0
+        self.busy_replies = 0
+        # Send write requests to all the replicas even when the primary is known, for replicas that reference the
+        # requests in their PrePrepares instead of sending them (prePrepareDigestsOnlyEnabled)
+        self.send_writes_to_all = False
 
         txn_signing_key_path = self._get_txn_signing_priv_key_path(self.client_id)
         self.signing_key = None
@@ -162,8 +168,8 @@ class BftClient(ABC):
         Retry Strategy:
             If the request is a write and the primary is known then send only to
             the primary on the first attempt. Otherwise, if the request is read
-            only or the primary is unknown, then send to all replicas on the
-            first attempt.
+            only, the primary is unknown or `send_writes_to_all` is set, then
+            send to all replicas on the first attempt.
 
             After `config.retry_timeout_milli` without receiving a quorum of
             identical replies, then clear the replies and send to all replicas.
@@ -288,11 +294,16 @@ class BftClient(ABC):
         while self.replies is None:
             with trio.move_on_after(timeout):
                 async with trio.open_nursery() as nursery:
-                    if read_only or self.primary is None:
+                    if read_only or self.primary is None or self.send_writes_to_all:
                         await self._send_to_replicas(data, dest_replicas)
                     else:
                         await self._send_to_primary(data)
                     nursery.start_soon(self._recv_data, m_of_n_quorum.required, dest_replicas, nursery.cancel_scope)
+            if self.replies is None and self.busy_until > time.monotonic():
+                # Keep receiving replies, without retransmitting, while the replicas are busy
+                with trio.move_on_after(self.busy_until - time.monotonic()):
+                    async with trio.open_nursery() as nursery:
+                        nursery.start_soon(self._recv_data, m_of_n_quorum.required, dest_replicas, nursery.cancel_scope)
             if self.replies is None:
                 if no_retries:
                     break
@@ -329,6 +340,9 @@ class BftClient(ABC):
 
     def _process_received_msg(self, data, sender, replicas_addr, required_replies, cancel_scope):
         """Called by child class to process a received message. At this point it's unknown if message is valid"""
+        if bft_msgs.unpack_msg_type(data) == bft_msgs.REPLY_BUSY_MSG_TYPE:
+            self._process_busy_reply(data)
+            return
         rsi_msg = RSI.MsgWithReplicaSpecificInfo(data, sender)
         header, reply = rsi_msg.get_common_reply()
         if self._valid_reply(header, rsi_msg.get_sender_id(), replicas_addr):
@@ -343,6 +357,18 @@ class BftClient(ABC):
                         self.primary = self.replicas[rsi_reply.get_primary()]
                 cancel_scope.cancel()
 
+    def _process_busy_reply(self, data):
+        """
+        Hold back retransmissions for the retry time of a busy reply, plus a random jitter of up to half of it.
+        The signature of the replica is not verified by this test client.
+        """
+        header, retry_after_milli = bft_msgs.unpack_busy_reply(data)
+        if not self.replies_manager.expects_seq_num(header.req_seq_num):
+            return
+        self.busy_replies += 1
+        retry_after = retry_after_milli * random.uniform(1, 1.5) / 1000
+        self.busy_until = max(self.busy_until, time.monotonic() + retry_after)
+
     def _get_txn_signing_priv_key_path(self, client_id):
         """
         This method finds the correct participant mapped to the given client_id.
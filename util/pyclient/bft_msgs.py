@@ -23,6 +23,8 @@ PRE_PROCESS_TYPE = 500
 REQUEST_MSG_TYPE = 700
 BATCH_REQUEST_MSG_TYPE = 750
 REPLY_MSG_TYPE = 800
+# An overloaded replica turned the request away. See REPLY_BUSY_MSG_TYPE in ClientMsgs.hpp
+REPLY_BUSY_MSG_TYPE = 802
 RECONFIG_FLAG = 0x20
 
 # A Request type precedes all headers. It can be viewed as part of the headers
@@ -162,6 +164,19 @@ def unpack_reply(data):
     start = MSG_TYPE_SIZE + REPLY_HEADER_SIZE
     return (unpack_reply_header(data), data[start:])
 
+def unpack_busy_reply(data):
+    """
+    Take a buffer and return a pair of the ReplyHeader and the time, in milliseconds, after which the client may retry.
+    Throws MsgError if type is not a busy reply or struct.error if structure can't be unpacked.
+    """
+    if unpack_msg_type(data) != REPLY_BUSY_MSG_TYPE:
+        raise MsgError("Expected a busy reply message")
+    end = REPLY_HEADER_SIZE + MSG_TYPE_SIZE
+    header = ReplyHeader._make(struct.unpack(REPLY_HEADER_FMT, data[MSG_TYPE_SIZE:end]))
+    start = end + header.span_context_size
+    retry_after_milli = struct.unpack("<L", data[start:start + 4])[0]
+    return (header, retry_after_milli)
+
 def unpack_reply_header(data):
     """
     Take a buffer and return a reply header.
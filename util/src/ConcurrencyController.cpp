@@ -0,0 +1,108 @@
+// Concord
+//
+// Copyright (c) 2022 VMware, Inc. All Rights Reserved.
+//
+// This product is licensed to you under the Apache 2.0 license (the "License").
+// You may not use this product except in compliance with the Apache 2.0
+// License.
+//
+// This product may include a number of subcomponents with separate copyright
+// notices and license terms. Your use of these subcomponents is subject to the
+// terms and conditions of the subcomponent's license, as noted in the
+// LICENSE file.
+
+#include "ConcurrencyController.hpp"
+#include "Logger.hpp"
+#include "kvstream.h"
+
+#include <time.h>
+#include <algorithm>
+#include <thread>
+
+namespace concord::util {
+
+using namespace std::chrono;
+
+namespace {
+nanoseconds processCpuTime() {
+  timespec ts{};
+  clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+  return seconds{ts.tv_sec} + nanoseconds{ts.tv_nsec};
+}
+}  // namespace
+
+ProcessCpuUtilization::ProcessCpuUtilization() : lastCpuTime_{processCpuTime()}, lastWallTime_{steady_clock::now()} {}
+
+double ProcessCpuUtilization::operator()() {
+  const auto cpuTime = processCpuTime();
+  const auto wallTime = steady_clock::now();
+  const auto numOfCpus = std::max(std::thread::hardware_concurrency(), 1u);
+  const auto available = duration_cast<nanoseconds>(wallTime - lastWallTime_) * numOfCpus;
+  const auto used = cpuTime - lastCpuTime_;
+  lastCpuTime_ = cpuTime;
+  lastWallTime_ = wallTime;
+  if (available.count() <= 0) return 0;
+  return std::clamp(static_cast<double>(used.count()) / static_cast<double>(available.count()), 0.0, 1.0);
+}
+
+ConcurrencyController::ConcurrencyController(const std::string& name,
+                                             const Config& config,
+                                             Pool pool,
+                                             concordMetrics::Component& metrics,
+                                             std::function<double()> cpuUtilization)
+    : name_{name},
+      // At least a thread, and minThreads <= maxThreads
+      config_{std::clamp<size_t>(config.minThreads, 1, std::max<size_t>(config.maxThreads, 1)),
+              std::max<size_t>(config.maxThreads, 1),
+              config.targetQueueWait,
+              config.maxCpuUtilization},
+      pool_{std::move(pool)},
+      cpuUtilization_{std::move(cpuUtilization)},
+      metric_threads_{metrics.RegisterGauge(name + "Threads", 0)},
+      metric_queue_wait_micros_{metrics.RegisterGauge(name + "QueueWaitMicros", 0)},
+      metric_cpu_utilization_percent_{metrics.RegisterGauge(name + "CpuUtilizationPercent", 0)},
+      metric_grown_{metrics.RegisterCounter(name + "ThreadsGrown")},
+      metric_shrunk_{metrics.RegisterCounter(name + "ThreadsShrunk")} {}
+
+ConcurrencyController::Decision ConcurrencyController::tick() {
+  const auto threads = pool_.numOfThreads();
+  // Not started, or stopped
+  if (threads == 0) return Decision::HOLD;
+  const auto queueWait = pool_.takeAverageQueueWait();
+  const auto jobs = pool_.numOfJobs();
+  const auto cpuUtilization = cpuUtilization_();
+  metric_queue_wait_micros_.Get().Set(static_cast<uint64_t>(queueWait.count()));
+  metric_cpu_utilization_percent_.Get().Set(static_cast<uint64_t>(cpuUtilization * 100));
+
+  const bool idle = jobs == 0 && queueWait < config_.targetQueueWait / 4;
+  idleTicks_ = idle ? idleTicks_ + 1 : 0;
+
+  const auto step = std::max<size_t>(threads / 4, 1);
+  auto target = threads;
+  if (cpuUtilization > config_.maxCpuUtilization) {
+    target = threads - std::min(step, threads);
+  } else if (queueWait > config_.targetQueueWait) {
+    target = threads + step;
+  } else if (idleTicks_ >= IDLE_TICKS_TO_SHRINK) {
+    target = threads - 1;
+    idleTicks_ = 0;
+  }
+  // Also brings a pool that started out of bounds into them
+  target = std::clamp(target, config_.minThreads, config_.maxThreads);
+
+  auto decision = Decision::HOLD;
+  if (target != threads) {
+    pool_.resize(target);
+    decision = target > threads ? Decision::GROW : Decision::SHRINK;
+    if (decision == Decision::GROW) {
+      metric_grown_++;
+    } else {
+      metric_shrunk_++;
+    }
+    LOG_DEBUG(GL, "Resized " << name_ << KVLOG(threads, target, queueWait.count(), jobs, cpuUtilization));
+  }
+  metric_threads_.Get().Set(target);
+  return decision;
+}
+
+}  // namespace concord::util
@@ -10,11 +10,13 @@
 // file.
 
 #include "Digest.hpp"
+#include "Sha256.hpp"
 #include "hex_tools.h"
 
 #include <string.h>
 #include <stdio.h>
 #include <iomanip>
+#include <vector>
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wpedantic"
 #include <cryptopp/dll.h>
@@ -33,19 +35,29 @@ using namespace std;
 #include <cryptopp/md5.h>
 #define DigestType Weak1::MD5
 #elif defined SHA256_DIGEST
-#define DigestType SHA256
+// Picks SHA-NI or AVX2 at runtime, see Sha256.hpp
+#define DigestType concord::util::digest::Sha256
 #elif defined SHA512_DIGEST
 #define DigestType SHA512
 #endif
 
 namespace concord::util::digest {
 
+#if defined SHA256_DIGEST
+size_t DigestUtil::digestLength() { return Sha256::DIGEST_LENGTH; }
+#else
 size_t DigestUtil::digestLength() { return DigestType::DIGESTSIZE; }
+#endif
 
 bool DigestUtil::compute(const char* input,
                          size_t inputLength,
                          char* outBufferForDigest,
                          size_t lengthOfBufferForDigest) {
+#if defined SHA256_DIGEST
+  if (lengthOfBufferForDigest < Sha256::DIGEST_LENGTH) return false;
+  Sha256::compute(reinterpret_cast<const uint8_t*>(input), inputLength, reinterpret_cast<uint8_t*>(outBufferForDigest));
+  return true;
+#else
   DigestType dig;
 
   size_t size = dig.DigestSize();
@@ -60,6 +72,23 @@ bool DigestUtil::compute(const char* input,
   memcpy(outBufferForDigest, h, size);
 
   return true;
+#endif
+}
+
+void DigestUtil::computeBatch(const char* const* inputs,
+                              const size_t* inputLengths,
+                              size_t count,
+                              Digest* outDigests) {
+#if defined SHA256_DIGEST
+  static_assert(sizeof(Digest) == Sha256::DIGEST_LENGTH);
+  std::vector<uint8_t*> digests(count);
+  for (size_t i = 0; i < count; ++i) digests[i] = reinterpret_cast<uint8_t*>(outDigests[i].getForUpdate());
+  Sha256::computeMany(reinterpret_cast<const uint8_t* const*>(inputs), inputLengths, count, digests.data());
+#else
+  for (size_t i = 0; i < count; ++i) {
+    compute(inputs[i], inputLengths[i], outDigests[i].getForUpdate(), sizeof(Digest));
+  }
+#endif
 }
 
 DigestUtil::Context::Context() {
@@ -70,16 +99,24 @@ DigestUtil::Context::Context() {
 void DigestUtil::Context::update(const char* data, size_t len) {
   ConcordAssert(internalState != NULL);
   DigestType* p = (DigestType*)internalState;
+#if defined SHA256_DIGEST
+  p->update(reinterpret_cast<const uint8_t*>(data), len);
+#else
   p->Update((CryptoPP::byte*)data, len);
+#endif
 }
 
 void DigestUtil::Context::writeDigest(char* outDigest) {
   ConcordAssert(internalState != NULL);
   DigestType* p = (DigestType*)internalState;
+#if defined SHA256_DIGEST
+  p->writeDigest(reinterpret_cast<uint8_t*>(outDigest));
+#else
   SecByteBlock digest(digestLength());
   p->Final(digest);
   const CryptoPP::byte* h = digest;
   memcpy(outDigest, h, digestLength());
+#endif
 
   delete p;
   internalState = NULL;
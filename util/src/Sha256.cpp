@@ -0,0 +1,416 @@
+// Concord
+//
+// Copyright (c) 2022 VMware, Inc. All Rights Reserved.
+//
+// This product is licensed to you under the Apache 2.0 license (the "License").  You may not use this product except in
+// compliance with the Apache 2.0 License.
+//
+// This product may include a number of subcomponents with separate copyright notices and license terms. Your use of
+// these subcomponents is subject to the terms and conditions of the subcomponent's license, as noted in the LICENSE
+// file.
+
+#include "Sha256.hpp"
+#include "assertUtils.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <vector>
+
+#if defined(__x86_64__)
+#include <cpuid.h>
+#include <immintrin.h>
+#define SHA256_X86 1
+#endif
+
+namespace concord::util::digest {
+
+namespace {
+
+constexpr std::array<uint32_t, 64> K = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+constexpr std::array<uint32_t, 8> INITIAL_STATE = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+
+// The padding of a message takes at least 9 bytes: 0x80 and the 64-bit length in bits
+constexpr size_t MIN_PADDING = 9;
+
+inline uint32_t loadBigEndian(const uint8_t* p) {
+  return (uint32_t{p[0]} << 24) | (uint32_t{p[1]} << 16) | (uint32_t{p[2]} << 8) | uint32_t{p[3]};
+}
+
+inline void storeBigEndian(uint8_t* p, uint32_t v) {
+  p[0] = static_cast<uint8_t>(v >> 24);
+  p[1] = static_cast<uint8_t>(v >> 16);
+  p[2] = static_cast<uint8_t>(v >> 8);
+  p[3] = static_cast<uint8_t>(v);
+}
+
+inline uint32_t rotr(uint32_t x, int n) { return (x >> n) | (x << (32 - n)); }
+
+using CompressFunc = void (*)(uint32_t* state, const uint8_t* blocks, size_t numBlocks);
+
+void compressPortable(uint32_t* state, const uint8_t* blocks, size_t numBlocks) {
+  uint32_t w[64];
+  for (; numBlocks > 0; --numBlocks, blocks += Sha256::BLOCK_LENGTH) {
+    for (int t = 0; t < 16; ++t) w[t] = loadBigEndian(blocks + 4 * t);
+    for (int t = 16; t < 64; ++t) {
+      const uint32_t s0 = rotr(w[t - 15], 7) ^ rotr(w[t - 15], 18) ^ (w[t - 15] >> 3);
+      const uint32_t s1 = rotr(w[t - 2], 17) ^ rotr(w[t - 2], 19) ^ (w[t - 2] >> 10);
+      w[t] = w[t - 16] + s0 + w[t - 7] + s1;
+    }
+
+    uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+    uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+    for (int t = 0; t < 64; ++t) {
+      const uint32_t t1 = h + (rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25)) + ((e & f) ^ (~e & g)) + K[t] + w[t];
+      const uint32_t t2 = (rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+      h = g;
+      g = f;
+      f = e;
+      e = d + t1;
+      d = c;
+      c = b;
+      b = a;
+      a = t1 + t2;
+    }
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+  }
+}
+
+// Pads the last bytes of a message of the given length, those after its last full block, into tail. Returns the number
+// of tail blocks.
+size_t padTail(const uint8_t* lastBytes, uint64_t length, uint8_t* tail) {
+  const size_t rest = length % Sha256::BLOCK_LENGTH;
+  const size_t tailLength =
+      rest + MIN_PADDING <= Sha256::BLOCK_LENGTH ? Sha256::BLOCK_LENGTH : 2 * Sha256::BLOCK_LENGTH;
+  memcpy(tail, lastBytes, rest);
+  tail[rest] = 0x80;
+  memset(tail + rest + 1, 0, tailLength - rest - 1);
+  const uint64_t bits = length * 8;
+  storeBigEndian(tail + tailLength - 8, static_cast<uint32_t>(bits >> 32));
+  storeBigEndian(tail + tailLength - 4, static_cast<uint32_t>(bits));
+  return tailLength / Sha256::BLOCK_LENGTH;
+}
+
+void computeWith(CompressFunc compress, const uint8_t* input, size_t length, uint8_t* digest) {
+  auto state = INITIAL_STATE;
+  const size_t fullBlocks = length / Sha256::BLOCK_LENGTH;
+  compress(state.data(), input, fullBlocks);
+  uint8_t tail[2 * Sha256::BLOCK_LENGTH];
+  compress(state.data(), tail, padTail(input + fullBlocks * Sha256::BLOCK_LENGTH, length, tail));
+  for (size_t i = 0; i < state.size(); ++i) storeBigEndian(digest + 4 * i, state[i]);
+}
+
+#ifdef SHA256_X86
+
+// cpuid may trap to the hypervisor, so it is queried once
+bool cpuHasShaNi() {
+  static const bool hasShaNi = [] {
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) return false;
+    return (ebx & (1u << 29)) != 0 && __builtin_cpu_supports("sse4.1");
+  }();
+  return hasShaNi;
+}
+
+bool cpuHasAvx2() {
+  static const bool hasAvx2 = __builtin_cpu_supports("avx2");
+  return hasAvx2;
+}
+
+// The state is kept as ABEF and CDGH, the layout of the SHA-NI round instructions
+__attribute__((target("sha,sse4.1"))) void compressShaNi(uint32_t* state, const uint8_t* blocks, size_t numBlocks) {
+  const __m128i byteSwap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+  __m128i tmp = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[0])), 0xB1);  // CDAB
+  __m128i state1 = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[4])), 0x1B);  // EFGH
+  __m128i state0 = _mm_alignr_epi8(tmp, state1, 8);     // ABEF
+  state1 = _mm_blend_epi16(state1, tmp, 0xF0);          // CDGH
+
+  for (; numBlocks > 0; --numBlocks, blocks += Sha256::BLOCK_LENGTH) {
+    const __m128i abefSaved = state0;
+    const __m128i cdghSaved = state1;
+
+    // The message schedule is computed along the rounds, 4 words at a time, in a ring of the last 16 words
+    __m128i w[4];
+#pragma GCC unroll 16
+    for (int i = 0; i < 16; ++i) {
+      if (i < 4) {
+        w[i] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(blocks + 16 * i)), byteSwap);
+      } else {
+        const __m128i x = _mm_add_epi32(_mm_sha256msg1_epu32(w[i & 3], w[(i + 1) & 3]),
+                                        _mm_alignr_epi8(w[(i + 3) & 3], w[(i + 2) & 3], 4));
+        w[i & 3] = _mm_sha256msg2_epu32(x, w[(i + 3) & 3]);
+      }
+      // Two rounds per instruction
+      __m128i msg = _mm_add_epi32(w[i & 3], _mm_loadu_si128(reinterpret_cast<const __m128i*>(&K[4 * i])));
+      state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+      msg = _mm_shuffle_epi32(msg, 0x0E);
+      state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+    }
+
+    state0 = _mm_add_epi32(state0, abefSaved);
+    state1 = _mm_add_epi32(state1, cdghSaved);
+  }
+
+  tmp = _mm_shuffle_epi32(state0, 0x1B);        // FEBA
+  state1 = _mm_shuffle_epi32(state1, 0xB1);     // DCHG
+  state0 = _mm_blend_epi16(tmp, state1, 0xF0);  // DCBA
+  state1 = _mm_alignr_epi8(state1, tmp, 8);     // HGFE
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[0]), state0);
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[4]), state1);
+}
+
+#define AVX2_FUNC __attribute__((target("avx2"))) inline
+
+AVX2_FUNC __m256i rotr8x(__m256i x, int n) {
+  return _mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - n));
+}
+
+// Transposes the 8 words of 8 lanes, so that rows[t] holds word t of every lane
+AVX2_FUNC void transpose8x8(__m256i* rows) {
+  const __m256i t0 = _mm256_unpacklo_epi32(rows[0], rows[1]);
+  const __m256i t1 = _mm256_unpackhi_epi32(rows[0], rows[1]);
+  const __m256i t2 = _mm256_unpacklo_epi32(rows[2], rows[3]);
+  const __m256i t3 = _mm256_unpackhi_epi32(rows[2], rows[3]);
+  const __m256i t4 = _mm256_unpacklo_epi32(rows[4], rows[5]);
+  const __m256i t5 = _mm256_unpackhi_epi32(rows[4], rows[5]);
+  const __m256i t6 = _mm256_unpacklo_epi32(rows[6], rows[7]);
+  const __m256i t7 = _mm256_unpackhi_epi32(rows[6], rows[7]);
+  const __m256i u0 = _mm256_unpacklo_epi64(t0, t2);
+  const __m256i u1 = _mm256_unpackhi_epi64(t0, t2);
+  const __m256i u2 = _mm256_unpacklo_epi64(t1, t3);
+  const __m256i u3 = _mm256_unpackhi_epi64(t1, t3);
+  const __m256i u4 = _mm256_unpacklo_epi64(t4, t6);
+  const __m256i u5 = _mm256_unpackhi_epi64(t4, t6);
+  const __m256i u6 = _mm256_unpacklo_epi64(t5, t7);
+  const __m256i u7 = _mm256_unpackhi_epi64(t5, t7);
+  rows[0] = _mm256_permute2x128_si256(u0, u4, 0x20);
+  rows[1] = _mm256_permute2x128_si256(u1, u5, 0x20);
+  rows[2] = _mm256_permute2x128_si256(u2, u6, 0x20);
+  rows[3] = _mm256_permute2x128_si256(u3, u7, 0x20);
+  rows[4] = _mm256_permute2x128_si256(u0, u4, 0x31);
+  rows[5] = _mm256_permute2x128_si256(u1, u5, 0x31);
+  rows[6] = _mm256_permute2x128_si256(u2, u6, 0x31);
+  rows[7] = _mm256_permute2x128_si256(u3, u7, 0x31);
+}
+
+// Compresses one block in each of the 8 lanes of state (state[i] holds word i of every lane). Only the lanes set in
+// the active mask are updated.
+AVX2_FUNC void compressAvx2x8(__m256i* state, const uint8_t* const* blocks, __m256i active) {
+  const __m256i byteSwap = _mm256_set_epi64x(
+      0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL, 0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+  __m256i w[16];
+  for (size_t half = 0; half < 2; ++half) {
+    __m256i* rows = w + 8 * half;
+    for (size_t lane = 0; lane < Sha256::LANES; ++lane) {
+      rows[lane] = _mm256_shuffle_epi8(
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(blocks[lane] + 32 * half)), byteSwap);
+    }
+    transpose8x8(rows);
+  }
+
+  __m256i a = state[0], b = state[1], c = state[2], d = state[3];
+  __m256i e = state[4], f = state[5], g = state[6], h = state[7];
+  for (int t = 0; t < 64; ++t) {
+    // w is a ring of the last 16 words of the schedule
+    __m256i wt = w[t & 15];
+    if (t >= 16) {
+      const __m256i w15 = w[(t - 15) & 15];
+      const __m256i w2 = w[(t - 2) & 15];
+      const __m256i s0 = _mm256_xor_si256(_mm256_xor_si256(rotr8x(w15, 7), rotr8x(w15, 18)), _mm256_srli_epi32(w15, 3));
+      const __m256i s1 = _mm256_xor_si256(_mm256_xor_si256(rotr8x(w2, 17), rotr8x(w2, 19)), _mm256_srli_epi32(w2, 10));
+      wt = _mm256_add_epi32(_mm256_add_epi32(wt, s0), _mm256_add_epi32(w[(t - 7) & 15], s1));
+      w[t & 15] = wt;
+    }
+
+    const __m256i sigma1 = _mm256_xor_si256(_mm256_xor_si256(rotr8x(e, 6), rotr8x(e, 11)), rotr8x(e, 25));
+    const __m256i ch = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+    const __m256i t1 = _mm256_add_epi32(_mm256_add_epi32(_mm256_add_epi32(h, sigma1), _mm256_add_epi32(ch, wt)),
+                                        _mm256_set1_epi32(static_cast<int>(K[t])));
+    const __m256i sigma0 = _mm256_xor_si256(_mm256_xor_si256(rotr8x(a, 2), rotr8x(a, 13)), rotr8x(a, 22));
+    const __m256i maj = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(c, _mm256_or_si256(a, b)));
+    const __m256i t2 = _mm256_add_epi32(sigma0, maj);
+    h = g;
+    g = f;
+    f = e;
+    e = _mm256_add_epi32(d, t1);
+    d = c;
+    c = b;
+    b = a;
+    a = _mm256_add_epi32(t1, t2);
+  }
+
+  const __m256i rounds[8] = {a, b, c, d, e, f, g, h};
+  for (size_t i = 0; i < 8; ++i) {
+    state[i] = _mm256_blendv_epi8(state[i], _mm256_add_epi32(state[i], rounds[i]), active);
+  }
+}
+
+// A message in a lane: its full blocks are read in place, and the rest is padded in tail
+struct Lane {
+  const uint8_t* input = nullptr;
+  size_t fullBlocks = 0;
+  size_t numBlocks = 0;
+  uint8_t* digest = nullptr;
+  alignas(32) uint8_t tail[2 * Sha256::BLOCK_LENGTH];
+
+  const uint8_t* block(size_t b) const {
+    return b < fullBlocks ? input + b * Sha256::BLOCK_LENGTH : tail + (b - fullBlocks) * Sha256::BLOCK_LENGTH;
+  }
+};
+
+// Hashes up to 8 lanes at once. Lanes that are done, or unused, are fed a zero block and keep their state.
+__attribute__((target("avx2"))) void computeLanesAvx2(Lane* lanes, size_t numLanes) {
+  static const uint8_t zeroBlock[Sha256::BLOCK_LENGTH] = {};
+
+  __m256i state[8];
+  for (size_t i = 0; i < 8; ++i) state[i] = _mm256_set1_epi32(static_cast<int>(INITIAL_STATE[i]));
+
+  size_t maxBlocks = 0;
+  for (size_t l = 0; l < numLanes; ++l) maxBlocks = std::max(maxBlocks, lanes[l].numBlocks);
+
+  for (size_t b = 0; b < maxBlocks; ++b) {
+    const uint8_t* blocks[Sha256::LANES];
+    alignas(32) int32_t active[Sha256::LANES];
+    for (size_t l = 0; l < Sha256::LANES; ++l) {
+      const bool isActive = l < numLanes && b < lanes[l].numBlocks;
+      blocks[l] = isActive ? lanes[l].block(b) : zeroBlock;
+      active[l] = isActive ? -1 : 0;
+    }
+    compressAvx2x8(state, blocks, _mm256_load_si256(reinterpret_cast<const __m256i*>(active)));
+  }
+
+  alignas(32) uint32_t words[8][Sha256::LANES];
+  for (size_t i = 0; i < 8; ++i) _mm256_store_si256(reinterpret_cast<__m256i*>(words[i]), state[i]);
+  for (size_t l = 0; l < numLanes; ++l) {
+    for (size_t i = 0; i < 8; ++i) storeBigEndian(lanes[l].digest + 4 * i, words[i][l]);
+  }
+}
+
+void computeManyAvx2(const uint8_t* const* inputs, const size_t* lengths, size_t count, uint8_t* const* digests) {
+  // Lanes run as long as the longest message of their group, so messages of similar lengths are grouped together
+  std::vector<size_t> order(count);
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [lengths](size_t i, size_t j) { return lengths[i] < lengths[j]; });
+
+  Lane lanes[Sha256::LANES];
+  for (size_t first = 0; first < count; first += Sha256::LANES) {
+    const size_t numLanes = std::min(Sha256::LANES, count - first);
+    for (size_t l = 0; l < numLanes; ++l) {
+      const size_t i = order[first + l];
+      lanes[l].input = inputs[i];
+      lanes[l].fullBlocks = lengths[i] / Sha256::BLOCK_LENGTH;
+      const uint8_t* lastBytes = inputs[i] + lanes[l].fullBlocks * Sha256::BLOCK_LENGTH;
+      lanes[l].numBlocks = lanes[l].fullBlocks + padTail(lastBytes, lengths[i], lanes[l].tail);
+      lanes[l].digest = digests[i];
+    }
+    computeLanesAvx2(lanes, numLanes);
+  }
+}
+
+#endif  // SHA256_X86
+
+CompressFunc compressFunc(Sha256::Implementation impl) {
+#ifdef SHA256_X86
+  if (impl == Sha256::Implementation::ShaNi) return compressShaNi;
+#endif
+  return compressPortable;
+}
+
+}  // namespace
+
+Sha256::Implementation Sha256::singleBuffer() {
+  static const Implementation impl =
+      isSupported(Implementation::ShaNi) ? Implementation::ShaNi : Implementation::Portable;
+  return impl;
+}
+
+Sha256::Implementation Sha256::multiBuffer() {
+  // SHA-NI, one input at a time, is as fast as 8 AVX2 lanes for small inputs and faster for large ones
+  static const Implementation impl = singleBuffer() == Implementation::Portable && isSupported(Implementation::Avx2)
+                                         ? Implementation::Avx2
+                                         : singleBuffer();
+  return impl;
+}
+
+bool Sha256::isSupported(Implementation impl) {
+  switch (impl) {
+    case Implementation::Portable:
+      return true;
+#ifdef SHA256_X86
+    case Implementation::ShaNi:
+      return cpuHasShaNi();
+    case Implementation::Avx2:
+      return cpuHasAvx2();
+#endif
+    default:
+      return false;
+  }
+}
+
+void Sha256::compute(Implementation impl, const uint8_t* input, size_t length, uint8_t* digest) {
+  ConcordAssert(isSupported(impl));
+  // AVX2 only pays off with several inputs
+  computeWith(compressFunc(impl == Implementation::Avx2 ? singleBuffer() : impl), input, length, digest);
+}
+
+void Sha256::computeMany(
+    Implementation impl, const uint8_t* const* inputs, const size_t* lengths, size_t count, uint8_t* const* digests) {
+  ConcordAssert(isSupported(impl));
+#ifdef SHA256_X86
+  if (impl == Implementation::Avx2) {
+    computeManyAvx2(inputs, lengths, count, digests);
+    return;
+  }
+#endif
+  for (size_t i = 0; i < count; ++i) computeWith(compressFunc(impl), inputs[i], lengths[i], digests[i]);
+}
+
+Sha256::Sha256() : state_(INITIAL_STATE) {}
+
+void Sha256::update(const uint8_t* data, size_t length) {
+  const auto compress = compressFunc(singleBuffer());
+  length_ += length;
+  if (buffered_ > 0) {
+    const size_t toCopy = std::min(length, BLOCK_LENGTH - buffered_);
+    memcpy(buffer_.data() + buffered_, data, toCopy);
+    buffered_ += toCopy;
+    data += toCopy;
+    length -= toCopy;
+    if (buffered_ < BLOCK_LENGTH) return;
+    compress(state_.data(), buffer_.data(), 1);
+    buffered_ = 0;
+  }
+  compress(state_.data(), data, length / BLOCK_LENGTH);
+  const size_t rest = length % BLOCK_LENGTH;
+  memcpy(buffer_.data(), data + length - rest, rest);
+  buffered_ = rest;
+}
+
+void Sha256::writeDigest(uint8_t* digest) {
+  // The buffered bytes are those after the last full block
+  uint8_t tail[2 * BLOCK_LENGTH];
+  const size_t numBlocks = padTail(buffer_.data(), length_, tail);
+  compressFunc(singleBuffer())(state_.data(), tail, numBlocks);
+  for (size_t i = 0; i < state_.size(); ++i) storeBigEndian(digest + 4 * i, state_[i]);
+}
+
+}  // namespace concord::util::digest
@@ -11,6 +11,8 @@
 
 #include "SimpleThreadPool.hpp"
 #include "Logger.hpp"
+#include "kvstream.h"
+#include <algorithm>
 #include <exception>
 #include <iostream>
 #include <mutex>
@@ -21,26 +23,62 @@ namespace concord::util {
 void SimpleThreadPool::start(uint8_t num_of_threads) {
   stopped_ = false;
   guard g(queue_lock_);
-  for (auto i = 0; i < num_of_threads; ++i) {
-    threads_.emplace_back(std::thread([this, num_of_threads] {
-      LOG_DEBUG(SP, "thread start " << std::this_thread::get_id());
-      {
-        std::unique_lock<std::mutex> ul(threads_startup_lock_);
-        num_of_free_threads_++;
-        if (num_of_free_threads_ == num_of_threads) threads_startup_cond_.notify_one();
-      }
-      SimpleThreadPool::Job* j = nullptr;
-      while (load(j)) {
-        execute(j);
-        j->release();
-        j = nullptr;
-      }
-    }));
-  }
+  for (auto i = 0; i < num_of_threads; ++i) startThread();
   std::unique_lock<std::mutex> ul(threads_startup_lock_);
   threads_startup_cond_.wait(ul, [this, num_of_threads] { return (num_of_free_threads_ == num_of_threads); });
 }
 
+// Should be called with queue_lock_ held
+void SimpleThreadPool::startThread() {
+  threads_.emplace_back(std::thread([this] {
+    LOG_DEBUG(SP, "thread start " << std::this_thread::get_id());
+    {
+      std::unique_lock<std::mutex> ul(threads_startup_lock_);
+      num_of_free_threads_++;
+      threads_startup_cond_.notify_one();
+    }
+    SimpleThreadPool::Job* j = nullptr;
+    while (load(j)) {
+      execute(j);
+      j->release();
+      j = nullptr;
+    }
+  }));
+}
+
+void SimpleThreadPool::resize(size_t num_of_threads) {
+  joinRetiredThreads();
+  {
+    guard g(queue_lock_);
+    if (stopped_) return;
+    const auto current = threads_.size() - num_of_retiring_threads_ - retired_threads_.size();
+    if (num_of_threads > current) {
+      // Threads that didn't retire yet keep working instead of new ones starting
+      const auto kept = std::min(num_of_threads - current, num_of_retiring_threads_);
+      num_of_retiring_threads_ -= kept;
+      for (auto i = current + kept; i < num_of_threads; ++i) startThread();
+    } else {
+      num_of_retiring_threads_ += current - num_of_threads;
+    }
+    LOG_DEBUG(SP, "resized thread pool" << KVLOG(current, num_of_threads));
+  }
+  queue_cond_.notify_all();
+}
+
+void SimpleThreadPool::joinRetiredThreads() {
+  std::vector<std::thread> retired;
+  {
+    guard g(queue_lock_);
+    for (const auto& id : retired_threads_) {
+      auto it = std::find_if(threads_.begin(), threads_.end(), [&id](const auto& t) { return t.get_id() == id; });
+      retired.push_back(std::move(*it));
+      threads_.erase(it);
+    }
+    retired_threads_.clear();
+  }
+  for (auto&& t : retired) t.join();
+}
+
 void SimpleThreadPool::stop(bool executeAllJobs) {
   {
     std::unique_lock<std::mutex> l{queue_lock_};
@@ -53,10 +91,12 @@ void SimpleThreadPool::stop(bool executeAllJobs) {
     LOG_DEBUG(SP, "thread joined " << tid);
   }
   threads_.clear();
+  num_of_retiring_threads_ = 0;
+  retired_threads_.clear();
   // no more concurrent threads, can cleanup without locking
   LOG_DEBUG(SP, "will " << (executeAllJobs ? "execute " : "discard ") << job_queue_.size() << " jobs in queue");
   while (!job_queue_.empty()) {
-    Job* j = job_queue_.front();
+    Job* j = job_queue_.front().job;
     job_queue_.pop();
     if (executeAllJobs) execute(j);
 
@@ -68,19 +108,41 @@ void SimpleThreadPool::add(Job* j) {
   {
     guard g(queue_lock_);
     if (stopped_) return;
-    job_queue_.push(j);
+    job_queue_.push({j, std::chrono::steady_clock::now()});
   }
   queue_cond_.notify_one();
 }
 
 bool SimpleThreadPool::load(Job*& outJob) {
   std::unique_lock<std::mutex> ul(queue_lock_);
-  queue_cond_.wait(ul, [this] { return !(job_queue_.empty() && !stopped_); });
-  if (!stopped_) {
-    outJob = job_queue_.front();
-    job_queue_.pop();
+  queue_cond_.wait(ul, [this] { return !(job_queue_.empty() && !stopped_) || num_of_retiring_threads_ > 0; });
+  if (stopped_) return false;
+  if (num_of_retiring_threads_ > 0) {
+    num_of_retiring_threads_--;
+    retired_threads_.push_back(std::this_thread::get_id());
+    LOG_DEBUG(SP, "thread retired " << std::this_thread::get_id());
+    return false;
   }
-  return !stopped_;
+  const auto queued = job_queue_.front();
+  job_queue_.pop();
+  queue_wait_ +=
+      std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - queued.enqueued);
+  num_of_dequeued_jobs_++;
+  outJob = queued.job;
+  return true;
+}
+
+std::chrono::microseconds SimpleThreadPool::takeAverageQueueWait() {
+  using namespace std::chrono;
+  guard g(queue_lock_);
+  auto average =
+      microseconds{num_of_dequeued_jobs_ ? queue_wait_.count() / static_cast<int64_t>(num_of_dequeued_jobs_) : 0};
+  // Jobs that still wait count too, so that a pool whose threads are all stuck shows a growing wait
+  if (!job_queue_.empty())
+    average = std::max(average, duration_cast<microseconds>(steady_clock::now() - job_queue_.front().enqueued));
+  queue_wait_ = microseconds{0};
+  num_of_dequeued_jobs_ = 0;
+  return average;
 }
 
 void SimpleThreadPool::execute(Job* j) {
@@ -0,0 +1,97 @@
+// Concord
+//
+// Copyright (c) 2022 VMware, Inc. All Rights Reserved.
+//
+// This product is licensed to you under the Apache 2.0 license (the "License").
+// You may not use this product except in compliance with the Apache 2.0
+// License.
+//
+// This product may include a number of subcomponents with separate copyright
+// notices and license terms. Your use of these subcomponents is subject to the
+// terms and conditions of the subcomponent's license, as noted in the
+// LICENSE file.
+
+// A SimpleThreadPool with static numbers of threads against one resized by a ConcurrencyController, on a workload
+// whose best number of threads changes: every iteration runs a phase of blocking jobs, which need many threads, and
+// then a phase of CPU bound jobs, which only lose to contention with more threads than CPUs.
+
+#include <benchmark/benchmark.h>
+
+#include "ConcurrencyController.hpp"
+#include "SimpleThreadPool.hpp"
+
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <thread>
+
+namespace {
+
+using namespace concord::util;
+using namespace std::chrono;
+using namespace std::chrono_literals;
+
+constexpr size_t kJobsPerPhase = 2000;
+constexpr auto kJobDuration = 200us;
+constexpr auto kTickPeriod = 2ms;
+
+class WorkJob final : public SimpleThreadPool::Job {
+ public:
+  WorkJob(std::atomic_size_t& done, bool blocking) : done_{done}, blocking_{blocking} {}
+  void execute() override {
+    if (blocking_) {
+      std::this_thread::sleep_for(kJobDuration);
+      return;
+    }
+    const auto end = steady_clock::now() + kJobDuration;
+    while (steady_clock::now() < end) {
+    }
+  }
+  void release() override {
+    done_++;
+    delete this;
+  }
+
+ private:
+  std::atomic_size_t& done_;
+  const bool blocking_;
+};
+
+void runPhases(benchmark::State& state, bool controlled) {
+  SimpleThreadPool pool;
+  pool.start(static_cast<uint8_t>(state.range(0)));
+  concordMetrics::Component metrics{"benchmark", std::make_shared<concordMetrics::Aggregator>()};
+  std::optional<ConcurrencyController> controller;
+  if (controlled) {
+    controller.emplace("pool",
+                       ConcurrencyController::Config{1, 64, 1ms, 0.9},
+                       ConcurrencyController::poolOf(pool),
+                       metrics);
+  }
+  microseconds queueWait{0};
+  for (auto _ : state) {
+    for (const bool blocking : {true, false}) {
+      std::atomic_size_t done{0};
+      for (size_t i = 0; i < kJobsPerPhase; ++i) pool.add(new WorkJob(done, blocking));
+      while (done < kJobsPerPhase) {
+        std::this_thread::sleep_for(kTickPeriod);
+        queueWait = std::max(queueWait, pool.takeAverageQueueWait());
+        if (controller) controller->tick();
+      }
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(2 * kJobsPerPhase));
+  state.counters["final_threads"] = static_cast<double>(pool.getNumOfThreads());
+  state.counters["max_queue_wait_us"] = static_cast<double>(queueWait.count());
+  pool.stop();
+}
+
+void static_threads(benchmark::State& state) { runPhases(state, false); }
+void controlled_threads(benchmark::State& state) { runPhases(state, true); }
+
+}  // namespace
+
+BENCHMARK(static_threads)->Arg(1)->Arg(4)->Arg(16)->Arg(64)->UseRealTime()->Unit(benchmark::kMillisecond);
+// Starts with as few threads as the static run with one, and finds its own
+BENCHMARK(controlled_threads)->Arg(1)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK_MAIN();
@@ -0,0 +1,156 @@
+// Concord
+//
+// Copyright (c) 2022 VMware, Inc. All Rights Reserved.
+//
+// This product is licensed to you under the Apache 2.0 license (the "License").
+// You may not use this product except in compliance with the Apache 2.0
+// License.
+//
+// This product may include a number of subcomponents with separate copyright
+// notices and license terms. Your use of these subcomponents is subject to the
+// terms and conditions of the subcomponent's license, as noted in the
+// LICENSE file.
+
+#include "gtest/gtest.h"
+
+#include "ConcurrencyController.hpp"
+#include "SimpleThreadPool.hpp"
+
+#include <memory>
+#include <thread>
+
+namespace {
+
+using namespace concord::util;
+using namespace std::chrono_literals;
+
+using Decision = ConcurrencyController::Decision;
+
+constexpr auto kTargetQueueWait = 1000us;
+
+class concurrency_controller : public ::testing::Test {
+ protected:
+  concurrency_controller()
+      : metrics_{"replica", std::make_shared<concordMetrics::Aggregator>()},
+        controller_{"pool",
+                    ConcurrencyController::Config{2, 10, kTargetQueueWait, 0.9},
+                    ConcurrencyController::Pool{[this]() { return threads_; },
+                                                [this]() { return jobs_; },
+                                                [this]() { return queueWait_; },
+                                                [this](size_t threads) { threads_ = threads; }},
+                    metrics_,
+                    [this]() { return cpuUtilization_; }} {}
+
+  uint64_t gauge(const std::string& name) {
+    for (auto& metric : metrics_.CollectGauges()) {
+      if (metric.name == name) return std::get<concordMetrics::Gauge>(metric.value).Get();
+    }
+    return 0;
+  }
+
+  uint64_t counter(const std::string& name) {
+    for (auto& metric : metrics_.CollectCounters()) {
+      if (metric.name == name) return std::get<concordMetrics::Counter>(metric.value).Get();
+    }
+    return 0;
+  }
+
+  size_t threads_ = 4;
+  size_t jobs_ = 0;
+  std::chrono::microseconds queueWait_{0};
+  double cpuUtilization_ = 0.5;
+  concordMetrics::Component metrics_;
+  ConcurrencyController controller_;
+};
+
+TEST_F(concurrency_controller, grows_by_a_quarter_when_jobs_wait) {
+  queueWait_ = 2 * kTargetQueueWait;
+  jobs_ = 8;
+  ASSERT_EQ(Decision::GROW, controller_.tick());
+  ASSERT_EQ(5u, threads_);
+  threads_ = 8;
+  ASSERT_EQ(Decision::GROW, controller_.tick());
+  ASSERT_EQ(10u, threads_);
+  // Up to the maximum
+  ASSERT_EQ(Decision::HOLD, controller_.tick());
+  ASSERT_EQ(10u, threads_);
+  ASSERT_EQ(2u, counter("poolThreadsGrown"));
+  ASSERT_EQ(10u, gauge("poolThreads"));
+  ASSERT_EQ(2000u, gauge("poolQueueWaitMicros"));
+}
+
+TEST_F(concurrency_controller, shrinks_when_cpu_is_saturated) {
+  queueWait_ = 2 * kTargetQueueWait;
+  cpuUtilization_ = 0.95;
+  ASSERT_EQ(Decision::SHRINK, controller_.tick());
+  ASSERT_EQ(3u, threads_);
+  ASSERT_EQ(Decision::SHRINK, controller_.tick());
+  ASSERT_EQ(2u, threads_);
+  // Down to the minimum
+  ASSERT_EQ(Decision::HOLD, controller_.tick());
+  ASSERT_EQ(2u, threads_);
+  ASSERT_EQ(2u, counter("poolThreadsShrunk"));
+  ASSERT_EQ(95u, gauge("poolCpuUtilizationPercent"));
+}
+
+TEST_F(concurrency_controller, shrinks_after_idle_ticks) {
+  for (size_t i = 1; i < ConcurrencyController::IDLE_TICKS_TO_SHRINK; ++i) {
+    ASSERT_EQ(Decision::HOLD, controller_.tick());
+  }
+  ASSERT_EQ(Decision::SHRINK, controller_.tick());
+  ASSERT_EQ(3u, threads_);
+
+  // A busy tick starts the count over
+  ASSERT_EQ(Decision::HOLD, controller_.tick());
+  jobs_ = 1;
+  ASSERT_EQ(Decision::HOLD, controller_.tick());
+  jobs_ = 0;
+  for (size_t i = 1; i < ConcurrencyController::IDLE_TICKS_TO_SHRINK; ++i) {
+    ASSERT_EQ(Decision::HOLD, controller_.tick());
+  }
+  ASSERT_EQ(Decision::SHRINK, controller_.tick());
+  ASSERT_EQ(2u, threads_);
+}
+
+TEST_F(concurrency_controller, holds_within_target) {
+  queueWait_ = kTargetQueueWait;
+  jobs_ = 2;
+  for (size_t i = 0; i < 2 * ConcurrencyController::IDLE_TICKS_TO_SHRINK; ++i) {
+    ASSERT_EQ(Decision::HOLD, controller_.tick());
+  }
+  ASSERT_EQ(4u, threads_);
+}
+
+TEST_F(concurrency_controller, brings_the_pool_into_bounds) {
+  threads_ = 20;
+  ASSERT_EQ(Decision::SHRINK, controller_.tick());
+  ASSERT_EQ(10u, threads_);
+  // A stopped pool is left alone
+  threads_ = 0;
+  ASSERT_EQ(Decision::HOLD, controller_.tick());
+  ASSERT_EQ(0u, threads_);
+}
+
+// The controller grows a SimpleThreadPool whose jobs wait
+TEST(concurrency_controller_pool, grows_simple_thread_pool) {
+  class SleepJob final : public SimpleThreadPool::Job {
+   public:
+    void execute() override { std::this_thread::sleep_for(5ms); }
+    void release() override { delete this; }
+  };
+  concordMetrics::Component metrics{"replica", std::make_shared<concordMetrics::Aggregator>()};
+  SimpleThreadPool pool;
+  pool.start(1);
+  ConcurrencyController controller{"pool",
+                                   ConcurrencyController::Config{1, 4, kTargetQueueWait, 1.0},
+                                   ConcurrencyController::poolOf(pool),
+                                   metrics,
+                                   []() { return 0.0; }};
+  for (int i = 0; i < 20; ++i) pool.add(new SleepJob);
+  std::this_thread::sleep_for(10ms);
+  ASSERT_EQ(Decision::GROW, controller.tick());
+  ASSERT_EQ(2u, pool.getNumOfThreads());
+  pool.stop();
+}
+
+}  // namespace
@@ -89,6 +89,29 @@ TEST_F(SimpleThreadPoolFixture, ThreadPoolMultipleProducers) {
   EXPECT_EQ(result, 1000);
 }
 
+TEST_F(SimpleThreadPoolFixture, ThreadPoolResize) {
+  const auto initial = pool_.getNumOfThreads();
+  pool_.resize(initial + 2);
+  EXPECT_EQ(pool_.getNumOfThreads(), initial + 2);
+  pool_.resize(1);
+  EXPECT_EQ(pool_.getNumOfThreads(), 1);
+  for (int i = 0; i < 100; ++i) pool_.add(new TestJob(this, 1));
+  pool_.resize(3);
+  EXPECT_EQ(pool_.getNumOfThreads(), 3);
+  pool_.stop(true);
+  EXPECT_EQ(result, 100);
+}
+
+TEST_F(SimpleThreadPoolFixture, ThreadPoolAverageQueueWait) {
+  pool_.resize(1);
+  for (int i = 0; i < 10; ++i) pool_.add(new TestJob(this, 10));
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  // The jobs that still wait have waited the longest
+  EXPECT_GE(pool_.takeAverageQueueWait(), std::chrono::milliseconds(40));
+  pool_.stop(true);
+  EXPECT_EQ(result, 10);
+}
+
 /**
  * Fixture for testing Handoff
  */
@@ -0,0 +1,105 @@
+// Concord
+//
+// Copyright (c) 2022 VMware, Inc. All Rights Reserved.
+//
+// This product is licensed to you under the Apache 2.0 license (the "License").
+// You may not use this product except in compliance with the Apache 2.0 License.
+//
+// This product may include a number of subcomponents with separate copyright
+// notices and license terms. Your use of these subcomponents is subject to the
+// terms and conditions of the subcomponent's license, as noted in the
+// LICENSE file.
+
+// SHA-256 throughput across input sizes: CryptoPP, which DigestUtil used before, against the implementations of
+// Sha256. Every iteration hashes a batch of inputs of the same size, one by one or, for multi-buffer, all at once.
+
+#include <benchmark/benchmark.h>
+
+#include "Sha256.hpp"
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+#include <cryptopp/sha.h>
+#pragma GCC diagnostic pop
+
+#include <vector>
+
+namespace {
+
+using concord::util::digest::Sha256;
+
+constexpr size_t kBatchSize = 64;
+
+struct Batch {
+  explicit Batch(size_t inputLength) : data(kBatchSize * inputLength, 0xab), digests(kBatchSize * 32) {
+    for (size_t i = 0; i < kBatchSize; ++i) {
+      inputs.push_back(data.data() + i * inputLength);
+      lengths.push_back(inputLength);
+      digestPtrs.push_back(digests.data() + i * Sha256::DIGEST_LENGTH);
+    }
+  }
+  std::vector<uint8_t> data;
+  std::vector<uint8_t> digests;
+  std::vector<const uint8_t*> inputs;
+  std::vector<size_t> lengths;
+  std::vector<uint8_t*> digestPtrs;
+};
+
+void setCounters(benchmark::State& state) {
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(kBatchSize));
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(kBatchSize) * state.range(0));
+}
+
+void cryptopp(benchmark::State& state) {
+  Batch batch(static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    for (size_t i = 0; i < kBatchSize; ++i) {
+      CryptoPP::SHA256 sha;
+      sha.Update(batch.inputs[i], batch.lengths[i]);
+      sha.Final(batch.digestPtrs[i]);
+    }
+    benchmark::DoNotOptimize(batch.digests.data());
+  }
+  setCounters(state);
+}
+
+void singleBuffer(benchmark::State& state, Sha256::Implementation impl) {
+  if (!Sha256::isSupported(impl)) {
+    state.SkipWithError("Not supported by this CPU");
+    return;
+  }
+  Batch batch(static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    for (size_t i = 0; i < kBatchSize; ++i) {
+      Sha256::compute(impl, batch.inputs[i], batch.lengths[i], batch.digestPtrs[i]);
+    }
+    benchmark::DoNotOptimize(batch.digests.data());
+  }
+  setCounters(state);
+}
+
+void multiBuffer(benchmark::State& state, Sha256::Implementation impl) {
+  if (!Sha256::isSupported(impl)) {
+    state.SkipWithError("Not supported by this CPU");
+    return;
+  }
+  Batch batch(static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    Sha256::computeMany(impl, batch.inputs.data(), batch.lengths.data(), kBatchSize, batch.digestPtrs.data());
+    benchmark::DoNotOptimize(batch.digests.data());
+  }
+  setCounters(state);
+}
+
+void inputSizes(benchmark::internal::Benchmark* b) {
+  for (int64_t size : {32, 64, 256, 1024, 4096, 64 * 1024}) b->Arg(size);
+}
+
+}  // namespace
+
+BENCHMARK(cryptopp)->Apply(inputSizes);
+BENCHMARK_CAPTURE(singleBuffer, portable, Sha256::Implementation::Portable)->Apply(inputSizes);
+BENCHMARK_CAPTURE(singleBuffer, sha_ni, Sha256::Implementation::ShaNi)->Apply(inputSizes);
+BENCHMARK_CAPTURE(multiBuffer, avx2, Sha256::Implementation::Avx2)->Apply(inputSizes);
+
+BENCHMARK_MAIN();
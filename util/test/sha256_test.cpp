@@ -0,0 +1,129 @@
+// Concord
+//
+// Copyright (c) 2022 VMware, Inc. All Rights Reserved.
+//
+// This product is licensed to you under the Apache 2.0 license (the "License").
+// You may not use this product except in compliance with the Apache 2.0
+// License.
+//
+// This product may include a number of subcomponents with separate copyright
+// notices and license terms. Your use of these subcomponents is subject to the
+// terms and conditions of the subcomponent's license, as noted in the
+// LICENSE file.
+
+#include "gtest/gtest.h"
+#include "Sha256.hpp"
+#include "Digest.hpp"
+
+#include <openssl/sha.h>
+
+#include <array>
+#include <random>
+#include <vector>
+
+using namespace concord::util::digest;
+
+namespace {
+
+using DigestBytes = std::array<uint8_t, Sha256::DIGEST_LENGTH>;
+
+DigestBytes expectedDigest(const uint8_t* input, size_t length) {
+  DigestBytes digest;
+  SHA256(input, length, digest.data());
+  return digest;
+}
+
+std::vector<uint8_t> randomBytes(size_t length, std::mt19937& rng) {
+  std::vector<uint8_t> bytes(length);
+  for (auto& b : bytes) b = static_cast<uint8_t>(rng());
+  return bytes;
+}
+
+class sha256_test : public ::testing::TestWithParam<Sha256::Implementation> {
+  void SetUp() override {
+    if (!Sha256::isSupported(GetParam())) GTEST_SKIP() << "Not supported by this CPU";
+  }
+
+ protected:
+  std::mt19937 rng_{42};
+};
+
+// Lengths around the block boundaries, where the padding takes one or two blocks
+TEST_P(sha256_test, compute_matches_openssl) {
+  const auto input = randomBytes(64 * 1024 + 7, rng_);
+  std::vector<size_t> lengths;
+  for (size_t length = 0; length <= 300; ++length) lengths.push_back(length);
+  lengths.push_back(4096);
+  lengths.push_back(input.size());
+  for (auto length : lengths) {
+    DigestBytes digest;
+    Sha256::compute(GetParam(), input.data(), length, digest.data());
+    ASSERT_EQ(expectedDigest(input.data(), length), digest) << "length " << length;
+  }
+}
+
+TEST_P(sha256_test, compute_many_matches_openssl) {
+  // Lanes hash inputs of different lengths, and the last group doesn't fill all lanes
+  for (size_t count : {size_t{0}, size_t{1}, Sha256::LANES, size_t{45}}) {
+    std::vector<std::vector<uint8_t>> inputs;
+    for (size_t i = 0; i < count; ++i) inputs.push_back(randomBytes(rng_() % (i % 7 == 0 ? 5000 : 200), rng_));
+
+    std::vector<const uint8_t*> inputPtrs;
+    std::vector<size_t> lengths;
+    for (const auto& input : inputs) {
+      inputPtrs.push_back(input.data());
+      lengths.push_back(input.size());
+    }
+    std::vector<DigestBytes> digests(count);
+    std::vector<uint8_t*> digestPtrs;
+    for (auto& digest : digests) digestPtrs.push_back(digest.data());
+
+    Sha256::computeMany(GetParam(), inputPtrs.data(), lengths.data(), count, digestPtrs.data());
+    for (size_t i = 0; i < count; ++i) {
+      ASSERT_EQ(expectedDigest(inputs[i].data(), inputs[i].size()), digests[i]) << "input " << i << " of " << count;
+    }
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(implementations,
+                         sha256_test,
+                         ::testing::Values(Sha256::Implementation::Portable,
+                                           Sha256::Implementation::ShaNi,
+                                           Sha256::Implementation::Avx2));
+
+TEST(sha256_incremental_test, random_updates_match_openssl) {
+  std::mt19937 rng{7};
+  for (int round = 0; round < 200; ++round) {
+    const auto input = randomBytes(rng() % 3000, rng);
+    Sha256 sha;
+    for (size_t pos = 0; pos < input.size();) {
+      const size_t length = std::min<size_t>(input.size() - pos, rng() % 150);
+      sha.update(input.data() + pos, length);
+      pos += length;
+    }
+    DigestBytes digest;
+    sha.writeDigest(digest.data());
+    ASSERT_EQ(expectedDigest(input.data(), input.size()), digest) << "length " << input.size();
+  }
+}
+
+TEST(sha256_digest_util_test, compute_batch_matches_compute) {
+  std::mt19937 rng{9};
+  std::vector<std::string> inputs;
+  for (int i = 0; i < 20; ++i) inputs.push_back(std::string(rng() % 500, static_cast<char>(i)));
+  std::vector<const char*> inputPtrs;
+  std::vector<size_t> lengths;
+  for (const auto& input : inputs) {
+    inputPtrs.push_back(input.data());
+    lengths.push_back(input.size());
+  }
+  std::vector<Digest> digests(inputs.size());
+  DigestUtil::computeBatch(inputPtrs.data(), lengths.data(), inputs.size(), digests.data());
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    Digest expected;
+    ASSERT_TRUE(DigestUtil::compute(inputs[i].data(), inputs[i].size(), expected.getForUpdate(), sizeof(Digest)));
+    ASSERT_EQ(expected, digests[i]);
+  }
+}
+
+}  // namespace
@@ -240,6 +240,40 @@ TEST(thread_pool, add_tasks_from_different_threads) {
   ASSERT_EQ(answer, pool_future.get());
 }
 
+// Make sure that the pool keeps executing tasks while it grows and shrinks.
+TEST(thread_pool, resize) {
+  auto pool = ThreadPool{2};
+  ASSERT_EQ(2, pool.getNumOfThreads());
+  pool.resize(5);
+  ASSERT_EQ(5, pool.getNumOfThreads());
+  auto futures = std::vector<std::future<AnswerType>>{};
+  for (auto i = 0u; i < 100; ++i) {
+    futures.push_back(pool.async(func));
+  }
+  pool.resize(1);
+  ASSERT_EQ(1, pool.getNumOfThreads());
+  for (auto& future : futures) {
+    ASSERT_EQ(answer, future.get());
+  }
+  pool.resize(3);
+  ASSERT_EQ(3, pool.getNumOfThreads());
+  ASSERT_EQ(answer, pool.async(func).get());
+}
+
+// Make sure that the queue wait covers the tasks that still wait.
+TEST(thread_pool, average_queue_wait) {
+  auto pool = ThreadPool{1};
+  auto blocker = std::promise<void>{};
+  auto blocked = pool.async([future = blocker.get_future().share()]() { future.wait(); });
+  auto waiting = pool.async(func);
+  std::this_thread::sleep_for(std::chrono::milliseconds{20});
+  ASSERT_EQ(1, pool.getNumOfJobs());
+  ASSERT_GE(pool.takeAverageQueueWait(), std::chrono::milliseconds{20});
+  blocker.set_value();
+  ASSERT_EQ(answer, waiting.get());
+  ASSERT_EQ(0, pool.getNumOfJobs());
+}
+
 }  // namespace
 
 int main(int argc, char** argv) {
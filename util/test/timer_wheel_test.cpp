@@ -0,0 +1,82 @@
+// Concord
+//
+// Copyright (c) 2022 VMware, Inc. All Rights Reserved.
+//
+// This product is licensed to you under the Apache 2.0 license (the "License").
+// You may not use this product except in compliance with the Apache 2.0
+// License.
+//
+// This product may include a number of subcomponents with separate copyright
+// notices and license terms. Your use of these subcomponents is subject to the
+// terms and conditions of the subcomponent's license, as noted in the LICENSE
+// file.
+
+#include "gtest/gtest.h"
+#include "timer_wheel.hpp"
+
+#include <vector>
+
+using namespace std::chrono;
+using concord::util::TimerWheel;
+
+namespace {
+
+TEST(timer_wheel_test, fires_in_order_and_not_early) {
+  const auto start = steady_clock::now();
+  auto wheel = TimerWheel{10ms, 8, start};
+  auto fired = std::vector<int>{};
+  wheel.add(30ms, [&]() { fired.push_back(30); }, start);
+  wheel.add(10ms, [&]() { fired.push_back(10); }, start);
+  wheel.add(200ms, [&]() { fired.push_back(200); }, start);
+  ASSERT_EQ(wheel.size(), 3u);
+
+  ASSERT_EQ(wheel.advance(start + 5ms), 0u);
+  ASSERT_EQ(wheel.advance(start + 10ms), 1u);
+  ASSERT_EQ(wheel.advance(start + 29ms), 0u);
+  ASSERT_EQ(wheel.advance(start + 30ms), 1u);
+  ASSERT_EQ(fired, (std::vector<int>{10, 30}));
+
+  // 200ms is more than a full rotation of the wheel - the timer must survive visits of its slot.
+  ASSERT_EQ(wheel.advance(start + 190ms), 0u);
+  ASSERT_EQ(wheel.advance(start + 500ms), 1u);
+  ASSERT_EQ(fired, (std::vector<int>{10, 30, 200}));
+  ASSERT_EQ(wheel.size(), 0u);
+}
+
+TEST(timer_wheel_test, cancel) {
+  const auto start = steady_clock::now();
+  auto wheel = TimerWheel{10ms, 8, start};
+  auto fired = 0;
+  const auto handle = wheel.add(20ms, [&]() { ++fired; }, start);
+  ASSERT_TRUE(wheel.cancel(handle));
+  ASSERT_FALSE(wheel.cancel(handle));
+  ASSERT_EQ(wheel.advance(start + 100ms), 0u);
+  ASSERT_EQ(fired, 0);
+}
+
+TEST(timer_wheel_test, callbacks_can_rearm) {
+  const auto start = steady_clock::now();
+  auto wheel = TimerWheel{10ms, 8, start};
+  auto fired = 0;
+  std::function<void()> cb = [&]() {
+    if (++fired < 3) wheel.add(10ms, cb, start + fired * 10ms);
+  };
+  wheel.add(10ms, cb, start);
+  for (auto t = 0ms; t <= 100ms; t += 10ms) {
+    wheel.advance(start + t);
+  }
+  ASSERT_EQ(fired, 3);
+}
+
+TEST(timer_wheel_test, zero_timeout_fires_on_next_tick) {
+  const auto start = steady_clock::now();
+  auto wheel = TimerWheel{10ms, 8, start};
+  ASSERT_EQ(wheel.advance(start + 50ms), 0u);
+  auto fired = false;
+  wheel.add(0ms, [&]() { fired = true; }, start + 50ms);
+  ASSERT_EQ(wheel.advance(start + 55ms), 0u);
+  ASSERT_EQ(wheel.advance(start + 60ms), 1u);
+  ASSERT_TRUE(fired);
+}
+
+}  // namespace